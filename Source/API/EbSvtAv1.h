@@ -95,7 +95,12 @@ typedef struct EbBufferHeaderType {
     int64_t  pts;
 
     // pic info
-    uint8_t          temporal_layer_index;
+    uint8_t temporal_layer_index;
+    // scene analysis (output only), percentage of the picture regions detected as a scene change or as a flash
+    // by the scene transition detector of the picture decision, 0 when the detector did not run on the picture.
+    // They take the alignment space after temporal_layer_index, so the size of the struct is unchanged
+    uint8_t          scene_change_score;
+    uint8_t          flash_score;
     uint32_t         qp;
     uint32_t         avg_qp;
     EbAv1PictureType pic_type;
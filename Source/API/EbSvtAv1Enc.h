@@ -69,8 +69,11 @@ typedef enum ATTRIBUTE_PACKED {
 #define EB_BUFFERFLAG_SHOW_EXT 0x00000002 // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD 0x00000004 // signals that the packet contains a TD
 #define EB_BUFFERFLAG_IS_ALT_REF 0x00000008 // signals that the packet contains an ALT_REF frame
+#define EB_BUFFERFLAG_FRAGMENT 0x00000010 // signals that the packet holds only part of a frame (obu streaming)
+#define EB_BUFFERFLAG_LAST_FRAGMENT 0x00000020 // signals that the packet completes the frame (obu streaming)
+#define EB_BUFFERFLAG_APP_BUFFER 0x00000040 // signals that p_buffer comes from the output buffer allocator
 #define EB_BUFFERFLAG_ERROR_MASK \
-    0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
+    0xFFFFFF80 // mask for signalling error assuming top flags fit in 7 bits. To be changed, if more flags are added.
 
 /*
  * Struct for storing content light level information
@@ -153,6 +156,7 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    SVT_AV1_STREAM_INFO_ANALYSIS_CACHE_OUT,
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
@@ -216,6 +220,16 @@ typedef struct SvtAv1FrameScaleEvts {
 
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
+/*
+ * Output buffer allocator, see EbSvtAv1EncConfiguration::output_buffer_alloc.
+ * Returns a buffer of at least size bytes, or NULL on failure.
+ */
+typedef uint8_t *(*EbOutputBufferAlloc)(void *output_buffer_ctx, uint32_t size);
+/*
+ * Frees a buffer obtained from the output buffer allocator which the encoder does not output.
+ */
+typedef void (*EbOutputBufferFree)(void *output_buffer_ctx, uint8_t *buffer);
+
 typedef struct EbSvtAv1EncConfiguration {
     /**
      * @brief Encoder preset used.
@@ -749,6 +763,8 @@ typedef struct EbSvtAv1EncConfiguration {
     int32_t target_socket;
 
     /* CPU FLAGS to limit assembly instruction set used by encoder.
+    * The kernels are selected once per process, by the first encoder initialized, later encoders
+    * asking for other flags use the ones of the first encoder.
     * Default is EB_CPU_FLAGS_ALL. */
     EbCpuFlags use_cpu_flags;
 
@@ -1038,8 +1054,101 @@ typedef struct EbSvtAv1EncConfiguration {
      */
      uint8_t hbd_mds;
 
+    /**
+     * @brief Fast recode: when the recode loop re-encodes a frame with a small change in base q,
+     * keep the blocks (partitioning, modes and motion vectors) coded by the previous pass and only
+     * redo the transform, quantization and entropy coding at the new q, without mode decision.
+     * Large q changes always fall back to a full recode.
+     * 0: disabled
+     * 1: enabled
+     * Default is 0
+     */
+    bool fast_recode;
+
+    /**
+     * @brief OBU streaming: svt_av1_enc_get_packet returns each frame as a sequence of fragments, the
+     * frame header first and then one tile group per tile as soon as the tile is entropy coded, so the
+     * transmission can overlap with the coding of the remaining tiles. Every fragment is flagged with
+     * EB_BUFFERFLAG_FRAGMENT, the one completing the frame also with EB_BUFFERFLAG_LAST_FRAGMENT.
+     * Only supported with the low delay prediction structure and without super-resolution.
+     * 0: disabled
+     * 1: enabled
+     * Default is 0
+     */
+    bool obu_streaming;
+
+    /**
+     * @brief PD0 quadrant parallelism: with 128x128 superblocks, the first partitioning pass (PD0) of the
+     * four 64x64 quadrants of a superblock runs on four threads. The quadrants are decided speculatively from
+     * the neighbours at the start of the superblock and reconciled before the final partitioning pass, so
+     * the output differs from the default but does not depend on the thread count. Each mode decision thread
+     * gets three helper threads with their own mode decision context.
+     * Only used with the 8-bit mode decision.
+     * 0: disabled
+     * 1: enabled
+     * Default is 0
+     */
+    bool pd0_quadrant_parallel;
+
+    /**
+     * @brief Analysis cache: an encode with analysis_cache_out set saves its lookahead analysis (scene changes,
+     * mini-GOP decisions, and the TPL r0, betas and lambda scaling factors), returned at the end of the encode by
+     * svt_av1_enc_get_stream_info with SVT_AV1_STREAM_INFO_ANALYSIS_CACHE_OUT. A later encode of the same input at
+     * the same resolution given that buffer in analysis_cache_in reuses the analysis instead of recomputing it,
+     * e.g. when encoding a title at several CRFs. svt_av1_enc_init fails when the GOP structure or TPL settings of
+     * the encodes differ, and warns when only the CRF or target bitrate differ. The buffer must stay valid until
+     * svt_av1_enc_deinit.
+     * Default is off / no buffer
+     */
+    bool analysis_cache_out;
+
+    /**
+     * @brief Chunk parallel encoding: the input is split at the key frame interval into closed GOPs of
+     * intra_period_length + 1 pictures, encoded concurrently by chunk_parallel encoder instances, each one encoding
+     * every chunk_parallel-th GOP. The packets are still returned in order by svt_av1_enc_get_packet. Up to
+     * intra_period_length + 1 pictures waiting for an instance are copied, svt_av1_enc_send_picture blocks while
+     * they are all queued, so the memory usage grows with chunk_parallel and the key frame interval.
+     * Only supported with the random access prediction structure, closed GOPs, a finite key frame interval and
+     * single pass CRF/CQP; each GOP is encoded with the same rate factor, there is no rate control across GOPs.
+     * 0/1: disabled
+     * 2-255: number of GOPs encoded concurrently
+     * Default is 0
+     */
+    uint8_t chunk_parallel;
+
+    /**
+     * @brief Split entropy coding: each entropy coding thread records the symbols of its tile, with their
+     * contexts, while a helper thread runs the arithmetic coder and the CDF adaptation on them. The two stages
+     * are joined by a bounded queue, the bitstream is identical to the one of the single stage coding.
+     * Each entropy coding thread gets one helper thread.
+     * 0: disabled
+     * 1: enabled
+     * Default is 0
+     */
+    bool split_entropy_coding;
+
+    /**
+     * @brief Output buffer allocator: when set, the encoder writes the packets returned by
+     * svt_av1_enc_get_packet directly into buffers obtained from output_buffer_alloc, e.g. memory owned by
+     * the framework the packets are handed to, instead of into its own buffers. Such packets are flagged with
+     * EB_BUFFERFLAG_APP_BUFFER and the application owns their p_buffer: svt_av1_enc_release_out_buffer does
+     * not free it. The buffers the encoder allocated but does not output are returned to output_buffer_free.
+     * Both callbacks are called from the encoder threads and must be set together.
+     * Default is NULL
+     */
+    EbOutputBufferAlloc output_buffer_alloc;
+    EbOutputBufferFree  output_buffer_free;
+    // Opaque pointer passed to the output buffer callbacks
+    void *output_buffer_ctx;
+
+    // Analysis cache saved by an earlier encode with analysis_cache_out set, see analysis_cache_out
+    SvtAv1FixedBuf analysis_cache_in;
+
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
-    uint8_t padding[128 - 1 * sizeof(bool) - 9 * sizeof(uint8_t) - sizeof(double)];
+    /* The pointer sized parameters above follow all the bool / uint8_t ones, so the alignment hole before them is
+     * covered by the slack the padding had; api_test checks the size of the struct */
+    uint8_t padding[128 - 6 * sizeof(bool) - 10 * sizeof(uint8_t) - sizeof(double) - 3 * sizeof(void *) -
+                    sizeof(SvtAv1FixedBuf)];
 } EbSvtAv1EncConfiguration;
 
 /**
@@ -1060,6 +1169,11 @@ EB_API const char *svt_psy_get_version(void);
  */
 EB_API void svt_av1_print_version(void);
 
+// Opaque executor shared by several encoder instances
+typedef struct EbSvtAv1Executor EbSvtAv1Executor;
+// Opaque lookahead analysis shared by the renditions of an ABR ladder
+typedef struct EbSvtAv1AnalysisLadder EbSvtAv1AnalysisLadder;
+
 /* STEP 1: Call the library to construct a Component Handle.
      *
      * Parameter:
@@ -1072,6 +1186,65 @@ EB_API EbErrorType svt_av1_enc_init_handle(
     EbComponentType         **p_handle,
     EbSvtAv1EncConfiguration *config_ptr); // config_ptr will be loaded with default params from the library
 
+/* OPTIONAL: Shared executor for multi-instance deployments.
+     *
+     * An executor bounds the number of compute-heavy tasks run at the same time by all the encoder
+     * instances attached to it to its core count, and hands the cores to the instances in proportion
+     * to their priority while they compete for them. Attached instances also size their thread pools
+     * from their share of the executor cores instead of from the whole machine.
+     *
+     * Parameter:
+     * @ **executor   Created executor.
+     * @ core_count   Number of cores shared by the attached instances, 0 uses all the processors. */
+EB_API EbErrorType svt_av1_executor_create(EbSvtAv1Executor **executor, uint32_t core_count);
+
+/* OPTIONAL: Attach an encoder instance to an executor, must be called before svt_av1_enc_set_parameter().
+     * The instance is detached by svt_av1_enc_deinit_handle(). The shares are computed from the instances
+     * attached when svt_av1_enc_set_parameter() is called, so attach all instances first for even sizing.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *executor           Executor created by svt_av1_executor_create().
+     * @ priority            Relative weight of the instance, 1 to 64, 0 is treated as 1. */
+EB_API EbErrorType svt_av1_enc_attach_executor(EbComponentType *svt_enc_component, EbSvtAv1Executor *executor,
+                                               uint32_t priority);
+
+/* OPTIONAL: Destroy an executor. It is freed once the last attached instance has been detached.
+     *
+     * Parameter:
+     * @ *executor  Executor created by svt_av1_executor_create(). */
+EB_API EbErrorType svt_av1_executor_destroy(EbSvtAv1Executor *executor);
+
+/* OPTIONAL: Shared lookahead analysis for ABR ladder encoding.
+     *
+     * The renditions of a ladder encode the same pictures at different resolutions or rates. The leader
+     * instance publishes its scene changes, dynamic mini-GOP decisions and TPL propagation results, and
+     * the follower instances reuse them, rescaled to their own resolution, instead of running their own
+     * analysis. Motion estimation still runs in every instance, on its own input. All the instances must
+     * be sent the same pictures in the same order; feed the leader ahead of its followers, a follower
+     * waits for the leader when it gets ahead of it.
+     *
+     * Parameter:
+     * @ **ladder   Created ladder. */
+EB_API EbErrorType svt_av1_analysis_ladder_create(EbSvtAv1AnalysisLadder **ladder);
+
+/* OPTIONAL: Attach an encoder instance to a ladder, must be called before svt_av1_enc_init().
+     * The instance is detached by svt_av1_enc_deinit_handle(), detaching the leader releases the
+     * followers waiting for it. A ladder has at most one leader.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *ladder             Ladder created by svt_av1_analysis_ladder_create().
+     * @ leader              Whether the instance publishes its analysis or consumes the analysis of the leader. */
+EB_API EbErrorType svt_av1_enc_attach_analysis_ladder(EbComponentType *svt_enc_component,
+                                                      EbSvtAv1AnalysisLadder *ladder, bool leader);
+
+/* OPTIONAL: Destroy a ladder. It is freed once the last attached instance has been detached.
+     *
+     * Parameter:
+     * @ *ladder  Ladder created by svt_av1_analysis_ladder_create(). */
+EB_API EbErrorType svt_av1_analysis_ladder_destroy(EbSvtAv1AnalysisLadder *ladder);
+
 /* STEP 2: Set all configuration parameters.
      *
      * Parameter:
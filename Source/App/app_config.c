@@ -53,6 +53,8 @@
 #define PASS_TOKEN "--pass"
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
+#define ANALYSIS_CACHE_OUT_TOKEN "--analysis-cache-out"
+#define ANALYSIS_CACHE_IN_TOKEN "--analysis-cache-in"
 #define STAT_FILE_TOKEN "--stat-file"
 #define WIDTH_TOKEN "-w"
 #define HEIGHT_TOKEN "-h"
@@ -84,6 +86,7 @@
 #define ENCODER_COLOR_FORMAT "--color-format"
 #define HIERARCHICAL_LEVELS_TOKEN "--hierarchical-levels" // no Eval
 #define PRED_STRUCT_TOKEN "--pred-struct"
+#define OBU_STREAMING_TOKEN "--obu-streaming"
 #define PROFILE_TOKEN "--profile"
 #define INTRA_PERIOD_TOKEN "--intra-period"
 #define TIER_TOKEN "--tier"
@@ -128,6 +131,7 @@
 #define BUFFER_INITIAL_SIZE_TOKEN "--buf-initial-sz"
 #define BUFFER_OPTIMAL_SIZE_TOKEN "--buf-optimal-sz"
 #define RECODE_LOOP_TOKEN "--recode-loop"
+#define FAST_RECODE_TOKEN "--fast-recode"
 #define ENABLE_TPL_LA_TOKEN "--enable-tpl-la"
 #define TILE_ROW_TOKEN "--tile-rows"
 #define TILE_COL_TOKEN "--tile-columns"
@@ -139,6 +143,9 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define PD0_QUADRANT_PARALLEL_TOKEN "--pd0-quadrant-parallel"
+#define SPLIT_EC_TOKEN "--split-ec"
+#define CHUNK_PARALLEL_TOKEN "--chunk-parallel"
 
 //double dash
 #define PRESET_TOKEN "--preset"
@@ -456,6 +463,36 @@ static EbErrorType set_two_pass_stats(EbConfig *cfg, const char *token, const ch
     return str_to_str(value, (char **)&cfg->stats, token);
 }
 
+static EbErrorType set_analysis_cache_out(EbConfig *cfg, const char *token, const char *value) {
+    cfg->config.analysis_cache_out = true;
+    return str_to_str(value, (char **)&cfg->analysis_cache_out, token);
+}
+
+static EbErrorType set_analysis_cache_in(EbConfig *cfg, const char *token, const char *value) {
+    FILE       *file         = NULL;
+    EbErrorType return_error = open_file(&file, token, value, "rb");
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    free(cfg->config.analysis_cache_in.buf);
+    cfg->config.analysis_cache_in.buf = NULL;
+    cfg->config.analysis_cache_in.sz  = 0;
+
+    long size = -1;
+    if (!fseek(file, 0, SEEK_END))
+        size = ftell(file);
+    rewind(file);
+    void *buf = size > 0 ? malloc(size) : NULL;
+    if (!buf || fread(buf, 1, size, file) != (size_t)size) {
+        free(buf);
+        fclose(file);
+        return validate_error(EB_ErrorBadParameter, token, value);
+    }
+    fclose(file);
+    cfg->config.analysis_cache_in.buf = buf;
+    cfg->config.analysis_cache_in.sz  = (uint64_t)size;
+    return EB_ErrorNone;
+}
+
 static EbErrorType set_passes(EbConfig *cfg, const char *token, const char *value) {
     (void)cfg;
     (void)token;
@@ -841,6 +878,20 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     PD0_QUADRANT_PARALLEL_TOKEN,
+     "Run the first partitioning pass of the four 64x64 quadrants of a 128x128 superblock in parallel, "
+     "default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     SPLIT_EC_TOKEN,
+     "Run the arithmetic coder of each tile on a helper thread of its entropy coding thread, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     CHUNK_PARALLEL_TOKEN,
+     "Number of closed GOPs of the key frame interval encoded concurrently, single pass CRF/CQP only, default is 0 "
+     "[0-255]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -960,6 +1011,11 @@ ConfigEntry config_entry_rc[] = {
      "Recode loop level, refer to \"Recode loop level table\" in the user guide for more info [0: "
      "off, 4: preset based]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     FAST_RECODE_TOKEN,
+     "Keep the blocks of the previous pass and only redo transform, quantization and entropy coding when the recode "
+     "loop only slightly changes q, default is 0 [0-1]",
+     set_cfg_generic_token},
     {SINGLE_INPUT,
      VBR_MIN_SECTION_PCT_TOKEN,
      "GOP min bitrate (expressed as a percentage of the target rate), default is 0 [0-100]",
@@ -1009,6 +1065,15 @@ ConfigEntry config_entry_2p[] = {
      "Number of encoding passes, default is preset dependent but generally 1 [1: one pass encode, "
      "2: multi-pass encode]",
      set_passes},
+    {SINGLE_INPUT,
+     ANALYSIS_CACHE_OUT_TOKEN,
+     "Filename the lookahead analysis of the encode is saved to, to be reused by later encodes of the same input",
+     set_analysis_cache_out},
+    {SINGLE_INPUT,
+     ANALYSIS_CACHE_IN_TOKEN,
+     "Filename of a lookahead analysis saved by an encode of the same input at the same resolution, reused "
+     "instead of recomputing the analysis",
+     set_analysis_cache_in},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1044,6 +1109,11 @@ ConfigEntry config_entry_intra_refresh[] = {
      "Set prediction structure, default is 2 [1: low delay frames, 2: "
      "random access]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     OBU_STREAMING_TOKEN,
+     "Output each frame as a frame header and per tile fragments as soon as the tiles are coded, low delay "
+     "only, default is 0 [0-1]",
+     set_cfg_generic_token},
     {SINGLE_INPUT,
      FORCE_KEY_FRAMES_TOKEN,
      "Force key frames at the comma separated specifiers. `#f` for frames, `#.#s` for seconds",
@@ -1336,6 +1406,9 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LevelOfParallelism", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, PD0_QUADRANT_PARALLEL_TOKEN, "Pd0QuadrantParallel", set_cfg_generic_token},
+    {SINGLE_INPUT, SPLIT_EC_TOKEN, "SplitEntropyCoding", set_cfg_generic_token},
+    {SINGLE_INPUT, CHUNK_PARALLEL_TOKEN, "ChunkParallel", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -1373,6 +1446,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, BUFFER_INITIAL_SIZE_TOKEN, "BufInitialSz", set_cfg_generic_token},
     {SINGLE_INPUT, BUFFER_OPTIMAL_SIZE_TOKEN, "BufOptimalSz", set_cfg_generic_token},
     {SINGLE_INPUT, RECODE_LOOP_TOKEN, "RecodeLoop", set_cfg_generic_token},
+    {SINGLE_INPUT, FAST_RECODE_TOKEN, "FastRecode", set_cfg_generic_token},
     {SINGLE_INPUT, VBR_MIN_SECTION_PCT_TOKEN, "MinSectionPct", set_cfg_generic_token},
     {SINGLE_INPUT, VBR_MAX_SECTION_PCT_TOKEN, "MaxSectionPct", set_cfg_generic_token},
 
@@ -1380,6 +1454,8 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, PASS_TOKEN, "Pass", set_cfg_generic_token},
     {SINGLE_INPUT, TWO_PASS_STATS_TOKEN, "Stats", set_two_pass_stats},
     {SINGLE_INPUT, PASSES_TOKEN, "Passes", set_passes},
+    {SINGLE_INPUT, ANALYSIS_CACHE_OUT_TOKEN, "AnalysisCacheOut", set_analysis_cache_out},
+    {SINGLE_INPUT, ANALYSIS_CACHE_IN_TOKEN, "AnalysisCacheIn", set_analysis_cache_in},
 
     // GOP size and type Options
     {SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", set_cfg_generic_token},
@@ -1390,6 +1466,7 @@ ConfigEntry config_entry[] = {
     //   Prediction Structure
     {SINGLE_INPUT, HIERARCHICAL_LEVELS_TOKEN, "HierarchicalLevels", set_cfg_generic_token},
     {SINGLE_INPUT, PRED_STRUCT_TOKEN, "PredStructure", set_cfg_generic_token},
+    {SINGLE_INPUT, OBU_STREAMING_TOKEN, "ObuStreaming", set_cfg_generic_token},
     {SINGLE_INPUT, FORCE_KEY_FRAMES_TOKEN, "ForceKeyFrames", set_cfg_force_key_frames},
     {SINGLE_INPUT, STARTUP_MG_SIZE_TOKEN, "StartupMgSize", set_cfg_generic_token},
     {SINGLE_INPUT, STARTUP_QP_OFFSET_TOKEN, "StartupGopQpOffset", set_cfg_generic_token},
@@ -1597,7 +1674,10 @@ void svt_config_dtor(EbConfig *app_cfg) {
     free(app_cfg->forced_keyframes.specifiers);
     free(app_cfg->forced_keyframes.frames);
 
+    free(app_cfg->fragment_buffer);
     free((void *)app_cfg->stats);
+    free((void *)app_cfg->analysis_cache_out);
+    free(app_cfg->config.analysis_cache_in.buf);
     free(app_cfg);
     return;
 }
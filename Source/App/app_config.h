@@ -136,6 +136,8 @@ typedef struct EbConfig {
     const char *stats;
     FILE       *input_stat_file;
     FILE       *output_stat_file;
+    /* analysis cache */
+    const char *analysis_cache_out;
     bool        y4m_input;
     char        y4m_buf[9];
 
@@ -168,6 +170,11 @@ typedef struct EbConfig {
 
     uint64_t ivf_count;
 
+    // obu streaming: fragments of the frame being received
+    uint8_t *fragment_buffer;
+    uint32_t fragment_size;
+    uint32_t fragment_capacity;
+
     struct forced_key_frames forced_keyframes;
 
     /****************************************
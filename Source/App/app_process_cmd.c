@@ -845,6 +845,37 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     return;
 }
 
+// Saves the lookahead analysis of the final pass to --analysis-cache-out
+static void write_analysis_cache(EbConfig *app_cfg, EbComponentType *component_handle) {
+    if (!app_cfg->analysis_cache_out || app_cfg->config.pass == ENC_FIRST_PASS)
+        return;
+    SvtAv1FixedBuf analysis_cache;
+    if (svt_av1_enc_get_stream_info(component_handle, SVT_AV1_STREAM_INFO_ANALYSIS_CACHE_OUT, &analysis_cache) !=
+        EB_ErrorNone)
+        return;
+    FILE *file;
+    FOPEN(file, app_cfg->analysis_cache_out, "wb");
+    if (!file || fwrite(analysis_cache.buf, 1, analysis_cache.sz, file) != analysis_cache.sz)
+        fprintf(app_cfg->error_log_file, "Error: can't write analysis cache %s\n", app_cfg->analysis_cache_out);
+    if (file)
+        fclose(file);
+}
+
+// obu streaming: gathers the fragments of a frame until the last one is received
+static bool append_fragment(EbConfig *app_cfg, const EbBufferHeaderType *header_ptr) {
+    const uint32_t size = app_cfg->fragment_size + header_ptr->n_filled_len;
+    if (size > app_cfg->fragment_capacity) {
+        uint8_t *buffer = (uint8_t *)realloc(app_cfg->fragment_buffer, size);
+        if (!buffer)
+            return false;
+        app_cfg->fragment_buffer   = buffer;
+        app_cfg->fragment_capacity = size;
+    }
+    memcpy(app_cfg->fragment_buffer + app_cfg->fragment_size, header_ptr->p_buffer, header_ptr->n_filled_len);
+    app_cfg->fragment_size = size;
+    return true;
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *app_cfg    = channel->app_cfg;
     AppPortActiveType   *port_state = &app_cfg->output_stream_port_active;
@@ -861,14 +892,16 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
     uint64_t finish_s_time = 0;
     uint64_t finish_u_time = 0;
     uint8_t  is_alt_ref    = 1;
+    uint8_t  is_fragment   = 0;
     if (channel->exit_cond_output != APP_ExitConditionNone)
         return;
     uint8_t pic_send_done = (channel->exit_cond_input == APP_ExitConditionNone) ||
             (channel->exit_cond_recon == APP_ExitConditionNone)
         ? 0
         : 1;
-    while (is_alt_ref) {
-        is_alt_ref = 0;
+    while (is_alt_ref || is_fragment) {
+        is_alt_ref  = 0;
+        is_fragment = 0;
         // If we are not in low-delay mode, this is a non-blocking call until all input frames are sent
         EbErrorType stream_status = svt_av1_enc_get_packet(component_handle, &header_ptr, pic_send_done);
 
@@ -887,6 +920,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 // Release the output buffer
                 svt_av1_enc_release_out_buffer(&header_ptr);
 
+                write_analysis_cache(app_cfg, component_handle);
                 if (app_cfg->config.pass == ENC_FIRST_PASS) {
                     SvtAv1FixedBuf first_pass_stat;
                     EbErrorType    ret = svt_av1_enc_get_stream_info(
@@ -902,7 +936,30 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         }
                     }
                 }
+            } else if (flags & EB_BUFFERFLAG_FRAGMENT && !(flags & EB_BUFFERFLAG_LAST_FRAGMENT)) {
+                // the frame is written once its last fragment is received
+                is_fragment = append_fragment(app_cfg, header_ptr);
+                svt_av1_enc_release_out_buffer(&header_ptr);
+                if (!is_fragment) {
+                    fprintf(stderr, "\nError: could not allocate the output frame buffer\n");
+                    channel->exit_cond_output = APP_ExitConditionError;
+                    return;
+                }
+                continue;
             } else {
+                const uint8_t *frame_data = header_ptr->p_buffer;
+                uint32_t       frame_size = header_ptr->n_filled_len;
+                if (flags & EB_BUFFERFLAG_FRAGMENT) {
+                    if (!append_fragment(app_cfg, header_ptr)) {
+                        svt_av1_enc_release_out_buffer(&header_ptr);
+                        fprintf(stderr, "\nError: could not allocate the output frame buffer\n");
+                        channel->exit_cond_output = APP_ExitConditionError;
+                        return;
+                    }
+                    frame_data             = app_cfg->fragment_buffer;
+                    frame_size             = app_cfg->fragment_size;
+                    app_cfg->fragment_size = 0;
+                }
                 is_alt_ref = (flags & EB_BUFFERFLAG_IS_ALT_REF);
                 if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
                     ++(app_cfg->performance_context.frame_count);
@@ -930,11 +987,11 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         write_ivf_stream_header(
                             app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
                     }
-                    write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                    fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
+                    write_ivf_frame_header(app_cfg, frame_size);
+                    fwrite(frame_data, 1, frame_size, stream_file);
                 }
 
-                app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
+                app_cfg->performance_context.byte_count += frame_size;
 
                 if (app_cfg->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
                     process_output_statistics_buffer(header_ptr, app_cfg);
@@ -1059,6 +1116,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             svt_av1_enc_release_out_buffer(&header_ptr);
 
             if (flags & EB_BUFFERFLAG_EOS) {
+                write_analysis_cache(app_cfg, component_handle);
                 if (app_cfg->config.pass == ENC_FIRST_PASS) {
                     SvtAv1FixedBuf first_pass_stat;
                     EbErrorType    ret = svt_av1_enc_get_stream_info(
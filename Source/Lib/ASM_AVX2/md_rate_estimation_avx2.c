@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "md_rate_estimation.h"
+#include "bitstream_unit.h"
+#include "aom_dsp_rtcd.h"
+
+// Costs of the (at most 16) symbols of a cdf, 8 at a time: the symbol probabilities are normalized to
+// [1 << 14, 1 << 15) with the shift read from the float exponent, and the cost of the normalized probability is
+// gathered from av1_prob_cost[]
+static INLINE __m256i syntax_rate_from_p15_avx2(__m256i p15) {
+    // av1_prob_cost[] is a uint16_t table, the 32-bit gather of its last entry would read past the end
+    const __m256i last = _mm256_set1_epi32(127);
+
+    p15 = _mm256_max_epi32(p15, _mm256_set1_epi32(EC_MIN_PROB));
+    p15 = _mm256_min_epi32(p15, _mm256_set1_epi32(CDF_PROB_TOP - 1));
+    const __m256i msb   = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(p15)), 23),
+                                         _mm256_set1_epi32(127));
+    const __m256i shift = _mm256_sub_epi32(_mm256_set1_epi32(CDF_PROB_BITS - 1), msb);
+    const __m256i num   = _mm256_sllv_epi32(p15, shift);
+    // get_prob(num, CDF_PROB_TOP)
+    __m256i prob = _mm256_srli_epi32(_mm256_add_epi32(_mm256_slli_epi32(num, 8), _mm256_set1_epi32(CDF_PROB_TOP >> 1)),
+                                     CDF_PROB_BITS);
+    prob               = _mm256_min_epi32(prob, _mm256_set1_epi32(255));
+    const __m256i idx  = _mm256_sub_epi32(prob, _mm256_set1_epi32(128));
+    const __m256i mask = _mm256_xor_si256(_mm256_cmpeq_epi32(idx, last), _mm256_set1_epi32(-1));
+    __m256i       cost = _mm256_mask_i32gather_epi32(
+        _mm256_set1_epi32(av1_prob_cost[127]), (const int *)av1_prob_cost, idx, mask, sizeof(av1_prob_cost[0]));
+    cost = _mm256_and_si256(cost, _mm256_set1_epi32(0xFFFF));
+    return _mm256_add_epi32(cost, _mm256_slli_epi32(shift, AV1_PROB_COST_SHIFT));
+}
+
+void svt_aom_get_syntax_rate_from_cdf_avx2(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map) {
+    DECLARE_ALIGNED(32, int32_t, cost[16]);
+    int32_t n = 0;
+
+    while (cdf[n] != AOM_ICDF(CDF_PROB_TOP) && n < 15) n++;
+    n++;
+    // the gathers only pay off on the larger cdfs
+    if (n <= 8) {
+        svt_aom_get_syntax_rate_from_cdf_c(costs, cdf, inv_map);
+        return;
+    }
+    // the cdf is loaded in pairs of entries, the entry past the end of a cdf of an odd number of symbols is its counter
+    const __m256i pairs = _mm256_cmpgt_epi32(_mm256_set1_epi32((n + 1) >> 1),
+                                             _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i cur   = _mm256_maskload_epi32((const int *)cdf, pairs);
+    // the cdf before each symbol, AOM_ICDF(0) before the first one
+    const __m256i prev = _mm256_alignr_epi8(cur, _mm256_permute2x128_si256(cur, cur, 0x08), 14);
+    // the symbol probabilities, modulo 1 << 16 as in the C code
+    const __m256i p15 = _mm256_sub_epi16(_mm256_insert_epi16(prev, AOM_ICDF(0), 0), cur);
+    _mm256_store_si256((__m256i *)cost, syntax_rate_from_p15_avx2(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(p15))));
+    _mm256_store_si256((__m256i *)(cost + 8),
+                       syntax_rate_from_p15_avx2(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(p15, 1))));
+    if (inv_map)
+        for (int32_t i = 0; i < n; i++) costs[inv_map[i]] = cost[i];
+    else
+        memcpy(costs, cost, n * sizeof(*costs));
+}
@@ -0,0 +1,417 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "analysis_cache.h"
+#include "pcs.h"
+#include "sequence_control_set.h"
+#include "svt_malloc.h"
+#include "svt_threads.h"
+#include "svt_log.h"
+#include "utility.h"
+
+#define CACHE_CAPACITY_INIT (1 << 16)
+
+typedef enum CacheRecordType {
+    CACHE_SCENE_CHANGE,
+    CACHE_MINI_GOP,
+    CACHE_R0,
+    CACHE_RECORD_TYPES
+} CacheRecordType;
+
+// Settings the cached analysis depends on
+typedef struct CacheSettings {
+    uint16_t width;
+    uint16_t height;
+    uint16_t sb_size;
+    // Structural settings: the GOP structure and the TPL groups depend on them, a cache exported with other
+    // values is rejected
+    int8_t   enc_mode;
+    uint8_t  pred_structure;
+    uint8_t  hierarchical_levels;
+    uint8_t  startup_mg_size;
+    uint8_t  enable_dg;
+    uint8_t  scene_change_detection;
+    uint8_t  rate_control_mode;
+    uint8_t  enable_tpl_la;
+    uint8_t  lad_mg;
+    uint8_t  tpl_lad_mg;
+    uint8_t  encoder_bit_depth;
+    uint8_t  reserved[3];
+    int32_t  intra_period_length;
+    // Rate settings: the TPL results were computed at the QP of the exporting encode, a cache exported with other
+    // values is reused with a warning
+    uint8_t  qp;
+    uint8_t  extended_crf_qindex_offset;
+    uint16_t reserved2;
+    uint32_t target_bit_rate;
+} CacheSettings;
+
+typedef struct CacheHeader {
+    uint32_t      magic;
+    uint16_t      version;
+    uint16_t      reserved;
+    CacheSettings settings;
+} CacheHeader;
+
+typedef struct CacheRecordHeader {
+    uint8_t  type;
+    uint8_t  reserved[3];
+    uint32_t size;
+    uint64_t picture_number;
+} CacheRecordHeader;
+
+// r0 payload: the fields below followed by the betas and the lambda scaling factors
+typedef struct CacheR0 {
+    double   r0;
+    uint32_t beta_count;
+    uint32_t factor_count;
+    uint8_t  tpl_is_valid;
+    uint8_t  reserved[7];
+} CacheR0;
+
+// Loaded record, the payload points into the input buffer
+typedef struct CacheEntry {
+    uint64_t       picture_number;
+    const uint8_t *payload;
+    uint32_t       size;
+} CacheEntry;
+
+struct AnalysisCache {
+    // Loaded records of each type, sorted by picture number
+    CacheEntry *entries[CACHE_RECORD_TYPES];
+    uint32_t    entry_count[CACHE_RECORD_TYPES];
+    // Exported records, appended by the picture decision and rate control threads
+    bool     export_cache;
+    EbHandle mutex;
+    uint8_t *out;
+    size_t   out_size;
+    size_t   out_capacity;
+};
+
+static int compare_entries(const void *a, const void *b) {
+    const uint64_t pa = ((const CacheEntry *)a)->picture_number;
+    const uint64_t pb = ((const CacheEntry *)b)->picture_number;
+    return pa < pb ? -1 : pa > pb;
+}
+
+static void get_cache_settings(const SequenceControlSet *scs, CacheSettings *settings) {
+    const EbSvtAv1EncConfiguration *cfg = &scs->static_config;
+    memset(settings, 0, sizeof(*settings));
+    settings->width                      = scs->max_input_luma_width;
+    settings->height                     = scs->max_input_luma_height;
+    settings->sb_size                    = scs->super_block_size;
+    settings->enc_mode                   = cfg->enc_mode;
+    settings->pred_structure             = cfg->pred_structure;
+    settings->hierarchical_levels        = (uint8_t)cfg->hierarchical_levels;
+    settings->startup_mg_size            = cfg->startup_mg_size;
+    settings->enable_dg                  = scs->enable_dg;
+    settings->scene_change_detection     = (uint8_t)cfg->scene_change_detection;
+    settings->rate_control_mode          = cfg->rate_control_mode;
+    settings->enable_tpl_la              = cfg->enable_tpl_la;
+    settings->lad_mg                     = scs->lad_mg;
+    settings->tpl_lad_mg                 = scs->tpl_lad_mg;
+    settings->encoder_bit_depth          = (uint8_t)cfg->encoder_bit_depth;
+    settings->intra_period_length        = cfg->intra_period_length;
+    settings->qp                         = (uint8_t)cfg->qp;
+    settings->extended_crf_qindex_offset = cfg->extended_crf_qindex_offset;
+    settings->target_bit_rate            = cfg->target_bit_rate;
+}
+
+// Rejects a cache exported with other structural settings, and warns when only the rate settings differ
+static EbErrorType check_cache_settings(const CacheSettings *cached, const CacheSettings *current) {
+    if (cached->width != current->width || cached->height != current->height || cached->sb_size != current->sb_size) {
+        SVT_ERROR("Analysis cache: exported for %ux%u with %u superblocks, encoding %ux%u with %u superblocks\n",
+                  cached->width,
+                  cached->height,
+                  cached->sb_size,
+                  current->width,
+                  current->height,
+                  current->sb_size);
+        return EB_ErrorBadParameter;
+    }
+    const struct {
+        const char *name;
+        int32_t     cached;
+        int32_t     current;
+    } fields[] = {
+        {"preset", cached->enc_mode, current->enc_mode},
+        {"prediction structure", cached->pred_structure, current->pred_structure},
+        {"hierarchical levels", cached->hierarchical_levels, current->hierarchical_levels},
+        {"startup mini-GOP size", cached->startup_mg_size, current->startup_mg_size},
+        {"dynamic GOP", cached->enable_dg, current->enable_dg},
+        {"scene change detection", cached->scene_change_detection, current->scene_change_detection},
+        {"rate control mode", cached->rate_control_mode, current->rate_control_mode},
+        {"TPL", cached->enable_tpl_la, current->enable_tpl_la},
+        {"lookahead mini-GOPs", cached->lad_mg, current->lad_mg},
+        {"TPL lookahead mini-GOPs", cached->tpl_lad_mg, current->tpl_lad_mg},
+        {"bit depth", cached->encoder_bit_depth, current->encoder_bit_depth},
+        {"key frame interval", cached->intra_period_length, current->intra_period_length},
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        if (fields[i].cached != fields[i].current) {
+            SVT_ERROR("Analysis cache: exported with %s %d, encoding with %d\n",
+                      fields[i].name,
+                      fields[i].cached,
+                      fields[i].current);
+            return EB_ErrorBadParameter;
+        }
+    }
+    if (current->rate_control_mode == SVT_AV1_RC_MODE_CQP_OR_CRF) {
+        if (cached->qp != current->qp || cached->extended_crf_qindex_offset != current->extended_crf_qindex_offset)
+            SVT_WARN("Analysis cache: exported at CRF %u (+%u qindex), encoding at CRF %u (+%u qindex), the TPL "
+                     "results are reused as an approximation\n",
+                     cached->qp,
+                     cached->extended_crf_qindex_offset,
+                     current->qp,
+                     current->extended_crf_qindex_offset);
+    } else if (cached->target_bit_rate != current->target_bit_rate)
+        SVT_WARN("Analysis cache: exported at %u bps, encoding at %u bps, the TPL results are reused as an "
+                 "approximation\n",
+                 cached->target_bit_rate,
+                 current->target_bit_rate);
+    return EB_ErrorNone;
+}
+
+static EbErrorType load_cache(AnalysisCache *cache, const SvtAv1FixedBuf *cache_in, const CacheSettings *settings) {
+    const uint8_t *buf = (const uint8_t *)cache_in->buf;
+    CacheHeader    header;
+    if (cache_in->sz < sizeof(header)) {
+        SVT_ERROR("Analysis cache: truncated header\n");
+        return EB_ErrorBadParameter;
+    }
+    memcpy(&header, buf, sizeof(header));
+    if (header.magic != ANALYSIS_CACHE_MAGIC || header.version != ANALYSIS_CACHE_VERSION) {
+        SVT_ERROR("Analysis cache: unknown format\n");
+        return EB_ErrorBadParameter;
+    }
+    EbErrorType ret = check_cache_settings(&header.settings, settings);
+    if (ret != EB_ErrorNone)
+        return ret;
+
+    // First pass counts the records of each type, second pass indexes them
+    for (int pass = 0; pass < 2; pass++) {
+        uint64_t offset = sizeof(header);
+        while (offset < cache_in->sz) {
+            CacheRecordHeader record;
+            if (cache_in->sz - offset < sizeof(record)) {
+                SVT_ERROR("Analysis cache: truncated record\n");
+                return EB_ErrorBadParameter;
+            }
+            memcpy(&record, buf + offset, sizeof(record));
+            offset += sizeof(record);
+            if (cache_in->sz - offset < record.size) {
+                SVT_ERROR("Analysis cache: truncated record\n");
+                return EB_ErrorBadParameter;
+            }
+            if (record.type < CACHE_RECORD_TYPES) {
+                if (pass) {
+                    CacheEntry *entry     = &cache->entries[record.type][cache->entry_count[record.type]];
+                    entry->picture_number = record.picture_number;
+                    entry->payload        = buf + offset;
+                    entry->size           = record.size;
+                }
+                cache->entry_count[record.type]++;
+            }
+            offset += record.size;
+        }
+        for (int type = 0; type < CACHE_RECORD_TYPES; type++) {
+            if (!pass && cache->entry_count[type])
+                EB_MALLOC_ARRAY(cache->entries[type], cache->entry_count[type]);
+            else if (pass)
+                qsort(cache->entries[type], cache->entry_count[type], sizeof(CacheEntry), compare_entries);
+            if (!pass)
+                cache->entry_count[type] = 0;
+        }
+    }
+    return EB_ErrorNone;
+}
+
+static EbErrorType cache_reserve(AnalysisCache *cache, size_t size) {
+    if (cache->out_size + size > cache->out_capacity) {
+        size_t capacity = MAX(cache->out_capacity * 3 / 2, CACHE_CAPACITY_INIT);
+        while (capacity < cache->out_size + size) capacity = capacity * 3 / 2;
+        EB_REALLOC_ARRAY(cache->out, capacity);
+        cache->out_capacity = capacity;
+    }
+    return EB_ErrorNone;
+}
+
+static void cache_write(AnalysisCache *cache, const void *data, size_t size) {
+    if (size)
+        memcpy(cache->out + cache->out_size, data, size);
+    cache->out_size += size;
+}
+
+EbErrorType svt_aom_analysis_cache_create(AnalysisCache **cache_ptr, const SequenceControlSet *scs) {
+    const SvtAv1FixedBuf *cache_in = &scs->static_config.analysis_cache_in;
+    AnalysisCache        *cache;
+    EB_CALLOC(cache, 1, sizeof(*cache));
+    *cache_ptr = cache;
+    CacheSettings settings;
+    get_cache_settings(scs, &settings);
+    if (cache_in->buf && cache_in->sz) {
+        EbErrorType ret = load_cache(cache, cache_in, &settings);
+        if (ret != EB_ErrorNone)
+            return ret;
+    }
+    if (scs->static_config.analysis_cache_out) {
+        cache->export_cache = true;
+        EB_CREATE_MUTEX(cache->mutex);
+        const CacheHeader header = {ANALYSIS_CACHE_MAGIC, ANALYSIS_CACHE_VERSION, 0, settings};
+        EbErrorType       ret    = cache_reserve(cache, sizeof(header));
+        if (ret != EB_ErrorNone)
+            return ret;
+        cache_write(cache, &header, sizeof(header));
+    }
+    return EB_ErrorNone;
+}
+
+void svt_aom_analysis_cache_free(AnalysisCache *cache) {
+    if (!cache)
+        return;
+    for (int type = 0; type < CACHE_RECORD_TYPES; type++) EB_FREE_ARRAY(cache->entries[type]);
+    EB_FREE_ARRAY(cache->out);
+    EB_DESTROY_MUTEX(cache->mutex);
+    EB_FREE(cache);
+}
+
+void svt_aom_analysis_cache_get_output(AnalysisCache *cache, SvtAv1FixedBuf *out) {
+    out->buf = cache && cache->export_cache ? cache->out : NULL;
+    out->sz  = cache && cache->export_cache ? cache->out_size : 0;
+}
+
+// Appends one record made of up to three chunks, so the payloads need not be copied together first
+static void cache_put(AnalysisCache *cache, CacheRecordType type, uint64_t picture_number, const void *data0,
+                      uint32_t size0, const void *data1, uint32_t size1, const void *data2, uint32_t size2) {
+    if (!cache || !cache->export_cache)
+        return;
+    const CacheRecordHeader record = {type, {0}, size0 + size1 + size2, picture_number};
+    svt_block_on_mutex(cache->mutex);
+    if (cache_reserve(cache, sizeof(record) + record.size) == EB_ErrorNone) {
+        cache_write(cache, &record, sizeof(record));
+        cache_write(cache, data0, size0);
+        cache_write(cache, data1, size1);
+        cache_write(cache, data2, size2);
+    } else
+        SVT_ERROR("Analysis cache: out of memory\n");
+    svt_release_mutex(cache->mutex);
+}
+
+static const CacheEntry *cache_find(const AnalysisCache *cache, CacheRecordType type, uint64_t picture_number,
+                                    uint32_t size) {
+    if (!cache || !cache->entry_count[type])
+        return NULL;
+    const CacheEntry  key   = {picture_number, NULL, 0};
+    const CacheEntry *entry = bsearch(
+        &key, cache->entries[type], cache->entry_count[type], sizeof(CacheEntry), compare_entries);
+    return entry && entry->size >= size ? entry : NULL;
+}
+
+void svt_aom_analysis_cache_put_scene_change(AnalysisCache *cache, const PictureParentControlSet *pcs) {
+    const uint8_t payload[3] = {pcs->scene_change_flag, pcs->scene_change_score, pcs->flash_score};
+    cache_put(cache, CACHE_SCENE_CHANGE, pcs->picture_number, payload, sizeof(payload), NULL, 0, NULL, 0);
+}
+
+bool svt_aom_analysis_cache_get_scene_change(AnalysisCache *cache, PictureParentControlSet *pcs) {
+    const CacheEntry *entry = cache_find(cache, CACHE_SCENE_CHANGE, pcs->picture_number, 3);
+    if (!entry)
+        return false;
+    pcs->scene_change_flag  = entry->payload[0] != 0;
+    pcs->scene_change_score = entry->payload[1];
+    pcs->flash_score        = entry->payload[2];
+    return true;
+}
+
+void svt_aom_analysis_cache_put_mini_gop(AnalysisCache *cache, uint64_t start_picture_number, const bool activity[3]) {
+    const uint8_t payload[3] = {activity[0], activity[1], activity[2]};
+    cache_put(cache, CACHE_MINI_GOP, start_picture_number, payload, sizeof(payload), NULL, 0, NULL, 0);
+}
+
+bool svt_aom_analysis_cache_get_mini_gop(AnalysisCache *cache, uint64_t start_picture_number, bool activity[3]) {
+    const CacheEntry *entry = cache_find(cache, CACHE_MINI_GOP, start_picture_number, 3);
+    if (!entry)
+        return false;
+    for (int i = 0; i < 3; i++) activity[i] = entry->payload[i] != 0;
+    return true;
+}
+
+// Number of SB betas and of lambda scaling factors written by svt_aom_generate_r0beta()
+static void get_r0_counts(const PictureParentControlSet *pcs, uint32_t *beta_count, uint32_t *factor_count) {
+    const SequenceControlSet *scs               = pcs->scs;
+    const uint32_t            picture_sb_width  = (pcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
+    const uint32_t            picture_sb_height = (pcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
+    const int                 mi_cols_sr        = ((pcs->enhanced_unscaled_pic->width + 15) / 16) << 2;
+    const int                 num_mi            = pcs->tpl_ctrls.synth_blk_size == 32 ? 8 : 4;
+    *beta_count   = picture_sb_width * picture_sb_height;
+    *factor_count = ((mi_cols_sr + num_mi - 1) / num_mi) * ((pcs->av1_cm->mi_rows + num_mi - 1) / num_mi);
+}
+
+void svt_aom_analysis_cache_put_r0(AnalysisCache *cache, const PictureParentControlSet *pcs) {
+    if (!cache || !cache->export_cache)
+        return;
+    CacheR0 r0 = {0};
+    r0.r0           = pcs->r0;
+    r0.tpl_is_valid = pcs->tpl_is_valid;
+    get_r0_counts(pcs, &r0.beta_count, &r0.factor_count);
+    cache_put(cache,
+              CACHE_R0,
+              pcs->picture_number,
+              &r0,
+              sizeof(r0),
+              pcs->pa_me_data->tpl_beta,
+              r0.beta_count * sizeof(double),
+              pcs->pa_me_data->tpl_rdmult_scaling_factors,
+              r0.factor_count * sizeof(double));
+}
+
+// Returns the r0 record of the picture when its sizes match the picture
+static const CacheEntry *find_r0(const AnalysisCache *cache, const PictureParentControlSet *pcs, CacheR0 *r0) {
+    const CacheEntry *entry = cache_find(cache, CACHE_R0, pcs->picture_number, sizeof(*r0));
+    if (!entry)
+        return NULL;
+    uint32_t beta_count, factor_count;
+    get_r0_counts(pcs, &beta_count, &factor_count);
+    memcpy(r0, entry->payload, sizeof(*r0));
+    if (r0->beta_count != beta_count || r0->factor_count != factor_count ||
+        entry->size != sizeof(*r0) + (beta_count + factor_count) * sizeof(double))
+        return NULL;
+    return entry;
+}
+
+bool svt_aom_analysis_cache_get_r0(AnalysisCache *cache, PictureParentControlSet *pcs) {
+    CacheR0           r0;
+    const CacheEntry *entry = find_r0(cache, pcs, &r0);
+    if (!entry)
+        return false;
+    const uint8_t *betas = entry->payload + sizeof(r0);
+    pcs->r0              = r0.r0;
+    pcs->tpl_is_valid    = r0.tpl_is_valid;
+    memcpy(pcs->pa_me_data->tpl_beta, betas, r0.beta_count * sizeof(double));
+    memcpy(pcs->pa_me_data->tpl_rdmult_scaling_factors,
+           betas + r0.beta_count * sizeof(double),
+           r0.factor_count * sizeof(double));
+    return true;
+}
+
+bool svt_aom_analysis_cache_has_tpl(AnalysisCache *cache, const PictureParentControlSet *pcs) {
+    // With TPL lookahead mini-GOPs, mode decision also uses the source stats computed by the TPL dispenser
+    if (!cache || !cache->entry_count[CACHE_R0] || pcs->scs->tpl_lad_mg)
+        return false;
+    for (uint32_t i = 0; i < pcs->tpl_group_size; i++) {
+        CacheR0 r0;
+        if (pcs->tpl_group[i]->r0_based_qps_qpm && !find_r0(cache, pcs->tpl_group[i], &r0))
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAnalysisCache_h
+#define EbAnalysisCache_h
+
+#include "definitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANALYSIS_CACHE_MAGIC 0x43415653 // "SVAC"
+#define ANALYSIS_CACHE_VERSION 2
+
+typedef struct AnalysisCache AnalysisCache;
+struct PictureParentControlSet;
+struct SequenceControlSet;
+
+/*
+ * Lookahead analysis saved by an encode and reloaded by later encodes of the same input, e.g. when a title is
+ * encoded at several CRFs.
+ *
+ * The cache holds the scene change decisions, the dynamic mini-GOP decisions, and the outputs of
+ * svt_aom_generate_r0beta() (r0, the SB betas and the lambda scaling factors) for the pictures using r0 based
+ * QPS/QPM. An encode loading the cache skips the scene change detection, the 6L vs. 5L evaluation, and the TPL
+ * propagation of the TPL groups whose pictures are all in the cache.
+ *
+ * The header holds the settings the analysis depends on. A cache is rejected when the resolution, the superblock
+ * size, the preset, the prediction structure, the hierarchical levels, the startup mini-GOP size, the dynamic GOP,
+ * the scene change detection, the rate control mode, the TPL and lookahead mini-GOP settings, the bit depth or the
+ * key frame interval differ. The TPL results depend on the QP of the encode which produced them: a cache exported
+ * at another CRF (or target bitrate) is reused with a warning, as an approximation. The stream is bit-exact with
+ * the exporting encode only when all the settings match.
+ *
+ * The file is a header followed by records, all in the native byte order:
+ *   header: magic, version and the settings of the exporting encode
+ *   record: type, payload size and picture number, followed by the payload
+ */
+EbErrorType svt_aom_analysis_cache_create(AnalysisCache **cache_ptr, const struct SequenceControlSet *scs);
+void        svt_aom_analysis_cache_free(AnalysisCache *cache);
+// Records exported so far, valid until the next put
+void svt_aom_analysis_cache_get_output(AnalysisCache *cache, SvtAv1FixedBuf *out);
+
+// The put functions are no-ops unless the cache is exported, the get functions return false unless the record
+// was loaded. Both accept a NULL cache.
+void svt_aom_analysis_cache_put_scene_change(AnalysisCache *cache, const struct PictureParentControlSet *pcs);
+bool svt_aom_analysis_cache_get_scene_change(AnalysisCache *cache, struct PictureParentControlSet *pcs);
+// activity holds the mini-GOP activity of the 6L mini-GOP and of its two 5L halves
+void svt_aom_analysis_cache_put_mini_gop(AnalysisCache *cache, uint64_t start_picture_number, const bool activity[3]);
+bool svt_aom_analysis_cache_get_mini_gop(AnalysisCache *cache, uint64_t start_picture_number, bool activity[3]);
+void svt_aom_analysis_cache_put_r0(AnalysisCache *cache, const struct PictureParentControlSet *pcs);
+bool svt_aom_analysis_cache_get_r0(AnalysisCache *cache, struct PictureParentControlSet *pcs);
+// Whether the TPL propagation of the group of pcs can be skipped: the r0 outputs of all the pictures of the group
+// using r0 based QPS/QPM were loaded, and mode decision does not use the TPL source stats
+bool svt_aom_analysis_cache_has_tpl(AnalysisCache *cache, const struct PictureParentControlSet *pcs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbAnalysisCache_h
@@ -0,0 +1,417 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "analysis_ladder.h"
+#include "pcs.h"
+#include "svt_malloc.h"
+#include "svt_threads.h"
+#include "utility.h"
+
+// TPL stats of one picture of a TPL group, on the grid of the leader
+typedef struct LadderTplFrame {
+    uint64_t  picture_number;
+    uint16_t  width;
+    uint16_t  height;
+    uint16_t  cols;
+    uint16_t  rows;
+    uint8_t   blk_size;
+    int32_t   base_rdmult;
+    TplStats *stats;
+} LadderTplFrame;
+
+typedef struct LadderRecord {
+    struct LadderRecord *next;
+    uint64_t             key;
+    // Followers currently reading the record
+    uint32_t readers;
+    bool     scene_change;
+    uint8_t  scene_change_score;
+    uint8_t  flash_score;
+    bool     activity[3];
+    // TPL group
+    LadderTplFrame *frames;
+    uint32_t        frame_count;
+} LadderRecord;
+
+struct LadderClient {
+    EbSvtAv1AnalysisLadder *ladder;
+    bool                    leader;
+    // Next follower of the ladder
+    LadderClient *next;
+    // Keys up to which the follower will not read any further record, per stage
+    int64_t done_key[LADDER_STAGES];
+};
+
+struct EbSvtAv1AnalysisLadder {
+    EbHandle mutex;
+    // Bumped on every change followers may wait for
+    CondVar       changed;
+    int32_t       generation;
+    LadderRecord *records[LADDER_STAGES];
+    // Key of the last record published for each stage, and whether the stage has been finished
+    int64_t  last_key[LADDER_STAGES];
+    bool     finished[LADDER_STAGES];
+    bool          has_leader;
+    LadderClient *followers;
+    uint32_t      client_count;
+    bool     destroyed;
+};
+
+static void ladder_record_free(LadderRecord *record) {
+    for (uint32_t i = 0; i < record->frame_count; i++) EB_FREE_ARRAY(record->frames[i].stats);
+    EB_FREE_ARRAY(record->frames);
+    EB_FREE(record);
+}
+
+static void ladder_free_records(LadderRecord *records) {
+    while (records) {
+        LadderRecord *next = records->next;
+        ladder_record_free(records);
+        records = next;
+    }
+}
+
+static void ladder_free(EbSvtAv1AnalysisLadder *ladder) {
+    for (int stage = 0; stage < LADDER_STAGES; stage++) ladder_free_records(ladder->records[stage]);
+    EB_DESTROY_MUTEX(ladder->mutex);
+    EB_FREE(ladder);
+}
+
+EbErrorType svt_aom_ladder_create(EbSvtAv1AnalysisLadder **ladder_ptr) {
+    EbSvtAv1AnalysisLadder *ladder;
+    EB_CALLOC(ladder, 1, sizeof(*ladder));
+    *ladder_ptr = ladder;
+    EB_CREATE_MUTEX(ladder->mutex);
+    svt_create_cond_var(&ladder->changed);
+    for (int stage = 0; stage < LADDER_STAGES; stage++) ladder->last_key[stage] = -1;
+    return EB_ErrorNone;
+}
+
+void svt_aom_ladder_destroy(EbSvtAv1AnalysisLadder *ladder) {
+    svt_block_on_mutex(ladder->mutex);
+    ladder->destroyed   = true;
+    const bool free_now = ladder->client_count == 0;
+    svt_release_mutex(ladder->mutex);
+    if (free_now)
+        ladder_free(ladder);
+}
+
+EbErrorType svt_aom_ladder_attach(EbSvtAv1AnalysisLadder *ladder, bool leader, LadderClient **client_ptr) {
+    svt_block_on_mutex(ladder->mutex);
+    const bool taken = leader && ladder->has_leader;
+    svt_release_mutex(ladder->mutex);
+    if (taken)
+        return EB_ErrorBadParameter;
+
+    LadderClient *client;
+    EB_CALLOC(client, 1, sizeof(*client));
+    *client_ptr    = client;
+    client->ladder = ladder;
+    client->leader = leader;
+
+    for (int stage = 0; stage < LADDER_STAGES; stage++) client->done_key[stage] = -1;
+
+    svt_block_on_mutex(ladder->mutex);
+    if (leader)
+        ladder->has_leader = true;
+    else {
+        client->next      = ladder->followers;
+        ladder->followers = client;
+    }
+    ladder->client_count++;
+    svt_release_mutex(ladder->mutex);
+    return EB_ErrorNone;
+}
+
+// Wakes up the waiting followers, called with the ladder mutex held
+static void ladder_signal(EbSvtAv1AnalysisLadder *ladder) {
+    ladder->generation++;
+    svt_set_cond_var(&ladder->changed, ladder->generation);
+}
+
+/*
+ * Unlinks the records of the stage which no follower will read anymore, i.e. the ones up to the key the slowest
+ * follower is done with, and returns them to be freed once the mutex is released. Called with the ladder mutex held.
+ * The records are kept in increasing key order, so they are unlinked from the head.
+ */
+static LadderRecord *ladder_prune(EbSvtAv1AnalysisLadder *ladder, LadderStage stage, LadderRecord *pruned) {
+    int64_t done_key = INT64_MAX;
+    for (const LadderClient *follower = ladder->followers; follower; follower = follower->next)
+        done_key = MIN(done_key, follower->done_key[stage]);
+    while (ladder->records[stage] && (int64_t)ladder->records[stage]->key <= done_key &&
+           !ladder->records[stage]->readers) {
+        LadderRecord *record   = ladder->records[stage];
+        ladder->records[stage] = record->next;
+        record->next           = pruned;
+        pruned                 = record;
+    }
+    return pruned;
+}
+
+void svt_aom_ladder_detach(LadderClient *client) {
+    if (!client)
+        return;
+    EbSvtAv1AnalysisLadder *ladder = client->ladder;
+    LadderRecord           *pruned = NULL;
+    svt_block_on_mutex(ladder->mutex);
+    if (client->leader) {
+        for (int stage = 0; stage < LADDER_STAGES; stage++) ladder->finished[stage] = true;
+        ladder_signal(ladder);
+    } else {
+        // The records the leaving follower did not read may not be needed by anyone else anymore
+        LadderClient **it = &ladder->followers;
+        while (*it != client) it = &(*it)->next;
+        *it = client->next;
+        for (int stage = 0; stage < LADDER_STAGES; stage++) pruned = ladder_prune(ladder, stage, pruned);
+    }
+    ladder->client_count--;
+    const bool free_ladder = ladder->destroyed && ladder->client_count == 0;
+    svt_release_mutex(ladder->mutex);
+
+    ladder_free_records(pruned);
+    EB_FREE(client);
+    if (free_ladder)
+        ladder_free(ladder);
+}
+
+bool svt_aom_ladder_is_leader(const LadderClient *client) { return client && client->leader; }
+
+bool svt_aom_ladder_is_follower(const LadderClient *client) { return client && !client->leader; }
+
+void svt_aom_ladder_finish(LadderClient *client, LadderStage stage) {
+    if (!svt_aom_ladder_is_leader(client))
+        return;
+    EbSvtAv1AnalysisLadder *ladder = client->ladder;
+    svt_block_on_mutex(ladder->mutex);
+    ladder->finished[stage] = true;
+    ladder_signal(ladder);
+    svt_release_mutex(ladder->mutex);
+}
+
+void svt_aom_ladder_advance(LadderClient *client, uint64_t picture_number) {
+    if (!svt_aom_ladder_is_follower(client))
+        return;
+    EbSvtAv1AnalysisLadder *ladder = client->ladder;
+    LadderRecord           *pruned = NULL;
+    svt_block_on_mutex(ladder->mutex);
+    for (int stage = 0; stage < LADDER_STAGES; stage++) {
+        client->done_key[stage] = MAX(client->done_key[stage], (int64_t)picture_number);
+        pruned                  = ladder_prune(ladder, stage, pruned);
+    }
+    svt_release_mutex(ladder->mutex);
+    ladder_free_records(pruned);
+}
+
+uint32_t svt_aom_ladder_record_count(EbSvtAv1AnalysisLadder *ladder, LadderStage stage) {
+    uint32_t count = 0;
+    svt_block_on_mutex(ladder->mutex);
+    for (const LadderRecord *record = ladder->records[stage]; record; record = record->next) count++;
+    svt_release_mutex(ladder->mutex);
+    return count;
+}
+
+// Appends a record published by the leader, the records of a stage are published in increasing key order. Records
+// which all the followers are already done with are freed right away.
+static void ladder_publish(EbSvtAv1AnalysisLadder *ladder, LadderStage stage, LadderRecord *record) {
+    svt_block_on_mutex(ladder->mutex);
+    ladder->last_key[stage] = MAX(ladder->last_key[stage], (int64_t)record->key);
+    LadderRecord **tail     = &ladder->records[stage];
+    while (*tail) tail = &(*tail)->next;
+    *tail                = record;
+    LadderRecord *pruned = ladder_prune(ladder, stage, NULL);
+    ladder_signal(ladder);
+    svt_release_mutex(ladder->mutex);
+    ladder_free_records(pruned);
+}
+
+/*
+ * Waits until the leader published the record of the key, went past the key or finished the stage. Returns NULL
+ * when the record is not coming. A follower reads the keys of a stage in increasing order, so the records before the
+ * key are not needed by this follower anymore. The record stays valid until the follower releases it with
+ * ladder_release().
+ */
+static LadderRecord *ladder_acquire(LadderClient *client, LadderStage stage, uint64_t key) {
+    EbSvtAv1AnalysisLadder *ladder = client->ladder;
+    LadderRecord           *pruned = NULL;
+    for (;;) {
+        svt_block_on_mutex(ladder->mutex);
+        client->done_key[stage] = MAX(client->done_key[stage], (int64_t)key - 1);
+        pruned                  = ladder_prune(ladder, stage, pruned);
+        LadderRecord *record    = ladder->records[stage];
+        while (record && record->key != key) record = record->next;
+        if (record)
+            record->readers++;
+        const bool    done       = record || ladder->finished[stage] || ladder->last_key[stage] >= (int64_t)key;
+        const int32_t generation = ladder->generation;
+        svt_release_mutex(ladder->mutex);
+        ladder_free_records(pruned);
+        pruned = NULL;
+        if (done)
+            return record;
+        svt_wait_cond_var(&ladder->changed, generation);
+    }
+}
+
+// Frees the record once the slowest follower is done with it
+static void ladder_release(LadderClient *client, LadderStage stage, LadderRecord *record) {
+    EbSvtAv1AnalysisLadder *ladder = client->ladder;
+    svt_block_on_mutex(ladder->mutex);
+    record->readers--;
+    client->done_key[stage] = MAX(client->done_key[stage], (int64_t)record->key);
+    LadderRecord *pruned    = ladder_prune(ladder, stage, NULL);
+    svt_release_mutex(ladder->mutex);
+    ladder_free_records(pruned);
+}
+
+void svt_aom_ladder_put_scene_change(LadderClient *client, const PictureParentControlSet *pcs) {
+    if (!svt_aom_ladder_is_leader(client))
+        return;
+    LadderRecord *record;
+    EB_NO_THROW_CALLOC(record, 1, sizeof(*record));
+    if (!record)
+        return;
+    record->key                = pcs->picture_number;
+    record->scene_change       = pcs->scene_change_flag;
+    record->scene_change_score = pcs->scene_change_score;
+    record->flash_score        = pcs->flash_score;
+    ladder_publish(client->ladder, LADDER_SCENE_CHANGE, record);
+}
+
+bool svt_aom_ladder_get_scene_change(LadderClient *client, PictureParentControlSet *pcs) {
+    if (!svt_aom_ladder_is_follower(client))
+        return false;
+    LadderRecord *record = ladder_acquire(client, LADDER_SCENE_CHANGE, pcs->picture_number);
+    if (!record)
+        return false;
+    pcs->scene_change_flag  = record->scene_change;
+    pcs->scene_change_score = record->scene_change_score;
+    pcs->flash_score        = record->flash_score;
+    ladder_release(client, LADDER_SCENE_CHANGE, record);
+    return true;
+}
+
+void svt_aom_ladder_put_mini_gop(LadderClient *client, uint64_t start_picture_number, const bool activity[3]) {
+    if (!svt_aom_ladder_is_leader(client))
+        return;
+    LadderRecord *record;
+    EB_NO_THROW_CALLOC(record, 1, sizeof(*record));
+    if (!record)
+        return;
+    record->key = start_picture_number;
+    memcpy(record->activity, activity, sizeof(record->activity));
+    ladder_publish(client->ladder, LADDER_MINI_GOP, record);
+}
+
+bool svt_aom_ladder_get_mini_gop(LadderClient *client, uint64_t start_picture_number, bool activity[3]) {
+    if (!svt_aom_ladder_is_follower(client))
+        return false;
+    LadderRecord *record = ladder_acquire(client, LADDER_MINI_GOP, start_picture_number);
+    if (!record)
+        return false;
+    memcpy(activity, record->activity, sizeof(record->activity));
+    ladder_release(client, LADDER_MINI_GOP, record);
+    return true;
+}
+
+// Grid of the TPL stats of a picture, as written by the TPL dispenser
+static void get_tpl_grid(const PictureParentControlSet *pcs, uint16_t *cols, uint16_t *rows) {
+    const uint8_t blk_size = pcs->tpl_ctrls.synth_blk_size;
+    *cols                  = (uint16_t)((pcs->aligned_width + blk_size - 1) / blk_size);
+    *rows                  = (uint16_t)((pcs->aligned_height + blk_size - 1) / blk_size);
+}
+
+void svt_aom_ladder_put_tpl(LadderClient *client, PictureParentControlSet *pcs) {
+    if (!svt_aom_ladder_is_leader(client))
+        return;
+    const uint32_t frames_in_sw = MIN(MAX_TPL_LA_SW, pcs->tpl_group_size);
+    LadderRecord  *record;
+    EB_NO_THROW_CALLOC(record, 1, sizeof(*record));
+    if (!record)
+        return;
+    record->key = pcs->picture_number;
+    EB_NO_THROW_CALLOC(record->frames, frames_in_sw, sizeof(*record->frames));
+    for (uint32_t i = 0; record->frames && i < frames_in_sw; i++) {
+        PictureParentControlSet *frame_pcs = pcs->tpl_group[i];
+        // Only the pictures of the lowest layers use the TPL results (r0 based QPS/QPM)
+        if (frame_pcs->temporal_layer_index > 2)
+            continue;
+        LadderTplFrame *frame = &record->frames[record->frame_count];
+        frame->picture_number = frame_pcs->picture_number;
+        frame->width          = frame_pcs->aligned_width;
+        frame->height         = frame_pcs->aligned_height;
+        frame->blk_size       = frame_pcs->tpl_ctrls.synth_blk_size;
+        frame->base_rdmult    = frame_pcs->pa_me_data->base_rdmult;
+        get_tpl_grid(frame_pcs, &frame->cols, &frame->rows);
+        const uint32_t count = (uint32_t)frame->cols * frame->rows;
+        EB_NO_THROW_MALLOC(frame->stats, count * sizeof(*frame->stats));
+        if (!frame->stats)
+            continue;
+        for (uint32_t idx = 0; idx < count; idx++) frame->stats[idx] = *frame_pcs->pa_me_data->tpl_stats[idx];
+        record->frame_count++;
+    }
+    ladder_publish(client->ladder, LADDER_TPL, record);
+}
+
+// Resamples the TPL stats of the leader to the grid of a follower picture. The costs are sums over the pixels of a
+// block, so they are scaled by the ratio of the block sizes
+static void rescale_tpl_frame(const LadderTplFrame *frame, PictureParentControlSet *pcs) {
+    uint16_t cols, rows;
+    get_tpl_grid(pcs, &cols, &rows);
+    const uint8_t blk_size = pcs->tpl_ctrls.synth_blk_size;
+    const double  scale    = ((double)blk_size * blk_size) / ((double)frame->blk_size * frame->blk_size);
+    for (uint32_t row = 0; row < rows; row++) {
+        // Leader block at the center of the follower block
+        const uint32_t src_row = MIN((uint32_t)frame->rows - 1,
+                                     (uint32_t)(((2 * row + 1) * blk_size * frame->height) /
+                                                (2 * pcs->aligned_height * frame->blk_size)));
+        for (uint32_t col = 0; col < cols; col++) {
+            const uint32_t  src_col = MIN((uint32_t)frame->cols - 1,
+                                         (uint32_t)(((2 * col + 1) * blk_size * frame->width) /
+                                                    (2 * pcs->aligned_width * frame->blk_size)));
+            const TplStats *src     = &frame->stats[src_row * frame->cols + src_col];
+            TplStats       *dst     = pcs->pa_me_data->tpl_stats[row * cols + col];
+            dst->srcrf_dist         = AOMMAX(1, (int64_t)(src->srcrf_dist * scale));
+            dst->recrf_dist         = AOMMAX(1, (int64_t)(src->recrf_dist * scale));
+            dst->srcrf_rate         = AOMMAX(1, (int64_t)(src->srcrf_rate * scale));
+            dst->recrf_rate         = AOMMAX(1, (int64_t)(src->recrf_rate * scale));
+            dst->mc_dep_rate        = (int64_t)(src->mc_dep_rate * scale);
+            dst->mc_dep_dist        = (int64_t)(src->mc_dep_dist * scale);
+            dst->mv.col             = (int16_t)((src->mv.col * pcs->aligned_width) / frame->width);
+            dst->mv.row             = (int16_t)((src->mv.row * pcs->aligned_height) / frame->height);
+            dst->ref_frame_poc      = src->ref_frame_poc;
+        }
+    }
+    pcs->pa_me_data->base_rdmult = frame->base_rdmult;
+}
+
+bool svt_aom_ladder_get_tpl(LadderClient *client, PictureParentControlSet *pcs) {
+    if (!svt_aom_ladder_is_follower(client))
+        return false;
+    LadderRecord *record = ladder_acquire(client, LADDER_TPL, pcs->picture_number);
+    if (!record)
+        return false;
+    const uint32_t frames_in_sw = MIN(MAX_TPL_LA_SW, pcs->tpl_group_size);
+    for (uint32_t i = 0; i < frames_in_sw; i++) {
+        PictureParentControlSet *frame_pcs = pcs->tpl_group[i];
+        uint16_t                 cols, rows;
+        get_tpl_grid(frame_pcs, &cols, &rows);
+        for (uint32_t idx = 0; idx < (uint32_t)cols * rows; idx++)
+            memset(frame_pcs->pa_me_data->tpl_stats[idx], 0, sizeof(TplStats));
+        for (uint32_t f = 0; f < record->frame_count; f++) {
+            if (record->frames[f].picture_number == frame_pcs->picture_number) {
+                rescale_tpl_frame(&record->frames[f], frame_pcs);
+                break;
+            }
+        }
+    }
+    ladder_release(client, LADDER_TPL, record);
+    return true;
+}
@@ -0,0 +1,75 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAnalysisLadder_h
+#define EbAnalysisLadder_h
+
+#include "definitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct LadderClient LadderClient;
+struct PictureParentControlSet;
+
+// Lookahead decisions shared by the leader of a ladder, in pipeline order
+typedef enum LadderStage {
+    LADDER_SCENE_CHANGE, // per picture, keyed by picture number
+    LADDER_MINI_GOP, // per mini-GOP, keyed by the picture number of its first picture
+    LADDER_TPL, // per TPL group, keyed by the picture number of its base picture
+    LADDER_STAGES
+} LadderStage;
+
+/*
+ * Analysis shared by the renditions of an ABR ladder.
+ *
+ * The leader instance publishes its scene changes, dynamic mini-GOP decisions and TPL results as its lookahead
+ * produces them; the follower instances wait for them instead of running their own analysis. The records are keyed
+ * by picture number, so all the instances must receive the same pictures in the same order. A follower computes the
+ * decision itself when the leader went past the key without publishing it (e.g. different settings), or once the
+ * leader has finished the stage, so a follower never waits for a record which is not coming. A record is freed once
+ * every follower read it, went past its key or detached.
+ *
+ * The ladder is freed once it has been destroyed and its last client detached.
+ */
+EbErrorType svt_aom_ladder_create(EbSvtAv1AnalysisLadder **ladder_ptr);
+void        svt_aom_ladder_destroy(EbSvtAv1AnalysisLadder *ladder);
+EbErrorType svt_aom_ladder_attach(EbSvtAv1AnalysisLadder *ladder, bool leader, LadderClient **client_ptr);
+// Detaching the leader finishes all its stages
+void svt_aom_ladder_detach(LadderClient *client);
+
+bool svt_aom_ladder_is_leader(const LadderClient *client);
+bool svt_aom_ladder_is_follower(const LadderClient *client);
+// Called by the leader once it will not publish any further record of the stage
+void svt_aom_ladder_finish(LadderClient *client, LadderStage stage);
+// Called by a follower once it will not read any further record keyed up to picture_number, so the records it
+// skipped (e.g. different settings, analysis cache hits) can be freed
+void svt_aom_ladder_advance(LadderClient *client, uint64_t picture_number);
+// Number of records published by the leader and kept for the followers
+uint32_t svt_aom_ladder_record_count(EbSvtAv1AnalysisLadder *ladder, LadderStage stage);
+
+// The put functions are no-ops unless the client is the leader, the get functions return false unless the client is
+// a follower and the leader published the record
+void svt_aom_ladder_put_scene_change(LadderClient *client, const struct PictureParentControlSet *pcs);
+bool svt_aom_ladder_get_scene_change(LadderClient *client, struct PictureParentControlSet *pcs);
+// activity holds the mini-GOP activity of the 6L mini-GOP and of its two 5L halves
+void svt_aom_ladder_put_mini_gop(LadderClient *client, uint64_t start_picture_number, const bool activity[3]);
+bool svt_aom_ladder_get_mini_gop(LadderClient *client, uint64_t start_picture_number, bool activity[3]);
+// Publishes the TPL stats of the pictures of the TPL group of pcs, and gets them rescaled to the follower resolution
+void svt_aom_ladder_put_tpl(LadderClient *client, struct PictureParentControlSet *pcs);
+bool svt_aom_ladder_get_tpl(LadderClient *client, struct PictureParentControlSet *pcs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbAnalysisLadder_h
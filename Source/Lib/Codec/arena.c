@@ -0,0 +1,123 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "arena.h"
+#include "svt_threads.h"
+
+// keep the blocks of a chunk ARENA_ALIGN-byte aligned
+#define ARENA_CHUNK_HEADER_SIZE ((sizeof(EbArenaChunk) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+#define ARENA_CHUNK_DATA(chunk) ((uint8_t *)(chunk) + ARENA_CHUNK_HEADER_SIZE)
+
+static EbErrorType arena_chunk_alloc(EbArena *arena, EbArenaChunk **chunk_ptr, size_t size) {
+    EbArenaChunk *chunk;
+    EB_MALLOC_ALIGNED(chunk, ARENA_CHUNK_HEADER_SIZE + size);
+    chunk->next = NULL;
+    chunk->size = size;
+    arena->size += size;
+    *chunk_ptr = chunk;
+    return EB_ErrorNone;
+}
+
+static void arena_chunk_free(EbArena *arena, EbArenaChunk *chunk) {
+    arena->size -= chunk->size;
+    EB_FREE_ALIGNED(chunk);
+}
+
+static void arena_dctor(EbPtr p) {
+    EbArena *arena = (EbArena *)p;
+    while (arena->chunks) {
+        EbArenaChunk *chunk = arena->chunks;
+        arena->chunks       = chunk->next;
+        arena_chunk_free(arena, chunk);
+    }
+    if (arena->spare)
+        arena_chunk_free(arena, arena->spare);
+    EB_DESTROY_MUTEX(arena->mutex);
+}
+
+EbErrorType svt_aom_arena_ctor(EbArena *arena) {
+    arena->dctor = arena_dctor;
+    EB_CREATE_MUTEX(arena->mutex);
+    return EB_ErrorNone;
+}
+
+void *svt_aom_arena_alloc(EbArena *arena, size_t size) {
+    uint8_t      *ptr = NULL;
+    EbArenaChunk *chunk;
+    size = size ? (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1) : ARENA_ALIGN;
+
+    svt_block_on_mutex(arena->mutex);
+    if (arena->chunks && size <= arena->chunks->size - arena->used) {
+        ptr = ARENA_CHUNK_DATA(arena->chunks) + arena->used;
+        arena->used += size;
+    } else if (size > ARENA_CHUNK_SIZE / 4) {
+        // a chunk of its own, the blocks are still carved from the first chunk
+        if (arena_chunk_alloc(arena, &chunk, size) == EB_ErrorNone) {
+            if (arena->chunks) {
+                chunk->next         = arena->chunks->next;
+                arena->chunks->next = chunk;
+            } else {
+                arena->chunks = chunk;
+                arena->used   = size;
+            }
+            ptr = ARENA_CHUNK_DATA(chunk);
+        }
+    } else {
+        chunk        = arena->spare;
+        arena->spare = NULL;
+        if (chunk || arena_chunk_alloc(arena, &chunk, ARENA_CHUNK_SIZE) == EB_ErrorNone) {
+            chunk->next   = arena->chunks;
+            arena->chunks = chunk;
+            arena->used   = size;
+            ptr           = ARENA_CHUNK_DATA(chunk);
+        }
+    }
+    arena->high_water = AOMMAX(arena->high_water, arena->size);
+    svt_release_mutex(arena->mutex);
+    return ptr;
+}
+
+void svt_aom_arena_reset(EbArena *arena) {
+    svt_block_on_mutex(arena->mutex);
+    while (arena->chunks) {
+        EbArenaChunk *chunk = arena->chunks;
+        arena->chunks       = chunk->next;
+        if (!arena->spare && chunk->size == ARENA_CHUNK_SIZE)
+            arena->spare = chunk;
+        else
+            arena_chunk_free(arena, chunk);
+    }
+    arena->used = 0;
+    arena->generation++;
+    svt_release_mutex(arena->mutex);
+}
+
+void *svt_aom_sub_arena_alloc(EbSubArena *sub, EbArena *arena, size_t size) {
+    size = size ? (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1) : ARENA_ALIGN;
+    if (size >= ARENA_SLAB_SIZE / 4)
+        return svt_aom_arena_alloc(arena, size);
+    // the slab was carved from another arena, or from this one before its last reset
+    if (sub->arena != arena || sub->generation != arena->generation) {
+        sub->arena      = arena;
+        sub->generation = arena->generation;
+        sub->left       = 0;
+    }
+    if (size > sub->left) {
+        sub->ptr  = svt_aom_arena_alloc(arena, ARENA_SLAB_SIZE);
+        sub->left = sub->ptr ? ARENA_SLAB_SIZE : 0;
+        if (!sub->ptr)
+            return NULL;
+    }
+    uint8_t *ptr = sub->ptr;
+    sub->ptr += size;
+    sub->left -= size;
+    return ptr;
+}
@@ -0,0 +1,99 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbArena_h
+#define EbArena_h
+
+#include "definitions.h"
+#include "object.h"
+#include "svt_malloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignment of the blocks handed out by an arena
+#define ARENA_ALIGN 64
+// Size of the chunks an arena carves its blocks from
+#define ARENA_CHUNK_SIZE (256 * 1024)
+// Size of the slabs a sub-arena takes from its arena
+#define ARENA_SLAB_SIZE (64 * 1024)
+
+typedef struct EbArenaChunk {
+    struct EbArenaChunk *next;
+    // bytes of the chunk available for blocks, they follow the header
+    size_t               size;
+} EbArenaChunk;
+
+/*
+ * Bump-pointer allocator for temporaries that live as long as the picture owning the arena.
+ *
+ * The arena allocates nothing until it is used. Blocks are carved from chunks of ARENA_CHUNK_SIZE
+ * bytes taken from the system allocator as the picture needs them, blocks of more than
+ * ARENA_CHUNK_SIZE / 4 bytes get a chunk of their own. Nothing is freed individually:
+ * svt_aom_arena_reset() returns the whole arena at once, and keeps one chunk for the next picture,
+ * so an idle arena holds at most ARENA_CHUNK_SIZE bytes.
+ * Allocation and reset are serialized by the arena mutex; threads carving many small blocks go
+ * through an EbSubArena, which only locks the arena to take a new slab.
+ */
+typedef struct EbArena {
+    EbDctor       dctor;
+    EbHandle      mutex;
+    // chunks handed out since the last reset, the blocks are carved from the first one
+    EbArenaChunk *chunks;
+    // bytes of the first chunk handed out
+    size_t        used;
+    // chunk kept by the last reset
+    EbArenaChunk *spare;
+    // bytes held by the chunks, and their peak over the lifetime of the arena
+    size_t        size;
+    size_t        high_water;
+    // bumped by every reset, the sub-arenas drop their slab when it changes
+    uint32_t      generation;
+} EbArena;
+
+/*
+ * Per-thread front end of an arena: hands out blocks from a slab taken from the arena, so only
+ * taking a new slab locks the arena. A sub-arena may be used with a different arena, or with its
+ * arena after a reset, at any time: it then takes a new slab. Blocks of ARENA_SLAB_SIZE / 4 bytes
+ * or more are taken from the arena directly.
+ */
+typedef struct EbSubArena {
+    EbArena *arena;
+    uint32_t generation;
+    uint8_t *ptr;
+    size_t   left;
+} EbSubArena;
+
+EbErrorType svt_aom_arena_ctor(EbArena *arena);
+// Returns a block of size bytes aligned to ARENA_ALIGN, NULL if the system allocator fails
+void *svt_aom_arena_alloc(EbArena *arena, size_t size);
+// Invalidates every block handed out by the arena and frees its chunks but one
+void svt_aom_arena_reset(EbArena *arena);
+// Returns a block of size bytes of arena aligned to ARENA_ALIGN, NULL if the system allocator fails
+void *svt_aom_sub_arena_alloc(EbSubArena *sub, EbArena *arena, size_t size);
+
+#define EB_ARENA_MALLOC_ARRAY(arena, pa, count)                   \
+    do {                                                          \
+        pa = svt_aom_arena_alloc(arena, sizeof(*(pa)) * (count)); \
+        EB_CHECK_MEM(pa);                                         \
+    } while (0)
+
+#define EB_SUB_ARENA_MALLOC_ARRAY(sub, arena, pa, count)                   \
+    do {                                                                   \
+        pa = svt_aom_sub_arena_alloc(sub, arena, sizeof(*(pa)) * (count)); \
+        EB_CHECK_MEM(pa);                                                  \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbArena_h
@@ -16,6 +16,7 @@
 #include "definitions.h"
 #include "utility.h"
 #include "svt_log.h"
+#include "svt_threads.h"
 
 #if OD_MEASURE_EC_OVERHEAD
 #include <stdio.h>
@@ -66,9 +67,82 @@ void svt_aom_daala_start_encode(DaalaWriter *br, OutputBitstreamUnit *source) {
     br->buffer_size   = source->size;
     br->buffer_parent = source;
     br->pos           = 0;
+    br->symbol_queue  = NULL;
     svt_od_ec_enc_init(&br->ec, 62025);
 }
 
+EbErrorType svt_aom_ec_symbol_queue_ctor(EcSymbolQueue *queue) {
+    EB_MALLOC_ARRAY(queue->ring, EC_SYMBOL_BATCH_SIZE * EC_SYMBOL_BATCH_COUNT);
+    queue->batch       = queue->ring;
+    queue->count       = 0;
+    queue->write_batch = 0;
+    queue->read_batch  = 0;
+    EB_CREATE_SEMAPHORE(queue->full_semaphore, 0, EC_SYMBOL_BATCH_COUNT);
+    // the batch being recorded is held by the tile thread
+    EB_CREATE_SEMAPHORE(queue->empty_semaphore, EC_SYMBOL_BATCH_COUNT - 1, EC_SYMBOL_BATCH_COUNT);
+    return EB_ErrorNone;
+}
+
+void svt_aom_ec_symbol_queue_dctor(EcSymbolQueue *queue) {
+    EB_DESTROY_SEMAPHORE(queue->full_semaphore);
+    EB_DESTROY_SEMAPHORE(queue->empty_semaphore);
+    EB_FREE_ARRAY(queue->ring);
+}
+
+void svt_aom_ec_symbol_queue_flush(EcSymbolQueue *queue) {
+    queue->batch_len[queue->write_batch] = queue->count;
+    svt_post_semaphore(queue->full_semaphore);
+    queue->write_batch = (queue->write_batch + 1) % EC_SYMBOL_BATCH_COUNT;
+    // wait for the coder to free the next batch
+    svt_block_on_semaphore(queue->empty_semaphore);
+    queue->batch = queue->ring + queue->write_batch * EC_SYMBOL_BATCH_SIZE;
+    queue->count = 0;
+}
+
+void svt_aom_ec_symbol_queue_end(EcSymbolQueue *queue) {
+    svt_aom_ec_symbol_push(queue, EC_SYMBOL_END, 0, NULL, 0);
+    svt_aom_ec_symbol_queue_flush(queue);
+}
+
+void svt_aom_daala_replay_symbols(DaalaWriter *w, EcSymbolQueue *queue) {
+    for (;;) {
+        svt_block_on_semaphore(queue->full_semaphore);
+        const EcSymbol *symbol = queue->ring + queue->read_batch * EC_SYMBOL_BATCH_SIZE;
+        const EcSymbol *end    = symbol + queue->batch_len[queue->read_batch];
+        bool            done   = false;
+        for (; symbol < end; symbol++) {
+            switch (symbol->type) {
+            case EC_SYMBOL_BOOL: aom_daala_write(w, symbol->value, symbol->arg); break;
+            case EC_SYMBOL_LITERAL:
+                for (int32_t bit = symbol->arg - 1; bit >= 0; bit--) aom_daala_write(w, 1 & (symbol->value >> bit), 128);
+                break;
+            case EC_SYMBOL_CDF: daala_write_symbol(w, symbol->value, symbol->cdf, symbol->arg); break;
+            case EC_SYMBOL_ADAPT:
+                daala_write_symbol(w, symbol->value, symbol->cdf, symbol->arg);
+                if (w->allow_update_cdf)
+                    update_cdf(symbol->cdf, symbol->value, symbol->arg);
+                break;
+            case EC_SYMBOL_PARTITION_VERT:
+            case EC_SYMBOL_PARTITION_HORZ: {
+                // the partition cdf is adapted by the coder, so the binary cdf is gathered here and not when recorded
+                AomCdfProb cdf[CDF_SIZE(2)];
+                if (symbol->type == EC_SYMBOL_PARTITION_VERT)
+                    partition_gather_vert_alike(cdf, symbol->cdf, (BlockSize)symbol->arg);
+                else
+                    partition_gather_horz_alike(cdf, symbol->cdf, (BlockSize)symbol->arg);
+                daala_write_symbol(w, symbol->value, cdf, 2);
+                break;
+            }
+            default: done = true; break;
+            }
+        }
+        queue->read_batch = (queue->read_batch + 1) % EC_SYMBOL_BATCH_COUNT;
+        svt_post_semaphore(queue->empty_semaphore);
+        if (done)
+            return;
+    }
+}
+
 /* Realloc when bitstream pointer size is not enough to write data of size sz */
 EbErrorType svt_realloc_output_bitstream_unit(OutputBitstreamUnit *output_bitstream_ptr, uint32_t sz) {
     if (output_bitstream_ptr && sz > 0) {
@@ -221,6 +221,59 @@ OD_WARN_UNUSED_RESULT uint8_t *svt_od_ec_enc_done(OdEcEnc *enc, uint32_t *nbytes
 
 OD_WARN_UNUSED_RESULT int32_t svt_od_ec_enc_tell(const OdEcEnc *enc) OD_ARG_NONNULL(1);
 
+/********************************************************************************************************************************/
+// Symbol queue of the two-stage entropy coding: the tile thread derives the contexts and records the symbols, an
+// arithmetic coder thread replays them on the tile writer and adapts the CDFs. The queue is a ring of batches, a batch
+// is handed over to the coder once full or at the end of the tile.
+#define EC_SYMBOL_BATCH_SIZE 1024
+#define EC_SYMBOL_BATCH_COUNT 32
+
+typedef enum EcSymbolType {
+    EC_SYMBOL_BOOL, // aom_write()
+    EC_SYMBOL_LITERAL, // aom_write_literal()
+    EC_SYMBOL_CDF, // aom_write_cdf()
+    EC_SYMBOL_ADAPT, // aom_write_symbol()
+    EC_SYMBOL_PARTITION_VERT, // split flag coded with a cdf gathered from a partition cdf
+    EC_SYMBOL_PARTITION_HORZ,
+    EC_SYMBOL_END, // end of the tile
+} EcSymbolType;
+
+typedef struct EcSymbol {
+    AomCdfProb *cdf;
+    int32_t     value;
+    uint8_t     type;
+    uint8_t     arg; // number of symbols, literal bits, probability or block size, depending on the type
+} EcSymbol;
+
+typedef struct EcSymbolQueue {
+    EcSymbol *ring;
+    uint32_t  batch_len[EC_SYMBOL_BATCH_COUNT];
+    EcSymbol *batch; // batch being recorded
+    uint32_t  count;
+    uint32_t  write_batch;
+    uint32_t  read_batch;
+    EbHandle  full_semaphore;
+    EbHandle  empty_semaphore;
+} EcSymbolQueue;
+
+EbErrorType svt_aom_ec_symbol_queue_ctor(EcSymbolQueue *queue);
+void        svt_aom_ec_symbol_queue_dctor(EcSymbolQueue *queue);
+// Hands the batch being recorded over to the coder and waits for a free one
+void svt_aom_ec_symbol_queue_flush(EcSymbolQueue *queue);
+// Records the end of the tile and hands the last batch over
+void svt_aom_ec_symbol_queue_end(EcSymbolQueue *queue);
+
+static INLINE void svt_aom_ec_symbol_push(EcSymbolQueue *queue, EcSymbolType type, int32_t value, AomCdfProb *cdf,
+                                          uint8_t arg) {
+    if (queue->count == EC_SYMBOL_BATCH_SIZE)
+        svt_aom_ec_symbol_queue_flush(queue);
+    EcSymbol *symbol = &queue->batch[queue->count++];
+    symbol->cdf      = cdf;
+    symbol->value    = value;
+    symbol->type     = (uint8_t)type;
+    symbol->arg      = arg;
+}
+
 /********************************************************************************************************************************/
 //daalaboolwriter.h
 struct DaalaWriter {
@@ -231,6 +284,8 @@ struct DaalaWriter {
            *buffer_parent; // save a pointer to the container holding the buffer, in case the buffer must be resized
     OdEcEnc ec;
     uint8_t allow_update_cdf;
+    // when set, the aom_write*() calls are recorded for the arithmetic coder thread instead of being coded
+    EcSymbolQueue *symbol_queue;
 };
 
 typedef struct DaalaWriter DaalaWriter;
@@ -238,6 +293,8 @@ typedef struct DaalaWriter DaalaWriter;
 void        svt_aom_daala_start_encode(DaalaWriter *br, OutputBitstreamUnit *source);
 EbErrorType svt_realloc_output_bitstream_unit(OutputBitstreamUnit *output_bitstream_ptr, uint32_t sz);
 int32_t     svt_aom_daala_stop_encode(DaalaWriter *w);
+// Codes the symbols of a tile recorded in the queue, returns at the end of the tile
+void svt_aom_daala_replay_symbols(DaalaWriter *w, EcSymbolQueue *queue);
 
 static INLINE void aom_daala_write(DaalaWriter *w, int32_t bit, int32_t prob) {
     int32_t p = (0x7FFFFF - (prob << 15) + prob) >> 8;
@@ -263,7 +320,13 @@ static INLINE void         aom_start_encode(AomWriter *bc, OutputBitstreamUnit *
 }
 static INLINE int32_t aom_stop_encode(AomWriter *bc) { return svt_aom_daala_stop_encode(bc); }
 
-static INLINE void aom_write(AomWriter *br, int32_t bit, int32_t probability) { aom_daala_write(br, bit, probability); }
+static INLINE void aom_write(AomWriter *br, int32_t bit, int32_t probability) {
+    if (br->symbol_queue) {
+        svt_aom_ec_symbol_push(br->symbol_queue, EC_SYMBOL_BOOL, bit, NULL, (uint8_t)probability);
+        return;
+    }
+    aom_daala_write(br, bit, probability);
+}
 
 static INLINE void aom_write_bit(AomWriter *w, int32_t bit) {
     aom_write(w, bit, 128); // aom_prob_half
@@ -272,14 +335,28 @@ static INLINE void aom_write_bit(AomWriter *w, int32_t bit) {
 static INLINE void aom_write_literal(AomWriter *w, int32_t data, int32_t bits) {
     int32_t bit;
 
+    if (w->symbol_queue) {
+        svt_aom_ec_symbol_push(w->symbol_queue, EC_SYMBOL_LITERAL, data, NULL, (uint8_t)bits);
+        return;
+    }
+
     for (bit = bits - 1; bit >= 0; bit--) aom_write_bit(w, 1 & (data >> bit));
 }
 
 static INLINE void aom_write_cdf(AomWriter *w, int32_t symb, const AomCdfProb *cdf, int32_t nsymbs) {
+    if (w->symbol_queue) {
+        // the cdf is only read by the coder
+        svt_aom_ec_symbol_push(w->symbol_queue, EC_SYMBOL_CDF, symb, (AomCdfProb *)cdf, (uint8_t)nsymbs);
+        return;
+    }
     daala_write_symbol(w, symb, cdf, nsymbs);
 }
 
 static INLINE void aom_write_symbol(AomWriter *w, int32_t symb, AomCdfProb *cdf, int32_t nsymbs) {
+    if (w->symbol_queue) {
+        svt_aom_ec_symbol_push(w->symbol_queue, EC_SYMBOL_ADAPT, symb, cdf, (uint8_t)nsymbs);
+        return;
+    }
     aom_write_cdf(w, symb, cdf, nsymbs);
     if (w->allow_update_cdf)
         update_cdf(cdf, symb, nsymbs);
@@ -25,6 +25,7 @@
 #include "utility.h"
 #include "pcs.h"
 #include "resize.h"
+#include "inv_transforms.h"
 
 void svt_aom_copy_sb8_16(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t src_voffset, int32_t src_hoffset,
                          int32_t sstride, int32_t vsize, int32_t hsize, bool is_16bit);
@@ -140,6 +141,11 @@ static void cdef_seg_search(PictureControlSet *pcs, SequenceControlSet *scs, uin
     const int32_t       sec_damping = pri_damping;
     const int32_t       num_planes  = 3;
     CdefList            dlist[MI_SIZE_128X128 * MI_SIZE_128X128];
+    // The search of a plane stops when its unfiltered distortion per pixel is below early_exit_q_th / 16 of the
+    // quantization noise (q_step / 8)^2 / 12; early_exit_th is that threshold times 16 * 64 * 12
+    const int32_t       q_step        = svt_aom_dc_quant_qtx(frm_hdr->quantization_params.base_q_idx, 0, EB_EIGHT_BIT);
+    const uint64_t      early_exit_th =
+        cdef_ctrls->default_first_pass_fs[0] ? 0 : (uint64_t)cdef_ctrls->early_exit_q_th * q_step * q_step;
 
     DECLARE_ALIGNED(32, uint16_t, inbuf[CDEF_INBUF_SIZE]);
     uint16_t *in = inbuf + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
@@ -241,6 +247,9 @@ static void cdef_seg_search(PictureControlSet *pcs, SequenceControlSet *scs, uin
                 case BLOCK_4X8: subsampling_factor = MIN(subsampling_factor, 2); break;
                 case BLOCK_4X4: subsampling_factor = MIN(subsampling_factor, 1); break;
                 }
+                // set once the off filter is found to leave too little distortion for the filter to remove
+                bool     early_exit  = false;
+                uint64_t zero_fs_mse = 0;
 
                 /* first cdef stage
                  * Perform the pri_filter strength search for the current sub_block
@@ -251,6 +260,13 @@ static void cdef_seg_search(PictureControlSet *pcs, SequenceControlSet *scs, uin
                         pcs->mse_seg[1][fb_idx][gi] = default_mse_uv * 64;
                         continue;
                     }
+                    if (early_exit) {
+                        if (pli < 2)
+                            pcs->mse_seg[pli][fb_idx][gi] = zero_fs_mse;
+                        else
+                            pcs->mse_seg[1][fb_idx][gi] += zero_fs_mse;
+                        continue;
+                    }
 
                     int32_t pri_strength = cdef_ctrls->default_first_pass_fs[gi] / CDEF_SEC_STRENGTHS;
                     int32_t sec_strength = cdef_ctrls->default_first_pass_fs[gi] % CDEF_SEC_STRENGTHS;
@@ -290,6 +306,14 @@ static void cdef_seg_search(PictureControlSet *pcs, SequenceControlSet *scs, uin
                         pcs->mse_seg[pli][fb_idx][gi] = curr_mse * subsampling_factor;
                     else
                         pcs->mse_seg[1][fb_idx][gi] += (curr_mse * subsampling_factor);
+                    if (gi == 0 && early_exit_th &&
+                        curr_mse * subsampling_factor * (16 * 64 * 12) <
+                            early_exit_th * cdef_count * (64 >> (xdec[pli] + ydec[pli]))) {
+                        early_exit = true;
+                        // slightly above the off filter, so that the block keeps preferring it
+                        zero_fs_mse = curr_mse * subsampling_factor;
+                        zero_fs_mse += (zero_fs_mse >> 5) + 1;
+                    }
                 }
 
                 /* second cdef stage
@@ -301,6 +325,13 @@ static void cdef_seg_search(PictureControlSet *pcs, SequenceControlSet *scs, uin
                         pcs->mse_seg[1][fb_idx][gi] = default_mse_uv * 64;
                         continue;
                     }
+                    if (early_exit) {
+                        if (pli < 2)
+                            pcs->mse_seg[pli][fb_idx][gi] = zero_fs_mse;
+                        else
+                            pcs->mse_seg[1][fb_idx][gi] += zero_fs_mse;
+                        continue;
+                    }
 
                     int32_t pri_strength = cdef_ctrls->default_second_pass_fs[gi - first_pass_fs_num] /
                         CDEF_SEC_STRENGTHS;
@@ -529,6 +560,7 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
                 svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper);
                 cdef_results                = (struct CdefResults *)cdef_results_wrapper->object_ptr;
                 cdef_results->pcs_wrapper   = dlf_results->pcs_wrapper;
+                cdef_results->task_type     = REST_TASKS_CDEF_INPUT;
                 cdef_results->segment_index = segment_index;
                 // Post Cdef Results
                 svt_post_full_object(cdef_results_wrapper);
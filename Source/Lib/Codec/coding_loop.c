@@ -32,9 +32,12 @@
 void               svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, bool is_highbd);
 void               aom_av1_set_ssim_rdmult(struct ModeDecisionContext *ctx, PictureControlSet *pcs, const int mi_row,
                                            const int mi_col);
-static EbErrorType ec_rtime_alloc_palette_info(EcBlkStruct *md_blk_arr_nsq) {
-    EB_MALLOC_ARRAY(md_blk_arr_nsq->palette_info, 1);
-    EB_MALLOC_ARRAY(md_blk_arr_nsq->palette_info->color_idx_map, MAX_PALETTE_SQUARE);
+// The palette data of the final blocks is read by entropy coding and returned with the picture arena
+static EbErrorType ec_rtime_alloc_palette_info(PictureControlSet *pcs, EncDecContext *ctx,
+                                               EcBlkStruct *md_blk_arr_nsq) {
+    EB_SUB_ARENA_MALLOC_ARRAY(&ctx->pic_arena, pcs->arena, md_blk_arr_nsq->palette_info, 1);
+    EB_SUB_ARENA_MALLOC_ARRAY(
+        &ctx->pic_arena, pcs->arena, md_blk_arr_nsq->palette_info->color_idx_map, MAX_PALETTE_SQUARE);
 
     return EB_ErrorNone;
 }
@@ -1722,7 +1725,7 @@ EB_EXTERN void svt_aom_encode_decode(SequenceControlSet *scs, PictureControlSet
     uint32_t blk_it = 0;
     while (blk_it < scs->max_block_cnt) {
         BlkStruct       *blk_ptr = ctx->blk_ptr = md_ctx->blk_ptr = &md_ctx->md_blk_arr_nsq[blk_it];
-        const BlockGeom *blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(blk_it);
+        const BlockGeom *blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_it);
 
         //At the boundary when it's not a complete super block.
         //We may only use part of the blocks in MD.
@@ -1746,7 +1749,7 @@ EB_EXTERN void svt_aom_encode_decode(SequenceControlSet *scs, PictureControlSet
                 assert(d1_itr == (d1_start_blk + num_d1_block - 1));
                 continue;
             }
-            blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(d1_itr);
+            blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(scs->blk_geom_mds, d1_itr);
             blk_ptr = ctx->blk_ptr = md_ctx->blk_ptr = &md_ctx->md_blk_arr_nsq[d1_itr];
 
             // PU Stack variables
@@ -1842,6 +1845,8 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
     pcs->sb_skip[sb_addr]            = 1;
     pcs->sb_64x64_mvp[sb_addr]       = 0;
     pcs->sb_count_nz_coeffs[sb_addr] = 0;
+    // Fast recode: rate of the coefficients of the blocks kept for the next coding passes of the picture
+    uint64_t *recode_coeff_rate = ctx->keep_recode_blocks ? sb_ptr->recode_coeff_rate : NULL;
 
     // CU Loop
     uint32_t final_blk_itr = 0;
@@ -1851,7 +1856,7 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
         sb_ptr->cu_partition_array[blk_it] = md_ctx->md_blk_arr_nsq[blk_it].part;
 
         BlkStruct       *blk_ptr = ctx->blk_ptr = md_ctx->blk_ptr = &md_ctx->md_blk_arr_nsq[blk_it];
-        const BlockGeom *blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(blk_it);
+        const BlockGeom *blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_it);
 
         //At the boundary when it's not a complete super block.
         //We may only use part of the blocks in MD.
@@ -1887,7 +1892,7 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                 assert(d1_itr == (d1_start_blk + num_d1_block - 1));
                 continue;
             }
-            blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(d1_itr);
+            blk_geom = ctx->blk_geom = md_ctx->blk_geom = get_blk_geom_mds(scs->blk_geom_mds, d1_itr);
             blk_ptr = ctx->blk_ptr = md_ctx->blk_ptr = &md_ctx->md_blk_arr_nsq[d1_itr];
 
             ctx->blk_org_x = (uint16_t)(sb_org_x + blk_geom->org_x);
@@ -1925,9 +1930,6 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                 pcs->sb_skip[sb_addr] = 0;
             }
             pcs->sb_count_nz_coeffs[sb_addr] += md_ctx->blk_ptr->cnt_nz_coeff;
-            svt_block_on_mutex(pcs->ppcs->pcs_total_rate_mutex);
-            pcs->ppcs->pcs_total_rate += blk_ptr->total_rate;
-            svt_release_mutex(pcs->ppcs->pcs_total_rate_mutex);
             // Copy recon to EncDec buffers if EncDec was bypassed;  if used pred depth only and NSQ is OFF data was copied directly to EncDec buffers in MD
             if (md_ctx->bypass_encdec && !(md_ctx->fixed_partition)) {
                 if (md_ctx->encoder_bit_depth > EB_EIGHT_BIT) {
@@ -2012,14 +2014,16 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
             } // END COPY RECON
 
             // Loop over TX units only if needed
-            if (pcs->cdf_ctrl.update_coef || (md_ctx->bypass_encdec && !(md_ctx->fixed_partition))) {
+            uint64_t blk_coeff_rate = 0;
+            if (pcs->cdf_ctrl.update_coef || (md_ctx->bypass_encdec && !(md_ctx->fixed_partition)) ||
+                recode_coeff_rate) {
                 ctx->is_inter = (blk_ptr->prediction_mode_flag == INTER_MODE || blk_ptr->use_intrabc);
 
                 // Initialize the Transform Loop
                 ctx->txb_itr = 0;
-                uint64_t             y_txb_coeff_bits;
-                uint64_t             cb_txb_coeff_bits;
-                uint64_t             cr_txb_coeff_bits;
+                uint64_t             y_txb_coeff_bits  = 0;
+                uint64_t             cb_txb_coeff_bits = 0;
+                uint64_t             cr_txb_coeff_bits = 0;
                 uint16_t             tot_tu           = blk_geom->txb_count[blk_ptr->tx_depth];
                 EbPictureBufferDesc *coeff_buffer_sb  = pcs->ppcs->enc_dec_ptr->quantized_coeff[sb_addr];
                 uint32_t             txb_1d_offset    = 0;
@@ -2172,6 +2176,41 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                         }
                     } // END COEFF CDF UPDATE
 
+                    // Fast recode: without the coefficient CDF update, estimate the rate without neighbor contexts
+                    if (recode_coeff_rate && blk_ptr->block_has_coeff && !pcs->cdf_ctrl.update_coef) {
+                        md_ctx->luma_txb_skip_context = 0;
+                        md_ctx->luma_dc_sign_context  = 0;
+                        md_ctx->cb_txb_skip_context   = 0;
+                        md_ctx->cb_dc_sign_context    = 0;
+                        md_ctx->cr_txb_skip_context   = 0;
+                        md_ctx->cr_dc_sign_context    = 0;
+
+                        ModeDecisionCandidateBuffer *cand_bf = md_ctx->cand_bf_ptr_array[0];
+                        cand_bf->cand->pred_mode             = blk_ptr->pred_mode;
+                        cand_bf->cand->filter_intra_mode     = blk_ptr->filter_intra_mode;
+                        svt_aom_txb_estimate_coeff_bits(md_ctx,
+                                                        0, //allow_update_cdf,
+                                                        NULL,
+                                                        pcs,
+                                                        cand_bf,
+                                                        ctx->coded_area_sb,
+                                                        ctx->coded_area_sb_uv,
+                                                        coeff_buffer_sb,
+                                                        blk_ptr->eob.y[ctx->txb_itr],
+                                                        blk_ptr->eob.u[ctx->txb_itr],
+                                                        blk_ptr->eob.v[ctx->txb_itr],
+                                                        &y_txb_coeff_bits,
+                                                        &cb_txb_coeff_bits,
+                                                        &cr_txb_coeff_bits,
+                                                        blk_geom->txsize[blk_ptr->tx_depth],
+                                                        blk_geom->txsize_uv[blk_ptr->tx_depth],
+                                                        blk_ptr->tx_type[ctx->txb_itr],
+                                                        blk_ptr->tx_type_uv,
+                                                        (blk_geom->has_uv && uv_pass) ? COMPONENT_ALL : COMPONENT_LUMA);
+                    }
+                    if (recode_coeff_rate && blk_ptr->block_has_coeff)
+                        blk_coeff_rate += y_txb_coeff_bits + cb_txb_coeff_bits + cr_txb_coeff_bits;
+
                     txb_1d_offset += blk_geom->tx_width[blk_ptr->tx_depth] * blk_geom->tx_height[blk_ptr->tx_depth];
 
                     ctx->coded_area_sb += blk_geom->tx_width[blk_ptr->tx_depth] *
@@ -2186,6 +2225,19 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                             blk_geom->tx_height_uv[blk_ptr->tx_depth];
                 }
             }
+            if (recode_coeff_rate) {
+                // Fast recode: the full pass keeps the coefficient rate of the block, the next passes swap it for the
+                // rate of the coefficients at their qindex in the rate of the block
+                if (ctx->reuse_recode_blocks)
+                    blk_ptr->total_rate = blk_ptr->total_rate + blk_coeff_rate >= recode_coeff_rate[final_blk_itr]
+                        ? blk_ptr->total_rate + blk_coeff_rate - recode_coeff_rate[final_blk_itr]
+                        : 0;
+                else
+                    recode_coeff_rate[final_blk_itr] = blk_coeff_rate;
+            }
+            svt_block_on_mutex(pcs->ppcs->pcs_total_rate_mutex);
+            pcs->ppcs->pcs_total_rate += blk_ptr->total_rate;
+            svt_release_mutex(pcs->ppcs->pcs_total_rate_mutex);
             if (!md_ctx->bypass_encdec) {
                 md_ctx->blk_org_x = ctx->blk_org_x;
                 md_ctx->blk_org_y = ctx->blk_org_y;
@@ -2236,7 +2288,7 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
             // ENCDEC palette info buffer
             {
                 if (svt_av1_allow_palette(pcs->ppcs->palette_level, blk_geom->bsize))
-                    ec_rtime_alloc_palette_info(&sb_ptr->final_blk_arr[final_blk_itr]);
+                    ec_rtime_alloc_palette_info(pcs, ctx, &sb_ptr->final_blk_arr[final_blk_itr]);
                 else
                     sb_ptr->final_blk_arr[final_blk_itr].palette_info = NULL;
             }
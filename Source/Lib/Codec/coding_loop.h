@@ -30,6 +30,19 @@ void svt_aom_mode_decision_sb_light_pd1(SequenceControlSet *scs, PictureControlS
                                         const MdcSbData *const mdcResultTbPtr);
 void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
                               const MdcSbData *const mdcResultTbPtr);
+// Block loop state of svt_aom_mode_decision_sb(), kept between the calls that process parts of an SB
+typedef struct MdSbLoopState {
+    EbPictureBufferDesc *input_pic;
+    uint32_t             next_non_skip_blk_idx_mds;
+    bool                 md_early_exit_sq;
+} MdSbLoopState;
+void svt_aom_mode_decision_sb_start(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                    MdSbLoopState *state);
+void svt_aom_mode_decision_sb_blocks(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                     const MdcSbData *const mdc_sb_data, uint32_t first_leaf, uint32_t end_leaf,
+                                     MdSbLoopState *state);
+bool svt_aom_mode_decision_sb_quadrant_exit(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                            uint32_t blk_mds, MdSbLoopState *state);
 extern void svt_aom_encode_decode(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr, uint32_t sb_addr,
                                   uint32_t sb_origin_x, uint32_t sb_origin_y, EncDecContext *ed_ctx);
 extern EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
@@ -49,6 +49,10 @@ EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr,
     larget_coding_unit_ptr->org_y = sb_origin_y;
 
     larget_coding_unit_ptr->index = sb_index;
+
+    larget_coding_unit_ptr->recode_blk_arr    = NULL;
+    larget_coding_unit_ptr->recode_coeff_rate = NULL;
+    larget_coding_unit_ptr->recode_blk_cnt    = 0;
     bool disallow_nsq             = true;
     for (uint8_t is_base = 0; is_base <= 1; is_base++) {
         for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
@@ -342,6 +342,11 @@ typedef struct SuperBlock {
     uint8_t        qindex;
     TileInfo       tile_info;
     uint16_t       final_blk_cnt; // number of block(s) posted from EncDec to EC
+    // Fast recode: blocks coded by the last full coding pass of the SB and the rate of their coefficients,
+    // allocated from the picture arena
+    BlkStruct *recode_blk_arr;
+    uint64_t  *recode_coeff_rate;
+    uint16_t   recode_blk_cnt;
 } SuperBlock;
 
 extern EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_size,
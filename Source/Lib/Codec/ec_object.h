@@ -37,6 +37,7 @@ typedef struct EntropyTileInfo {
     EbDctor       dctor;
     EntropyCoder* ec;
     bool          entropy_coding_tile_done;
+    bool          stream_tile_ready; // obu streaming: tile coded, waiting to be output
 } EntropyTileInfo;
 
 extern EbErrorType svt_aom_entropy_tile_info_ctor(EntropyTileInfo* entropy_tile_info_ptr, uint32_t buf_size);
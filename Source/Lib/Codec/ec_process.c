@@ -20,11 +20,42 @@
 #include "cabac_context_model.h"
 #include "svt_log.h"
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 void svt_av1_reset_loop_restoration(PictureControlSet *piCSetPtr, uint16_t tile_idx);
 
+/*
+ * Arithmetic coder thread: codes the symbols its entropy coding thread records for a tile, while the entropy coding
+ * thread derives the contexts of the next ones. The CDFs are only read and adapted here while the tile is coded.
+ */
+static void *ec_coder_worker_kernel(void *input_ptr) {
+    EcCoderWorker *worker = (EcCoderWorker *)input_ptr;
+    for (;;) {
+        svt_block_on_semaphore(worker->start_semaphore);
+        if (worker->exit)
+            break;
+        svt_aom_daala_replay_symbols(worker->writer, &worker->queue);
+        svt_post_semaphore(worker->done_semaphore);
+    }
+    return NULL;
+}
+
+static void ec_coder_worker_dctor(EcCoderWorker *worker) {
+    if (worker->thread) {
+        worker->exit = true;
+        svt_post_semaphore(worker->start_semaphore);
+        EB_DESTROY_THREAD(worker->thread);
+    }
+    EB_DESTROY_SEMAPHORE(worker->start_semaphore);
+    EB_DESTROY_SEMAPHORE(worker->done_semaphore);
+    svt_aom_ec_symbol_queue_dctor(&worker->queue);
+    EB_FREE(worker);
+}
+
 static void rest_context_dctor(EbPtr p) {
     EbThreadContext      *thread_ctx = (EbThreadContext *)p;
     EntropyCodingContext *obj        = (EntropyCodingContext *)thread_ctx->priv;
+    if (obj->coder_worker)
+        ec_coder_worker_dctor(obj->coder_worker);
     EB_FREE_ARRAY(obj);
 }
 
@@ -50,6 +81,18 @@ EbErrorType svt_aom_entropy_coding_context_ctor(EbThreadContext *thread_ctx, con
     context_ptr->rate_control_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->rate_control_tasks_resource_ptr, rate_control_index);
 
+    if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.split_entropy_coding) {
+        EB_CALLOC(context_ptr->coder_worker, 1, sizeof(EcCoderWorker));
+        EcCoderWorker *worker = context_ptr->coder_worker;
+        EB_CREATE_SEMAPHORE(worker->start_semaphore, 0, 1);
+        EB_CREATE_SEMAPHORE(worker->done_semaphore, 0, 1);
+        EbErrorType return_error = svt_aom_ec_symbol_queue_ctor(&worker->queue);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        worker->thread = svt_create_thread(ec_coder_worker_kernel, worker);
+        EB_ADD_MEM(worker->thread, 1, EB_THREAD);
+    }
+
     return EB_ErrorNone;
 }
 
@@ -67,8 +110,6 @@ static void entropy_coding_reset_neighbor_arrays(PictureControlSet *pcs, uint16_
     return;
 }
 
-void svt_aom_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map);
-
 void svt_av1_cost_tokens_from_cdf(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map) {
     // int32_t i;
     // AomCdfProb prev_cdf = 0;
@@ -252,9 +293,20 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
             pcs->entropy_coding_pic_reset_flag = false;
 
             reset_entropy_coding_picture(context_ptr, pcs, scs);
+            // No tile of the picture is coded yet, the frame header can be output ahead of the tiles
+            if (scs->static_config.obu_streaming)
+                svt_aom_stream_start_picture(pcs);
         }
         svt_release_mutex(pcs->entropy_coding_pic_mutex);
 
+        EcCoderWorker *coder_worker = context_ptr->coder_worker;
+        DaalaWriter   *ec_writer    = &pcs->ec_info[tile_idx]->ec->ec_writer;
+        if (coder_worker) {
+            // The symbols of the tile are coded by the worker
+            coder_worker->writer    = ec_writer;
+            ec_writer->symbol_queue = &coder_worker->queue;
+            svt_post_semaphore(coder_worker->start_semaphore);
+        }
         if (!svt_aom_is_pic_skipped(pcs->ppcs)) {
             for (uint32_t y_sb_index = 0; y_sb_index < tile_height_in_sb; ++y_sb_index) {
                 for (uint32_t x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
@@ -274,6 +326,11 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
                 }
             }
         }
+        if (coder_worker) {
+            svt_aom_ec_symbol_queue_end(&coder_worker->queue);
+            svt_block_on_semaphore(coder_worker->done_semaphore);
+            ec_writer->symbol_queue = NULL;
+        }
         bool pic_ready = true;
 
         // Current tile ready
@@ -288,6 +345,8 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
             }
         }
         svt_release_mutex(pcs->entropy_coding_pic_mutex);
+        if (scs->static_config.obu_streaming)
+            svt_aom_stream_tile_done(pcs, tile_idx);
         if (pic_ready) {
             if (pcs->ppcs->superres_total_recode_loop == 0) {
                 // Release the List 0 Reference Pictures
@@ -19,9 +19,23 @@
 #include "pic_buffer_desc.h"
 #include "enc_inter_prediction.h"
 #include "entropy_coding.h"
+#include "bitstream_unit.h"
 #include "coding_unit.h"
 #include "object.h"
 
+/**************************************
+ * Arithmetic Coder Worker
+ **************************************/
+typedef struct EcCoderWorker {
+    EbHandle      thread;
+    EbHandle      start_semaphore;
+    EbHandle      done_semaphore;
+    EcSymbolQueue queue;
+    // Writer of the tile being coded
+    DaalaWriter *writer;
+    bool         exit;
+} EcCoderWorker;
+
 /**************************************
  * Enc Dec Context
  **************************************/
@@ -63,6 +77,8 @@ typedef struct EntropyCodingContext {
     int32_t     coded_area_sb_uv;
     TOKENEXTRA *tok;
     MbModeInfo *mbmi;
+    // Arithmetic coder of the tiles, NULL unless split_entropy_coding is used
+    EcCoderWorker *coder_worker;
 } EntropyCodingContext;
 
 /**************************************
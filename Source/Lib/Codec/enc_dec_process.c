@@ -26,15 +26,69 @@
 #include "pic_analysis_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "full_loop.h"
 
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, bool is_highbd);
 void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
 void svt_c_unpack_compressed_10bit(const uint8_t *inn_bit_buffer, uint32_t inn_stride, uint8_t *in_compn_bit_buffer,
                                    uint32_t out_stride, uint32_t height);
+void set_block_based_depth_refinement_controls(ModeDecisionContext *ctx, uint8_t block_based_depth_refinement_level);
+
+/*
+ * PD0 quadrant helper thread: decides the leaves of one quadrant of the SB of its mode decision thread, using the
+ * SB-level data copied by the mode decision thread. The helpers only run while their mode decision thread waits for
+ * them, so they do not take executor slots of their own.
+ */
+static void *pd0_quadrant_worker_kernel(void *input_ptr) {
+    Pd0QuadrantWorker *worker = (Pd0QuadrantWorker *)input_ptr;
+    for (;;) {
+        svt_block_on_semaphore(worker->start_semaphore);
+        if (worker->exit)
+            break;
+        SequenceControlSet  *scs    = worker->scs;
+        PictureControlSet   *pcs    = worker->pcs;
+        ModeDecisionContext *md_ctx = worker->md_ctx;
+        SuperBlock          *sb_ptr = md_ctx->sb_ptr;
+
+        set_block_based_depth_refinement_controls(md_ctx, pcs->pic_block_based_depth_refinement_level);
+        svt_aom_mode_decision_configure_sb(md_ctx, pcs, sb_ptr->qindex, svt_aom_get_me_qindex(pcs, sb_ptr, true));
+        svt_aom_sig_deriv_enc_dec_common(scs, pcs, md_ctx);
+        md_ctx->lpd0_ctrls      = worker->lpd0_ctrls;
+        md_ctx->is_subres_safe  = (uint8_t)~0;
+        md_ctx->pd_pass         = PD_PASS_0;
+        md_ctx->fixed_partition = false;
+        svt_aom_sig_deriv_enc_dec(scs, pcs, md_ctx);
+
+        MdSbLoopState state;
+        md_ctx->d2_resume_mds = (uint32_t)~0;
+        svt_aom_mode_decision_sb_start(scs, pcs, md_ctx, &state);
+        svt_aom_mode_decision_sb_blocks(
+            scs, pcs, md_ctx, worker->mdc_sb_data, worker->first_leaf, worker->end_leaf, &state);
+        svt_post_semaphore(worker->done_semaphore);
+    }
+    return NULL;
+}
+
+static void pd0_quadrant_workers_dctor(Pd0QuadrantWorker *workers) {
+    for (int i = 0; i < PD0_QUADRANT_WORKERS; i++) {
+        Pd0QuadrantWorker *worker = &workers[i];
+        if (worker->thread) {
+            worker->exit = true;
+            svt_post_semaphore(worker->start_semaphore);
+            EB_DESTROY_THREAD(worker->thread);
+        }
+        EB_DESTROY_SEMAPHORE(worker->start_semaphore);
+        EB_DESTROY_SEMAPHORE(worker->done_semaphore);
+        EB_DELETE(worker->md_ctx);
+    }
+    EB_FREE_ARRAY(workers);
+}
 
 static void enc_dec_context_dctor(EbPtr p) {
     EbThreadContext *thread_ctx = (EbThreadContext *)p;
     EncDecContext   *obj        = (EncDecContext *)thread_ctx->priv;
+    if (obj->pd0_workers)
+        pd0_quadrant_workers_dctor(obj->pd0_workers);
     EB_DELETE(obj->md_ctx);
     EB_DELETE(obj->residual_buffer);
     EB_DELETE(obj->transform_buffer);
@@ -124,6 +178,7 @@ EbErrorType svt_aom_enc_dec_context_ctor(EbThreadContext *thread_ctx, const EbEn
            color_format,
            enc_handle_ptr->scs_instance_array[0]->scs->super_block_size,
            static_config->enc_mode,
+           enc_handle_ptr->scs_instance_array[0]->scs->blk_geom_mds,
            enc_handle_ptr->scs_instance_array[0]->scs->max_block_cnt,
            static_config->encoder_bit_depth,
            0,
@@ -137,6 +192,36 @@ EbErrorType svt_aom_enc_dec_context_ctor(EbThreadContext *thread_ctx, const EbEn
 
     ed_ctx->md_ctx->ed_ctx = ed_ctx;
 
+    if (static_config->pd0_quadrant_parallel && enc_handle_ptr->scs_instance_array[0]->scs->super_block_size == 128) {
+        EB_CALLOC_ARRAY(ed_ctx->pd0_workers, PD0_QUADRANT_WORKERS);
+        for (int i = 0; i < PD0_QUADRANT_WORKERS; i++) {
+            Pd0QuadrantWorker *worker = &ed_ctx->pd0_workers[i];
+            EB_NEW(worker->md_ctx,
+                   svt_aom_mode_decision_context_ctor,
+                   color_format,
+                   enc_handle_ptr->scs_instance_array[0]->scs->super_block_size,
+                   static_config->enc_mode,
+                   enc_handle_ptr->scs_instance_array[0]->scs->blk_geom_mds,
+                   enc_handle_ptr->scs_instance_array[0]->scs->max_block_cnt,
+                   static_config->encoder_bit_depth,
+                   0,
+                   0,
+                   enable_hbd_mode_decision == DEFAULT ? 2 : enable_hbd_mode_decision,
+                   static_config->screen_content_mode,
+                   enc_handle_ptr->scs_instance_array[0]->scs->seq_qp_mod);
+            worker->md_ctx->ed_ctx = ed_ctx;
+            // Each helper decides its quadrant in its own pair of neighbor array sets
+            worker->md_ctx->md_na_idx          = PD0_QUADRANT_NEIGHBOR_ARRAY_INDEX + 2 * i;
+            worker->md_ctx->nsq_na_idx         = PD0_QUADRANT_NEIGHBOR_ARRAY_INDEX + 2 * i + 1;
+            worker->md_ctx->d2_max_parent_size = 64;
+            worker->md_ctx->skip_mi_map_update = true;
+            EB_CREATE_SEMAPHORE(worker->start_semaphore, 0, 1);
+            EB_CREATE_SEMAPHORE(worker->done_semaphore, 0, 1);
+            worker->thread = svt_create_thread(pd0_quadrant_worker_kernel, worker);
+            EB_ADD_MEM(worker->thread, 1, EB_THREAD);
+        }
+    }
+
     return EB_ErrorNone;
 }
 
@@ -195,6 +280,10 @@ static void reset_enc_dec(EncDecContext *ed_ctx, PictureControlSet *pcs, Sequenc
         10,
         pcs->ppcs->frm_hdr.quantization_params.base_q_idx,
         true);
+    // Fast recode: keep the coded blocks of the SBs when the recode loop may code the picture again
+    ed_ctx->keep_recode_blocks = scs->static_config.fast_recode &&
+        (scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR || scs->static_config.max_bit_rate != 0) &&
+        scs->enc_ctx->recode_loop != DISALLOW_RECODE;
     if (segment_index == 0) {
         if (ed_ctx->tile_group_index == 0) {
             reset_segmentation_map(pcs->segmentation_neighbor_map);
@@ -2029,23 +2118,30 @@ static void copy_neighbour_arrays_light_pd0(PictureControlSet *pcs, ModeDecision
 }
 void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t src_idx, uint32_t dst_idx,
                                    uint32_t blk_mds);
-static void set_parent_to_be_considered(ModeDecisionContext *ctx, MdcSbData *results_ptr, uint32_t blk_index,
-                                        int32_t sb_size, int8_t pred_depth, uint8_t pred_sq_idx, int8_t depth_step,
-                                        const uint8_t disallow_nsq) {
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_index);
+static void set_parent_to_be_considered(PictureControlSet *pcs, ModeDecisionContext *ctx, MdcSbData *results_ptr,
+                                        uint32_t blk_index, int32_t sb_size, int8_t pred_depth, uint8_t pred_sq_idx,
+                                        int8_t depth_step, const uint8_t disallow_nsq) {
+    const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_index);
     if (blk_geom->sq_size < ((sb_size == BLOCK_128X128) ? 128 : 64)) {
         //Set parent to be considered
         uint32_t parent_depth_idx_mds                     = blk_geom->parent_depth_idx_mds;
         results_ptr->consider_block[parent_depth_idx_mds] = 1;
         if (depth_step < -1)
-            set_parent_to_be_considered(
-                ctx, results_ptr, parent_depth_idx_mds, sb_size, pred_depth, pred_sq_idx, depth_step + 1, disallow_nsq);
+            set_parent_to_be_considered(pcs,
+                                        ctx,
+                                        results_ptr,
+                                        parent_depth_idx_mds,
+                                        sb_size,
+                                        pred_depth,
+                                        pred_sq_idx,
+                                        depth_step + 1,
+                                        disallow_nsq);
     }
 }
 static void set_child_to_be_considered(PictureControlSet *pcs, ModeDecisionContext *ctx, MdcSbData *results_ptr,
                                        uint32_t blk_index, uint32_t sb_index, int32_t sb_size, int8_t pred_depth,
                                        uint8_t pred_sq_idx, int8_t depth_step, const uint8_t disallow_nsq) {
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_index);
+    const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_index);
     // 4x4 blocks have no children
     if (blk_geom->sq_size <= 4 || (blk_geom->sq_size == 8 && ctx->disallow_4x4))
         return;
@@ -2175,6 +2271,16 @@ static void set_d1_blocks_to_test(PictureControlSet *pcs, ModeDecisionContext *c
     *tot_shapes = shapes_idx;
 }
 
+// Return the smallest SQ block size that may be tested at MD for the current SB
+static int32_t get_min_sq_size(SequenceControlSet *scs, ModeDecisionContext *ctx) {
+    int32_t min_sq_size = (ctx->depth_removal_ctrls.enabled && ctx->depth_removal_ctrls.disallow_below_64x64) ? 64
+        : (ctx->depth_removal_ctrls.enabled && ctx->depth_removal_ctrls.disallow_below_32x32)                 ? 32
+        : (ctx->depth_removal_ctrls.enabled && ctx->depth_removal_ctrls.disallow_below_16x16)                 ? 16
+        : ctx->disallow_4x4                                                                                   ? 8
+                                                                                                              : 4;
+    // Safety check: Restrict min sq size so mode decision can always find at least one valid partition scheme
+    return scs->static_config.max_32_tx_size ? MIN(min_sq_size, 32) : min_sq_size;
+}
 // Initialize structures used to indicate which blocks will be tested at MD.
 // MD data structures should be updated in init_block_data(), not here.
 // When first_stage is false, the blocks added are based off results of a previous
@@ -2188,16 +2294,10 @@ static void build_cand_block_array(SequenceControlSet *scs, PictureControlSet *p
     uint32_t       blk_index      = 0;
     const uint16_t max_block_cnt  = scs->max_block_cnt;
     const bool     is_complete_sb = pcs->ppcs->sb_geom[ctx->sb_index].is_complete_sb;
-    int32_t min_sq_size = (ctx->depth_removal_ctrls.enabled && ctx->depth_removal_ctrls.disallow_below_64x64) ? 64
-        : (ctx->depth_removal_ctrls.enabled && ctx->depth_removal_ctrls.disallow_below_32x32)                 ? 32
-        : (ctx->depth_removal_ctrls.enabled && ctx->depth_removal_ctrls.disallow_below_16x16)                 ? 16
-        : ctx->disallow_4x4                                                                                   ? 8
-                                                                                                              : 4;
-    // Safety check: Restrict min sq size so mode decision can always find at least one valid partition scheme
-    min_sq_size = scs->static_config.max_32_tx_size ? MIN(min_sq_size, 32) : min_sq_size;
+    const int32_t  min_sq_size    = get_min_sq_size(scs, ctx);
 
     while (blk_index < max_block_cnt) {
-        const BlockGeom *blk_geom = get_blk_geom_mds(blk_index);
+        const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_index);
         int32_t max_sq_size = (blk_geom->sq_size > 32 && scs->static_config.max_32_tx_size) ? 32 : blk_geom->sq_size;
 
         assert(min_sq_size <= max_sq_size);
@@ -2435,7 +2535,7 @@ static void get_max_min_pd0_depths(SequenceControlSet *scs, PictureControlSet *p
     uint16_t min_pd0_size = 255;
     uint32_t blk_index    = 0;
     while (blk_index < scs->max_block_cnt) {
-        const BlockGeom *blk_geom = get_blk_geom_mds(blk_index);
+        const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_index);
         // if the parent square is inside inject this block
         const uint8_t is_blk_allowed = pcs->slice_type != I_SLICE ? 1 : (blk_geom->sq_size < 128) ? 1 : 0;
 
@@ -2461,6 +2561,286 @@ static void get_max_min_pd0_depths(SequenceControlSet *scs, PictureControlSet *p
     *min_pd0_size_out = min_pd0_size;
 }
 
+/*
+ * Copy the MD neighbor arrays seen by the blocks of the SB (the SB area and the area to its top-right) from one set
+ * to another.
+ */
+static void copy_sb_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t src_idx,
+                                     uint32_t dst_idx) {
+    const uint16_t      tile_idx  = ctx->tile_index;
+    const uint32_t      sb_size   = ctx->sb_size;
+    NeighborArrayUnit ***luma_na[] = {
+        pcs->mdleaf_partition_na,
+        pcs->md_y_dcs_na,
+        pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na,
+        pcs->md_txfm_context_array,
+        pcs->md_luma_recon_na,
+        pcs->md_tx_depth_1_luma_recon_na,
+        pcs->md_tx_depth_2_luma_recon_na,
+    };
+    NeighborArrayUnit ***chroma_na[] = {
+        pcs->md_cb_dc_sign_level_coeff_na,
+        pcs->md_cr_dc_sign_level_coeff_na,
+        pcs->md_cb_recon_na,
+        pcs->md_cr_recon_na,
+    };
+    for (uint32_t i = 0; i < sizeof(luma_na) / sizeof(luma_na[0]); i++)
+        if (luma_na[i][src_idx])
+            svt_aom_copy_neigh_arr_area(luma_na[i][src_idx][tile_idx],
+                                        luma_na[i][dst_idx][tile_idx],
+                                        ctx->sb_origin_x,
+                                        ctx->sb_origin_y,
+                                        sb_size << 1,
+                                        sb_size);
+    for (uint32_t i = 0; i < sizeof(chroma_na) / sizeof(chroma_na[0]); i++)
+        if (chroma_na[i][src_idx])
+            svt_aom_copy_neigh_arr_area(chroma_na[i][src_idx][tile_idx],
+                                        chroma_na[i][dst_idx][tile_idx],
+                                        ctx->sb_origin_x >> 1,
+                                        ctx->sb_origin_y >> 1,
+                                        sb_size,
+                                        sb_size >> 1);
+}
+
+/*
+ * Copy the MD results of a block between contexts, keeping the buffers owned by the destination context.
+ */
+static void copy_blk_struct_data(BlkStruct *dst, const BlkStruct *src) {
+    BlkStruct tmp = *dst;
+    *dst          = *src;
+    dst->av1xd    = tmp.av1xd;
+    for (int i = 0; i < 3; i++) {
+        dst->neigh_left_recon[i]       = tmp.neigh_left_recon[i];
+        dst->neigh_top_recon[i]        = tmp.neigh_top_recon[i];
+        dst->neigh_left_recon_16bit[i] = tmp.neigh_left_recon_16bit[i];
+        dst->neigh_top_recon_16bit[i]  = tmp.neigh_top_recon_16bit[i];
+    }
+    dst->coeff_tmp    = tmp.coeff_tmp;
+    dst->recon_tmp    = tmp.recon_tmp;
+    dst->palette_info = tmp.palette_info;
+    dst->palette_mem  = tmp.palette_mem;
+}
+
+// Fast recode: copy the blocks coded in the SB, in the order svt_aom_encode_decode() codes them, to blk_arr when
+// it is not NULL, and return the number of coded blocks. The palette data is copied to the picture arena.
+static uint16_t copy_recode_blocks(SequenceControlSet *scs, PictureControlSet *pcs, EncDecContext *ed_ctx,
+                                   BlkStruct *blk_arr) {
+    ModeDecisionContext *md_ctx  = ed_ctx->md_ctx;
+    uint16_t             blk_cnt = 0;
+    uint32_t             blk_it  = 0;
+    while (blk_it < scs->max_block_cnt) {
+        const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_it);
+        const BlkStruct *blk_ptr  = &md_ctx->md_blk_arr_nsq[blk_it];
+        if (blk_ptr->part == PARTITION_SPLIT) {
+            blk_it += blk_geom->d1_depth_offset;
+            continue;
+        }
+        const uint32_t d1_start_blk = blk_it +
+            (blk_geom->sq_size == 128 ? ns_blk_offset_128[blk_ptr->part] : ns_blk_offset[blk_ptr->part]);
+        for (uint32_t d1_itr = d1_start_blk; d1_itr < d1_start_blk + ns_blk_num[blk_ptr->part]; d1_itr++) {
+            if (!pcs->ppcs->sb_geom[ed_ctx->sb_index].block_is_allowed[d1_itr])
+                continue;
+            if (blk_arr) {
+                const BlockSize  bsize = get_blk_geom_mds(scs->blk_geom_mds, d1_itr)->bsize;
+                const BlkStruct *src   = &md_ctx->md_blk_arr_nsq[d1_itr];
+                BlkStruct       *dst   = &blk_arr[blk_cnt];
+                *dst                   = *src;
+                dst->mds_idx           = d1_itr;
+                dst->palette_info      = NULL;
+                if (svt_av1_allow_palette(pcs->ppcs->palette_level, bsize)) {
+                    dst->palette_info = svt_aom_sub_arena_alloc(&ed_ctx->pic_arena, pcs->arena, sizeof(PaletteInfo));
+                    if (!dst->palette_info)
+                        return 0;
+                    dst->palette_info->pmi           = src->palette_info->pmi;
+                    dst->palette_info->color_idx_map = NULL;
+                    if (src->palette_size[0] > 0) {
+                        dst->palette_info->color_idx_map = svt_aom_sub_arena_alloc(
+                            &ed_ctx->pic_arena, pcs->arena, MAX_PALETTE_SQUARE);
+                        if (!dst->palette_info->color_idx_map)
+                            return 0;
+                        svt_memcpy(
+                            dst->palette_info->color_idx_map, src->palette_info->color_idx_map, MAX_PALETTE_SQUARE);
+                    }
+                }
+            }
+            blk_cnt++;
+        }
+        blk_it += blk_geom->ns_depth_offset;
+    }
+    return blk_cnt;
+}
+
+// Fast recode: keep the blocks selected by the mode decision of the SB, so the next coding passes of the picture
+// can code the SB again without the mode decision. The SB is coded by a full pass when they cannot be kept.
+static void save_recode_blocks(SequenceControlSet *scs, PictureControlSet *pcs, EncDecContext *ed_ctx,
+                               SuperBlock *sb_ptr) {
+    sb_ptr->recode_blk_arr    = NULL;
+    sb_ptr->recode_coeff_rate = NULL;
+    sb_ptr->recode_blk_cnt    = copy_recode_blocks(scs, pcs, ed_ctx, NULL);
+
+    BlkStruct *blk_arr    = svt_aom_sub_arena_alloc(
+        &ed_ctx->pic_arena, pcs->arena, sizeof(*blk_arr) * sb_ptr->recode_blk_cnt);
+    uint64_t  *coeff_rate = svt_aom_sub_arena_alloc(
+        &ed_ctx->pic_arena, pcs->arena, sizeof(*coeff_rate) * sb_ptr->recode_blk_cnt);
+    if (!blk_arr || !coeff_rate || copy_recode_blocks(scs, pcs, ed_ctx, blk_arr) != sb_ptr->recode_blk_cnt)
+        return;
+    sb_ptr->recode_blk_arr    = blk_arr;
+    sb_ptr->recode_coeff_rate = coeff_rate;
+}
+
+// Fast recode: set the blocks kept by the previous pass as the coded blocks of the SB, so that only the transform,
+// quantization and entropy coding are redone at the qindex of the current pass
+static EbErrorType restore_recode_blocks(SequenceControlSet *scs, PictureControlSet *pcs, EncDecContext *ed_ctx,
+                                         SuperBlock *sb_ptr) {
+    ModeDecisionContext *md_ctx = ed_ctx->md_ctx;
+
+    // Partitioning of the SB
+    uint32_t blk_it = 0;
+    while (blk_it < scs->max_block_cnt) {
+        const BlockGeom *blk_geom           = get_blk_geom_mds(scs->blk_geom_mds, blk_it);
+        md_ctx->md_blk_arr_nsq[blk_it].part = sb_ptr->cu_partition_array[blk_it];
+        blk_it += md_ctx->md_blk_arr_nsq[blk_it].part == PARTITION_SPLIT ? blk_geom->d1_depth_offset
+                                                                         : blk_geom->ns_depth_offset;
+    }
+    // Coded blocks
+    for (uint16_t blk_idx = 0; blk_idx < sb_ptr->recode_blk_cnt; blk_idx++) {
+        const BlkStruct *src     = &sb_ptr->recode_blk_arr[blk_idx];
+        BlkStruct       *blk_ptr = &md_ctx->md_blk_arr_nsq[src->mds_idx];
+        copy_blk_struct_data(blk_ptr, src);
+        blk_ptr->qindex = md_ctx->qp_index;
+        if (src->palette_info) {
+            // The encode pass scales the palette colors in place, so each pass codes its own copy of them. The color
+            // map is only read, the kept one is used when the block has a palette. Both live in the picture arena.
+            blk_ptr->palette_info = svt_aom_sub_arena_alloc(&ed_ctx->pic_arena, pcs->arena, sizeof(PaletteInfo));
+            if (!blk_ptr->palette_info)
+                return EB_ErrorInsufficientResources;
+            blk_ptr->palette_info->pmi           = src->palette_info->pmi;
+            blk_ptr->palette_info->color_idx_map = src->palette_info->color_idx_map;
+            if (!blk_ptr->palette_info->color_idx_map) {
+                EB_SUB_ARENA_MALLOC_ARRAY(
+                    &ed_ctx->pic_arena, pcs->arena, blk_ptr->palette_info->color_idx_map, MAX_PALETTE_SQUARE);
+            }
+        }
+        md_ctx->blk_ptr   = blk_ptr;
+        md_ctx->blk_geom  = get_blk_geom_mds(scs->blk_geom_mds, src->mds_idx);
+        md_ctx->blk_org_x = md_ctx->sb_origin_x + md_ctx->blk_geom->org_x;
+        md_ctx->blk_org_y = md_ctx->sb_origin_y + md_ctx->blk_geom->org_y;
+        svt_aom_init_xd(pcs, md_ctx);
+        svt_aom_update_mi_map(blk_ptr, md_ctx->blk_org_x, md_ctx->blk_org_y, md_ctx->blk_geom, pcs, md_ctx);
+    }
+    return EB_ErrorNone;
+}
+
+/*
+ * Regular PD0 of a 128x128 SB with the 64x64 quadrants decided in parallel.
+ *
+ * The mode decision thread decides the 128x128 leaves, then hands quadrants 1 to 3 to its helpers and decides
+ * quadrant 0 itself. Every quadrant starts from the neighbor arrays of the SB as they were before the quadrants, so
+ * the blocks of the previous quadrants are not seen as neighbors: the PD0 partitioning is a speculation on the
+ * sequential one, which PD1 refines as usual. The results are then merged in quadrant order, with the quadrant
+ * early exit and the 128x128 inter-depth decision evaluated as in the sequential order.
+ */
+static void mode_decision_sb_pd0_quadrants(SequenceControlSet *scs, PictureControlSet *pcs, EncDecContext *ed_ctx,
+                                           const MdcSbData *const mdc_sb_data) {
+    ModeDecisionContext *md_ctx     = ed_ctx->md_ctx;
+    const uint32_t       leaf_count = mdc_sb_data->leaf_count;
+
+    // The leaves are in depth-first order: the 128x128 leaves, then the leaves of each quadrant
+    uint32_t quad_start[5];
+    uint32_t leaf = 0;
+    while (leaf < leaf_count &&
+           get_blk_geom_mds(scs->blk_geom_mds, mdc_sb_data->leaf_data_array[leaf].mds_idx)->sq_size == 128)
+        leaf++;
+    for (int q = 0; q < 4; q++) {
+        quad_start[q] = leaf;
+        while (leaf < leaf_count) {
+            const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, mdc_sb_data->leaf_data_array[leaf].mds_idx);
+            if ((blk_geom->org_x >= 64) + 2 * (blk_geom->org_y >= 64) != q)
+                break;
+            leaf++;
+        }
+    }
+    quad_start[4] = leaf;
+    if (leaf != leaf_count || quad_start[1] == quad_start[2] || quad_start[2] == quad_start[3] ||
+        quad_start[3] == quad_start[4]) {
+        svt_aom_mode_decision_sb(scs, pcs, md_ctx, mdc_sb_data);
+        return;
+    }
+
+    MdSbLoopState state;
+    svt_aom_mode_decision_sb_start(scs, pcs, md_ctx, &state);
+    svt_aom_mode_decision_sb_blocks(scs, pcs, md_ctx, mdc_sb_data, 0, quad_start[0], &state);
+    // The 128x128 block skips its sub-depths
+    if (state.md_early_exit_sq) {
+        svt_aom_mode_decision_sb_blocks(scs, pcs, md_ctx, mdc_sb_data, quad_start[0], leaf_count, &state);
+        return;
+    }
+
+    // The helpers start from the 128x128 decisions and the neighbor arrays of the SB
+    const uint32_t root_blk_cnt = get_blk_geom_mds(scs->blk_geom_mds, 0)->d1_depth_offset;
+    for (int i = 0; i < PD0_QUADRANT_WORKERS; i++) {
+        Pd0QuadrantWorker   *worker = &ed_ctx->pd0_workers[i];
+        ModeDecisionContext *w_ctx  = worker->md_ctx;
+        w_ctx->sb_index             = md_ctx->sb_index;
+        w_ctx->sb_ptr               = md_ctx->sb_ptr;
+        w_ctx->tile_index           = md_ctx->tile_index;
+        w_ctx->sb_origin_x          = md_ctx->sb_origin_x;
+        w_ctx->sb_origin_y          = md_ctx->sb_origin_y;
+        w_ctx->md_rate_est_ctx      = md_ctx->md_rate_est_ctx;
+        w_ctx->encoder_bit_depth    = md_ctx->encoder_bit_depth;
+        w_ctx->corrupted_mv_check   = md_ctx->corrupted_mv_check;
+        w_ctx->hbd_md               = md_ctx->hbd_md;
+        w_ctx->bypass_encdec        = md_ctx->bypass_encdec;
+        w_ctx->pred_depth_only      = md_ctx->pred_depth_only;
+        w_ctx->rtc_use_N4_dct_dct_shortcut = md_ctx->rtc_use_N4_dct_dct_shortcut;
+        w_ctx->need_hbd_comp_mds3   = 0;
+        memset(w_ctx->avail_blk_flag, false, sizeof(uint8_t) * scs->max_block_cnt);
+        memset(w_ctx->cost_avail, false, sizeof(uint8_t) * scs->max_block_cnt);
+        for (uint32_t blk = 0; blk < root_blk_cnt; blk++)
+            copy_blk_struct_data(&w_ctx->md_blk_arr_nsq[blk], &md_ctx->md_blk_arr_nsq[blk]);
+        memcpy(w_ctx->avail_blk_flag, md_ctx->avail_blk_flag, sizeof(uint8_t) * root_blk_cnt);
+        memcpy(w_ctx->cost_avail, md_ctx->cost_avail, sizeof(uint8_t) * root_blk_cnt);
+        copy_sb_neighbour_arrays(pcs, md_ctx, md_ctx->md_na_idx, w_ctx->md_na_idx);
+
+        worker->scs         = scs;
+        worker->pcs         = pcs;
+        worker->mdc_sb_data = mdc_sb_data;
+        worker->first_leaf  = quad_start[i + 1];
+        worker->end_leaf    = quad_start[i + 2];
+        worker->lpd0_ctrls  = md_ctx->lpd0_ctrls;
+        svt_post_semaphore(worker->start_semaphore);
+    }
+    md_ctx->skip_mi_map_update = true;
+    svt_aom_mode_decision_sb_blocks(scs, pcs, md_ctx, mdc_sb_data, quad_start[0], quad_start[1], &state);
+    md_ctx->skip_mi_map_update = false;
+    for (int i = 0; i < PD0_QUADRANT_WORKERS; i++) svt_block_on_semaphore(ed_ctx->pd0_workers[i].done_semaphore);
+
+    const uint32_t quad_blk_cnt = get_blk_geom_mds(scs->blk_geom_mds, root_blk_cnt)->ns_depth_offset;
+    for (int q = 1; q < 4; q++) {
+        ModeDecisionContext *w_ctx    = ed_ctx->pd0_workers[q - 1].md_ctx;
+        const uint32_t       quad_mds = root_blk_cnt + q * quad_blk_cnt;
+        // The early exit of the quadrant depends on the costs of the previous quadrants, so it is checked once they
+        // are merged; the remaining quadrants are then skipped as in the sequential order
+        if (!state.md_early_exit_sq || state.next_non_skip_blk_idx_mds <= quad_mds) {
+            state.md_early_exit_sq = false;
+            if (mdc_sb_data->leaf_data_array[quad_start[q]].mds_idx == quad_mds)
+                svt_aom_mode_decision_sb_quadrant_exit(scs, pcs, md_ctx, quad_mds, &state);
+        }
+        if (state.md_early_exit_sq) {
+            svt_aom_mode_decision_sb_blocks(scs, pcs, md_ctx, mdc_sb_data, quad_start[q], leaf_count, &state);
+            return;
+        }
+        for (uint32_t blk = quad_mds; blk < quad_mds + quad_blk_cnt; blk++)
+            copy_blk_struct_data(&md_ctx->md_blk_arr_nsq[blk], &w_ctx->md_blk_arr_nsq[blk]);
+        memcpy(md_ctx->avail_blk_flag + quad_mds, w_ctx->avail_blk_flag + quad_mds, sizeof(uint8_t) * quad_blk_cnt);
+        memcpy(md_ctx->cost_avail + quad_mds, w_ctx->cost_avail + quad_mds, sizeof(uint8_t) * quad_blk_cnt);
+    }
+    // The helper of the last quadrant stops the inter-depth decisions below the 128x128 block
+    const uint32_t resume_mds = ed_ctx->pd0_workers[PD0_QUADRANT_WORKERS - 1].md_ctx->d2_resume_mds;
+    if (resume_mds != (uint32_t)~0)
+        svt_aom_d2_inter_depth_parent_decision(pcs, md_ctx, resume_mds);
+}
+
 static void perform_pred_depth_refinement(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
                                           uint32_t sb_index) {
     MdcSbData *results_ptr = &ctx->mdc_sb_array;
@@ -2474,7 +2854,7 @@ static void perform_pred_depth_refinement(SequenceControlSet *scs, PictureContro
             memset(results_ptr->refined_split_flag, 1, sizeof(uint8_t) * scs->max_block_cnt);
         } else {
             while (blk_index < scs->max_block_cnt) {
-                const BlockGeom *blk_geom = get_blk_geom_mds(blk_index);
+                const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_index);
 
                 bool split_flag                            = blk_geom->sq_size > 4 ? true : false;
                 results_ptr->consider_block[blk_index]     = 0;
@@ -2485,7 +2865,7 @@ static void perform_pred_depth_refinement(SequenceControlSet *scs, PictureContro
     } else {
         // Reset mdc_sb_array data to defaults; it will be updated based on the predicted blocks (stored in md_blk_arr_nsq)
         while (blk_index < scs->max_block_cnt) {
-            const BlockGeom *blk_geom                  = get_blk_geom_mds(blk_index);
+            const BlockGeom *blk_geom                  = get_blk_geom_mds(scs->blk_geom_mds, blk_index);
             results_ptr->consider_block[blk_index]     = 0;
             results_ptr->refined_split_flag[blk_index] = blk_geom->sq_size > 4 ? true : false;
             blk_index++;
@@ -2502,7 +2882,7 @@ static void perform_pred_depth_refinement(SequenceControlSet *scs, PictureContro
     bool pred_depth_only    = 1;
 
     while (blk_index < scs->max_block_cnt) {
-        const BlockGeom *blk_geom = get_blk_geom_mds(blk_index);
+        const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_index);
         ctx->blk_ptr              = &ctx->md_blk_arr_nsq[blk_index];
 
         // if the parent square is inside inject this block
@@ -2649,7 +3029,8 @@ static void perform_pred_depth_refinement(SequenceControlSet *scs, PictureContro
                             pred_depth_only = 0;
 
                         if (s_depth != 0 && add_parent_depth)
-                            set_parent_to_be_considered(ctx,
+                            set_parent_to_be_considered(pcs,
+                                                        ctx,
                                                         results_ptr,
                                                         blk_index,
                                                         scs->seq_header.sb_size,
@@ -2688,6 +3069,10 @@ void normalize_sb_delta_q(PictureControlSet *pcs);
 void mode_decision_configuration_init_qp_update(PictureControlSet *pcs);
 void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs);
 
+// Maximum base q_idx change between two coding passes for which a fast recode (reusing the blocks coded by the
+// previous pass) is allowed; larger changes trigger a full recode
+#define FAST_RECODE_MAX_QINDEX_DELTA 16
+
 static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSet *scs, bool *do_recode) {
     PictureParentControlSet *ppcs    = pcs->ppcs;
     EncodeContext *const     enc_ctx = ppcs->scs->enc_ctx;
@@ -2695,6 +3080,7 @@ static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSe
     int32_t                  loop    = 0;
     FrameHeader             *frm_hdr = &ppcs->frm_hdr;
     int32_t                  q       = frm_hdr->quantization_params.base_q_idx;
+    const int32_t            prev_q  = q;
     if (ppcs->loop_count == 0) {
         ppcs->q_low  = ppcs->bottom_index;
         ppcs->q_high = ppcs->top_index;
@@ -2727,6 +3113,10 @@ static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSe
             (int32_t)quantizer_to_qindex[scs->static_config.max_qp_allowed],
             q);
 
+        // Fast recode: keep the blocks of the previous pass if q did not move much
+        ppcs->recode_reuse_blocks = scs->static_config.fast_recode &&
+            abs(frm_hdr->quantization_params.base_q_idx - prev_q) <= FAST_RECODE_MAX_QINDEX_DELTA;
+
         ppcs->picture_qp = (uint8_t)CLIP3((int32_t)scs->static_config.min_qp_allowed,
                                           (int32_t)scs->static_config.max_qp_allowed,
                                           (frm_hdr->quantization_params.base_q_idx + 2) >> 2);
@@ -2756,7 +3146,8 @@ static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSe
             normalize_sb_delta_q(pcs);
         }
     } else {
-        ppcs->loop_count = 0;
+        ppcs->loop_count          = 0;
+        ppcs->recode_reuse_blocks = 0;
     }
 }
 
@@ -3293,6 +3684,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                 segment_band_size  = (segments_ptr->sb_band_count * (segment_band_index + 1) +
                                      segments_ptr->segment_band_count - 1) /
                     segments_ptr->segment_band_count;
+                // A segment is a compute-only task, it holds an executor slot while it runs
+                svt_aom_executor_acquire(scs->enc_ctx->executor_client);
 
                 // Reset Coding Loop State
                 svt_aom_reset_mode_decision(scs, ed_ctx->md_ctx, pcs, ed_ctx->tile_group_index, segment_index);
@@ -3399,6 +3792,26 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                             for (int i = 0; i < scs->max_block_cnt; ++i)
                                 ed_ctx->md_ctx->md_blk_arr_nsq[i].palette_mem = 0;
 
+                        // Fast recode: code the blocks kept by the previous pass, without mode decision
+                        ed_ctx->reuse_recode_blocks = false;
+                        if (pcs->ppcs->recode_reuse_blocks && sb_ptr->recode_blk_arr) {
+                            md_ctx->pd_pass = PD_PASS_1;
+                            svt_aom_sig_deriv_enc_dec(scs, pcs, md_ctx);
+                            // The coefficients of MD were made at the qindex of the previous pass; its skip decisions are
+                            // kept with the modes
+                            md_ctx->bypass_encdec       = 0;
+                            md_ctx->fixed_partition     = false;
+                            ed_ctx->reuse_recode_blocks = restore_recode_blocks(scs, pcs, ed_ctx, sb_ptr) ==
+                                EB_ErrorNone;
+                        }
+                        if (ed_ctx->reuse_recode_blocks) {
+                            svt_aom_encode_decode(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
+                            md_ctx->mds_subres_step = 0;
+                            svt_aom_encdec_update(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
+                            ed_ctx->coded_sb_count++;
+                            continue;
+                        }
+
                         // Initialize is_subres_safe
                         ed_ctx->md_ctx->is_subres_safe = (uint8_t)~0;
                         // Signal initialized here; if needed, will be set in md_encode_block before MDS3
@@ -3468,7 +3881,16 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                                 build_cand_block_array(scs, pcs, md_ctx, true);
                                 // PD0 MD Tool(s) : ME_MV(s) as INTER candidate(s), DC as INTRA candidate, luma only, Frequency domain SSE,
                                 // no fast rate (no MVP table generation), MDS0 then MDS3, reduced NIC(s), 1 ref per list,..
-                                svt_aom_mode_decision_sb(scs, pcs, ed_ctx->md_ctx, mdc_ptr);
+                                // The quadrants are only decided in parallel when PD0 does not read state shared
+                                // between blocks outside of the neighbor arrays (mode info, palette buffers)
+                                if (ed_ctx->pd0_workers && pcs->ppcs->sb_geom[sb_index].is_complete_sb &&
+                                    !md_ctx->hbd_md && md_ctx->shut_fast_rate && !pcs->ppcs->palette_level &&
+                                    !md_ctx->rate_est_ctrls.update_skip_coeff_ctx &&
+                                    !md_ctx->tx_shortcut_ctrls.use_neighbour_info && !md_ctx->txs_ctrls.enabled &&
+                                    !md_ctx->cand_reduction_ctrls.use_neighbouring_mode_ctrls.enabled)
+                                    mode_decision_sb_pd0_quadrants(scs, pcs, ed_ctx, mdc_ptr);
+                                else
+                                    svt_aom_mode_decision_sb(scs, pcs, ed_ctx->md_ctx, mdc_ptr);
                                 // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
                                 // Reset neighnor information to current SB @ position (0,0)
                                 svt_aom_copy_neighbour_arrays(pcs,
@@ -3525,10 +3947,15 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                         // if (/*ppcs->is_ref &&*/ md_ctx->hbd_md == 0 &&
                         // scs->static_config.encoder_bit_depth > EB_EIGHT_BIT)
                         //     md_ctx->bypass_encdec = 0;
+                        if (ed_ctx->keep_recode_blocks)
+                            save_recode_blocks(scs, pcs, ed_ctx, sb_ptr);
                         //  Encode Pass
                         if (!ed_ctx->md_ctx->bypass_encdec) {
                             svt_aom_encode_decode(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
                         }
+                        // The coefficient rate kept for a fast recode is estimated at full resolution
+                        if (ed_ctx->keep_recode_blocks)
+                            md_ctx->mds_subres_step = 0;
 
                         svt_aom_encdec_update(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
 
@@ -3536,6 +3963,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     }
                     x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
                 }
+                svt_aom_executor_release(scs->enc_ctx->executor_client);
             }
 
             svt_block_on_mutex(pcs->intra_mutex);
@@ -3556,19 +3984,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                 }
 
                 if (do_recode) {
-                    // Deallocate the palette data
-                    for (sb_index = 0; sb_index < pcs->enc_dec_coded_sb_count; ++sb_index) {
-                        sb_ptr = pcs->sb_ptr_array[sb_index];
-                        for (uint16_t blk_cnt = 0; blk_cnt < sb_ptr->final_blk_cnt; blk_cnt++) {
-                            EcBlkStruct *final_blk_arr = &(sb_ptr->final_blk_arr[blk_cnt]);
-                            if (final_blk_arr->palette_info != NULL) {
-                                assert(final_blk_arr->palette_info->color_idx_map != NULL && "free palette:Null");
-                                EB_FREE(final_blk_arr->palette_info->color_idx_map);
-                                final_blk_arr->palette_info->color_idx_map = NULL;
-                                EB_FREE(final_blk_arr->palette_info);
-                            }
-                        }
-                    }
+                    // the palette data of the dropped pass stays in the picture arena until the picture is released
                     pcs->enc_dec_coded_sb_count = 0;
                     // re-init mode decision configuration for qp update for re-encode frame
                     mode_decision_configuration_init_qp_update(pcs);
@@ -3590,7 +4006,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     }
 
                 } else {
-                    EB_FREE_ARRAY(pcs->ec_ctx_array);
+                    // the contexts are returned with the picture arena
+                    pcs->ec_ctx_array = NULL;
                     // Copy film grain data from parent picture set to the reference object for
                     // further reference
                     if (scs->seq_header.film_grain_params_present) {
@@ -28,6 +28,29 @@
 extern "C" {
 #endif
 
+// Number of helper threads of a mode decision thread with pd0_quadrant_parallel, one per 64x64 quadrant of a
+// 128x128 SB except the first one, which the mode decision thread decides itself
+#define PD0_QUADRANT_WORKERS 3
+
+/**************************************
+     * PD0 Quadrant Worker
+     **************************************/
+typedef struct Pd0QuadrantWorker {
+    ModeDecisionContext *md_ctx;
+    EbHandle             thread;
+    EbHandle             start_semaphore;
+    EbHandle             done_semaphore;
+    // Task posted by the mode decision thread: the leaves [first_leaf, end_leaf) of its SB
+    SequenceControlSet  *scs;
+    PictureControlSet   *pcs;
+    const MdcSbData     *mdc_sb_data;
+    uint32_t             first_leaf;
+    uint32_t             end_leaf;
+    // Light-PD0 controls of the SB, which the detectors may have changed
+    Lpd0Ctrls            lpd0_ctrls;
+    bool                 exit;
+} Pd0QuadrantWorker;
+
 /**************************************
      * Enc Dec Context
      **************************************/
@@ -37,6 +60,8 @@ typedef struct EncDecContext {
     EbFifo              *enc_dec_feedback_fifo_ptr;
     EbFifo              *picture_demux_output_fifo_ptr; // to picture-manager
     ModeDecisionContext *md_ctx;
+    // Helpers deciding quadrants of the SB in PD0, NULL unless pd0_quadrant_parallel is used with 128x128 SBs
+    Pd0QuadrantWorker   *pd0_workers;
     const BlockGeom     *blk_geom;
     // Coding Unit Workspace---------------------------
     EbPictureBufferDesc *residual_buffer;
@@ -78,6 +103,13 @@ typedef struct EncDecContext {
     uint16_t tile_group_index;
     uint16_t tile_index;
     uint32_t coded_sb_count;
+    // front end of the picture arena, serves the palette data of the final blocks and the blocks kept for a
+    // fast recode
+    EbSubArena pic_arena;
+    // fast recode: keep the coded blocks of each SB for the next coding passes of the picture
+    bool keep_recode_blocks;
+    // fast recode: the current SB is coded with the blocks kept by a previous pass
+    bool reuse_recode_blocks;
 } EncDecContext;
 
 /**************************************
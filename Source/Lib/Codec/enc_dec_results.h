@@ -32,10 +32,17 @@ typedef struct DlfResults {
     uint32_t         segment_index;
 } DlfResults;
 
+#define REST_TASKS_CDEF_INPUT 0
+#define REST_TASKS_FINISH_SEARCH 1
+
 typedef struct CdefResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
+    uint32_t         task_type;
     uint32_t         segment_index;
+    // REST_TASKS_FINISH_SEARCH: plane and frame restoration type of the final restoration search job
+    uint8_t plane;
+    uint8_t rest_type;
 } CdefResults;
 
 typedef struct RestResults {
@@ -2431,6 +2431,61 @@ static const int32_t filter_sets[DUAL_FILTER_SET_SIZE][2] = {
     {2, 1},
     {2, 2},
 };
+static INLINE uint64_t inter_pred_cache_mix(uint64_t h, uint64_t v) {
+    h = (h ^ v) * 0xff51afd7ed558ccdULL;
+    return h ^ (h >> 29);
+}
+
+// Key of the luma prediction of the current block, 0 for the predictions which are not cached. OBMC and warped
+// predictions depend on more than the candidate motion parameters, and the DIFFWTD mask is derived from the luma
+// prediction so it must be rebuilt with it.
+static uint64_t inter_pred_cache_key(ModeDecisionContext *ctx, const ModeDecisionCandidate *cand,
+                                     const MvUnit *mv_unit, uint32_t interp_filters, MotionMode motion_mode,
+                                     uint8_t is_interintra_used, const EbPictureBufferDesc *ref_pic_list0,
+                                     const EbPictureBufferDesc *ref_pic_list1, uint8_t bit_depth) {
+    const InterInterCompoundData *comp = &cand->interinter_comp;
+    if (motion_mode != SIMPLE_TRANSLATION || cand->use_intrabc ||
+        (mv_unit->pred_direction == BI_PRED && comp->type == COMPOUND_DIFFWTD))
+        return 0;
+    uint64_t h = inter_pred_cache_mix((uint64_t)ctx->blk_org_x << 48 | (uint64_t)ctx->blk_org_y << 32 |
+                                          (uint64_t)ctx->blk_geom->blkidx_mds << 8 | bit_depth,
+                                      (uintptr_t)ref_pic_list0);
+    h = inter_pred_cache_mix(h, (uintptr_t)ref_pic_list1);
+    h = inter_pred_cache_mix(h, (uint64_t)mv_unit->mv[0].as_int << 32 | mv_unit->mv[1].as_int);
+    h = inter_pred_cache_mix(h,
+                             (uint64_t)interp_filters << 32 | cand->ref_frame_type << 24 | mv_unit->pred_direction << 16 |
+                                 cand->compound_idx << 8 | comp->type);
+    h = inter_pred_cache_mix(
+        h, (uint64_t)comp->wedge_index << 32 | comp->wedge_sign << 24 | comp->mask_type << 16 | is_interintra_used);
+    if (is_interintra_used)
+        h = inter_pred_cache_mix(h,
+                                 (uint64_t)cand->interintra_mode << 40 | (uint64_t)cand->use_wedge_interintra << 32 |
+                                     (uint32_t)cand->interintra_wedge_index);
+    return h | 1;
+}
+
+static EbPictureBufferDesc *inter_pred_cache_find(InterPredCache *cache, uint64_t key) {
+    cache->lookups++;
+    for (int i = 0; i < INTER_PRED_CACHE_SIZE; i++) {
+        if (cache->entries[i].key == key && cache->entries[i].generation == cache->generation) {
+            cache->hits++;
+            return cache->entries[i].pred;
+        }
+    }
+    return NULL;
+}
+
+// Returns the buffer the prediction of key is to be built in, without evicting the prediction of keep_key
+static EbPictureBufferDesc *inter_pred_cache_insert(InterPredCache *cache, uint64_t key, uint64_t keep_key) {
+    if (keep_key && cache->entries[cache->next].key == keep_key)
+        cache->next = (cache->next + 1) % INTER_PRED_CACHE_SIZE;
+    InterPredCacheEntry *entry = &cache->entries[cache->next];
+    cache->next                = (cache->next + 1) % INTER_PRED_CACHE_SIZE;
+    entry->key                 = key;
+    entry->generation          = cache->generation;
+    return entry->pred;
+}
+
 static void interpolation_filter_search(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                         ModeDecisionCandidateBuffer *cand_bf, MvUnit mv_unit,
                                         EbPictureBufferDesc *ref_pic_list0, EbPictureBufferDesc *ref_pic_list1,
@@ -2474,6 +2529,7 @@ static void interpolation_filter_search(PictureControlSet *pcs, ModeDecisionCont
     int32_t  switchable_rate = 0;
     uint64_t rd              = (uint64_t)~0;
     uint32_t best_filters    = 0;
+    uint64_t best_key        = 0;
 
     // Loop over allowable filter combinations and select the best one
     for (unsigned int i = 0; i < DUAL_FILTER_SET_SIZE; i++) {
@@ -2494,7 +2550,28 @@ static void interpolation_filter_search(PictureControlSet *pcs, ModeDecisionCont
                                               cand_bf->cand->interp_filters == org_interp_filters &&
                                               ctx->md_stage > MD_STAGE_0 && encoder_bit_depth == EB_EIGHT_BIT);
 
+        // The prediction is built in the cache, to be reused once the filter is selected
+        EbPictureBufferDesc *pred = ctx->scratch_prediction_ptr;
+        bool                 hit  = false;
+        uint64_t             key  = 0;
         if (is_pred_buffer_ready == 0) {
+            key = inter_pred_cache_key(ctx,
+                                       cand_bf->cand,
+                                       &mv_unit,
+                                       cand_bf->cand->interp_filters,
+                                       (encoder_bit_depth > EB_EIGHT_BIT) ? SIMPLE_TRANSLATION
+                                                                          : cand_bf->cand->motion_mode,
+                                       (encoder_bit_depth > EB_EIGHT_BIT) ? 0 : cand_bf->cand->is_interintra_used,
+                                       ref_pic_list0,
+                                       ref_pic_list1,
+                                       hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT);
+            if (key) {
+                EbPictureBufferDesc *cached = inter_pred_cache_find(&ctx->inter_pred_cache, key);
+                hit                         = cached != NULL;
+                pred = hit ? cached : inter_pred_cache_insert(&ctx->inter_pred_cache, key, best_key);
+            }
+        }
+        if (is_pred_buffer_ready == 0 && !hit) {
             svt_aom_inter_prediction(scs,
                                      pcs,
                                      cand_bf->cand->interp_filters,
@@ -2520,7 +2597,7 @@ static void interpolation_filter_search(PictureControlSet *pcs, ModeDecisionCont
                                      ctx->blk_geom->bheight,
                                      ref_pic_list0,
                                      ref_pic_list1,
-                                     ctx->scratch_prediction_ptr,
+                                     pred,
                                      ctx->blk_geom->org_x,
                                      ctx->blk_geom->org_y,
                                      PICTURE_BUFFER_DESC_LUMA_MASK,
@@ -2531,7 +2608,7 @@ static void interpolation_filter_search(PictureControlSet *pcs, ModeDecisionCont
         int32_t tmp_rate;
         int64_t tmp_dist;
         model_rd_for_sb(pcs,
-                        is_pred_buffer_ready ? cand_bf->pred : ctx->scratch_prediction_ptr,
+                        is_pred_buffer_ready ? cand_bf->pred : pred,
                         ctx,
                         0,
                         0,
@@ -2561,6 +2638,7 @@ static void interpolation_filter_search(PictureControlSet *pcs, ModeDecisionCont
             rd              = tmp_rd;
             switchable_rate = tmp_rs;
             best_filters    = cand_bf->cand->interp_filters;
+            best_key        = key;
         }
     }
 
@@ -3809,7 +3887,7 @@ static void av1_inter_prediction_obmc(PictureControlSet *pcs, BlkStruct *blk_ptr
                                       uint32_t component_mask, uint8_t bit_depth, uint8_t is_16bit_pipeline) {
     uint8_t is16bit = bit_depth > EB_EIGHT_BIT || is_16bit_pipeline;
 
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
 
     // cppcheck-suppress unassignedVariable
     DECLARE_ALIGNED(16, uint8_t, obmc_buff_0[2 * MAX_MB_PLANE * MAX_SB_SQUARE]);
@@ -4136,7 +4214,7 @@ EbErrorType svt_aom_inter_prediction(SequenceControlSet *scs, PictureControlSet
 
     InterpFilterParams filter_params_x, filter_params_y;
 
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_ptr->mds_idx);
 
     ScaleFactors sf_identity = scs->sf_identity;
 
@@ -5122,6 +5200,37 @@ EbErrorType svt_aom_inter_pu_prediction_av1(uint8_t hbd_md, ModeDecisionContext
             }
         }
     }
+    // Copy the luma prediction if it was already built by the IFS
+    if ((component_mask & PICTURE_BUFFER_DESC_LUMA_MASK) && !ctx->need_hbd_comp_mds3) {
+        const uint64_t key = inter_pred_cache_key(ctx,
+                                                  cand,
+                                                  &mv_unit,
+                                                  cand->interp_filters,
+                                                  cand->motion_mode,
+                                                  cand->is_interintra_used,
+                                                  ref_pic_list0,
+                                                  ref_pic_list1,
+                                                  hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT);
+        EbPictureBufferDesc *cached = key ? inter_pred_cache_find(&ctx->inter_pred_cache, key) : NULL;
+        if (cached) {
+            const uint32_t blk_origin_index = ctx->blk_geom->org_x + ctx->blk_geom->org_y * cached->stride_y;
+            svt_av1_picture_copy(cached,
+                                 blk_origin_index,
+                                 0,
+                                 cand_bf->pred,
+                                 ctx->blk_geom->org_x + ctx->blk_geom->org_y * cand_bf->pred->stride_y,
+                                 0,
+                                 ctx->blk_geom->bwidth,
+                                 ctx->blk_geom->bheight,
+                                 0,
+                                 0,
+                                 PICTURE_BUFFER_DESC_Y_FLAG,
+                                 hbd_md != 0);
+            component_mask &= ~PICTURE_BUFFER_DESC_LUMA_MASK;
+            if (!component_mask)
+                return return_error;
+        }
+    }
     svt_aom_inter_prediction(scs,
                              pcs,
                              cand_bf->cand->interp_filters,
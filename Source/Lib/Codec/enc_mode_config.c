@@ -877,6 +877,8 @@ static void set_cdef_search_controls(PictureParentControlSet *pcs, uint8_t cdef_
     const bool          is_base              = pcs->temporal_layer_index == 0;
     const bool          is_not_highest_layer = !pcs->is_highest_layer;
     int                 i, j, sf_idx, second_pass_fs_num;
+    cdef_ctrls->ref_prior_top_k = 0;
+    cdef_ctrls->early_exit_q_th = 0;
     switch (cdef_search_level) {
         // OFF
     case 0:
@@ -2241,7 +2243,7 @@ static EbErrorType svt_aom_check_high_freq(PictureControlSet *pcs, SuperBlock *s
         // block position should be calculated from the values in MD context,
         // because sb params are different since frames might be downscaled
         // if super-res or resize is enabled
-        const BlockGeom *blk_geom = ctx->blk_geom = get_blk_geom_mds(blk_idx_mds);
+        const BlockGeom *blk_geom = ctx->blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_idx_mds);
         ctx->blk_org_x                            = (uint16_t)(ctx->sb_origin_x + blk_geom->org_x);
         ctx->blk_org_y                            = (uint16_t)(ctx->sb_origin_y + blk_geom->org_y);
         const uint32_t input_origin_index         = (ctx->blk_org_y + input_pic->org_y) * input_pic->stride_y +
@@ -7809,7 +7811,7 @@ Input   : encoder mode and tune
 Output  : EncDec Kernel signal(s)
 ******************************************************/
 static EbErrorType rtime_alloc_ec_ctx_array(PictureControlSet *pcs, uint16_t all_sb) {
-    EB_MALLOC_ARRAY(pcs->ec_ctx_array, all_sb);
+    EB_ARENA_MALLOC_ARRAY(pcs->arena, pcs->ec_ctx_array, all_sb);
     return EB_ErrorNone;
 }
 
@@ -74,6 +74,7 @@ static void encode_context_dctor(EbPtr p) {
 #endif
     EB_DELETE_PTR_ARRAY(obj->initial_rate_control_reorder_queue, INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH);
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
+    EB_DESTROY_MUTEX(obj->stream_mutex);
     EB_FREE(obj->stats_out.stat);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
@@ -81,7 +82,14 @@ static void encode_context_dctor(EbPtr p) {
     if (obj->rc_param_queue)
         EB_FREE_2D(obj->rc_param_queue);
     EB_DESTROY_MUTEX(obj->rc_param_queue_mutex);
+    EB_FREE_ARRAY(obj->var_boost_lut);
+    EB_DESTROY_MUTEX(obj->var_boost_lut_mutex);
     EB_DESTROY_MUTEX(obj->rc.rc_mutex);
+    // packets still held by the application keep the pool alive until they are released
+    svt_aom_packet_buffer_pool_close(obj->packet_buffer_pool);
+    svt_aom_executor_detach(obj->executor_client);
+    svt_aom_ladder_detach(obj->ladder_client);
+    svt_aom_analysis_cache_free(obj->analysis_cache);
 }
 
 EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_init_data_ptr) {
@@ -131,6 +139,7 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
                svt_aom_packetization_reorder_entry_ctor,
                picture_index);
     }
+    EB_CREATE_MUTEX(enc_ctx->stream_mutex);
 #if OPT_LD_LATENCY2
     EB_CREATE_MUTEX(enc_ctx->total_number_of_shown_frames_mutex);
     EB_CREATE_MUTEX(enc_ctx->ref_pic_list_mutex);
@@ -181,6 +190,13 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->cr_sb_end                 = 0;
 
     EB_CREATE_MUTEX(enc_ctx->rc_param_queue_mutex);
+    // variance boost rows, built per base_q_idx on first use
+    EB_MALLOC_ARRAY(enc_ctx->var_boost_lut, QINDEX_RANGE * VAR_BOOST_LUT_SIZE);
+    EB_CREATE_MUTEX(enc_ctx->var_boost_lut_mutex);
+
+    EbErrorType return_error = svt_aom_packet_buffer_pool_create(&enc_ctx->packet_buffer_pool);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
     enc_ctx->roi_map_evt = NULL;
     return EB_ErrorNone;
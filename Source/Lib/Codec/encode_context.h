@@ -28,6 +28,10 @@
 #include "encoder.h"
 #include "firstpass.h"
 #include "rc_process.h"
+#include "packet_buffer_pool.h"
+#include "executor.h"
+#include "analysis_ladder.h"
+#include "analysis_cache.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH 128 // should be large enough to hold an entire prediction period
@@ -92,6 +96,14 @@ typedef struct EncodeContext {
     // Output Buffer Fifos
     EbFifo *stream_output_fifo_ptr;
     EbFifo *recon_output_fifo_ptr;
+    // Recycled storage for the p_buffer of the output packets
+    PacketBufferPool *packet_buffer_pool;
+    // Slot accounting in the shared executor, NULL when the instance is not attached to one
+    ExecutorClient *executor_client;
+    // Shared lookahead analysis of an ABR ladder, NULL when the instance is not attached to one
+    LadderClient *ladder_client;
+    // Lookahead analysis loaded from / saved to an analysis cache, NULL when neither is used
+    AnalysisCache *analysis_cache;
 
     // Picture Buffer Fifos
     EbFifo *reference_picture_pool_fifo_ptr;
@@ -141,6 +153,11 @@ typedef struct EncodeContext {
     PacketizationReorderEntry **packetization_reorder_queue;
     uint32_t                    packetization_reorder_queue_head_index;
 
+    // Obu streaming: pictures in entropy coding indexed by decode order, their fragments are output in that order
+    EbHandle                  stream_mutex;
+    struct PictureControlSet *stream_pcs[PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+    uint64_t                  stream_next_decode_order;
+
     // GOP Counters
     uint32_t intra_period_position; // Current position in intra period
     uint32_t pred_struct_position; // Current position within a prediction structure
@@ -195,6 +212,10 @@ typedef struct EncodeContext {
     RateControlIntervalParamContext **rc_param_queue;
     int32_t                           rc_param_queue_head_index;
     EbHandle                          rc_param_queue_mutex;
+    // variance boost per base_q_idx and sb variance, a row is built the first time its base_q_idx is used
+    int8_t  *var_boost_lut;
+    bool     var_boost_lut_ready[QINDEX_RANGE];
+    EbHandle var_boost_lut_mutex;
     // reference scaling random access event
     EbRefFrameScale resize_evt;
     //Superblock end index for cycling refresh through the frame.
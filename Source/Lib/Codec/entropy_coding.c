@@ -620,7 +620,7 @@ static EbErrorType av1_encode_tx_coef_y(PictureControlSet *pcs, EntropyCodingCon
                                         NeighborArrayUnit *luma_dc_sign_level_coeff_na) {
     EbErrorType      return_error = EB_ErrorNone;
     bool             is_inter     = is_inter_mode(mbmi->block_mi.mode) || mbmi->block_mi.use_intrabc;
-    const BlockGeom *blk_geom     = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom *blk_geom     = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     const uint8_t    tx_depth     = mbmi->block_mi.tx_depth;
     const uint16_t   txb_count    = blk_geom->txb_count[mbmi->block_mi.tx_depth];
 
@@ -686,7 +686,7 @@ static EbErrorType av1_encode_tx_coef_uv(PictureControlSet *pcs, EntropyCodingCo
                                          NeighborArrayUnit *cb_dc_sign_level_coeff_na) {
     EbErrorType      return_error = EB_ErrorNone;
     int32_t          is_inter     = is_inter_mode(ec_ctx->mbmi->block_mi.mode) || ec_ctx->mbmi->block_mi.use_intrabc;
-    const BlockGeom *blk_geom     = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom *blk_geom     = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
 
     if (!blk_geom->has_uv)
         return return_error;
@@ -826,7 +826,7 @@ static EbErrorType av1_encode_coeff_1d(PictureControlSet *pcs, EntropyCodingCont
                               cb_dc_sign_level_coeff_na);
     } else {
         // Transform partitioning free patch (except the 128x128 case)
-        const BlockGeom *blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
+        const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
         int32_t          cul_level_y, cul_level_cb = 0, cul_level_cr = 0;
 
         const uint8_t tx_depth  = ec_ctx->mbmi->block_mi.tx_depth;
@@ -1048,6 +1048,13 @@ static void encode_partition_av1(PictureControlSet *pcs, FRAME_CONTEXT *frame_co
     if (has_rows && has_cols) {
         aom_write_symbol(
             ec_writer, p, frame_context->partition_cdf[context_index], svt_aom_partition_cdf_length(bsize));
+    } else if (ec_writer->symbol_queue) {
+        // the partition cdf is gathered by the coder, once the symbols before are adapted
+        svt_aom_ec_symbol_push(ec_writer->symbol_queue,
+                               has_cols ? EC_SYMBOL_PARTITION_VERT : EC_SYMBOL_PARTITION_HORZ,
+                               p == PARTITION_SPLIT,
+                               frame_context->partition_cdf[context_index],
+                               (uint8_t)bsize);
     } else if (!has_rows && has_cols) {
         AomCdfProb cdf[CDF_SIZE(2)];
         partition_gather_vert_alike(cdf, frame_context->partition_cdf[context_index], bsize);
@@ -3833,6 +3840,50 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     return return_error;
 }
 
+/**************************************************
+* svt_aom_write_frame_header_obu_av1
+* Frame header as a standalone OBU_FRAME_HEADER, the tiles are sent separately in tile group OBUs
+**************************************************/
+EbErrorType svt_aom_write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
+                                               PictureControlSet *pcs) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
+    uint8_t             *data                 = output_bitstream_ptr->buffer_av1;
+
+    const uint32_t obu_header_size  = write_obu_header(OBU_FRAME_HEADER, 0, data);
+    const uint32_t obu_payload_size = write_frame_header_obu(scs, pcs->ppcs, data + obu_header_size, 0, 1);
+
+    const size_t length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    output_bitstream_ptr->buffer_av1 = data + obu_header_size + obu_payload_size + length_field_size;
+    return EB_ErrorNone;
+}
+
+/**************************************************
+* svt_aom_write_tile_group_obu_av1
+* Single tile OBU_TILE_GROUP for tile_idx, dst must hold the tile size + TILE_GROUP_OBU_MAX_OVERHEAD bytes
+**************************************************/
+uint32_t svt_aom_write_tile_group_obu_av1(PictureControlSet *pcs, uint16_t tile_idx, uint8_t *dst) {
+    Av1Common *const cm           = pcs->ppcs->av1_cm;
+    const int        n_log2_tiles = cm->log2_tile_rows + cm->log2_tile_cols;
+    const uint32_t   tile_size    = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
+    uint8_t          tg_header[4] = {0};
+
+    // the tile group holds a single tile, signal its index when the frame has several tiles
+    const uint32_t tg_header_size   = write_tile_group_header(tg_header, tile_idx, tile_idx, n_log2_tiles, 1);
+    const uint32_t obu_payload_size = tg_header_size + tile_size;
+    const uint32_t obu_header_size  = write_obu_header(OBU_TILE_GROUP, 0, dst);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, dst) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    uint8_t *data = dst + obu_header_size + svt_aom_uleb_size_in_bytes(obu_payload_size);
+    svt_memcpy(data, tg_header, tg_header_size);
+    OutputBitstreamUnit *ec_output_bitstream_ptr = pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
+    svt_memcpy(data + tg_header_size, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
+    return (uint32_t)(data + obu_payload_size - dst);
+}
+
 /**************************************************
 * svt_aom_encode_sps_av1
 **************************************************/
@@ -4088,7 +4139,7 @@ static EbErrorType ec_update_neighbors(PictureControlSet *pcs, EntropyCodingCont
     NeighborArrayUnit *luma_dc_sign_level_coeff_na = pcs->luma_dc_sign_level_coeff_na[tile_idx];
     NeighborArrayUnit *cr_dc_sign_level_coeff_na   = pcs->cr_dc_sign_level_coeff_na[tile_idx];
     NeighborArrayUnit *cb_dc_sign_level_coeff_na   = pcs->cb_dc_sign_level_coeff_na[tile_idx];
-    const BlockGeom   *blk_geom                    = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom   *blk_geom                    = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     MbModeInfo        *mbmi                        = get_mbmi(pcs, blk_org_x, blk_org_y);
     uint8_t            skip_coeff                  = mbmi->block_mi.skip;
     PartitionContext   partition;
@@ -4783,7 +4834,7 @@ static EbErrorType write_modes_b(PictureControlSet *pcs, EntropyCodingContext *e
     NeighborArrayUnit *cr_dc_sign_level_coeff_na   = pcs->cr_dc_sign_level_coeff_na[tile_idx];
     NeighborArrayUnit *cb_dc_sign_level_coeff_na   = pcs->cb_dc_sign_level_coeff_na[tile_idx];
     NeighborArrayUnit *txfm_context_array          = pcs->txfm_context_array[tile_idx];
-    const BlockGeom   *blk_geom                    = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom   *blk_geom                    = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     uint32_t           blk_org_x                   = ec_ctx->sb_origin_x + blk_geom->org_x;
     uint32_t           blk_org_y                   = ec_ctx->sb_origin_y + blk_geom->org_y;
     BlockSize          bsize                       = blk_geom->bsize;
@@ -5276,13 +5327,8 @@ static EbErrorType write_modes_b(PictureControlSet *pcs, EntropyCodingContext *e
     // Update the neighbors
     ec_update_neighbors(pcs, ec_ctx, blk_org_x, blk_org_y, blk_ptr, tile_idx, bsize, coeff_ptr);
 
-    if (svt_av1_allow_palette(pcs->ppcs->palette_level, blk_geom->bsize)) {
-        // free ENCDEC palette info buffer
-        assert(blk_ptr->palette_info->color_idx_map != NULL && "free palette:Null");
-        EB_FREE(blk_ptr->palette_info->color_idx_map);
-        blk_ptr->palette_info->color_idx_map = NULL;
-        EB_FREE(blk_ptr->palette_info);
-    }
+    // the ENCDEC palette info buffer is returned with the picture arena
+    blk_ptr->palette_info = NULL;
 
     return return_error;
 }
@@ -5308,7 +5354,7 @@ EB_EXTERN EbErrorType svt_aom_write_sb(EntropyCodingContext *ec_ctx, SuperBlock
     do {
         bool             code_blk_cond = true; // Code cu only if it is inside the picture
         EcBlkStruct     *blk_ptr       = &tb_ptr->final_blk_arr[final_blk_index];
-        const BlockGeom *blk_geom      = get_blk_geom_mds(blk_index);
+        const BlockGeom *blk_geom      = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_index);
 
         const BlockSize bsize     = blk_geom->bsize;
         const uint32_t  blk_org_x = ec_ctx->sb_origin_x + blk_geom->org_x;
@@ -182,6 +182,12 @@ extern EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetad
                                               const EbAv1MetadataType type);
 extern EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
                                                   PictureControlSet *pcs, uint8_t show_existing);
+// Largest size of the obu header, obu size and tile group header written ahead of the tile data
+#define TILE_GROUP_OBU_MAX_OVERHEAD 16
+// Obu streaming: the frame header and the tile groups of a frame written as separate OBUs
+extern EbErrorType svt_aom_write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
+                                                      PictureControlSet *pcs);
+extern uint32_t    svt_aom_write_tile_group_obu_av1(PictureControlSet *pcs, uint16_t tile_idx, uint8_t *dst);
 extern EbErrorType svt_aom_encode_td_av1(uint8_t *bitstream_ptr);
 extern EbErrorType svt_aom_encode_sps_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs);
 
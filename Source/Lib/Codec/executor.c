@@ -0,0 +1,168 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "executor.h"
+#include "svt_malloc.h"
+#include "svt_threads.h"
+#include "utility.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+struct ExecutorClient {
+    EbSvtAv1Executor *executor;
+    ExecutorClient   *next;
+    EbHandle          semaphore;
+    uint32_t          weight;
+    uint32_t          waiting;
+    uint64_t          vtime;
+};
+
+struct EbSvtAv1Executor {
+    EbHandle        mutex;
+    ExecutorClient *clients;
+    uint32_t        core_count;
+    uint32_t        free_slots;
+    uint32_t        waiting;
+    uint32_t        client_count;
+    uint32_t        total_weight;
+    uint64_t        vtime;
+    bool            destroyed;
+};
+
+static uint32_t get_num_processors(void) {
+#ifdef _WIN32
+    return GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+    return sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+static void executor_free(EbSvtAv1Executor *executor) {
+    EB_DESTROY_MUTEX(executor->mutex);
+    EB_FREE(executor);
+}
+
+EbErrorType svt_aom_executor_create(EbSvtAv1Executor **executor_ptr, uint32_t core_count) {
+    EbSvtAv1Executor *executor;
+    EB_CALLOC(executor, 1, sizeof(*executor));
+    *executor_ptr = executor;
+    EB_CREATE_MUTEX(executor->mutex);
+    executor->core_count = executor->free_slots = core_count ? core_count : MAX(get_num_processors(), 1);
+    return EB_ErrorNone;
+}
+
+void svt_aom_executor_destroy(EbSvtAv1Executor *executor) {
+    svt_block_on_mutex(executor->mutex);
+    executor->destroyed = true;
+    const bool free_now = executor->client_count == 0;
+    svt_release_mutex(executor->mutex);
+    if (free_now)
+        executor_free(executor);
+}
+
+EbErrorType svt_aom_executor_attach(EbSvtAv1Executor *executor, uint32_t priority, ExecutorClient **client_ptr) {
+    ExecutorClient *client;
+    EB_CALLOC(client, 1, sizeof(*client));
+    *client_ptr = client;
+    EB_CREATE_SEMAPHORE(client->semaphore, 0, UINT32_MAX >> 1);
+    client->executor = executor;
+    client->weight   = CLIP3(1, EXECUTOR_MAX_PRIORITY, priority);
+
+    svt_block_on_mutex(executor->mutex);
+    client->vtime     = executor->vtime;
+    client->next      = executor->clients;
+    executor->clients = client;
+    executor->client_count++;
+    executor->total_weight += client->weight;
+    svt_release_mutex(executor->mutex);
+    return EB_ErrorNone;
+}
+
+void svt_aom_executor_detach(ExecutorClient *client) {
+    if (!client)
+        return;
+    EbSvtAv1Executor *executor = client->executor;
+    svt_block_on_mutex(executor->mutex);
+    for (ExecutorClient **it = &executor->clients; *it; it = &(*it)->next) {
+        if (*it == client) {
+            *it = client->next;
+            break;
+        }
+    }
+    executor->waiting -= client->waiting;
+    executor->client_count--;
+    executor->total_weight -= client->weight;
+    const bool free_executor = executor->destroyed && executor->client_count == 0;
+    svt_release_mutex(executor->mutex);
+
+    EB_DESTROY_SEMAPHORE(client->semaphore);
+    EB_FREE(client);
+    if (free_executor)
+        executor_free(executor);
+}
+
+uint32_t svt_aom_executor_core_share(const ExecutorClient *client) {
+    EbSvtAv1Executor *executor = client->executor;
+    svt_block_on_mutex(executor->mutex);
+    const uint32_t share = (executor->core_count * client->weight + executor->total_weight - 1) /
+        executor->total_weight;
+    svt_release_mutex(executor->mutex);
+    return MAX(share, 1);
+}
+
+EbSvtAv1Executor *svt_aom_executor_of(const ExecutorClient *client) { return client->executor; }
+
+// Charges a granted slot to the client, called with the executor mutex held
+static void charge_slot(EbSvtAv1Executor *executor, ExecutorClient *client) {
+    // a client coming back from idle does not get credit for the time it did not use
+    client->vtime   = MAX(client->vtime, executor->vtime);
+    executor->vtime = client->vtime;
+    client->vtime += EXECUTOR_VTIME_SCALE / client->weight;
+}
+
+void svt_aom_executor_acquire(ExecutorClient *client) {
+    if (!client)
+        return;
+    EbSvtAv1Executor *executor = client->executor;
+    svt_block_on_mutex(executor->mutex);
+    if (executor->free_slots && !executor->waiting) {
+        executor->free_slots--;
+        charge_slot(executor, client);
+        svt_release_mutex(executor->mutex);
+        return;
+    }
+    client->waiting++;
+    executor->waiting++;
+    svt_release_mutex(executor->mutex);
+    // the slot is handed over by svt_aom_executor_release()
+    svt_block_on_semaphore(client->semaphore);
+}
+
+void svt_aom_executor_release(ExecutorClient *client) {
+    if (!client)
+        return;
+    EbSvtAv1Executor *executor = client->executor;
+    ExecutorClient   *next     = NULL;
+    svt_block_on_mutex(executor->mutex);
+    for (ExecutorClient *it = executor->clients; it; it = it->next)
+        if (it->waiting && (!next || MAX(it->vtime, executor->vtime) < MAX(next->vtime, executor->vtime)))
+            next = it;
+    if (next) {
+        next->waiting--;
+        executor->waiting--;
+        charge_slot(executor, next);
+    } else
+        executor->free_slots++;
+    svt_release_mutex(executor->mutex);
+    if (next)
+        svt_post_semaphore(next->semaphore);
+}
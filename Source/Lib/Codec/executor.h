@@ -0,0 +1,56 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbExecutor_h
+#define EbExecutor_h
+
+#include "definitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Virtual time charged to an instance of weight 1 for each granted slot
+#define EXECUTOR_VTIME_SCALE (1 << 16)
+#define EXECUTOR_MAX_PRIORITY 64
+
+typedef struct ExecutorClient ExecutorClient;
+
+/*
+ * Process wide executor shared by several encoder instances.
+ *
+ * The kernels of every attached instance hold one of the executor core_count slots while they run a
+ * compute-heavy task (a mode decision, motion estimation or TPL segment), so the instances together
+ * never run more heavy tasks than there are cores. When instances are waiting for a slot, the next
+ * free slot goes to the waiting instance with the lowest virtual time; each grant advances the virtual
+ * time of an instance by EXECUTOR_VTIME_SCALE / priority, so slots are shared in proportion to the
+ * instance priorities. Tasks never block while holding a slot, so the slots cannot deadlock.
+ *
+ * The executor is freed once it has been destroyed and its last client detached.
+ */
+EbErrorType svt_aom_executor_create(EbSvtAv1Executor **executor_ptr, uint32_t core_count);
+void        svt_aom_executor_destroy(EbSvtAv1Executor *executor);
+EbErrorType svt_aom_executor_attach(EbSvtAv1Executor *executor, uint32_t priority, ExecutorClient **client_ptr);
+void        svt_aom_executor_detach(ExecutorClient *client);
+// Number of cores the client gets when all attached clients are busy, at least 1
+uint32_t svt_aom_executor_core_share(const ExecutorClient *client);
+// Executor the client is attached to, valid while the client is attached
+EbSvtAv1Executor *svt_aom_executor_of(const ExecutorClient *client);
+
+// Both are no-ops for a NULL client, i.e. for instances which are not attached to an executor
+void svt_aom_executor_acquire(ExecutorClient *client);
+void svt_aom_executor_release(ExecutorClient *client);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbExecutor_h
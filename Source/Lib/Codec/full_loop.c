@@ -2681,16 +2681,16 @@ static void compute_depth_costs(ModeDecisionContext *ctx, PictureParentControlSe
     * anyway (as they are completely outside the picture).  If the block does have area inside the picture, it will have
     * a cost, and if the cost is not valid, that partition scheme cannot be selected.
     */
-    const BlockGeom *curr_blk_geom = get_blk_geom_mds(curr_depth_blk0_mds);
+    const BlockGeom *curr_blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, curr_depth_blk0_mds);
     const bool blk0_within_pic     = (pcs->sb_geom[ctx->sb_index].org_x + curr_blk_geom->org_x < pcs->aligned_width) &&
         (pcs->sb_geom[ctx->sb_index].org_y + curr_blk_geom->org_y < pcs->aligned_height);
-    curr_blk_geom              = get_blk_geom_mds(curr_depth_blk1_mds);
+    curr_blk_geom              = get_blk_geom_mds(pcs->scs->blk_geom_mds, curr_depth_blk1_mds);
     const bool blk1_within_pic = (pcs->sb_geom[ctx->sb_index].org_x + curr_blk_geom->org_x < pcs->aligned_width) &&
         (pcs->sb_geom[ctx->sb_index].org_y + curr_blk_geom->org_y < pcs->aligned_height);
-    curr_blk_geom              = get_blk_geom_mds(curr_depth_blk2_mds);
+    curr_blk_geom              = get_blk_geom_mds(pcs->scs->blk_geom_mds, curr_depth_blk2_mds);
     const bool blk2_within_pic = (pcs->sb_geom[ctx->sb_index].org_x + curr_blk_geom->org_x < pcs->aligned_width) &&
         (pcs->sb_geom[ctx->sb_index].org_y + curr_blk_geom->org_y < pcs->aligned_height);
-    curr_blk_geom              = get_blk_geom_mds(curr_depth_blk3_mds);
+    curr_blk_geom              = get_blk_geom_mds(pcs->scs->blk_geom_mds, curr_depth_blk3_mds);
     const bool blk3_within_pic = (pcs->sb_geom[ctx->sb_index].org_x + curr_blk_geom->org_x < pcs->aligned_width) &&
         (pcs->sb_geom[ctx->sb_index].org_y + curr_blk_geom->org_y < pcs->aligned_height);
 
@@ -2736,47 +2736,60 @@ static void compute_depth_costs(ModeDecisionContext *ctx, PictureParentControlSe
  * of a given depth have been evaluted.
  */
 uint32_t svt_aom_d2_inter_depth_block_decision(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t blk_mds) {
+    // Only the last block of a depth completes the decisions of its parents
+    if (ctx->md_blk_arr_nsq[blk_mds].split_flag)
+        return blk_mds;
+    return svt_aom_d2_inter_depth_parent_decision(pcs, ctx, blk_mds);
+}
+
+/*
+ * Perform the inter-depth decisions of the parents of blk_mds, for as long as the current block is the last quadrant
+ * of its parent. The decisions stop below parents larger than ctx->d2_max_parent_size, in which case the block at
+ * which they stopped is saved in ctx->d2_resume_mds.
+ */
+uint32_t svt_aom_d2_inter_depth_parent_decision(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t blk_mds) {
     uint64_t         parent_depth_cost = 0, current_depth_cost = 0;
-    bool             last_depth_flag = (ctx->md_blk_arr_nsq[blk_mds].split_flag == false);
     uint32_t         last_blk_index = blk_mds, current_depth_idx_mds = blk_mds;
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_mds);
-    if (last_depth_flag) {
-        while (blk_geom->is_last_quadrant) {
-            //get parent idx
-            uint32_t parent_depth_idx_mds = blk_geom->parent_depth_idx_mds;
-            compute_depth_costs(ctx,
-                                pcs->ppcs,
-                                current_depth_idx_mds,
-                                parent_depth_idx_mds,
-                                blk_geom->ns_depth_offset,
-                                &parent_depth_cost,
-                                &current_depth_cost);
-            if (ctx->inter_depth_bias && current_depth_cost != MAX_MODE_COST) {
-                current_depth_cost = (current_depth_cost * ctx->inter_depth_bias) / 1000;
-            }
-            int parent_bias = parent_depth_cost != MAX_MODE_COST ? ctx->d2_parent_bias : 1000;
-            if (parent_depth_cost == MAX_MODE_COST && current_depth_cost == MAX_MODE_COST) {
-                // If parent and current depth are both invalid, don't update the cost
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].part       = PARTITION_SPLIT;
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].split_flag = true;
-            } else if (((parent_bias * parent_depth_cost) / 1000) <= current_depth_cost) {
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].split_flag = false;
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].cost       = parent_depth_cost;
-                last_blk_index                                       = parent_depth_idx_mds;
-                ctx->cost_avail[parent_depth_idx_mds]                = 1;
-                assert(parent_depth_cost != MAX_MODE_COST);
-            } else {
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].cost       = current_depth_cost;
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].part       = PARTITION_SPLIT;
-                ctx->md_blk_arr_nsq[parent_depth_idx_mds].split_flag = true;
-                ctx->cost_avail[parent_depth_idx_mds]                = 1;
-                assert(current_depth_cost != MAX_MODE_COST);
-            }
-
-            //setup next parent inter depth
-            blk_geom              = get_blk_geom_mds(parent_depth_idx_mds);
-            current_depth_idx_mds = parent_depth_idx_mds;
+    const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_mds);
+    while (blk_geom->is_last_quadrant) {
+        if ((blk_geom->sq_size << 1) > ctx->d2_max_parent_size) {
+            ctx->d2_resume_mds = current_depth_idx_mds;
+            break;
+        }
+        //get parent idx
+        uint32_t parent_depth_idx_mds = blk_geom->parent_depth_idx_mds;
+        compute_depth_costs(ctx,
+                            pcs->ppcs,
+                            current_depth_idx_mds,
+                            parent_depth_idx_mds,
+                            blk_geom->ns_depth_offset,
+                            &parent_depth_cost,
+                            &current_depth_cost);
+        if (ctx->inter_depth_bias && current_depth_cost != MAX_MODE_COST) {
+            current_depth_cost = (current_depth_cost * ctx->inter_depth_bias) / 1000;
         }
+        int parent_bias = parent_depth_cost != MAX_MODE_COST ? ctx->d2_parent_bias : 1000;
+        if (parent_depth_cost == MAX_MODE_COST && current_depth_cost == MAX_MODE_COST) {
+            // If parent and current depth are both invalid, don't update the cost
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].part       = PARTITION_SPLIT;
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].split_flag = true;
+        } else if (((parent_bias * parent_depth_cost) / 1000) <= current_depth_cost) {
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].split_flag = false;
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].cost       = parent_depth_cost;
+            last_blk_index                                       = parent_depth_idx_mds;
+            ctx->cost_avail[parent_depth_idx_mds]                = 1;
+            assert(parent_depth_cost != MAX_MODE_COST);
+        } else {
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].cost       = current_depth_cost;
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].part       = PARTITION_SPLIT;
+            ctx->md_blk_arr_nsq[parent_depth_idx_mds].split_flag = true;
+            ctx->cost_avail[parent_depth_idx_mds]                = 1;
+            assert(current_depth_cost != MAX_MODE_COST);
+        }
+
+        //setup next parent inter depth
+        blk_geom              = get_blk_geom_mds(pcs->scs->blk_geom_mds, parent_depth_idx_mds);
+        current_depth_idx_mds = parent_depth_idx_mds;
     }
 
     return last_blk_index;
@@ -642,6 +642,71 @@ static void set_frame_coeff_lvl(PictureControlSet *pcs) {
     }
 }
 
+/* Restrict the CDEF search of an inter picture to the ref_prior_top_k first pass primary strengths closest to
+the strengths selected by its nearest references, and to the second pass strengths built on the kept primaries.
+The first filter (off) is always kept. */
+static void cdef_restrict_to_ref_prior(PictureControlSet *pcs, CdefSearchControls *cdef_ctrls) {
+    const int first_pass_fs_num = cdef_ctrls->first_pass_fs_num;
+    const int top_k             = cdef_ctrls->ref_prior_top_k;
+    if (pcs->slice_type == I_SLICE || !top_k || top_k >= first_pass_fs_num)
+        return;
+
+    // Primary strengths selected by the list0 (and list1) references, luma and chroma
+    bool prior_pri[CDEF_PRI_STRENGTHS] = {false};
+    bool has_prior                     = false;
+    for (int list = REF_LIST_0; list <= (pcs->slice_type == B_SLICE ? REF_LIST_1 : REF_LIST_0); list++) {
+        EbReferenceObject *ref_obj = (EbReferenceObject *)pcs->ref_pic_ptr_array[list][0]->object_ptr;
+        for (uint8_t fs = 0; fs < ref_obj->ref_cdef_strengths_num; fs++) {
+            prior_pri[ref_obj->ref_cdef_strengths[0][fs] / CDEF_SEC_STRENGTHS] = true;
+            prior_pri[ref_obj->ref_cdef_strengths[1][fs] / CDEF_SEC_STRENGTHS] = true;
+            has_prior                                                          = true;
+        }
+    }
+    if (!has_prior)
+        return;
+
+    // Distance of each first pass primary strength to the closest prior one
+    int dist[TOTAL_STRENGTHS];
+    for (int gi = 0; gi < first_pass_fs_num; gi++) {
+        const int pri = cdef_ctrls->default_first_pass_fs[gi] / CDEF_SEC_STRENGTHS;
+        dist[gi]      = CDEF_PRI_STRENGTHS;
+        for (int p = 0; p < CDEF_PRI_STRENGTHS; p++)
+            if (prior_pri[p])
+                dist[gi] = MIN(dist[gi], ABS(pri - p));
+    }
+    // Keep the off filter and the top_k - 1 closest primaries; the lower strength wins ties
+    bool keep[TOTAL_STRENGTHS] = {false};
+    keep[0]                    = true;
+    for (int k = 1; k < top_k; k++) {
+        int best = -1;
+        for (int gi = 1; gi < first_pass_fs_num; gi++)
+            if (!keep[gi] && (best < 0 || dist[gi] < dist[best]))
+                best = gi;
+        keep[best] = true;
+    }
+
+    bool    kept_pri[CDEF_PRI_STRENGTHS] = {false};
+    uint8_t fs_num                       = 0;
+    for (int gi = 0; gi < first_pass_fs_num; gi++) {
+        if (!keep[gi])
+            continue;
+        kept_pri[cdef_ctrls->default_first_pass_fs[gi] / CDEF_SEC_STRENGTHS] = true;
+        cdef_ctrls->default_first_pass_fs[fs_num]                           = cdef_ctrls->default_first_pass_fs[gi];
+        cdef_ctrls->default_first_pass_fs_uv[fs_num]                        = cdef_ctrls->default_first_pass_fs_uv[gi];
+        fs_num++;
+    }
+    cdef_ctrls->first_pass_fs_num = fs_num;
+    fs_num                        = 0;
+    for (int gi = 0; gi < cdef_ctrls->default_second_pass_fs_num; gi++) {
+        if (!kept_pri[cdef_ctrls->default_second_pass_fs[gi] / CDEF_SEC_STRENGTHS])
+            continue;
+        cdef_ctrls->default_second_pass_fs[fs_num]    = cdef_ctrls->default_second_pass_fs[gi];
+        cdef_ctrls->default_second_pass_fs_uv[fs_num] = cdef_ctrls->default_second_pass_fs_uv[gi];
+        fs_num++;
+    }
+    cdef_ctrls->default_second_pass_fs_num = fs_num;
+}
+
 /* Mode Decision Configuration Kernel */
 
 /*********************************************************************************
@@ -741,6 +806,10 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
         FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
 
         pcs->rtc_tune = (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
+        // A superres recode sends the picture through again, drop the data of the previous pass, so its first
+        // coding pass is a full one
+        svt_aom_arena_reset(pcs->arena);
+        pcs->ppcs->recode_reuse_blocks = 0;
         // Mode Decision Configuration Kernel Signal(s) derivation
         svt_aom_sig_deriv_mode_decision_config(scs, pcs);
 
@@ -960,7 +1029,8 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
                     if (cdef_ctrls->first_pass_fs_num == 1)
                         pcs->ppcs->cdef_level = 0;
                 }
-            }
+            } else
+                cdef_restrict_to_ref_prior(pcs, cdef_ctrls);
         }
 
         if (scs->vq_ctrls.sharpness_ctrls.restoration && pcs->ppcs->is_noise_level) {
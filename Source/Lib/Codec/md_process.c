@@ -58,6 +58,7 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_FREE_ALIGNED_ARRAY(obj->cfl_temp_luma_recon);
     EB_FREE_ALIGNED_ARRAY(obj->pred_buf_q3);
     EB_FREE_ARRAY(obj->fast_cand_array);
+    EB_FREE_ARRAY(obj->fast_cand_class_array);
     EB_FREE_ARRAY(obj->fast_cand_ptr_array);
     EB_FREE_2D(obj->injected_mvs);
     EB_FREE_ARRAY(obj->injected_ref_types);
@@ -113,6 +114,8 @@ static void mode_decision_context_dctor(EbPtr p) {
     }
     EB_DELETE(obj->tx_coeffs);
     EB_DELETE(obj->scratch_prediction_ptr);
+    for (int i = 0; i < INTER_PRED_CACHE_SIZE; i++)
+        EB_DELETE(obj->inter_pred_cache.entries[i].pred);
     EB_DELETE(obj->temp_residual);
     EB_DELETE(obj->temp_recon_ptr);
     EB_FREE_ARRAY(obj->full_cost_ssim_array);
@@ -125,7 +128,8 @@ void svt_aom_set_nics(NicScalingCtrls *scaling_ctrls, uint32_t mds1_count[CAND_C
  * Mode Decision Context Constructor
  ******************************************************/
 EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColorFormat color_format, uint8_t sb_size,
-                                               EncMode enc_mode, uint16_t max_block_cnt, uint32_t encoder_bit_depth,
+                                               EncMode enc_mode, const BlockGeom *blk_geom_mds, uint16_t max_block_cnt,
+                                               uint32_t encoder_bit_depth,
                                                EbFifo *mode_decision_configuration_input_fifo_ptr,
                                                EbFifo *mode_decision_output_fifo_ptr, uint8_t enable_hbd_mode_decision,
                                                uint8_t cfg_palette, uint8_t seq_qp_mod) {
@@ -137,6 +141,10 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
 
     ctx->sb_size = sb_size;
     (void)color_format;
+    // Contexts decide whole SBs unless set up as a PD0 quadrant helper
+    ctx->md_na_idx          = MD_NEIGHBOR_ARRAY_INDEX;
+    ctx->nsq_na_idx         = MD_NEIGHBOR_ARRAY_INDEX + 1;
+    ctx->d2_max_parent_size = sb_size;
 
     ctx->dctor  = mode_decision_context_dctor;
     ctx->hbd_md = enable_hbd_mode_decision;
@@ -251,6 +259,7 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
     // Fast Candidate Array
     uint16_t max_can_count = svt_aom_get_max_can_count(enc_mode) + ind_uv_cands;
     EB_MALLOC_ARRAY(ctx->fast_cand_array, max_can_count);
+    EB_MALLOC_ARRAY(ctx->fast_cand_class_array, max_can_count);
 
     EB_MALLOC_ARRAY(ctx->fast_cand_ptr_array, max_can_count);
     svt_aom_assert_err(max_can_count > ind_uv_cands, "Max. candidates is too low");
@@ -353,7 +362,7 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
     for (coded_leaf_index = 0; coded_leaf_index < block_max_count_sb; ++coded_leaf_index) {
         ctx->md_blk_arr_nsq[coded_leaf_index].av1xd      = ctx->md_blk_arr_nsq[0].av1xd + coded_leaf_index;
         ctx->md_blk_arr_nsq[coded_leaf_index].segment_id = 0;
-        const BlockGeom *blk_geom                        = get_blk_geom_mds(coded_leaf_index);
+        const BlockGeom *blk_geom                        = get_blk_geom_mds(blk_geom_mds, coded_leaf_index);
 
         if (svt_aom_get_bypass_encdec(enc_mode, encoder_bit_depth)) {
             EbPictureBufferDescInitData init_data;
@@ -433,6 +442,13 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
     }
     EB_NEW(ctx->tx_coeffs, svt_picture_buffer_desc_ctor, (EbPtr)&thirty_two_width_picture_buffer_desc_init_data);
     EB_NEW(ctx->scratch_prediction_ptr, svt_picture_buffer_desc_ctor, (EbPtr)&picture_buffer_desc_init_data);
+    picture_buffer_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    for (int i = 0; i < INTER_PRED_CACHE_SIZE; i++)
+        EB_NEW(ctx->inter_pred_cache.entries[i].pred,
+               svt_picture_buffer_desc_ctor,
+               (EbPtr)&picture_buffer_desc_init_data);
+    ctx->inter_pred_cache.generation                 = 1;
+    picture_buffer_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
     EbPictureBufferDescInitData double_width_picture_buffer_desc_init_data;
     double_width_picture_buffer_desc_init_data.max_width          = sb_size;
     double_width_picture_buffer_desc_init_data.max_height         = sb_size;
@@ -487,7 +503,7 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
  *************************************************/
 void svt_aom_reset_mode_decision_neighbor_arrays(PictureControlSet *pcs, uint16_t tile_idx) {
     uint8_t depth;
-    for (depth = 0; depth < NA_TOT_CNT; depth++) {
+    for (depth = 0; depth < pcs->md_na_count; depth++) {
         svt_aom_neighbor_array_unit_reset(pcs->mdleaf_partition_na[depth][tile_idx]);
         if (pcs->hbd_md != EB_10_BIT_MD) {
             svt_aom_neighbor_array_unit_reset(pcs->md_luma_recon_na[depth][tile_idx]);
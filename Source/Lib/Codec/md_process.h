@@ -887,6 +887,26 @@ typedef struct CompoundPredictionStore {
     uint8_t *pred1_buf[4];
     IntMv    pred1_mv[4];
 } CompoundPredictionStore;
+#define INTER_PRED_CACHE_SIZE 4
+typedef struct InterPredCacheEntry {
+    // luma prediction of the block at its position in the SB
+    EbPictureBufferDesc *pred;
+    // hash of the block, the reference pictures and the motion parameters of the prediction
+    uint64_t key;
+    uint32_t generation;
+} InterPredCacheEntry;
+/*
+ * Luma inter predictions of the current block, so a prediction built during the interpolation filter search is
+ * not built again for the selected filter. The entries are replaced in round robin order, and the generation is
+ * bumped at the start of each SB MD pass.
+ */
+typedef struct InterPredCache {
+    InterPredCacheEntry entries[INTER_PRED_CACHE_SIZE];
+    uint32_t            generation;
+    uint8_t             next;
+    uint64_t            lookups;
+    uint64_t            hits;
+} InterPredCache;
 
 typedef struct ModeDecisionContext {
     EbDctor dctor;
@@ -895,6 +915,8 @@ typedef struct ModeDecisionContext {
     EbFifo                       *mode_decision_output_fifo_ptr;
     ModeDecisionCandidate       **fast_cand_ptr_array;
     ModeDecisionCandidate        *fast_cand_array;
+    // cand_class of each fast_cand_array entry, packed so the per class scans of MDS0 do not walk the candidates
+    uint8_t                      *fast_cand_class_array;
     ModeDecisionCandidateBuffer **cand_bf_ptr_array;
     ModeDecisionCandidateBuffer  *cand_bf_tx_depth_1;
     ModeDecisionCandidateBuffer  *cand_bf_tx_depth_2;
@@ -905,6 +927,17 @@ typedef struct ModeDecisionContext {
     uint8_t                      *cost_avail;
     MdcSbData                     mdc_sb_array;
     bool                          copied_neigh_arrays;
+    // Neighbor array sets of the context: the MD set and the scratch set used to restore it after NSQ shapes
+    uint8_t                       md_na_idx;
+    uint8_t                       nsq_na_idx;
+    // Largest parent block whose split is decided by the inter-depth (d2) decision, smaller than the SB for
+    // the PD0 quadrant helpers, which leave the SB level decision to the context of the SB
+    uint8_t                       d2_max_parent_size;
+    // Block at which the d2 decisions stopped because of d2_max_parent_size
+    uint32_t                      d2_resume_mds;
+    // Set while the PD0 quadrants of the SB are decided in parallel: the mode info map is shared between the
+    // quadrants, so the blocks do not update it
+    bool                          skip_mi_map_update;
     MvReferenceFrame              ref_frame_type_arr[MODE_CTX_REF_FRAMES];
     uint8_t                       tot_ref_frame_types;
 
@@ -1031,6 +1064,7 @@ typedef struct ModeDecisionContext {
     uint16_t tile_index;
     // Store buffers for inter-inter compound search
     CompoundPredictionStore cmp_store;
+    InterPredCache          inter_pred_cache;
 
     uint8_t  *pred0;
     uint8_t  *pred1;
@@ -1257,9 +1291,10 @@ typedef void (*EbAv1LambdaAssignFunc)(PictureControlSet *pcs, uint32_t *fast_lam
  * Extern Function Declarations
  **************************************/
 extern EbErrorType svt_aom_mode_decision_context_ctor(
-    ModeDecisionContext *ctx, EbColorFormat color_format, uint8_t sb_size, EncMode enc_mode, uint16_t max_block_cnt,
-    uint32_t encoder_bit_depth, EbFifo *mode_decision_configuration_input_fifo_ptr,
-    EbFifo *mode_decision_output_fifo_ptr, uint8_t enable_hbd_mode_decision, uint8_t cfg_palette, uint8_t seq_qp_mod);
+    ModeDecisionContext *ctx, EbColorFormat color_format, uint8_t sb_size, EncMode enc_mode,
+    const BlockGeom *blk_geom_mds, uint16_t max_block_cnt, uint32_t encoder_bit_depth,
+    EbFifo *mode_decision_configuration_input_fifo_ptr, EbFifo *mode_decision_output_fifo_ptr,
+    uint8_t enable_hbd_mode_decision, uint8_t cfg_palette, uint8_t seq_qp_mod);
 
 extern const EbAv1LambdaAssignFunc svt_aom_av1_lambda_assignment_function_table[4];
 
@@ -19,6 +19,7 @@
 #include "bitstream_unit.h"
 #include "rd_cost.h"
 #include "inter_prediction.h"
+#include "aom_dsp_rtcd.h"
 
 static INLINE int32_t get_interinter_wedge_bits(BlockSize bsize) {
     const int32_t wbits = svt_aom_get_wedge_params_bits(bsize);
@@ -43,9 +44,9 @@ static INLINE int32_t av1_cost_symbol(AomCdfProb p15) {
 }
 
 /*************************************************************
-* svt_aom_get_syntax_rate_from_cdf
+* svt_aom_get_syntax_rate_from_cdf_c
 **************************************************************/
-void svt_aom_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map) {
+void svt_aom_get_syntax_rate_from_cdf_c(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map) {
     int32_t    i;
     AomCdfProb prev_cdf = 0;
     for (i = 0;; ++i) {
@@ -63,6 +64,16 @@ void svt_aom_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, con
             break;
     }
 }
+
+/* Records the CDFs the rate tables are derived from, returns true when they differ from the ones the tables were last
+ * derived from. The tables must then be rederived. */
+static INLINE bool rate_cdf_changed(void *rate_cdf, const void *cdf, size_t size) {
+    if (!memcmp(rate_cdf, cdf, size))
+        return false;
+    memcpy(rate_cdf, cdf, size);
+    return true;
+}
+#define RATE_CDF_CHANGED(ctx, fc, field) rate_cdf_changed(&(ctx)->rate_fc.field, &(fc)->field, sizeof((fc)->field))
 /*************************************************************
  * svt_aom_estimate_syntax_rate()
  * Estimate the rate for each syntax elements and for
@@ -71,10 +82,14 @@ void svt_aom_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, con
 void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, bool is_i_slice,
                                   uint8_t pic_filter_intra_level, uint8_t allow_screen_content_tools,
                                   uint8_t enable_restoration, uint8_t allow_intrabc, FRAME_CONTEXT *fc) {
-    int32_t i, j;
+    int32_t    i, j;
+    const bool all = !md_rate_est_ctx->syntax_rate_valid;
 
-    md_rate_est_ctx->initialized = 1;
+    md_rate_est_ctx->initialized       = 1;
+    md_rate_est_ctx->syntax_rate_valid = true;
     for (i = 0; i < PARTITION_CONTEXTS; ++i) {
+        if (!RATE_CDF_CHANGED(md_rate_est_ctx, fc, partition_cdf[i]) && !all)
+            continue;
         svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_fac_bits[i], fc->partition_cdf[i], NULL);
 
         AomCdfProb cdf[CDF_SIZE(2)];
@@ -122,89 +137,114 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, bool
     }
 
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, skip_mode_cdfs[i]) || all)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
 
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, skip_cdfs[i]) || all)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
     for (i = 0; i < KF_MODE_CONTEXTS; ++i)
         for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, kf_y_cdf[i][j]) || all)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
 
     for (i = 0; i < BlockSize_GROUPS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, y_mode_cdf[i]) || all)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
 
     for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
         for (j = 0; j < INTRA_MODES; ++j)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->intra_uv_mode_fac_bits[i][j], fc->uv_mode_cdf[i][j], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, uv_mode_cdf[i][j]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->intra_uv_mode_fac_bits[i][j], fc->uv_mode_cdf[i][j], NULL);
     }
     if (pic_filter_intra_level) {
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, filter_intra_mode_cdf) || all)
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i) {
-            if (svt_aom_filter_intra_allowed_bsize(i))
+            if (svt_aom_filter_intra_allowed_bsize(i) &&
+                (RATE_CDF_CHANGED(md_rate_est_ctx, fc, filter_intra_cdfs[i]) || all))
                 svt_aom_get_syntax_rate_from_cdf(
                     md_rate_est_ctx->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
         }
     }
     for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(
-            md_rate_est_ctx->switchable_interp_fac_bitss[i], fc->switchable_interp_cdf[i], NULL);
-    if (allow_screen_content_tools) {
-        for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, switchable_interp_cdf[i]) || all)
             svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->palette_uv_size_fac_bits[i], fc->palette_uv_size_cdf[i], NULL);
-            for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
+                md_rate_est_ctx->switchable_interp_fac_bitss[i], fc->switchable_interp_cdf[i], NULL);
+    if (allow_screen_content_tools) {
+        for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, palette_y_size_cdf[i]) || all)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->palette_ymode_fac_bits[i][j], fc->palette_y_mode_cdf[i][j], NULL);
-        }
+                    md_rate_est_ctx->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
+        for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, palette_uv_size_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->palette_uv_size_fac_bits[i], fc->palette_uv_size_cdf[i], NULL);
+        for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
+            for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, palette_y_mode_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->palette_ymode_fac_bits[i][j], fc->palette_y_mode_cdf[i][j], NULL);
 
         for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->palette_uv_mode_fac_bits[i], fc->palette_uv_mode_cdf[i], NULL);
-        for (i = 0; i < PALETTE_SIZES; ++i) {
-            for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, palette_uv_mode_cdf[i]) || all)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->palette_ycolor_fac_bitss[i][j], fc->palette_y_color_index_cdf[i][j], NULL);
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->palette_uv_color_fac_bits[i][j], fc->palette_uv_color_index_cdf[i][j], NULL);
-            }
-        }
+                    md_rate_est_ctx->palette_uv_mode_fac_bits[i], fc->palette_uv_mode_cdf[i], NULL);
+        for (i = 0; i < PALETTE_SIZES; ++i)
+            for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j)
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, palette_y_color_index_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->palette_ycolor_fac_bitss[i][j], fc->palette_y_color_index_cdf[i][j], NULL);
+        for (i = 0; i < PALETTE_SIZES; ++i)
+            for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j)
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, palette_uv_color_index_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->palette_uv_color_fac_bits[i][j], fc->palette_uv_color_index_cdf[i][j], NULL);
     }
-    int32_t sign_fac_bits[CFL_JOINT_SIGNS];
-    svt_aom_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
-    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-        int32_t *fac_bits_u = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
-        int32_t *fac_bits_v = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
-        if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
-        else {
-            const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-            svt_aom_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
-        }
-        if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
-        else {
-            assert((CFL_CONTEXT_V(joint_sign) < CFL_ALPHA_CONTEXTS) && (CFL_CONTEXT_V(joint_sign) >= 0));
-            const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
-            svt_aom_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+    // the sign cost is added to the costs of both alphas, both cdfs are recorded
+    if ((RATE_CDF_CHANGED(md_rate_est_ctx, fc, cfl_sign_cdf) | RATE_CDF_CHANGED(md_rate_est_ctx, fc, cfl_alpha_cdf)) ||
+        all) {
+        int32_t sign_fac_bits[CFL_JOINT_SIGNS];
+        svt_aom_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
+        for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+            int32_t *fac_bits_u = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
+            int32_t *fac_bits_v = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
+            if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
+            else {
+                const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+                svt_aom_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
+            }
+            if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
+            else {
+                assert((CFL_CONTEXT_V(joint_sign) < CFL_ALPHA_CONTEXTS) && (CFL_CONTEXT_V(joint_sign) >= 0));
+                const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
+                svt_aom_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+            }
+            for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
         }
-        for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
     }
 
     for (i = 0; i < MAX_TX_CATS; ++i)
         for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, tx_size_cdf[i][j]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
 
     for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, txfm_partition_cdf[i]) || all)
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
     }
 
     for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
         int32_t s;
         for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
-            if (use_inter_ext_tx_for_txsize[s][i])
+            if (use_inter_ext_tx_for_txsize[s][i] &&
+                (RATE_CDF_CHANGED(md_rate_est_ctx, fc, inter_ext_tx_cdf[s][i]) || all))
                 svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->inter_tx_type_fac_bits[s][i],
                                                  fc->inter_ext_tx_cdf[s][i],
                                                  av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
@@ -212,91 +252,124 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, bool
         for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
             if (use_intra_ext_tx_for_txsize[s][i]) {
                 for (j = 0; j < INTRA_MODES; ++j)
-                    svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intra_tx_type_fac_bits[s][i][j],
-                                                     fc->intra_ext_tx_cdf[s][i][j],
-                                                     av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+                    if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, intra_ext_tx_cdf[s][i][j]) || all)
+                        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intra_tx_type_fac_bits[s][i][j],
+                                                         fc->intra_ext_tx_cdf[s][i][j],
+                                                         av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
             }
         }
     }
     for (i = 0; i < DIRECTIONAL_MODES; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, angle_delta_cdf[i]) || all)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
     if (enable_restoration) {
-        svt_aom_get_syntax_rate_from_cdf(
-            md_rate_est_ctx->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, switchable_restore_cdf) || all)
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, wiener_restore_cdf) || all)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, sgrproj_restore_cdf) || all)
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
     }
     if (allow_intrabc) {
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intrabc_fac_bits, fc->intrabc_cdf, NULL);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, intrabc_cdf) || all)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intrabc_fac_bits, fc->intrabc_cdf, NULL);
     }
 
     if (!is_i_slice) { // NM - Hardcoded to true
         for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, comp_inter_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < SINGLE_REFS - 1; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->single_ref_fac_bits[i][j], fc->single_ref_cdf[i][j], NULL);
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, single_ref_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->single_ref_fac_bits[i][j], fc->single_ref_cdf[i][j], NULL);
         }
 
         for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->comp_ref_type_fac_bits[i], fc->comp_ref_type_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, comp_ref_type_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->comp_ref_type_fac_bits[i], fc->comp_ref_type_cdf[i], NULL);
         for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
             for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->uni_comp_ref_fac_bits[i][j], fc->uni_comp_ref_cdf[i][j], NULL);
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, uni_comp_ref_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->uni_comp_ref_fac_bits[i][j], fc->uni_comp_ref_cdf[i][j], NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < FWD_REFS - 1; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->comp_ref_fac_bits[i][j], fc->comp_ref_cdf[i][j], NULL);
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, comp_ref_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->comp_ref_fac_bits[i][j], fc->comp_ref_cdf[i][j], NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < BWD_REFS - 1; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->comp_bwd_ref_fac_bits[i][j], fc->comp_bwdref_cdf[i][j], NULL);
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, comp_bwdref_cdf[i][j]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->comp_bwd_ref_fac_bits[i][j], fc->comp_bwdref_cdf[i][j], NULL);
         }
 
         for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, intra_inter_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
         for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, newmv_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
         for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, zeromv_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
         for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, refmv_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
         for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, drl_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
         for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->inter_compound_mode_fac_bits[i], fc->inter_compound_mode_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, inter_compound_mode_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->inter_compound_mode_fac_bits[i], fc->inter_compound_mode_cdf[i], NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->compound_type_fac_bits[i], fc->compound_type_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, compound_type_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->compound_type_fac_bits[i], fc->compound_type_cdf[i], NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i) {
-            if (get_interinter_wedge_bits((BlockSize)i))
+            if (get_interinter_wedge_bits((BlockSize)i) &&
+                (RATE_CDF_CHANGED(md_rate_est_ctx, fc, wedge_idx_cdf[i]) || all))
                 svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
         }
-        for (i = 0; i < BlockSize_GROUPS; ++i) {
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->inter_intra_mode_fac_bits[i], fc->interintra_mode_cdf[i], NULL);
-        }
+        for (i = 0; i < BlockSize_GROUPS; ++i)
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, interintra_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
+        for (i = 0; i < BlockSize_GROUPS; ++i)
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, interintra_mode_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->inter_intra_mode_fac_bits[i], fc->interintra_mode_cdf[i], NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->wedge_inter_intra_fac_bits[i], fc->wedge_interintra_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, wedge_interintra_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->wedge_inter_intra_fac_bits[i], fc->wedge_interintra_cdf[i], NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, motion_mode_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, obmc_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
         for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, compound_index_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
         for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->comp_group_idx_fac_bits[i], fc->comp_group_idx_cdf[i], NULL);
+            if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, comp_group_idx_cdf[i]) || all)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->comp_group_idx_fac_bits[i], fc->comp_group_idx_cdf[i], NULL);
     }
 }
 
@@ -359,6 +432,7 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
         memset(pcs->ppcs->scs->nmv_costs, 0, sizeof(int32_t) * MV_VALS * 2);
         md_rate_est_ctx->nmvcoststack[0] = &pcs->ppcs->scs->nmv_costs[0][MV_MAX];
         md_rate_est_ctx->nmvcoststack[1] = &pcs->ppcs->scs->nmv_costs[1][MV_MAX];
+        md_rate_est_ctx->mv_rate_valid = false;
         return;
     }
     int32_t     *nmvcost[2];
@@ -371,10 +445,14 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
     nmvcost_hp[1]                   = &md_rate_est_ctx->nmv_costs_hp[1][MV_MAX];
     uint8_t allow_high_precision_mv = pcs->ppcs->bypass_cost_table_gen ? 0 : frm_hdr->allow_high_precision_mv;
     if (!pcs->ppcs->bypass_cost_table_gen) {
-        svt_av1_build_nmv_cost_table(md_rate_est_ctx->nmv_vec_cost, // out
-                                     allow_high_precision_mv ? nmvcost_hp : nmvcost, // out
-                                     &fc->nmvc,
-                                     allow_high_precision_mv);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, nmvc) || !md_rate_est_ctx->mv_rate_valid ||
+            md_rate_est_ctx->mv_rate_hp != allow_high_precision_mv)
+            svt_av1_build_nmv_cost_table(md_rate_est_ctx->nmv_vec_cost, // out
+                                         allow_high_precision_mv ? nmvcost_hp : nmvcost, // out
+                                         &fc->nmvc,
+                                         allow_high_precision_mv);
+        md_rate_est_ctx->mv_rate_valid = true;
+        md_rate_est_ctx->mv_rate_hp    = allow_high_precision_mv;
         md_rate_est_ctx->nmvcoststack[0] = allow_high_precision_mv ? &md_rate_est_ctx->nmv_costs_hp[0][MV_MAX]
                                                                    : &md_rate_est_ctx->nmv_costs[0][MV_MAX];
         md_rate_est_ctx->nmvcoststack[1] = allow_high_precision_mv ? &md_rate_est_ctx->nmv_costs_hp[1][MV_MAX]
@@ -386,6 +464,7 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
             pcs->ppcs->scs->mvrate_set = 1;
         }
     } else {
+        md_rate_est_ctx->mv_rate_valid = false;
         memcpy(md_rate_est_ctx->nmv_vec_cost, pcs->ppcs->scs->nmv_vec_cost, sizeof(int32_t) * MV_JOINTS);
         memcpy(md_rate_est_ctx->nmv_costs, pcs->ppcs->scs->nmv_costs, sizeof(int32_t) * MV_VALS * 2);
         md_rate_est_ctx->nmvcoststack[0] = &md_rate_est_ctx->nmv_costs[0][MV_MAX];
@@ -393,12 +472,17 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
     }
     if (frm_hdr->allow_intrabc) {
         int32_t *dvcost[2] = {&md_rate_est_ctx->dv_cost[0][MV_MAX], &md_rate_est_ctx->dv_cost[1][MV_MAX]};
-        svt_av1_build_nmv_cost_table(md_rate_est_ctx->dv_joint_cost, dvcost, &fc->ndvc, MV_SUBPEL_NONE);
+        if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, ndvc) || !md_rate_est_ctx->dv_rate_valid)
+            svt_av1_build_nmv_cost_table(md_rate_est_ctx->dv_joint_cost, dvcost, &fc->ndvc, MV_SUBPEL_NONE);
+        md_rate_est_ctx->dv_rate_valid = true;
     }
 }
 void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
     FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
 
+    // the tables no longer match the cdfs recorded in dst_rate->rate_fc
+    dst_rate->mv_rate_valid = false;
+    dst_rate->dv_rate_valid = false;
     memcpy(dst_rate->nmv_vec_cost, pcs->md_rate_est_ctx->nmv_vec_cost, MV_JOINTS * sizeof(int32_t));
 
     if (frm_hdr->allow_high_precision_mv) {
@@ -425,23 +509,64 @@ void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
 void svt_aom_estimate_coefficients_rate(MdRateEstimationContext *md_rate_est_ctx, FRAME_CONTEXT *fc) {
     const int32_t num_planes = 3; // NM - Hardcoded to 3
     const int32_t nplanes    = AOMMIN(num_planes, PLANE_TYPES);
+    const bool    all        = !md_rate_est_ctx->coeff_rate_valid;
+    // the cdfs shared by the tables of several transform sizes or planes are checked once
+    bool txb_skip_changed[TX_SIZES][TXB_SKIP_CONTEXTS];
+    bool dc_sign_changed[PLANE_TYPES][DC_SIGN_CONTEXTS];
+    bool br_changed[TX_32X32 + 1][PLANE_TYPES][LEVEL_CONTEXTS];
+
+    md_rate_est_ctx->coeff_rate_valid = true;
+    for (int tx_size = 0; tx_size < TX_SIZES; ++tx_size)
+        for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
+            txb_skip_changed[tx_size][ctx] = RATE_CDF_CHANGED(md_rate_est_ctx, fc, txb_skip_cdf[tx_size][ctx]) || all;
+    for (int plane = 0; plane < nplanes; ++plane) {
+        for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
+            dc_sign_changed[plane][ctx] = RATE_CDF_CHANGED(md_rate_est_ctx, fc, dc_sign_cdf[plane][ctx]) || all;
+        for (int tx_size = 0; tx_size <= TX_32X32; ++tx_size)
+            for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx)
+                br_changed[tx_size][plane][ctx] =
+                    RATE_CDF_CHANGED(md_rate_est_ctx, fc, coeff_br_cdf[tx_size][plane][ctx]) || all;
+    }
 
     for (int eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size) {
         for (int plane = 0; plane < nplanes; ++plane) {
             LvMapEobCost *pcost = &md_rate_est_ctx->eob_frac_bits[eob_multi_size][plane];
             for (int ctx = 0; ctx < 2; ++ctx) {
                 AomCdfProb *pcdf;
+                bool        changed;
                 switch (eob_multi_size) {
-                case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
-                case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
-                case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
-                case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
-                case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
-                case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
+                case 0:
+                    pcdf    = fc->eob_flag_cdf16[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf16[plane][ctx]);
+                    break;
+                case 1:
+                    pcdf    = fc->eob_flag_cdf32[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf32[plane][ctx]);
+                    break;
+                case 2:
+                    pcdf    = fc->eob_flag_cdf64[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf64[plane][ctx]);
+                    break;
+                case 3:
+                    pcdf    = fc->eob_flag_cdf128[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf128[plane][ctx]);
+                    break;
+                case 4:
+                    pcdf    = fc->eob_flag_cdf256[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf256[plane][ctx]);
+                    break;
+                case 5:
+                    pcdf    = fc->eob_flag_cdf512[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf512[plane][ctx]);
+                    break;
                 case 6:
-                default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
+                default:
+                    pcdf    = fc->eob_flag_cdf1024[plane][ctx];
+                    changed = RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_flag_cdf1024[plane][ctx]);
+                    break;
                 }
-                svt_aom_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
+                if (changed || all)
+                    svt_aom_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
             }
         }
     }
@@ -450,30 +575,37 @@ void svt_aom_estimate_coefficients_rate(MdRateEstimationContext *md_rate_est_ctx
             LvMapCoeffCost *pcost = &md_rate_est_ctx->coeff_fac_bits[tx_size][plane];
 
             for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
+                if (txb_skip_changed[tx_size][ctx])
+                    svt_aom_get_syntax_rate_from_cdf(pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
 
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(
-                    pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
-            for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, coeff_base_eob_cdf[tx_size][plane][ctx]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
+                if (!RATE_CDF_CHANGED(md_rate_est_ctx, fc, coeff_base_cdf[tx_size][plane][ctx]) && !all)
+                    continue;
+                svt_aom_get_syntax_rate_from_cdf(pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
                 pcost->base_cost[ctx][4] = 0;
                 pcost->base_cost[ctx][5] = pcost->base_cost[ctx][1] + av1_cost_literal(1) - pcost->base_cost[ctx][0];
                 pcost->base_cost[ctx][6] = pcost->base_cost[ctx][2] - pcost->base_cost[ctx][1];
                 pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
             }
             for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(
-                    pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+                if (RATE_CDF_CHANGED(md_rate_est_ctx, fc, eob_extra_cdf[tx_size][plane][ctx]) || all)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
 
             for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+                if (dc_sign_changed[plane][ctx])
+                    svt_aom_get_syntax_rate_from_cdf(pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
 
             for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
                 int32_t br_rate[BR_CDF_SIZE];
                 int32_t prev_cost = 0;
                 int32_t i, j;
+                if (!br_changed[AOMMIN(tx_size, TX_32X32)][plane][ctx])
+                    continue;
                 svt_aom_get_syntax_rate_from_cdf(
                     br_rate, fc->coeff_br_cdf[AOMMIN(tx_size, TX_32X32)][plane][ctx], NULL);
                 // SVT_LOG("br_rate: ");
@@ -489,10 +621,8 @@ void svt_aom_estimate_coefficients_rate(MdRateEstimationContext *md_rate_est_ctx
                 // for (i = 0; i <= COEFF_BASE_RANGE; i++)
                 //  SVT_LOG("%5d ", pcost->lps_cost[ctx][i]);
                 // SVT_LOG("\n");
-            }
-            for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
                 pcost->lps_cost[ctx][0 + COEFF_BASE_RANGE + 1] = pcost->lps_cost[ctx][0];
-                for (int i = 1; i <= COEFF_BASE_RANGE; ++i)
+                for (i = 1; i <= COEFF_BASE_RANGE; ++i)
                     pcost->lps_cost[ctx][i + COEFF_BASE_RANGE + 1] = pcost->lps_cost[ctx][i] -
                         pcost->lps_cost[ctx][i - 1];
             }
@@ -636,10 +766,10 @@ static AOM_INLINE void update_inter_mode_stats(FRAME_CONTEXT *fc, PredictionMode
 /*******************************************************************************
  * Updates all the palette stats/CDF for the current block
  ******************************************************************************/
-static AOM_INLINE void update_palette_cdf(MacroBlockD *xd, const MbModeInfo *const mbmi, BlkStruct *blk_ptr,
-                                          const int mi_row, const int mi_col) {
+static AOM_INLINE void update_palette_cdf(PictureControlSet *pcs, MacroBlockD *xd, const MbModeInfo *const mbmi,
+                                          BlkStruct *blk_ptr, const int mi_row, const int mi_col) {
     FRAME_CONTEXT   *fc                = xd->tile_ctx;
-    const BlockGeom *blk_geom          = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom *blk_geom          = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     const BlockSize  bsize             = blk_geom->bsize;
     const int        palette_bsize_ctx = svt_aom_get_palette_bsize_ctx(bsize);
 
@@ -672,7 +802,7 @@ static AOM_INLINE void sum_intra_stats(PictureControlSet *pcs, BlkStruct *blk_pt
     const MbModeInfo *const mbmi     = &xd->mi[0]->mbmi;
     FRAME_CONTEXT          *fc       = xd->tile_ctx;
     const PredictionMode    y_mode   = mbmi->block_mi.mode;
-    const BlockGeom        *blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom        *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     const BlockSize         bsize    = mbmi->block_mi.bsize;
     assert(bsize < BlockSizeS_ALL);
     assert(y_mode < 13);
@@ -725,7 +855,7 @@ static AOM_INLINE void sum_intra_stats(PictureControlSet *pcs, BlkStruct *blk_pt
                    2 * MAX_ANGLE_DELTA + 1);
     }
     if (svt_aom_allow_palette(pcs->ppcs->frm_hdr.allow_screen_content_tools, bsize)) {
-        update_palette_cdf(xd, mbmi, blk_ptr, mi_row, mi_col);
+        update_palette_cdf(pcs, xd, mbmi, blk_ptr, mi_row, mi_col);
     }
 }
 /*******************************************************************************
@@ -737,7 +867,7 @@ void svt_aom_update_stats(PictureControlSet *pcs, BlkStruct *blk_ptr, int mi_row
     MacroBlockD            *xd      = blk_ptr->av1xd;
     const MbModeInfo *const mbmi    = &xd->mi[0]->mbmi;
 
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     BlockSize        bsize    = blk_geom->bsize;
     assert(bsize < BlockSizeS_ALL);
     FRAME_CONTEXT *fc             = xd->tile_ctx;
@@ -958,7 +1088,7 @@ void svt_aom_update_stats(PictureControlSet *pcs, BlkStruct *blk_ptr, int mi_row
 void svt_aom_update_part_stats(PictureControlSet *pcs, BlkStruct *blk_ptr, uint16_t tile_idx, int mi_row, int mi_col) {
     const AV1_COMMON *const cm       = pcs->ppcs->av1_cm;
     MacroBlockD            *xd       = blk_ptr->av1xd;
-    const BlockGeom        *blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
+    const BlockGeom        *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_ptr->mds_idx);
     BlockSize               bsize    = blk_geom->bsize;
     FRAME_CONTEXT          *fc       = xd->tile_ctx;
     assert(bsize < BlockSizeS_ALL);
@@ -133,6 +133,15 @@ extern "C" {
         int32_t inter_tx_type_fac_bits[EXT_TX_SETS_INTER][EXT_TX_SIZES][CDF_SIZE(TX_TYPES)];
         int32_t switchable_interp_fac_bitss[SWITCHABLE_FILTER_CONTEXTS][SWITCHABLE_FILTERS];
         int32_t initialized;
+
+        // CDFs the tables were last derived from: the estimations only rederive the tables of the CDFs which
+        // changed since, or all of them when the valid flag is cleared (tables copied from elsewhere)
+        FRAME_CONTEXT rate_fc;
+        bool          syntax_rate_valid;
+        bool          coeff_rate_valid;
+        bool          mv_rate_valid;
+        bool          dv_rate_valid;
+        uint8_t       mv_rate_hp; // precision the mv tables were derived for
     } MdRateEstimationContext;
     /***************************************************************************
     * AV1 Probability table
@@ -179,13 +188,6 @@ extern "C" {
         },
     };
 
-    /***************************************************************************
-    * svt_aom_get_syntax_rate_from_cdf
-    ***************************************************************************/
-    extern void svt_aom_get_syntax_rate_from_cdf(
-        int32_t                        *costs,
-        const AomCdfProb             *cdf,
-        const int32_t                  *inv_map);
     /**************************************************************************
     * Estimate the rate for each syntax elements and for
     * all scenarios based on the frame CDF
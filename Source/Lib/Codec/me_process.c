@@ -161,6 +161,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                 skip_me = true;
             // skip me for the first pass. ME is already performed
             if (!skip_me) {
+                svt_aom_executor_acquire(scs->enc_ctx->executor_client);
                 if (pcs->slice_type != I_SLICE) {
                     // Use scaled source references if resolution of the reference is different that of the input
                     svt_aom_use_scaled_source_refs_if_needed(pcs,
@@ -296,6 +297,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                             uint32_t b64_index = (uint16_t)(x_b64_index + y_b64_index * pic_width_in_b64);
                             svt_aom_open_loop_intra_search_mb(pcs, b64_index, input_pic);
                         }
+                svt_aom_executor_release(scs->enc_ctx->executor_client);
             }
             // Get Empty Results Object
             svt_get_empty_object(me_context_ptr->motion_estimation_results_output_fifo_ptr,
@@ -319,8 +321,10 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                     pcs->temp_filt_pcs_list);
             // temporal filtering start
             me_context_ptr->me_ctx->me_type = ME_MCTF;
+            svt_aom_executor_acquire(scs->enc_ctx->executor_client);
             svt_av1_init_temporal_filtering(
                 pcs->temp_filt_pcs_list, pcs, me_context_ptr, in_results_ptr->segment_index);
+            svt_aom_executor_release(scs->enc_ctx->executor_client);
 
             // Release the Input Results
             svt_release_object(in_results_wrapper_ptr);
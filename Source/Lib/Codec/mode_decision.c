@@ -4059,6 +4059,7 @@ EbErrorType generate_md_stage_0_cand(
             }
 
         }
+        ctx->fast_cand_class_array[cand_i] = (uint8_t)cand_ptr->cand_class;
     }
     return EB_ErrorNone;
 }
@@ -140,6 +140,108 @@ void svt_aom_neighbor_array_unit_reset(NeighborArrayUnit *na_unit_ptr) {
     return;
 }
 
+static uint8_t *neighbor_array_unit_array(NeighborArrayUnit *na_unit_ptr, NeighborArrayType type) {
+    return type == NEIGHBOR_ARRAY_LEFT ? na_unit_ptr->left_array
+        : type == NEIGHBOR_ARRAY_TOP   ? na_unit_ptr->top_array
+                                       : na_unit_ptr->top_left_array;
+}
+
+/*************************************************
+ * Neighbor Array Unit Copy-On-Write Snapshot
+ *************************************************/
+void svt_aom_neighbor_array_unit_cow_start(NeighborArrayUnit *na_unit_ptr, NeighborArrayUnit *na_backup) {
+    na_unit_ptr->cow_backup = na_backup;
+    memset(na_unit_ptr->cow_saved, 0, sizeof(na_unit_ptr->cow_saved));
+    memset(na_unit_ptr->cow_dirty, 0, sizeof(na_unit_ptr->cow_dirty));
+}
+
+void svt_aom_neighbor_array_unit_cow_stop(NeighborArrayUnit *na_unit_ptr) {
+    svt_aom_neighbor_array_unit_cow_start(na_unit_ptr, NULL);
+}
+
+/*
+ * Save the units [start, start + count) of an array to the backup before they are written. The saved and the
+ * written spans are kept contiguous: the units of a gap are unchanged since the snapshot, so saving and restoring
+ * them is harmless.
+ */
+static void neighbor_array_unit_cow_save(NeighborArrayUnit *na_unit_ptr, NeighborArrayType type, uint32_t start,
+                                         uint32_t count) {
+    const uint32_t     unit_size = na_unit_ptr->unit_size;
+    const uint32_t     end       = start + count;
+    uint8_t           *src       = neighbor_array_unit_array(na_unit_ptr, type);
+    uint8_t           *dst       = neighbor_array_unit_array(na_unit_ptr->cow_backup, type);
+    NeighborArraySpan *saved     = &na_unit_ptr->cow_saved[type];
+    NeighborArraySpan *dirty     = &na_unit_ptr->cow_dirty[type];
+
+    if (!count)
+        return;
+    if (saved->start >= saved->end) {
+        svt_memcpy(dst + start * unit_size, src + start * unit_size, count * unit_size);
+        saved->start = (uint16_t)start;
+        saved->end   = (uint16_t)end;
+    } else {
+        if (start < saved->start) {
+            svt_memcpy(dst + start * unit_size, src + start * unit_size, (saved->start - start) * unit_size);
+            saved->start = (uint16_t)start;
+        }
+        if (end > saved->end) {
+            svt_memcpy(dst + saved->end * unit_size, src + saved->end * unit_size, (end - saved->end) * unit_size);
+            saved->end = (uint16_t)end;
+        }
+    }
+    if (dirty->start >= dirty->end) {
+        dirty->start = (uint16_t)start;
+        dirty->end   = (uint16_t)end;
+    } else {
+        dirty->start = (uint16_t)MIN(dirty->start, start);
+        dirty->end   = (uint16_t)MAX(dirty->end, end);
+    }
+}
+
+// Save the units of a block about to be written while a copy-on-write snapshot is active
+static INLINE void neighbor_array_unit_cow_write(NeighborArrayUnit *na_unit_ptr, uint32_t org_x, uint32_t org_y,
+                                                 uint32_t block_width, uint32_t block_height,
+                                                 uint8_t neighbor_array_type_mask) {
+    if (!na_unit_ptr->cow_backup)
+        return;
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK)
+        neighbor_array_unit_cow_save(na_unit_ptr,
+                                     NEIGHBOR_ARRAY_TOP,
+                                     get_neighbor_array_unit_top_index(na_unit_ptr, org_x),
+                                     block_width >> na_unit_ptr->granularity_normal_log2);
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK)
+        neighbor_array_unit_cow_save(na_unit_ptr,
+                                     NEIGHBOR_ARRAY_LEFT,
+                                     get_neighbor_array_unit_left_index(na_unit_ptr, org_y),
+                                     block_height >> na_unit_ptr->granularity_normal_log2);
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK)
+        neighbor_array_unit_cow_save(
+            na_unit_ptr,
+            NEIGHBOR_ARRAY_TOPLEFT,
+            svt_aom_get_neighbor_array_unit_top_left_index(na_unit_ptr, org_x, org_y + (block_height - 1)),
+            ((block_width + block_height) >> na_unit_ptr->granularity_top_left_log2) - 1);
+}
+
+/*
+ * Restore the units [start, start + count) of an array from its copy-on-write backup: only the units written since
+ * the snapshot or the last rollback differ from the backup.
+ */
+static void neighbor_array_unit_cow_rollback(NeighborArrayUnit *na_unit_ptr, NeighborArrayType type, uint32_t start,
+                                             uint32_t count) {
+    const uint32_t     unit_size = na_unit_ptr->unit_size;
+    NeighborArraySpan *dirty     = &na_unit_ptr->cow_dirty[type];
+    const uint32_t     from      = MAX(dirty->start, start);
+    const uint32_t     to        = MIN(dirty->end, start + count);
+
+    if (from >= to)
+        return;
+    svt_memcpy(neighbor_array_unit_array(na_unit_ptr, type) + from * unit_size,
+               neighbor_array_unit_array(na_unit_ptr->cow_backup, type) + from * unit_size,
+               (to - from) * unit_size);
+    if (from == dirty->start && to == dirty->end)
+        dirty->start = dirty->end = 0;
+}
+
 /*************************************************
  * Neighbor Array Unit Get Top Index
  *************************************************/
@@ -159,6 +261,9 @@ void svt_aom_update_recon_neighbor_array(NeighborArrayUnit *na_unit_ptr, uint8_t
                                          uint32_t block_height) {
     uint8_t *dst_ptr;
 
+    neighbor_array_unit_cow_write(
+        na_unit_ptr, pic_origin_x, pic_origin_y, block_width, block_height, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+
     dst_ptr = na_unit_ptr->top_array +
         get_neighbor_array_unit_top_index(na_unit_ptr, pic_origin_x) * na_unit_ptr->unit_size;
     svt_memcpy(dst_ptr, src_ptr_top, block_width);
@@ -235,6 +340,8 @@ void svt_aom_update_recon_neighbor_array16bit(NeighborArrayUnit *na_unit_ptr, ui
                                               uint16_t *src_ptr_left, uint32_t pic_origin_x, uint32_t pic_origin_y,
                                               uint32_t block_width, uint32_t block_height) {
     uint16_t *dst_ptr;
+    neighbor_array_unit_cow_write(
+        na_unit_ptr, pic_origin_x, pic_origin_y, block_width, block_height, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
     dst_ptr = (uint16_t *)(na_unit_ptr->top_array +
                            get_neighbor_array_unit_top_index(na_unit_ptr, pic_origin_x) * na_unit_ptr->unit_size);
     svt_memcpy(dst_ptr, src_ptr_top, block_width * sizeof(uint16_t));
@@ -295,6 +402,8 @@ void svt_aom_neighbor_array_unit_sample_write(NeighborArrayUnit *na_unit_ptr, ui
 
     // Adjust the Source ptr to start at the origin of the block being updated.
     src_ptr += ((src_origin_y * stride) + src_origin_x) * na_unit_ptr->unit_size;
+    neighbor_array_unit_cow_write(
+        na_unit_ptr, pic_origin_x, pic_origin_y, block_width, block_height, neighbor_array_type_mask);
 
     if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
         //
@@ -437,6 +546,8 @@ void svt_aom_neighbor_array_unit16bit_sample_write(NeighborArrayUnit *na_unit_pt
 
     // Adjust the Source ptr to start at the origin of the block being updated.
     src_ptr += ((src_origin_y * stride) + src_origin_x) /*CHKN  * na_unit_ptr->unit_size*/;
+    neighbor_array_unit_cow_write(
+        na_unit_ptr, pic_origin_x, pic_origin_y, block_width, block_height, neighbor_array_type_mask);
 
     if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
         //
@@ -692,6 +803,7 @@ void svt_aom_neighbor_array_unit_mode_write(NeighborArrayUnit *na_unit_ptr, uint
     uint32_t na_unit_size;
 
     na_unit_size = na_unit_ptr->unit_size;
+    neighbor_array_unit_cow_write(na_unit_ptr, org_x, org_y, block_width, block_height, neighbor_array_type_mask);
 
     if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
         //
@@ -805,6 +917,28 @@ void svt_aom_copy_neigh_arr(NeighborArrayUnit *na_src, NeighborArrayUnit *na_dst
     UNUSED(idx);
     na_unit_size = na_src->unit_size;
 
+    // Restoring from the copy-on-write backup only copies back the units written since the snapshot
+    if (na_dst->cow_backup == na_src) {
+        if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK)
+            neighbor_array_unit_cow_rollback(na_dst,
+                                             NEIGHBOR_ARRAY_TOP,
+                                             get_neighbor_array_unit_top_index(na_src, org_x),
+                                             bw >> na_src->granularity_normal_log2);
+        if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK)
+            neighbor_array_unit_cow_rollback(na_dst,
+                                             NEIGHBOR_ARRAY_LEFT,
+                                             get_neighbor_array_unit_left_index(na_src, org_y),
+                                             bh >> na_src->granularity_normal_log2);
+        if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK)
+            neighbor_array_unit_cow_rollback(
+                na_dst,
+                NEIGHBOR_ARRAY_TOPLEFT,
+                svt_aom_get_neighbor_array_unit_top_left_index(na_src, org_x, org_y + (bh - 1)),
+                ((bw + bh) >> na_src->granularity_top_left_log2) - 1);
+        return;
+    }
+    neighbor_array_unit_cow_write(na_dst, org_x, org_y, bw, bh, neighbor_array_type_mask);
+
     if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
         na_offset = get_neighbor_array_unit_top_index(na_src, org_x);
         src_ptr   = na_src->top_array + na_offset * na_unit_size;
@@ -857,3 +991,19 @@ void svt_aom_copy_neigh_arr(NeighborArrayUnit *na_src, NeighborArrayUnit *na_dst
 
     return;
 }
+
+/*
+ * Copy the neighbor data of an area, clipped to the size of the arrays: the top and left arrays over the area
+ * and the top-left array over the diagonals of the area.
+ */
+void svt_aom_copy_neigh_arr_area(NeighborArrayUnit *na_src, NeighborArrayUnit *na_dst, uint32_t org_x, uint32_t org_y,
+                                 uint32_t bw, uint32_t bh) {
+    const uint32_t max_w = (uint32_t)na_src->top_array_size << na_src->granularity_normal_log2;
+    const uint32_t max_h = (uint32_t)na_src->left_array_size << na_src->granularity_normal_log2;
+    if (org_x >= max_w || org_y >= max_h)
+        return;
+    uint8_t mask = NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK;
+    if (na_src->top_left_array_size)
+        mask |= NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK;
+    svt_aom_copy_neigh_arr(na_src, na_dst, org_x, org_y, MIN(bw, max_w - org_x), MIN(bh, max_h - org_y), mask);
+}
@@ -41,6 +41,12 @@ typedef enum NeighborArrayType {
     (NEIGHBOR_ARRAY_UNIT_LEFT_MASK | NEIGHBOR_ARRAY_UNIT_TOP_MASK | NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK)
 #define NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK (NEIGHBOR_ARRAY_UNIT_LEFT_MASK | NEIGHBOR_ARRAY_UNIT_TOP_MASK)
 
+// Span [start, end) of the units of a neighbor array, empty when start >= end
+typedef struct NeighborArraySpan {
+    uint16_t start;
+    uint16_t end;
+} NeighborArraySpan;
+
 typedef struct NeighborArrayUnit {
     EbDctor  dctor;
     uint8_t *left_array;
@@ -55,6 +61,12 @@ typedef struct NeighborArrayUnit {
     uint8_t  granularity_top_left;
     uint8_t  granularity_top_left_log2;
     uint32_t max_pic_h;
+    // Copy-on-write snapshot: while cow_backup is set, the units are saved to cow_backup on their first write
+    // (cow_saved), and the units written since the snapshot or the last rollback (cow_dirty) are the only ones
+    // copied back when restoring from cow_backup. Both are indexed by NeighborArrayType.
+    struct NeighborArrayUnit *cow_backup;
+    NeighborArraySpan         cow_saved[3];
+    NeighborArraySpan         cow_dirty[3];
 } NeighborArrayUnit;
 
 typedef struct NeighborArrayUnit32 {
@@ -84,6 +96,9 @@ extern EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_p
 
 extern void svt_aom_neighbor_array_unit_reset(NeighborArrayUnit *na_unit_ptr);
 
+void svt_aom_neighbor_array_unit_cow_start(NeighborArrayUnit *na_unit_ptr, NeighborArrayUnit *na_backup);
+void svt_aom_neighbor_array_unit_cow_stop(NeighborArrayUnit *na_unit_ptr);
+
 extern void svt_aom_neighbor_array_unit_reset32(NeighborArrayUnit32 *na_unit_ptr);
 
 /*************************************************
@@ -126,6 +141,8 @@ void svt_aom_update_recon_neighbor_array16bit(NeighborArrayUnit *na_unit_ptr, ui
 
 void svt_aom_copy_neigh_arr(NeighborArrayUnit *na_src, NeighborArrayUnit *na_dst, uint32_t org_x, uint32_t org_y,
                             uint32_t bw, uint32_t bh, uint8_t neighbor_array_type_mask);
+void svt_aom_copy_neigh_arr_area(NeighborArrayUnit *na_src, NeighborArrayUnit *na_dst, uint32_t org_x, uint32_t org_y,
+                                 uint32_t bw, uint32_t bh);
 
 extern void svt_aom_neighbor_array_unit16bit_sample_write(NeighborArrayUnit *na_unit_ptr, uint16_t *src_ptr,
                                                           uint32_t stride, uint32_t src_origin_x, uint32_t src_origin_y,
@@ -0,0 +1,139 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "packet_buffer_pool.h"
+#include "svt_malloc.h"
+#include "svt_threads.h"
+
+// Buffers larger than the biggest class are not pooled
+#define PACKET_POOL_UNPOOLED PACKET_POOL_NUM_CLASSES
+
+typedef struct PacketBufferNode {
+    PacketBufferPool        *pool;
+    struct PacketBufferNode *next;
+    uint32_t                 size_class;
+    uint32_t                 capacity;
+} PacketBufferNode;
+
+// keep the payload 32-byte aligned relative to the allocation
+#define PACKET_NODE_SIZE ((sizeof(PacketBufferNode) + 31) & ~(size_t)31)
+
+struct PacketBufferPool {
+    EbHandle          mutex;
+    PacketBufferNode *free_list[PACKET_POOL_NUM_CLASSES];
+    uint32_t          free_count[PACKET_POOL_NUM_CLASSES];
+    uint32_t          outstanding;
+    bool              closed;
+};
+
+static inline uint8_t *node_to_payload(PacketBufferNode *node) { return (uint8_t *)node + PACKET_NODE_SIZE; }
+
+static inline PacketBufferNode *payload_to_node(uint8_t *buffer) {
+    return (PacketBufferNode *)(buffer - PACKET_NODE_SIZE);
+}
+
+static uint32_t get_size_class(uint32_t size) {
+    for (uint32_t c = 0; c < PACKET_POOL_NUM_CLASSES; c++)
+        if (size <= (1u << (PACKET_POOL_MIN_LOG2 + c)))
+            return c;
+    return PACKET_POOL_UNPOOLED;
+}
+
+static void free_node(PacketBufferNode *node) { EB_FREE(node); }
+
+static void packet_buffer_pool_free(PacketBufferPool *pool) {
+    for (uint32_t c = 0; c < PACKET_POOL_NUM_CLASSES; c++) {
+        while (pool->free_list[c]) {
+            PacketBufferNode *node = pool->free_list[c];
+            pool->free_list[c]     = node->next;
+            free_node(node);
+        }
+        pool->free_count[c] = 0;
+    }
+    EB_DESTROY_MUTEX(pool->mutex);
+    EB_FREE(pool);
+}
+
+EbErrorType svt_aom_packet_buffer_pool_create(PacketBufferPool **pool_ptr) {
+    PacketBufferPool *pool;
+    EB_CALLOC(pool, 1, sizeof(*pool));
+    *pool_ptr = pool;
+    EB_CREATE_MUTEX(pool->mutex);
+    return EB_ErrorNone;
+}
+
+void svt_aom_packet_buffer_pool_close(PacketBufferPool *pool) {
+    if (!pool)
+        return;
+    svt_block_on_mutex(pool->mutex);
+    pool->closed        = true;
+    const bool free_now = pool->outstanding == 0;
+    svt_release_mutex(pool->mutex);
+    if (free_now)
+        packet_buffer_pool_free(pool);
+}
+
+uint8_t *svt_aom_packet_buffer_alloc(PacketBufferPool *pool, uint32_t size, uint32_t *capacity) {
+    const uint32_t    size_class = get_size_class(size);
+    PacketBufferNode *node       = NULL;
+
+    svt_block_on_mutex(pool->mutex);
+    if (size_class != PACKET_POOL_UNPOOLED && pool->free_list[size_class]) {
+        node                        = pool->free_list[size_class];
+        pool->free_list[size_class] = node->next;
+        pool->free_count[size_class]--;
+    }
+    pool->outstanding++;
+    svt_release_mutex(pool->mutex);
+
+    if (!node) {
+        const uint32_t cap = size_class == PACKET_POOL_UNPOOLED ? size : 1u << (PACKET_POOL_MIN_LOG2 + size_class);
+        EB_NO_THROW_MALLOC(node, PACKET_NODE_SIZE + cap);
+        if (!node) {
+            svt_block_on_mutex(pool->mutex);
+            pool->outstanding--;
+            svt_release_mutex(pool->mutex);
+            *capacity = 0;
+            return NULL;
+        }
+        node->pool       = pool;
+        node->size_class = size_class;
+        node->capacity   = cap;
+    }
+    node->next = NULL;
+    *capacity  = node->capacity;
+    return node_to_payload(node);
+}
+
+void svt_aom_packet_buffer_release(uint8_t *buffer) {
+    if (!buffer)
+        return;
+    PacketBufferNode *node       = payload_to_node(buffer);
+    PacketBufferPool *pool       = node->pool;
+    const uint32_t    size_class = node->size_class;
+
+    svt_block_on_mutex(pool->mutex);
+    if (!pool->closed && size_class != PACKET_POOL_UNPOOLED &&
+        pool->free_count[size_class] < PACKET_POOL_MAX_FREE_PER_CLASS) {
+        node->next                  = pool->free_list[size_class];
+        pool->free_list[size_class] = node;
+        pool->free_count[size_class]++;
+        node = NULL;
+    }
+    pool->outstanding--;
+    const bool free_pool = pool->closed && pool->outstanding == 0;
+    svt_release_mutex(pool->mutex);
+
+    if (node)
+        free_node(node);
+    if (free_pool)
+        packet_buffer_pool_free(pool);
+}
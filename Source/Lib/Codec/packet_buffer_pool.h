@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbPacketBufferPool_h
+#define EbPacketBufferPool_h
+
+#include "definitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Smallest pooled class is 1 << PACKET_POOL_MIN_LOG2 bytes, each following class doubles the capacity.
+#define PACKET_POOL_MIN_LOG2 12
+#define PACKET_POOL_NUM_CLASSES 14 // 4KB .. 32MB
+// Maximum number of idle buffers kept per class; extra buffers are returned to the system
+#define PACKET_POOL_MAX_FREE_PER_CLASS 16
+
+typedef struct PacketBufferPool PacketBufferPool;
+
+/*
+ * Size-classed pool of output packet buffers owned by an encoder instance.
+ *
+ * Buffers handed out by the pool carry a hidden header in front of the payload pointing back to the
+ * pool, so they can be recycled from svt_av1_enc_release_out_buffer() without any reference to the
+ * encoder handle. The pool outlives the encoder if packets are still held by the application: it is
+ * freed when it has been closed and its last outstanding buffer is released.
+ */
+EbErrorType svt_aom_packet_buffer_pool_create(PacketBufferPool **pool_ptr);
+void        svt_aom_packet_buffer_pool_close(PacketBufferPool *pool);
+
+// Returns a buffer of at least size bytes, *capacity is set to the usable size of the buffer
+uint8_t *svt_aom_packet_buffer_alloc(PacketBufferPool *pool, uint32_t size, uint32_t *capacity);
+// Returns a buffer obtained from svt_aom_packet_buffer_alloc() to its pool, NULL is ignored
+void svt_aom_packet_buffer_release(uint8_t *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPacketBufferPool_h
@@ -24,8 +24,13 @@
 #include "EbSvtAv1ErrorCodes.h"
 #include "pd_results.h"
 #include "restoration.h" // RDCOST_DBL
+#include "restoration_pick.h"
 #include "rc_process.h"
 #include "enc_mode_config.h"
+#include "packet_buffer_pool.h"
+
+// Every frame output buffer reserves TD_SIZE bytes ahead of the frame data for the temporal delimiter
+#define TD_SIZE 2
 
 #define RDCOST_DBL_WITH_NATIVE_BD_DIST(RM, R, D, BD) RDCOST_DBL((RM), (R), (double)((D) >> (2 * (BD - 8))))
 
@@ -116,7 +121,7 @@ static uint32_t count_frames_in_next_tu(const EncodeContext *enc_ctx, uint32_t *
             return 0;
 
         const EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType *)wrapper->object_ptr;
-        *data_size += output_stream_ptr->n_filled_len;
+        *data_size += output_stream_ptr->n_filled_len - TD_SIZE;
 
         i++;
         //we have a td when we got a displable frame
@@ -304,49 +309,73 @@ static void collect_frames_info(PacketizationContext *context_ptr, const EncodeC
     }
 }
 
-#define TD_SIZE 2
+// Buffers which end up in an output packet come from the application allocator when one is set, so the packets
+// are written directly into its memory. Those buffers are flagged with EB_BUFFERFLAG_APP_BUFFER in *flags.
+static uint8_t *alloc_output_buffer(const SequenceControlSet *scs, uint32_t size, uint32_t *capacity,
+                                    uint32_t *flags) {
+    const EbSvtAv1EncConfiguration *cfg = &scs->static_config;
+    if (!cfg->output_buffer_alloc) {
+        *flags &= ~EB_BUFFERFLAG_APP_BUFFER;
+        return svt_aom_packet_buffer_alloc(scs->enc_ctx->packet_buffer_pool, size, capacity);
+    }
+    uint8_t *buffer = cfg->output_buffer_alloc(cfg->output_buffer_ctx, size);
+    *capacity       = buffer ? size : 0;
+    *flags |= EB_BUFFERFLAG_APP_BUFFER;
+    return buffer;
+}
+
+static void release_output_buffer(const SequenceControlSet *scs, uint8_t *buffer, uint32_t flags) {
+    if (!(flags & EB_BUFFERFLAG_APP_BUFFER))
+        svt_aom_packet_buffer_release(buffer);
+    else if (buffer)
+        scs->static_config.output_buffer_free(scs->static_config.output_buffer_ctx, buffer);
+}
 
 // a tu start with a td, + 0 more not displable frame, + 1 display frame
-static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_bytes,
+static EbErrorType encode_tu(const SequenceControlSet *scs, int frames, uint32_t total_bytes,
                              EbBufferHeaderType *output_stream_ptr) {
+    EncodeContext *enc_ctx = scs->enc_ctx;
     total_bytes += TD_SIZE;
-    if (total_bytes > output_stream_ptr->n_alloc_len) {
-        uint8_t *pbuff;
-        EB_MALLOC(pbuff, total_bytes);
+    // Single frame tu: the td goes into the space reserved ahead of the frame data, nothing to move.
+    // Otherwise, the frames are written forward into a buffer reserved for the entire tu.
+    if (frames > 1) {
+        uint32_t capacity, flags = 0;
+        uint8_t *pbuff = alloc_output_buffer(scs, total_bytes, &capacity, &flags);
         if (!pbuff) {
             SVT_ERROR("failed to allocate more memory in encode_tu");
             return EB_ErrorInsufficientResources;
         }
-        EB_MEMCPY(pbuff,
-                  output_stream_ptr->p_buffer,
-                  output_stream_ptr->n_alloc_len > total_bytes ? total_bytes : output_stream_ptr->n_alloc_len);
-        EB_FREE(output_stream_ptr->p_buffer);
-        output_stream_ptr->p_buffer    = pbuff;
-        output_stream_ptr->n_alloc_len = total_bytes;
-    }
-    uint8_t *dst = output_stream_ptr->p_buffer + total_bytes;
-    // we use last frame's output_stream_ptr to hold entire tu, so we need copy backward.
-    for (int i = frames - 1; i >= 0; i--) {
-        PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(enc_ctx, i);
-        EbObjectWrapper           *wrapper         = queue_entry_ptr->output_stream_wrapper_ptr;
-        EbBufferHeaderType        *src_stream_ptr  = (EbBufferHeaderType *)wrapper->object_ptr;
-        uint32_t                   size            = src_stream_ptr->n_filled_len;
-        dst -= size;
-        memmove(dst, src_stream_ptr->p_buffer, size);
-        // 1. The last frame is a displayable frame, others are undisplayed.
-        // 2. We do not push alt ref frame since the overlay frame will carry the pts.
-        // 3. Release alt ref stream buffer here for it will not be sent out
-        if (i != frames - 1 && !queue_entry_ptr->is_alt_ref)
-            push_undisplayed_frame(enc_ctx, wrapper);
-        else if (queue_entry_ptr->is_alt_ref) {
-            EB_FREE(src_stream_ptr->p_buffer);
-            svt_release_object(wrapper);
+        uint8_t *dst = pbuff + TD_SIZE;
+        for (int i = 0; i < frames; i++) {
+            PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(enc_ctx, i);
+            EbObjectWrapper           *wrapper         = queue_entry_ptr->output_stream_wrapper_ptr;
+            EbBufferHeaderType        *src_stream_ptr  = (EbBufferHeaderType *)wrapper->object_ptr;
+            uint32_t                   size            = src_stream_ptr->n_filled_len - TD_SIZE;
+            EB_MEMCPY(dst, src_stream_ptr->p_buffer + TD_SIZE, size);
+            dst += size;
+            if (i == frames - 1)
+                break;
+            // The data of the undisplayed frames now lives in the tu, recycle their buffers
+            svt_aom_packet_buffer_release(src_stream_ptr->p_buffer);
+            src_stream_ptr->p_buffer     = NULL;
+            src_stream_ptr->n_alloc_len  = 0;
+            src_stream_ptr->n_filled_len = 0;
+            // 1. The last frame is a displayable frame, others are undisplayed.
+            // 2. We do not push alt ref frame since the overlay frame will carry the pts.
+            // 3. Release alt ref stream buffer here for it will not be sent out
+            if (!queue_entry_ptr->is_alt_ref)
+                push_undisplayed_frame(enc_ctx, wrapper);
+            else
+                svt_release_object(wrapper);
         }
-    }
-    if (frames > 1)
         sort_undisplayed_frame(enc_ctx);
-    dst -= TD_SIZE;
-    svt_aom_encode_td_av1(dst);
+        // we use last frame's output_stream_ptr to hold entire tu
+        release_output_buffer(scs, output_stream_ptr->p_buffer, output_stream_ptr->flags);
+        output_stream_ptr->p_buffer    = pbuff;
+        output_stream_ptr->n_alloc_len = capacity;
+        output_stream_ptr->flags       = (output_stream_ptr->flags & ~EB_BUFFERFLAG_APP_BUFFER) | flags;
+    }
+    svt_aom_encode_td_av1(output_stream_ptr->p_buffer);
     output_stream_ptr->n_filled_len = total_bytes;
     output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
     return EB_ErrorNone;
@@ -357,7 +386,7 @@ static EbErrorType copy_data_from_bitstream(EncodeContext *enc_ctx, Bitstream *b
     EbErrorType return_error = EB_ErrorNone;
     int         size         = svt_aom_bitstream_get_bytes_count(bitstream_ptr);
 
-    CHECK_REPORT_ERROR((size + output_stream_ptr->n_filled_len < output_stream_ptr->n_alloc_len),
+    CHECK_REPORT_ERROR((size + output_stream_ptr->n_filled_len <= output_stream_ptr->n_alloc_len),
                        enc_ctx->app_callback_ptr,
                        EB_ENC_EC_ERROR2);
 
@@ -368,9 +397,18 @@ static EbErrorType copy_data_from_bitstream(EncodeContext *enc_ctx, Bitstream *b
     return return_error;
 }
 
-static void encode_show_existing(EncodeContext *enc_ctx, PacketizationReorderEntry *queue_entry_ptr,
+static void encode_show_existing(const SequenceControlSet *scs, PacketizationReorderEntry *queue_entry_ptr,
                                  EbBufferHeaderType *output_stream_ptr) {
-    uint8_t *dst = output_stream_ptr->p_buffer;
+    EncodeContext *enc_ctx = scs->enc_ctx;
+    // the buffer of the undisplayed frame was recycled in encode_tu, get one sized for the show existing header
+    const uint32_t size = (uint32_t)svt_aom_bitstream_get_bytes_count(queue_entry_ptr->bitstream_ptr) + TD_SIZE;
+    uint8_t *dst = alloc_output_buffer(scs, size, &output_stream_ptr->n_alloc_len, &output_stream_ptr->flags);
+    output_stream_ptr->p_buffer = dst;
+    if (!dst) {
+        SVT_ERROR("failed to allocate memory in encode_show_existing");
+        output_stream_ptr->n_filled_len = 0;
+        return;
+    }
 
     svt_aom_encode_td_av1(dst);
     output_stream_ptr->n_filled_len = TD_SIZE;
@@ -446,11 +484,6 @@ inline static void set_eos_flag(EbBufferHeaderType *output_stream_ptr) {
     output_stream_ptr->flags |= EB_BUFFERFLAG_EOS;
 }
 
-/* Wrapper function to capture the return of EB_MALLOC */
-static inline EbErrorType malloc_p_buffer(EbBufferHeaderType *output_stream_ptr) {
-    EB_MALLOC(output_stream_ptr->p_buffer, output_stream_ptr->n_alloc_len);
-    return EB_ErrorNone;
-}
 void update_firstpass_stats(PictureParentControlSet *pcs, const int frame_number, const double ts_duration,
                             StatStruct *stat_struct);
 void svt_av1_end_first_pass(PictureParentControlSet *pcs);
@@ -466,6 +499,163 @@ static EbErrorType realloc_output_bitstream(Bitstream *bitstream_ptr, uint32_t s
     }
     return EB_ErrorNone;
 }
+// Writes the OBUs preceding the frame header: the sequence header and the HDR metadata on key frames, and the
+// ITU-T T.35 metadata of shown frames. Returns the size of the metadata kept for a following show existing frame.
+static size_t write_frame_prefix_obus(SequenceControlSet *scs, PictureControlSet *pcs) {
+    EncodeContext *enc_ctx     = scs->enc_ctx;
+    FrameHeader   *frm_hdr     = &pcs->ppcs->frm_hdr;
+    size_t         metadata_sz = 0;
+
+    // Code the SPS
+    if (frm_hdr->frame_type == KEY_FRAME) {
+        if (scs->static_config.mastering_display.max_luma)
+            svt_add_metadata(pcs->ppcs->input_ptr,
+                             EB_AV1_METADATA_TYPE_HDR_MDCV,
+                             (const uint8_t *)&scs->static_config.mastering_display,
+                             sizeof(scs->static_config.mastering_display));
+        if (scs->static_config.content_light_level.max_cll)
+            svt_add_metadata(pcs->ppcs->input_ptr,
+                             EB_AV1_METADATA_TYPE_HDR_CLL,
+                             (const uint8_t *)&scs->static_config.content_light_level,
+                             sizeof(scs->static_config.content_light_level));
+        svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
+        // Add CLL and MDCV meta when frame is keyframe and SPS is written
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
+    }
+
+    if (frm_hdr->show_frame) {
+        // Add HDR10+ dynamic metadata when show frame flag is enabled
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+        svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+    } else {
+        // Copy metadata pointer to the queue entry related to current frame number
+        uint64_t                   current_picture_number = pcs->picture_number;
+        PacketizationReorderEntry *temp_entry =
+            enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+        temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
+        pcs->ppcs->input_ptr->metadata = NULL;
+        metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+    }
+    return metadata_sz;
+}
+
+/*
+ * Obu streaming
+ *
+ * The entropy coding threads output the frames as fragments: the td and the frame header OBUs as soon as the
+ * picture enters entropy coding, then one tile group OBU per tile as soon as the tile is coded. The fragments
+ * are output in decode order, the tiles of a frame in tile order. The packetization process waits for the last
+ * fragment of the frame and only does the rate control and reference bookkeeping.
+ */
+static void post_stream_fragment(EncodeContext *enc_ctx, PictureControlSet *pcs, uint8_t *buffer, uint32_t size,
+                                 uint32_t capacity, uint32_t flags) {
+    PictureParentControlSet *ppcs = pcs->ppcs;
+    EbObjectWrapper         *output_stream_wrapper_ptr;
+    svt_get_empty_object(enc_ctx->stream_output_fifo_ptr, &output_stream_wrapper_ptr);
+    EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
+
+    uint64_t finish_time_seconds   = 0;
+    uint64_t finish_time_u_seconds = 0;
+    svt_av1_get_time(&finish_time_seconds, &finish_time_u_seconds);
+
+    output_stream_ptr->p_buffer     = buffer;
+    output_stream_ptr->n_alloc_len  = capacity;
+    output_stream_ptr->n_filled_len = size;
+    output_stream_ptr->flags        = EB_BUFFERFLAG_FRAGMENT | flags;
+    output_stream_ptr->n_tick_count = (uint32_t)svt_av1_compute_overall_elapsed_time_ms(
+        ppcs->start_time_seconds, ppcs->start_time_u_seconds, finish_time_seconds, finish_time_u_seconds);
+    output_stream_ptr->pts                  = ppcs->input_ptr->pts;
+    output_stream_ptr->dts                  = output_stream_ptr->pts;
+    output_stream_ptr->pic_type             = ppcs->is_ref ? ppcs->idr_flag ? EB_AV1_KEY_PICTURE
+                                                                            : (EbAv1PictureType)pcs->slice_type
+                                                           : EB_AV1_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private        = ppcs->input_ptr->p_app_private;
+    output_stream_ptr->temporal_layer_index = ppcs->temporal_layer_index;
+    output_stream_ptr->qp                   = ppcs->picture_qp;
+    // the average qindex is final once all the tiles are coded
+    output_stream_ptr->avg_qp = (flags & EB_BUFFERFLAG_LAST_FRAGMENT) && ppcs->valid_qindex_area
+        ? (uint32_t)(((ppcs->tot_qindex / ppcs->valid_qindex_area) + 2) >> 2)
+        : ppcs->avg_qp;
+    output_stream_ptr->scene_change_score = ppcs->scene_change_score;
+    output_stream_ptr->flash_score        = ppcs->flash_score;
+    output_stream_ptr->luma_sse           = 0;
+    output_stream_ptr->cr_sse             = 0;
+    output_stream_ptr->cb_sse             = 0;
+    output_stream_ptr->luma_ssim          = 0;
+    output_stream_ptr->cr_ssim            = 0;
+    output_stream_ptr->cb_ssim            = 0;
+    svt_post_full_object(output_stream_wrapper_ptr);
+}
+
+// Outputs the fragments that are ready, in decode order. Called under enc_ctx->stream_mutex.
+static void output_stream_fragments(EncodeContext *enc_ctx) {
+    for (;;) {
+        const uint32_t     slot = enc_ctx->stream_next_decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
+        PictureControlSet *pcs  = enc_ctx->stream_pcs[slot];
+        if (!pcs)
+            return;
+        Av1Common *const cm       = pcs->ppcs->av1_cm;
+        const uint16_t   tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+
+        if (!pcs->stream_header_sent) {
+            const uint32_t size = (uint32_t)svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE;
+            uint32_t       capacity, flags = EB_BUFFERFLAG_HAS_TD;
+            uint8_t       *buffer = alloc_output_buffer(pcs->scs, size, &capacity, &flags);
+            assert(buffer != NULL && "bit-stream memory allocation failure");
+            svt_aom_encode_td_av1(buffer);
+            svt_aom_bitstream_copy(pcs->bitstream_ptr, buffer + TD_SIZE, size - TD_SIZE);
+            post_stream_fragment(enc_ctx, pcs, buffer, size, capacity, flags);
+            pcs->stream_header_sent = true;
+            pcs->stream_bytes       = size;
+        }
+        while (pcs->stream_next_tile < tile_cnt && pcs->ec_info[pcs->stream_next_tile]->stream_tile_ready) {
+            const uint16_t tile_idx = pcs->stream_next_tile++;
+            uint32_t       capacity, flags = pcs->stream_next_tile == tile_cnt ? EB_BUFFERFLAG_LAST_FRAGMENT : 0;
+            uint8_t       *buffer = alloc_output_buffer(
+                pcs->scs, pcs->ec_info[tile_idx]->ec->ec_writer.pos + TILE_GROUP_OBU_MAX_OVERHEAD, &capacity, &flags);
+            assert(buffer != NULL && "bit-stream memory allocation failure");
+            const uint32_t size = svt_aom_write_tile_group_obu_av1(pcs, tile_idx, buffer);
+            post_stream_fragment(enc_ctx, pcs, buffer, size, capacity, flags);
+            pcs->stream_bytes += size;
+        }
+        if (pcs->stream_next_tile < tile_cnt)
+            return;
+        enc_ctx->stream_pcs[slot] = NULL;
+        enc_ctx->stream_next_decode_order++;
+        svt_post_semaphore(pcs->stream_done_sem);
+    }
+}
+
+void svt_aom_stream_start_picture(PictureControlSet *pcs) {
+    SequenceControlSet *scs      = pcs->scs;
+    EncodeContext      *enc_ctx  = scs->enc_ctx;
+    Av1Common *const    cm       = pcs->ppcs->av1_cm;
+    const uint16_t      tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+
+    // The frame header is final once the picture enters entropy coding
+    svt_aom_bitstream_reset(pcs->bitstream_ptr);
+    write_frame_prefix_obus(scs, pcs);
+    svt_aom_write_frame_header_obu_av1(pcs->bitstream_ptr, scs, pcs);
+
+    svt_block_on_mutex(enc_ctx->stream_mutex);
+    pcs->stream_next_tile   = 0;
+    pcs->stream_header_sent = false;
+    pcs->stream_bytes       = 0;
+    for (uint16_t tile_idx = 0; tile_idx < tile_cnt; tile_idx++) pcs->ec_info[tile_idx]->stream_tile_ready = false;
+    enc_ctx->stream_pcs[pcs->ppcs->decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH] = pcs;
+    output_stream_fragments(enc_ctx);
+    svt_release_mutex(enc_ctx->stream_mutex);
+}
+
+void svt_aom_stream_tile_done(PictureControlSet *pcs, uint16_t tile_idx) {
+    EncodeContext *enc_ctx = pcs->scs->enc_ctx;
+    svt_block_on_mutex(enc_ctx->stream_mutex);
+    pcs->ec_info[tile_idx]->stream_tile_ready = true;
+    output_stream_fragments(enc_ctx);
+    svt_release_mutex(enc_ctx->stream_mutex);
+}
+
 void *svt_aom_packetization_kernel(void *input_ptr) {
     // Context
     EbThreadContext      *thread_ctx  = (EbThreadContext *)input_ptr;
@@ -527,6 +717,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 
             assert(ppcs->superres_total_recode_loop <= SCALE_NUMERATOR + 1);
             ppcs->superres_rdcost[ppcs->superres_recode_loop] = rdcost;
+            svt_aom_rest_unit_cache_update(ppcs, rdcost);
             ++ppcs->superres_recode_loop;
 
             if (ppcs->superres_recode_loop <= ppcs->superres_total_recode_loop) {
@@ -688,6 +879,9 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             }
         } else if (!scs->static_config.stat_report)
             free_temporal_filtering_buffer(pcs, scs);
+        // Obu streaming: wait for the entropy coding threads to output the last fragment of the frame
+        if (scs->static_config.obu_streaming)
+            svt_block_on_semaphore(pcs->stream_done_sem);
         //****************************************************
         // Input Entropy Results into Reordering Queue
         //****************************************************
@@ -701,19 +895,6 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         EbObjectWrapper    *output_stream_wrapper_ptr = pcs->ppcs->output_stream_wrapper_ptr;
         EbBufferHeaderType *output_stream_ptr         = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
 
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            if (scs->static_config.mastering_display.max_luma)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_MDCV,
-                                 (const uint8_t *)&scs->static_config.mastering_display,
-                                 sizeof(scs->static_config.mastering_display));
-            if (scs->static_config.content_light_level.max_cll)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_CLL,
-                                 (const uint8_t *)&scs->static_config.content_light_level,
-                                 sizeof(scs->static_config.content_light_level));
-        }
-
         output_stream_ptr->flags = 0;
 #if !OPT_LD_LATENCY2
         if (pcs->ppcs->end_of_sequence_flag) {
@@ -731,6 +912,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         output_stream_ptr->temporal_layer_index = pcs->ppcs->temporal_layer_index;
         output_stream_ptr->qp                   = pcs->ppcs->picture_qp;
         output_stream_ptr->avg_qp               = pcs->ppcs->avg_qp;
+        output_stream_ptr->scene_change_score   = pcs->ppcs->scene_change_score;
+        output_stream_ptr->flash_score          = pcs->ppcs->flash_score;
         if (scs->static_config.stat_report) {
             output_stream_ptr->luma_sse  = pcs->ppcs->luma_sse;
             output_stream_ptr->cr_sse    = pcs->ppcs->cr_sse;
@@ -775,45 +958,35 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             picture_manager_results_ptr->decode_order   = pcs->ppcs->decode_order;
             picture_manager_results_ptr->scs            = pcs->scs;
         }
-        // Reset the Bitstream before writing to it
-        svt_aom_bitstream_reset(pcs->bitstream_ptr);
-
-        size_t metadata_sz = 0;
-
-        // Code the SPS
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
-            // Add CLL and MDCV meta when frame is keyframe and SPS is written
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
-        }
-
-        if (frm_hdr->show_frame) {
-            // Add HDR10+ dynamic metadata when show frame flag is enabled
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
-            svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+        if (scs->static_config.obu_streaming) {
+            // The frame was already output in fragments, only its size is kept for the rate control
+            output_stream_ptr->p_buffer     = NULL;
+            output_stream_ptr->n_alloc_len  = 0;
+            output_stream_ptr->n_filled_len = pcs->stream_bytes;
         } else {
-            // Copy metadata pointer to the queue entry related to current frame number
-            uint64_t                   current_picture_number = pcs->picture_number;
-            PacketizationReorderEntry *temp_entry =
-                enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
-            temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
-            pcs->ppcs->input_ptr->metadata = NULL;
-            metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
-        }
+            // Reset the Bitstream before writing to it
+            svt_aom_bitstream_reset(pcs->bitstream_ptr);
 
-        svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
+            const size_t metadata_sz = write_frame_prefix_obus(scs, pcs);
 
-        output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
-                                                    metadata_sz);
-        malloc_p_buffer(output_stream_ptr);
+            svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
 
-        assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
+            const uint32_t size = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
+                                             metadata_sz);
+            // A displayed frame ends its tu, its buffer is output as is when no undisplayed frame precedes it
+            if (frm_hdr->show_frame)
+                output_stream_ptr->p_buffer = alloc_output_buffer(
+                    scs, size, &output_stream_ptr->n_alloc_len, &output_stream_ptr->flags);
+            else
+                output_stream_ptr->p_buffer = svt_aom_packet_buffer_alloc(
+                    enc_ctx->packet_buffer_pool, size, &output_stream_ptr->n_alloc_len);
+
+            assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
 
-        copy_data_from_bitstream(enc_ctx, pcs->bitstream_ptr, output_stream_ptr);
+            // Leave room for the temporal delimiter written when the tu is assembled
+            output_stream_ptr->n_filled_len = TD_SIZE;
+            copy_data_from_bitstream(enc_ctx, pcs->bitstream_ptr, output_stream_ptr);
+        }
 
         if (pcs->ppcs->has_show_existing) {
             uint64_t                   next_picture_number = pcs->picture_number + 1;
@@ -836,7 +1009,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         }
 
         // Send the number of bytes per frame to RC
-        pcs->ppcs->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        pcs->ppcs->total_num_bits = (output_stream_ptr->n_filled_len - TD_SIZE) << 3;
         if (scs->passes == 2 && scs->static_config.pass == ENC_FIRST_PASS) {
             StatStruct stat_struct;
             stat_struct.poc = pcs->picture_number;
@@ -904,6 +1077,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         svt_release_object(pcs->ppcs->enc_dec_ptr->enc_dec_wrapper); // Child
         // Release the Parent PCS then the Child PCS
         assert(entropy_coding_results_ptr->pcs_wrapper->live_count == 1);
+        svt_aom_arena_reset(pcs->arena);
         svt_release_object(entropy_coding_results_ptr->pcs_wrapper); // Child
         // Release the Entropy Coding Result
         svt_release_object(entropy_coding_results_wrapper_ptr);
@@ -930,17 +1104,22 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             bool eos = output_stream_ptr->flags & EB_BUFFERFLAG_EOS;
 #endif
 #if OPT_LD_LATENCY2
-            encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
+            if (scs->static_config.obu_streaming) {
+                // The fragments of the frame were already output, drop the placeholder buffer
+                svt_release_object(output_stream_wrapper_ptr);
+            } else {
+                encode_tu(scs, frames, total_bytes, output_stream_ptr);
 
-            if (eos && queue_entry_ptr->has_show_existing)
-                clear_eos_flag(output_stream_ptr);
+                if (eos && queue_entry_ptr->has_show_existing)
+                    clear_eos_flag(output_stream_ptr);
 
-            svt_post_full_object(output_stream_wrapper_ptr);
+                svt_post_full_object(output_stream_wrapper_ptr);
+            }
             if (queue_entry_ptr->has_show_existing) {
                 EbObjectWrapper *existed = pop_undisplayed_frame(enc_ctx);
                 if (existed) {
                     EbBufferHeaderType *existed_output_stream_ptr = (EbBufferHeaderType *)existed->object_ptr;
-                    encode_show_existing(enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
+                    encode_show_existing(scs, queue_entry_ptr, existed_output_stream_ptr);
                     if (eos)
                         set_eos_flag(existed_output_stream_ptr);
                     svt_post_full_object(existed);
@@ -955,17 +1134,22 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             release_frames(enc_ctx, frames);
 
 #else
-            encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
+            if (scs->static_config.obu_streaming) {
+                // The fragments of the frame were already output, drop the placeholder buffer
+                svt_release_object(output_stream_wrapper_ptr);
+            } else {
+                encode_tu(scs, frames, total_bytes, output_stream_ptr);
 
-            if (eos && queue_entry_ptr->has_show_existing)
-                clear_eos_flag(output_stream_ptr);
+                if (eos && queue_entry_ptr->has_show_existing)
+                    clear_eos_flag(output_stream_ptr);
 
-            svt_post_full_object(output_stream_wrapper_ptr);
+                svt_post_full_object(output_stream_wrapper_ptr);
+            }
             if (queue_entry_ptr->has_show_existing) {
                 EbObjectWrapper *existed = pop_undisplayed_frame(enc_ctx);
                 if (existed) {
                     EbBufferHeaderType *existed_output_stream_ptr = (EbBufferHeaderType *)existed->object_ptr;
-                    encode_show_existing(enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
+                    encode_show_existing(scs, queue_entry_ptr, existed_output_stream_ptr);
                     if (eos)
                         set_eos_flag(existed_output_stream_ptr);
                     svt_post_full_object(existed);
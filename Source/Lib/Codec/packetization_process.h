@@ -24,6 +24,9 @@ EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, cons
                                                int rate_control_index, int demux_index, int me_port_index);
 
 extern void *svt_aom_packetization_kernel(void *input_ptr);
+// Obu streaming: called by the entropy coding threads when a picture enters entropy coding and when a tile is coded
+extern void svt_aom_stream_start_picture(PictureControlSet *pcs);
+extern void svt_aom_stream_tile_done(PictureControlSet *pcs, uint16_t tile_idx);
 #if OPT_LD_LATENCY2
 // Release the pd_dpb and ref_pic_list at the end of the sequence
 extern void release_references_eos(SequenceControlSet *scs);
@@ -186,6 +186,7 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->b64_me_qindex);
     EB_DELETE(obj->bitstream_ptr);
     EB_DELETE_PTR_ARRAY(obj->ec_info, tile_cnt);
+    EB_DELETE(obj->arena);
 
     const int32_t num_planes = 3; // av1_num_planes(cm);
     for (int32_t pl = 0; pl < num_planes; ++pl) {
@@ -198,6 +199,9 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->rusi_picture[0]);
     EB_FREE_ARRAY(obj->rusi_picture[1]);
     EB_FREE_ARRAY(obj->rusi_picture[2]);
+    EB_FREE_ARRAY(obj->rusi_finish[0]);
+    EB_FREE_ARRAY(obj->rusi_finish[1]);
+    EB_FREE_ARRAY(obj->rusi_finish[2]);
     EB_DELETE(obj->input_frame16bit);
 
     EB_FREE_ARRAY(obj->mse_seg[0]);
@@ -208,6 +212,7 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->mip);
     EB_FREE_ARRAY(obj->md_rate_est_ctx);
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
+    EB_DESTROY_SEMAPHORE(obj->stream_done_sem);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
@@ -512,6 +517,9 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
         EB_CALLOC_ARRAY(object_ptr->rusi_picture[0], ntiles[0]);
         EB_CALLOC_ARRAY(object_ptr->rusi_picture[1], ntiles[1]);
         EB_CALLOC_ARRAY(object_ptr->rusi_picture[2], ntiles[1]);
+        EB_CALLOC_ARRAY(object_ptr->rusi_finish[0], ntiles[0]);
+        EB_CALLOC_ARRAY(object_ptr->rusi_finish[1], ntiles[1]);
+        EB_CALLOC_ARRAY(object_ptr->rusi_finish[2], ntiles[1]);
     }
 
     if ((is_16bit) || (init_data_ptr->is_16bit_pipeline)) {
@@ -549,6 +557,8 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     object_ptr->sb_total_count          = all_sb;
     object_ptr->sb_total_count_unscaled = all_sb;
+    // per-picture temporaries of the enc dec pass, allocated while the picture is coded
+    EB_NEW(object_ptr->arena, svt_aom_arena_ctor);
     EB_ALLOC_PTR_ARRAY(object_ptr->sb_ptr_array, object_ptr->sb_total_count_unscaled);
 
     EB_MALLOC_ARRAY(object_ptr->sb_count_nz_coeffs, object_ptr->sb_total_count);
@@ -575,8 +585,11 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     else
         object_ptr->hbd_md = init_data_ptr->hbd_md;
     // Mode Decision Neighbor Arrays
+    object_ptr->md_na_count = init_data_ptr->static_config.pd0_quadrant_parallel && init_data_ptr->log2_sb_size == 5
+        ? NA_TOT_CNT
+        : PD0_QUADRANT_NEIGHBOR_ARRAY_INDEX;
     uint8_t depth;
-    for (depth = 0; depth < NA_TOT_CNT; depth++) {
+    for (depth = 0; depth < object_ptr->md_na_count; depth++) {
         EB_ALLOC_PTR_ARRAY(object_ptr->mdleaf_partition_na[depth], total_tile_cnt);
         EB_ALLOC_PTR_ARRAY(object_ptr->md_y_dcs_na[depth], total_tile_cnt);
         EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_na[depth], total_tile_cnt);
@@ -603,7 +616,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     const uint32_t na_max_pic_h = init_data_ptr->picture_height + 2 * BLOCK_SIZE_64;
 
     for (tile_idx = 0; tile_idx < total_tile_cnt; tile_idx++) {
-        for (depth = 0; depth < NA_TOT_CNT; depth++) {
+        for (depth = 0; depth < object_ptr->md_na_count; depth++) {
             InitData data0[] = {
                 {
                     &object_ptr->mdleaf_partition_na[depth][tile_idx],
@@ -1030,6 +1043,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     // Entropy Rows
     EB_CREATE_MUTEX(object_ptr->entropy_coding_pic_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->stream_done_sem, 0, 1);
 
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
@@ -1128,6 +1142,7 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
 
     if (obj->variance)
         EB_FREE_2D(obj->variance);
+    EB_FREE_ARRAY(obj->sb_boost_variance);
 
     if (obj->picture_histogram) {
         for (int region_in_picture_width_index = 0; region_in_picture_width_index < MAX_NUMBER_OF_REGIONS_IN_WIDTH;
@@ -1167,6 +1182,8 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     EB_DESTROY_MUTEX(obj->temp_filt_mutex);
     EB_DESTROY_MUTEX(obj->debug_mutex);
     EB_FREE_ARRAY(obj->tile_group_info);
+    for (int slot = 0; slot < 2; slot++)
+        for (int plane = 0; plane < MAX_MB_PLANE; plane++) EB_FREE_ARRAY(obj->rest_unit_cache[slot][plane]);
     EB_DESTROY_MUTEX(obj->pa_me_done.mutex);
     if (obj->is_pcs_sb_params)
         svt_pcs_sb_structs_dctor(obj);
@@ -1279,6 +1296,8 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
         else
             block_count = 1;
         EB_MALLOC_2D(object_ptr->variance, object_ptr->b64_total_count, block_count);
+        if (init_data_ptr->enable_variance_boost)
+            EB_MALLOC_ARRAY(object_ptr->sb_boost_variance, object_ptr->b64_total_count);
     }
     if (init_data_ptr->calc_hist) {
         EB_ALLOC_PTR_ARRAY(object_ptr->picture_histogram, MAX_NUMBER_OF_REGIONS_IN_WIDTH);
@@ -1374,15 +1393,29 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
     object_ptr->superres_recode_loop       = 0;
     memset(&object_ptr->superres_rdcost, 0, sizeof(object_ptr->superres_rdcost));
     memset(&object_ptr->superres_denom_array, 0, sizeof(object_ptr->superres_denom_array));
+    object_ptr->rest_unit_cache_best = -1;
+    if (init_data_ptr->static_config.superres_mode == SUPERRES_AUTO) {
+        for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+            const int32_t ss_x   = plane ? subsampling_x : 0;
+            const int32_t ss_y   = plane ? subsampling_y : 0;
+            const int32_t h_unit = svt_aom_count_units_in_tile(RESTORATION_UNITSIZE_MAX,
+                                                               (init_data_ptr->picture_width + ss_x) >> ss_x);
+            const int32_t v_unit = svt_aom_count_units_in_tile(RESTORATION_UNITSIZE_MAX,
+                                                               (init_data_ptr->picture_height + ss_y) >> ss_y);
+            for (int slot = 0; slot < 2; slot++)
+                EB_CALLOC_ARRAY(object_ptr->rest_unit_cache[slot][plane], h_unit * v_unit);
+        }
+    }
 
     object_ptr->frame_resize_enabled = false;
     object_ptr->resize_denom         = SCALE_NUMERATOR;
 
     // Loop variables
-    object_ptr->loop_count      = 0;
-    object_ptr->overshoot_seen  = 0;
-    object_ptr->undershoot_seen = 0;
-    object_ptr->low_cr_seen     = 0;
+    object_ptr->loop_count          = 0;
+    object_ptr->overshoot_seen      = 0;
+    object_ptr->undershoot_seen     = 0;
+    object_ptr->low_cr_seen         = 0;
+    object_ptr->recode_reuse_blocks = 0;
     EB_CREATE_MUTEX(object_ptr->pcs_total_rate_mutex);
     EbInputResolution resolution;
     svt_aom_derive_input_resolution(&resolution, init_data_ptr->picture_width * init_data_ptr->picture_height);
@@ -1583,9 +1616,9 @@ EbErrorType sb_geom_init_pcs(SequenceControlSet *scs, PictureParentControlSet *p
         uint16_t max_block_count = scs->max_block_cnt;
 
         for (md_scan_block_index = 0; md_scan_block_index < max_block_count; md_scan_block_index++) {
-            const BlockGeom *blk_geom = get_blk_geom_mds(md_scan_block_index);
+            const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, md_scan_block_index);
             if (scs->over_boundary_block_mode == 1) {
-                const BlockGeom *sq_blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                const BlockGeom *sq_blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_geom->sqi_mds);
                 uint8_t has_rows = (pcs->sb_geom[sb_index].org_y + sq_blk_geom->org_y + sq_blk_geom->bheight / 2 <
                                     encoding_height);
                 uint8_t has_cols = (pcs->sb_geom[sb_index].org_x + sq_blk_geom->org_x + sq_blk_geom->bwidth / 2 <
@@ -1606,7 +1639,7 @@ EbErrorType sb_geom_init_pcs(SequenceControlSet *scs, PictureParentControlSet *p
                 }
             } else {
                 if (blk_geom->shape != PART_N)
-                    blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                    blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_geom->sqi_mds);
 
                 pcs->sb_geom[sb_index].block_is_allowed[md_scan_block_index] =
                     ((pcs->sb_geom[sb_index].org_x + blk_geom->org_x + blk_geom->bwidth > encoding_width) ||
@@ -34,6 +34,7 @@
 #include "av1me.h"
 #include "hash_motion.h"
 #include "firstpass.h"
+#include "arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,7 +47,9 @@ extern "C" {
 // BDP OFF
 #define MD_NEIGHBOR_ARRAY_INDEX 0
 #define MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX 4
-#define NA_TOT_CNT 5
+// Two sets (MD and NSQ scratch) per PD0 quadrant helper, only allocated with pd0_quadrant_parallel
+#define PD0_QUADRANT_NEIGHBOR_ARRAY_INDEX 5
+#define NA_TOT_CNT 11
 #define AOM_QM_BITS 5
 
 typedef struct DepCntPicInfo {
@@ -253,6 +256,11 @@ typedef struct PictureControlSet {
     EbHandle          entropy_coding_pic_mutex;
     bool              entropy_coding_pic_reset_flag;
     uint8_t           tile_size_bytes_minus_1;
+    // Obu streaming, accessed under enc_ctx->stream_mutex
+    uint16_t          stream_next_tile; // next tile to output
+    bool              stream_header_sent;
+    uint32_t          stream_bytes; // bytes output so far, including the td
+    EbHandle          stream_done_sem; // posted when the last fragment of the picture is output
     EbHandle          intra_mutex;
     uint32_t          intra_coded_area;
     uint64_t          skip_coded_area;
@@ -276,6 +284,12 @@ typedef struct PictureControlSet {
     uint8_t      rest_segments_row_count;
     // flag to indicate whether the frame is extended for restoration search
     bool rest_extend_flag[3];
+    // final restoration search, run as jobs per plane and frame restoration type (see restoration_pick.c):
+    // unit decisions and frame level cost of each type per plane, and jobs left per plane and for the picture
+    RestUnitSearchInfo *rusi_finish[3];
+    double              rest_finish_cost[3][RESTORE_TYPES];
+    uint8_t             rest_finish_plane_jobs[3];
+    uint8_t             rest_finish_jobs;
 
     // Slice Type
     SliceType slice_type;
@@ -314,6 +328,8 @@ typedef struct PictureControlSet {
     NeighborArrayUnit **md_cr_dc_sign_level_coeff_na[NA_TOT_CNT];
     NeighborArrayUnit **md_txfm_context_array[NA_TOT_CNT];
     NeighborArrayUnit **mdleaf_partition_na[NA_TOT_CNT];
+    // Number of allocated MD neighbor array sets
+    uint8_t md_na_count;
 
     // Encode Pass Neighbor Arrays
     NeighborArrayUnit **ep_luma_recon_na;
@@ -399,6 +415,8 @@ typedef struct PictureControlSet {
     CRC_CALCULATOR   crc_calculator1;
     CRC_CALCULATOR   crc_calculator2;
 
+    // per-picture temporaries, reset when the picture is released by packetization
+    EbArena                        *arena;
     FRAME_CONTEXT                  *ec_ctx_array;
     FRAME_CONTEXT                   md_frame_context;
     CdfControls                     cdf_ctrl;
@@ -643,6 +661,12 @@ typedef struct CdefSearchControls {
     uint8_t search_best_ref_fs;
     // Shut CDEF at the picture level based on the skip area of the nearest reference frames.
     uint8_t use_skip_detector;
+    // 0: OFF. Number of first pass primary strengths searched in inter pictures; the primary strengths closest to
+    // the ones selected by the nearest reference frames are kept, along with their second pass strengths.
+    uint8_t ref_prior_top_k;
+    // 0: OFF. Stop the search of a filter block plane when its unfiltered distortion is below <x>/16 of the
+    // quantization noise of the picture qindex; the remaining strengths are assumed to bring no gain.
+    uint8_t early_exit_q_th;
 } CdefSearchControls;
 
 typedef struct CdefReconControls {
@@ -792,6 +816,9 @@ typedef struct PictureParentControlSet {
     bool      idr_flag;
     bool      cra_flag;
     bool      scene_change_flag;
+    // percentage of the picture regions detected as a scene change / flash by the scene transition detector
+    uint8_t   scene_change_score;
+    uint8_t   flash_score;
     int8_t    transition_present; // -1: not computed
     bool      end_of_sequence_flag;
     uint8_t   picture_qp;
@@ -854,6 +881,7 @@ typedef struct PictureParentControlSet {
     EbObjectWrapper *ref_pa_pic_ptr_array[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     uint64_t         ref_pic_poc_array[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     uint16_t       **variance;
+    uint16_t        *sb_boost_variance; // per 64x64 block octile variance used by variance boost
     uint32_t         pre_assignment_buffer_count;
     uint16_t         pic_avg_variance;
 
@@ -1081,6 +1109,12 @@ typedef struct PictureParentControlSet {
     int32_t superres_total_recode_loop; // how many loops to run, set to 2 in dual search mode
     uint8_t superres_denom_array[NUM_SR_SCALES + 1]; // denom candidate array used in auto supreres
     double  superres_rdcost[NUM_SR_SCALES + 1]; // 9 slots, for denom 8 ~ 16
+    // restoration search results per unit of the recode loops, kept for the final recode with the best denom
+    // in two slots: the best loop so far and the running one (see restoration_pick.c)
+    RestUnitCacheEntry *rest_unit_cache[2][MAX_MB_PLANE];
+    uint8_t             rest_unit_cache_denom[2]; // denom searched in each slot, 0 if none
+    double              rest_unit_cache_rdcost[2];
+    int8_t              rest_unit_cache_best; // slot of the loop with the lowest rdcost so far, -1 if none
 
     EbObjectWrapper      *me_data_wrapper;
     MotionEstimationData *pa_me_data;
@@ -1118,6 +1152,8 @@ typedef struct PictureParentControlSet {
     int         overshoot_seen;
     int         undershoot_seen;
     int         low_cr_seen;
+    // 1 if the current recode pass codes the blocks of the previous pass again (fast recode)
+    uint8_t     recode_reuse_blocks;
     uint64_t    pcs_total_rate;
     EbHandle    pcs_total_rate_mutex;
     uint8_t     first_pass_done;
@@ -54,6 +54,14 @@ void  svt_aom_get_max_allocated_me_refs(uint8_t ref_count_used_list0, uint8_t re
 void svt_aom_init_resize_picture(SequenceControlSet* scs, PictureParentControlSet* pcs);
 MvReferenceFrame svt_get_ref_frame_type(uint8_t list, uint8_t ref_idx);
 
+// Accumulative (absolute) histogram difference of one picture region
+static INLINE uint32_t calc_region_ahd(const uint32_t* hist, const uint32_t* ref_hist) {
+    uint32_t ahd = 0;
+    for (int bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin)
+        ahd += ABS((int32_t)hist[bin] - (int32_t)ref_hist[bin]);
+    return ahd;
+}
+
 static uint32_t calc_ahd(
     SequenceControlSet* scs,
     PictureParentControlSet* input_pcs,
@@ -66,11 +74,9 @@ static uint32_t calc_ahd(
     // Loop over regions inside the picture
     for (uint32_t region_in_picture_width_index = 0; region_in_picture_width_index < scs->picture_analysis_number_of_regions_per_width; region_in_picture_width_index++) { // loop over horizontal regions
         for (uint32_t region_in_picture_height_index = 0; region_in_picture_height_index < scs->picture_analysis_number_of_regions_per_height; region_in_picture_height_index++) { // loop over vertical regions
-            uint32_t ahd_per_region = 0;
-            for (int bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin) {
-
-                ahd_per_region += ABS((int32_t)input_pcs->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][bin] - (int32_t)ref_pcs->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][bin]);
-            }
+            uint32_t ahd_per_region = calc_region_ahd(
+                input_pcs->picture_histogram[region_in_picture_width_index][region_in_picture_height_index],
+                ref_pcs->picture_histogram[region_in_picture_width_index][region_in_picture_height_index]);
 
             ahd += ahd_per_region;
             if (ahd_per_region > (region_width * region_height))
@@ -285,8 +291,10 @@ static bool scene_transition_detector(
 
     uint32_t  is_abrupt_change_count = 0;
     uint32_t  is_scene_change_count = 0;
+    uint32_t  is_flash_count = 0;
 
-    uint32_t  region_count_threshold = (uint32_t)(((float)((scs->picture_analysis_number_of_regions_per_width * scs->picture_analysis_number_of_regions_per_height) * 50) / 100) + 0.5);
+    const uint32_t region_count = scs->picture_analysis_number_of_regions_per_width * scs->picture_analysis_number_of_regions_per_height;
+    uint32_t  region_count_threshold = (uint32_t)(((float)(region_count * 50) / 100) + 0.5);
 
     region_width = parent_pcs_window[1]->enhanced_pic->width / scs->picture_analysis_number_of_regions_per_width;
     region_height = parent_pcs_window[1]->enhanced_pic->height / scs->picture_analysis_number_of_regions_per_height;
@@ -298,9 +306,6 @@ static bool scene_transition_detector(
             is_abrupt_change = false;
             is_scene_change = false;
 
-            // accumulative histogram (absolute) differences between the past and current frame
-            uint32_t ahd = 0;
-
             region_width_offset = (region_in_picture_width_index == scs->picture_analysis_number_of_regions_per_width - 1) ?
                 parent_pcs_window[1]->enhanced_pic->width - (scs->picture_analysis_number_of_regions_per_width * region_width) :
                 0;
@@ -314,9 +319,10 @@ static bool scene_transition_detector(
 
             region_threshhold = SCENE_TH * NUM64x64INPIC(region_width, region_height);
 
-            for (int bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin) {
-                ahd += ABS((int32_t)current_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][bin] - (int32_t)pd_ctx->prev_picture_histogram[region_in_picture_width_index][region_in_picture_height_index][bin]);
-            }
+            // accumulative histogram (absolute) differences between the past and current frame
+            uint32_t ahd = calc_region_ahd(
+                current_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index],
+                pd_ctx->prev_picture_histogram[region_in_picture_width_index][region_in_picture_height_index]);
 
             if (pd_ctx->reset_running_avg) {
                 ahd_running_avg[region_in_picture_width_index][region_in_picture_height_index] = ahd;
@@ -344,6 +350,7 @@ static bool scene_transition_detector(
                 uint8_t   aid_present_past = (uint8_t)ABS((int16_t)current_pcs_ptr->average_intensity_per_region[region_in_picture_width_index][region_in_picture_height_index] - (int16_t)pd_ctx->prev_average_intensity_per_region[region_in_picture_width_index][region_in_picture_height_index]);
 
                 if (aid_future_past < FLASH_TH && aid_future_present >= FLASH_TH && aid_present_past >= FLASH_TH) {
+                    is_flash_count++;
                     //SVT_LOG ("\nFlash in frame# %i , %i\n", current_pcs_ptr->picture_number,aid_future_past);
                 }
                 else if (aid_future_present < FADE_TH && aid_present_past < FADE_TH) {
@@ -361,6 +368,10 @@ static bool scene_transition_detector(
         }
     }
 
+    // Per-frame scores reported with the output packets
+    current_pcs_ptr->scene_change_score = (uint8_t)(is_scene_change_count * 100 / region_count);
+    current_pcs_ptr->flash_score = (uint8_t)(is_flash_count * 100 / region_count);
+
     pd_ctx->reset_running_avg = is_abrupt_change_count >= region_count_threshold;
     return is_scene_change_count >= region_count_threshold;
 }
@@ -514,6 +525,8 @@ void dg_detector_hme_level0(struct PictureParentControlSet *ppcs, uint32_t seg_i
     uint32_t y_b64_start_idx = SEGMENT_START_IDX(y_seg_idx, pic_height_in_b64, ppcs->me_segments_row_count);
     uint32_t y_b64_end_idx = SEGMENT_END_IDX(y_seg_idx, pic_height_in_b64, ppcs->me_segments_row_count);
 
+    // accumulate the dg metrics of the segment locally; they are merged into the frame metrics once the segment is done
+    DGDetectorMetrics seg_metrics = { 0 };
     for (uint32_t y_b64_idx = y_b64_start_idx; y_b64_idx < y_b64_end_idx; ++y_b64_idx) {
         for (uint32_t x_b64_idx = x_b64_start_idx; x_b64_idx < x_b64_end_idx; ++x_b64_idx) {
 
@@ -538,50 +551,52 @@ void dg_detector_hme_level0(struct PictureParentControlSet *ppcs, uint32_t seg_i
                 &hme_level0_sad,
                 &sr_center);
 
-            // lock the dg metrics calculation using a mutex, only one segment can modify the data at a time
-            svt_block_on_mutex(ppcs->dg_detector->metrics_mutex);
-            ppcs->dg_detector->metrics.tot_dist += hme_level0_sad;
+            seg_metrics.tot_dist += hme_level0_sad;
 
-            ppcs->dg_detector->metrics.tot_cplx += (hme_level0_sad > (16 * 16 * 30));
-            ppcs->dg_detector->metrics.tot_active += ((abs(sr_center.col) > 0) || (abs(sr_center.row) > 0));
+            seg_metrics.tot_cplx += (hme_level0_sad > (16 * 16 * 30));
+            seg_metrics.tot_active += ((abs(sr_center.col) > 0) || (abs(sr_center.row) > 0));
             if (y_b64_idx < pic_height_in_b64 / 2) {
                 if (sr_center.row > 0) {
-                    --ppcs->dg_detector->metrics.sum_in_vectors;
+                    --seg_metrics.sum_in_vectors;
                 }
                 else if (sr_center.row < 0) {
-                    ++ppcs->dg_detector->metrics.sum_in_vectors;
+                    ++seg_metrics.sum_in_vectors;
                 }
             }
             else if (y_b64_idx > pic_height_in_b64 / 2) {
                 if (sr_center.row > 0) {
-                    ++ppcs->dg_detector->metrics.sum_in_vectors;
+                    ++seg_metrics.sum_in_vectors;
                 }
                 else if (sr_center.row < 0) {
-                    --ppcs->dg_detector->metrics.sum_in_vectors;
+                    --seg_metrics.sum_in_vectors;
                 }
             }
 
             // Does the col vector point inwards or outwards?
             if (x_b64_idx < pic_width_in_b64 / 2) {
                 if (sr_center.col > 0) {
-                    --ppcs->dg_detector->metrics.sum_in_vectors;
+                    --seg_metrics.sum_in_vectors;
                 }
                 else if (sr_center.col < 0) {
-                    ++ppcs->dg_detector->metrics.sum_in_vectors;
+                    ++seg_metrics.sum_in_vectors;
                 }
             }
             else if (x_b64_idx > pic_width_in_b64 / 2) {
                 if (sr_center.col > 0) {
-                    ++ppcs->dg_detector->metrics.sum_in_vectors;
+                    ++seg_metrics.sum_in_vectors;
                 }
                 else if (sr_center.col < 0) {
-                    --ppcs->dg_detector->metrics.sum_in_vectors;
+                    --seg_metrics.sum_in_vectors;
                 }
             }
-            svt_release_mutex(ppcs->dg_detector->metrics_mutex);
         }
     }
+    // lock the dg metrics calculation using a mutex, only one segment can modify the data at a time
     svt_block_on_mutex(ppcs->dg_detector->metrics_mutex);
+    ppcs->dg_detector->metrics.tot_dist += seg_metrics.tot_dist;
+    ppcs->dg_detector->metrics.tot_cplx += seg_metrics.tot_cplx;
+    ppcs->dg_detector->metrics.tot_active += seg_metrics.tot_active;
+    ppcs->dg_detector->metrics.sum_in_vectors += seg_metrics.sum_in_vectors;
     ppcs->dg_detector->metrics.seg_completed++;
     if (ppcs->dg_detector->metrics.seg_completed == (ppcs->me_segments_column_count*ppcs->me_segments_row_count))
         // signal that all the hme_level0 segments have been performed and dg metrics collected for the frame
@@ -589,7 +604,10 @@ void dg_detector_hme_level0(struct PictureParentControlSet *ppcs, uint32_t seg_i
     svt_release_mutex(ppcs->dg_detector->metrics_mutex);
 }
 
-static void early_hme(
+/* Post the early HME (dg detector) segments of src_pcs against ref_pcs to the motion estimation kernel. The
+ * results are collected by early_hme_wait(), so that the early HME of independent picture pairs can run
+ * concurrently. */
+static void early_hme_start(
     PictureDecisionContext* ctx,
     PictureParentControlSet* src_pcs,
     PictureParentControlSet* ref_pcs) {
@@ -619,6 +637,11 @@ static void early_hme(
         out_results->task_type = TASK_DG_DETECTOR_HME;
         svt_post_full_object(out_results_wrp);
     }
+}
+
+static void early_hme_wait(
+    PictureDecisionContext* ctx,
+    PictureParentControlSet* src_pcs) {
 
     // wait for all segments to complete before the frame based calculations can be performed using the dg metrics
     svt_block_on_semaphore(src_pcs->dg_detector->frame_done_sem);
@@ -679,35 +702,46 @@ static void eval_sub_mini_gop(
     PictureParentControlSet *mid_pcs,
     PictureParentControlSet *end_pcs) {
 
-    early_hme(
+    // The dg metrics are stored in the source picture, so the (mid, start) pair can be searched concurrently
+    // with the (end, start) and (end, mid) pairs
+    early_hme_start(
         ctx,
         end_pcs,
         start_pcs);
+    early_hme_start(
+        ctx,
+        mid_pcs,
+        start_pcs);
 
+    early_hme_wait(
+        ctx,
+        end_pcs);
     uint64_t dist_end_start = ctx->norm_dist;
     uint8_t perc_cplx_end_start = ctx->perc_cplx;
     uint8_t perc_active_end_start = ctx->perc_active;
     int16_t mv_in_out_count_end_start = ctx->mv_in_out_count;
-    early_hme(
+
+    early_hme_start(
         ctx,
         end_pcs,
         mid_pcs);
 
-    uint64_t dist_end_mid = ctx->norm_dist;
-    uint8_t perc_cplx_end_mid = ctx->perc_cplx;
-    uint8_t perc_active_end_mid = ctx->perc_active;
-    int16_t mv_in_out_count_end_mid = ctx->mv_in_out_count;
-
-    early_hme(
+    early_hme_wait(
         ctx,
-        mid_pcs,
-        start_pcs);
-
+        mid_pcs);
     uint64_t dist_mid_start = ctx->norm_dist;
     uint8_t perc_cplx_mid_start = ctx->perc_cplx;
     uint8_t perc_active_mid_start = ctx->perc_active;
     int16_t mv_in_out_count_mid_start = ctx->mv_in_out_count;
 
+    early_hme_wait(
+        ctx,
+        end_pcs);
+    uint64_t dist_end_mid = ctx->norm_dist;
+    uint8_t perc_cplx_end_mid = ctx->perc_cplx;
+    uint8_t perc_active_end_mid = ctx->perc_active;
+    int16_t mv_in_out_count_end_mid = ctx->mv_in_out_count;
+
     calc_mini_gop_activity(
         ctx,
         enc_ctx,
@@ -812,15 +846,29 @@ static void initialize_mini_gop_activity_array(SequenceControlSet* scs, PictureP
         PictureParentControlSet* start_pcs = (PictureParentControlSet*)enc_ctx->pre_assignment_buffer[0]->object_ptr;
         PictureParentControlSet* mid_pcs = (PictureParentControlSet*)enc_ctx->pre_assignment_buffer[((1 << scs->static_config.hierarchical_levels) >> 1) - 1]->object_ptr;
         PictureParentControlSet* end_pcs = (PictureParentControlSet*)enc_ctx->pre_assignment_buffer[enc_ctx->pre_assignment_buffer_count - 1]->object_ptr;
-        eval_sub_mini_gop(
-            ctx,
-            enc_ctx,
-            L6_INDEX,
-            L5_0_INDEX,
-            L5_1_INDEX,
-            start_pcs,
-            mid_pcs,
-            end_pcs);
+        bool activity[3];
+        if (svt_aom_ladder_get_mini_gop(enc_ctx->ladder_client, start_pcs->picture_number, activity) ||
+            svt_aom_analysis_cache_get_mini_gop(enc_ctx->analysis_cache, start_pcs->picture_number, activity)) {
+            ctx->mini_gop_activity_array[L6_INDEX]   = activity[0];
+            ctx->mini_gop_activity_array[L5_0_INDEX] = activity[1];
+            ctx->mini_gop_activity_array[L5_1_INDEX] = activity[2];
+        }
+        else {
+            eval_sub_mini_gop(
+                ctx,
+                enc_ctx,
+                L6_INDEX,
+                L5_0_INDEX,
+                L5_1_INDEX,
+                start_pcs,
+                mid_pcs,
+                end_pcs);
+            activity[0] = ctx->mini_gop_activity_array[L6_INDEX];
+            activity[1] = ctx->mini_gop_activity_array[L5_0_INDEX];
+            activity[2] = ctx->mini_gop_activity_array[L5_1_INDEX];
+        }
+        svt_aom_ladder_put_mini_gop(enc_ctx->ladder_client, start_pcs->picture_number, activity);
+        svt_aom_analysis_cache_put_mini_gop(enc_ctx->analysis_cache, start_pcs->picture_number, activity);
     }
     ctx->list0_only = 0;
     if (scs->list0_only_base_ctrls.enabled) {
@@ -3845,11 +3893,16 @@ static void check_window_availability(SequenceControlSet* scs, EncodeContext* en
 // Perform scene change detection and update relevant signals
 static void perform_scene_change_detection(SequenceControlSet* scs, PictureParentControlSet* pcs, PictureDecisionContext* ctx) {
     if (scs->static_config.scene_change_detection) {
-        pcs->scene_change_flag = scene_transition_detector(
-            ctx,
-            scs,
-            (PictureParentControlSet**)pcs->pd_window);
-
+        // The followers of an ABR ladder reuse the decisions of the leader, and re-encodes the cached decisions
+        if (!svt_aom_ladder_get_scene_change(scs->enc_ctx->ladder_client, pcs) &&
+            !svt_aom_analysis_cache_get_scene_change(scs->enc_ctx->analysis_cache, pcs)) {
+            pcs->scene_change_flag = scene_transition_detector(
+                ctx,
+                scs,
+                (PictureParentControlSet**)pcs->pd_window);
+        }
+        svt_aom_ladder_put_scene_change(scs->enc_ctx->ladder_client, pcs);
+        svt_aom_analysis_cache_put_scene_change(scs->enc_ctx->analysis_cache, pcs);
     }
     else {
         pcs->scene_change_flag = false;
@@ -4888,6 +4941,11 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
                     // Send the pictures in the MG to TF and ME
                     process_pics(scs, ctx);
                 } // End MINI GOPs loop
+                // The followers of an ABR ladder no longer wait for the pre-assignment decisions of the leader
+                if (enc_ctx->pre_assignment_buffer_eos_flag) {
+                    svt_aom_ladder_finish(enc_ctx->ladder_client, LADDER_SCENE_CHANGE);
+                    svt_aom_ladder_finish(enc_ctx->ladder_client, LADDER_MINI_GOP);
+                }
                 // Reset the Pre-Assignment Buffer
                 enc_ctx->pre_assignment_buffer_count = 0;
                 enc_ctx->pre_assignment_buffer_idr_count = 0;
@@ -29,6 +29,7 @@
 #include "pic_operators.h"
 #include "resize.h"
 #include "av1me.h"
+#include "rc_process.h"
 
 #define VARIANCE_PRECISION 16
 
@@ -1544,6 +1545,10 @@ static void compute_picture_spatial_statistics(SequenceControlSet *scs, PictureP
 
         compute_block_mean_compute_variance(scs, pcs, input_padded_pic, b64_idx, input_luma_origin_index);
         pic_tot_variance += (pcs->variance[b64_idx][RASTER_SCAN_CU_INDEX_64x64]);
+        // select the variance boost octile here, in parallel across pictures, rather than in rate control
+        if (scs->static_config.enable_variance_boost)
+            pcs->sb_boost_variance[b64_idx] = svt_aom_variance_boost_sb_variance(pcs->variance[b64_idx],
+                                                                                 scs->static_config.variance_octile);
     }
 
     pcs->pic_avg_variance = (uint16_t)(pic_tot_variance / b64_total_count);
@@ -183,7 +183,7 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
                 NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
             svt_aom_neighbor_array_unit_mode_write(
-                pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[ctx->md_na_idx][tile_idx],
                 (uint8_t *)&dc_sign_level_coeff,
                 ctx->sb_origin_x + ctx->blk_geom->tx_org_x[is_inter][ctx->blk_ptr->tx_depth][txb_itr],
                 ctx->sb_origin_y + ctx->blk_geom->tx_org_y[is_inter][ctx->blk_ptr->tx_depth][txb_itr],
@@ -245,7 +245,7 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
 
             if (ctx->txs_ctrls.enabled) {
                 svt_aom_update_recon_neighbor_array16bit(
-                    pcs->md_tx_depth_1_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    pcs->md_tx_depth_1_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                     ctx->blk_ptr->neigh_top_recon_16bit[0],
                     ctx->blk_ptr->neigh_left_recon_16bit[0],
                     org_x,
@@ -253,7 +253,7 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
                     ctx->blk_geom->bwidth,
                     ctx->blk_geom->bheight);
                 svt_aom_update_recon_neighbor_array16bit(
-                    pcs->md_tx_depth_2_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    pcs->md_tx_depth_2_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                     ctx->blk_ptr->neigh_top_recon_16bit[0],
                     ctx->blk_ptr->neigh_left_recon_16bit[0],
                     org_x,
@@ -289,14 +289,14 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
                                                 ctx->blk_geom->bheight);
 
             if (ctx->txs_ctrls.enabled) {
-                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_1_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_1_luma_recon_na[ctx->md_na_idx][tile_idx],
                                                     ctx->blk_ptr->neigh_top_recon[0],
                                                     ctx->blk_ptr->neigh_left_recon[0],
                                                     org_x,
                                                     org_y,
                                                     ctx->blk_geom->bwidth,
                                                     ctx->blk_geom->bheight);
-                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_2_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_2_luma_recon_na[ctx->md_na_idx][tile_idx],
                                                     ctx->blk_ptr->neigh_top_recon[0],
                                                     ctx->blk_ptr->neigh_left_recon[0],
                                                     org_x,
@@ -330,14 +330,14 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
                                                 ctx->blk_geom->bwidth,
                                                 ctx->blk_geom->bheight);
             if (ctx->txs_ctrls.enabled) {
-                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_1_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_1_luma_recon_na[ctx->md_na_idx][tile_idx],
                                                     ctx->blk_ptr->neigh_top_recon[0],
                                                     ctx->blk_ptr->neigh_left_recon[0],
                                                     org_x,
                                                     org_y,
                                                     ctx->blk_geom->bwidth,
                                                     ctx->blk_geom->bheight);
-                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_2_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                svt_aom_update_recon_neighbor_array(pcs->md_tx_depth_2_luma_recon_na[ctx->md_na_idx][tile_idx],
                                                     ctx->blk_ptr->neigh_top_recon[0],
                                                     ctx->blk_ptr->neigh_left_recon[0],
                                                     org_x,
@@ -371,7 +371,7 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
                                                      ctx->blk_geom->bheight);
             if (ctx->txs_ctrls.enabled) {
                 svt_aom_update_recon_neighbor_array16bit(
-                    pcs->md_tx_depth_1_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    pcs->md_tx_depth_1_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                     ctx->blk_ptr->neigh_top_recon_16bit[0],
                     ctx->blk_ptr->neigh_left_recon_16bit[0],
                     org_x,
@@ -379,7 +379,7 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
                     ctx->blk_geom->bwidth,
                     ctx->blk_geom->bheight);
                 svt_aom_update_recon_neighbor_array16bit(
-                    pcs->md_tx_depth_2_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    pcs->md_tx_depth_2_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                     ctx->blk_ptr->neigh_top_recon_16bit[0],
                     ctx->blk_ptr->neigh_left_recon_16bit[0],
                     org_x,
@@ -411,7 +411,7 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                                    uint32_t blk_mds) {
     uint16_t tile_idx = ctx->tile_index;
 
-    const BlockGeom *blk_geom = get_blk_geom_mds(blk_mds);
+    const BlockGeom *blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_mds);
 
     uint32_t blk_org_x    = ctx->sb_origin_x + blk_geom->org_x;
     uint32_t blk_org_y    = ctx->sb_origin_y + blk_geom->org_y;
@@ -642,9 +642,54 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 }
 
+/*
+ * Start (or stop) copy-on-write snapshots of the MD neighbor arrays in the NSQ neighbor arrays: the units are only
+ * saved when first written, and svt_aom_copy_neighbour_arrays() from the NSQ arrays only restores the units written
+ * since, instead of copying the whole SQ block both ways. The snapshots cover the arrays
+ * svt_aom_copy_neighbour_arrays() would copy for the SQ block.
+ */
+static void set_neighbour_arrays_cow(PictureControlSet *pcs, ModeDecisionContext *ctx, bool start) {
+    const BlockGeom *sq_geom     = get_blk_geom_mds(pcs->scs->blk_geom_mds, ctx->blk_geom->sqi_mds);
+    const bool       recon_8bit  = !ctx->hbd_md;
+    const bool       recon_16bit = ctx->hbd_md ||
+        (ctx->encoder_bit_depth > EB_EIGHT_BIT && ctx->bypass_encdec && ctx->pd_pass == PD_PASS_1);
+    const bool txs = ctx->txs_ctrls.enabled;
+    const bool uv  = sq_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1;
+    const struct {
+        NeighborArrayUnit **const *na;
+        bool                       used;
+    } arrays[] = {{pcs->mdleaf_partition_na, true},
+                  {pcs->md_luma_recon_na, recon_8bit},
+                  {pcs->md_tx_depth_1_luma_recon_na, recon_8bit && txs},
+                  {pcs->md_tx_depth_2_luma_recon_na, recon_8bit && txs},
+                  {pcs->md_cb_recon_na, recon_8bit && uv},
+                  {pcs->md_cr_recon_na, recon_8bit && uv},
+                  {pcs->md_luma_recon_na_16bit, recon_16bit},
+                  {pcs->md_tx_depth_1_luma_recon_na_16bit, recon_16bit && txs},
+                  {pcs->md_tx_depth_2_luma_recon_na_16bit, recon_16bit && txs},
+                  {pcs->md_cb_recon_na_16bit, recon_16bit && uv},
+                  {pcs->md_cr_recon_na_16bit, recon_16bit && uv},
+                  {pcs->md_y_dcs_na, true},
+                  {pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na, true},
+                  {pcs->md_cb_dc_sign_level_coeff_na, uv},
+                  {pcs->md_cr_dc_sign_level_coeff_na, uv},
+                  {pcs->md_txfm_context_array, true}};
+    const uint16_t tile_idx = ctx->tile_index;
+
+    for (uint32_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        if (!arrays[i].na[ctx->md_na_idx])
+            continue;
+        NeighborArrayUnit *na = arrays[i].na[ctx->md_na_idx][tile_idx];
+        if (!start)
+            svt_aom_neighbor_array_unit_cow_stop(na);
+        else if (arrays[i].used)
+            svt_aom_neighbor_array_unit_cow_start(na, arrays[i].na[ctx->nsq_na_idx][tile_idx]);
+    }
+}
+
 static void md_update_all_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                            uint32_t last_blk_index_mds) {
-    ctx->blk_geom       = get_blk_geom_mds(last_blk_index_mds);
+    ctx->blk_geom       = get_blk_geom_mds(pcs->scs->blk_geom_mds, last_blk_index_mds);
     ctx->blk_org_x      = ctx->sb_origin_x + ctx->blk_geom->org_x;
     ctx->blk_org_y      = ctx->sb_origin_y + ctx->blk_geom->org_y;
     ctx->round_origin_x = ((ctx->blk_org_x >> 3) << 3);
@@ -654,15 +699,17 @@ static void md_update_all_neighbour_arrays(PictureControlSet *pcs, ModeDecisionC
     uint8_t avail_blk_flag = ctx->avail_blk_flag[last_blk_index_mds];
     if (avail_blk_flag) {
         mode_decision_update_neighbor_arrays(pcs, ctx, last_blk_index_mds);
-        if (ctx->pd_pass == PD_PASS_1 || !ctx->shut_fast_rate || ctx->rate_est_ctrls.update_skip_ctx_dc_sign_ctx ||
-            ctx->rate_est_ctrls.update_skip_coeff_ctx || ctx->cand_reduction_ctrls.use_neighbouring_mode_ctrls.enabled)
+        if (!ctx->skip_mi_map_update &&
+            (ctx->pd_pass == PD_PASS_1 || !ctx->shut_fast_rate || ctx->rate_est_ctrls.update_skip_ctx_dc_sign_ctx ||
+             ctx->rate_est_ctrls.update_skip_coeff_ctx ||
+             ctx->cand_reduction_ctrls.use_neighbouring_mode_ctrls.enabled))
             svt_aom_update_mi_map(ctx->blk_ptr, ctx->blk_org_x, ctx->blk_org_y, ctx->blk_geom, pcs, ctx);
     }
 }
 
 static void md_update_all_neighbour_arrays_multiple(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                                     uint32_t blk_mds) {
-    ctx->blk_geom = get_blk_geom_mds(blk_mds);
+    ctx->blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_mds);
 
     uint32_t blk_it;
     for (blk_it = 0; blk_it < ctx->blk_geom->totns; blk_it++) {
@@ -1617,17 +1664,17 @@ static void sort_fast_cost_based_candidates(
     struct ModeDecisionContext *ctx, uint32_t input_buffer_start_idx,
     uint32_t  input_buffer_count, //how many cand buffers to sort. one of the buffer can have max cost.
     uint32_t *cand_buff_indices) {
-    ModeDecisionCandidateBuffer **buffer_ptr_array     = ctx->cand_bf_ptr_array;
-    uint32_t                      input_buffer_end_idx = input_buffer_start_idx + input_buffer_count - 1;
-    uint32_t                      buffer_index, i, j;
-    uint32_t                      k = 0;
+    // The costs are read from the cost array of the context the candidate buffers point to
+    const uint64_t *fast_cost_array      = ctx->fast_cost_array;
+    uint32_t        input_buffer_end_idx = input_buffer_start_idx + input_buffer_count - 1;
+    uint32_t        buffer_index, i, j;
+    uint32_t        k = 0;
     for (buffer_index = input_buffer_start_idx; buffer_index <= input_buffer_end_idx; buffer_index++, k++) {
         cand_buff_indices[k] = buffer_index;
     }
     for (i = 0; i < input_buffer_count - 1; ++i) {
         for (j = i + 1; j < input_buffer_count; ++j) {
-            if (*(buffer_ptr_array[cand_buff_indices[j]]->fast_cost) <
-                *(buffer_ptr_array[cand_buff_indices[i]]->fast_cost)) {
+            if (fast_cost_array[cand_buff_indices[j]] < fast_cost_array[cand_buff_indices[i]]) {
                 buffer_index         = cand_buff_indices[i];
                 cand_buff_indices[i] = (uint32_t)cand_buff_indices[j];
                 cand_buff_indices[j] = (uint32_t)buffer_index;
@@ -1637,12 +1684,11 @@ static void sort_fast_cost_based_candidates(
 }
 void sort_full_cost_based_candidates(struct ModeDecisionContext *ctx, uint32_t num_of_cand_to_sort,
                                      uint32_t *cand_buff_indices) {
-    uint32_t                      i, j, index;
-    ModeDecisionCandidateBuffer **buffer_ptr_array = ctx->cand_bf_ptr_array;
+    uint32_t        i, j, index;
+    const uint64_t *full_cost_array = ctx->full_cost_array;
     for (i = 0; i < num_of_cand_to_sort - 1; ++i) {
         for (j = i + 1; j < num_of_cand_to_sort; ++j) {
-            if (*(buffer_ptr_array[cand_buff_indices[j]]->full_cost) <
-                *(buffer_ptr_array[cand_buff_indices[i]]->full_cost)) {
+            if (full_cost_array[cand_buff_indices[j]] < full_cost_array[cand_buff_indices[i]]) {
                 index                = cand_buff_indices[i];
                 cand_buff_indices[i] = (uint32_t)cand_buff_indices[j];
                 cand_buff_indices[j] = (uint32_t)index;
@@ -1681,13 +1727,10 @@ static bool perform_ind_uv_search_last_mds(struct ModeDecisionContext   *ctx,
                 (!ctx->uv_ctrls.skip_ind_uv_if_only_dc || buffer_ptr_array[id]->cand->intra_chroma_mode != UV_DC_PRED)
             ? 1
             : 0;
-        if (is_inter) {
-            if (*buffer_ptr_array[id]->full_cost < best_inter_cost)
-                best_inter_cost = *buffer_ptr_array[id]->full_cost;
-        } else {
-            if (*buffer_ptr_array[id]->full_cost < best_intra_cost)
-                best_intra_cost = *buffer_ptr_array[id]->full_cost;
-        }
+        if (is_inter)
+            best_inter_cost = MIN(best_inter_cost, ctx->full_cost_array[id]);
+        else
+            best_intra_cost = MIN(best_intra_cost, ctx->full_cost_array[id]);
     }
 
     // Update md_stage_3_total_intra_count based based on inter/intra cost deviation
@@ -1818,11 +1861,12 @@ static void md_stage_0(PictureControlSet *pcs, ModeDecisionContext *ctx,
     uint64_t       regular_intra_cost[PAETH_PRED + 1];
     for (unsigned i = 0; i < PAETH_PRED + 1; i++) regular_intra_cost[i] = MAX_CU_COST;
 
-    uint32_t tot_processed_cand = 0;
+    uint32_t       tot_processed_cand = 0;
+    const uint8_t *cand_class_array   = ctx->fast_cand_class_array;
 
     for (uint8_t itr = 0; itr < tot_itr; itr++) {
         for (uint32_t cand_idx = 0; cand_idx < fast_cand_count; cand_idx++) {
-            if (fast_candidate_array[cand_idx].cand_class != ctx->target_class)
+            if (cand_class_array[cand_idx] != ctx->target_class)
                 continue;
 
             ModeDecisionCandidateBuffer *cand_bf = cand_bf_ptr_array_base[highest_cost_index];
@@ -4263,19 +4307,19 @@ static void tx_initialize_neighbor_arrays(PictureControlSet *pcs, ModeDecisionCo
     if (!is_inter) {
         if (ctx->hbd_md)
             ctx->tx_search_luma_recon_na_16bit = ctx->tx_depth == 2
-                ? pcs->md_tx_depth_2_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx]
-                : ctx->tx_depth == 1 ? pcs->md_tx_depth_1_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx]
-                                     : pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+                ? pcs->md_tx_depth_2_luma_recon_na_16bit[ctx->md_na_idx][tile_idx]
+                : ctx->tx_depth == 1 ? pcs->md_tx_depth_1_luma_recon_na_16bit[ctx->md_na_idx][tile_idx]
+                                     : pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx];
         else
             ctx->tx_search_luma_recon_na = ctx->tx_depth == 2
-                ? pcs->md_tx_depth_2_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx]
-                : ctx->tx_depth == 1 ? pcs->md_tx_depth_1_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx]
-                                     : pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+                ? pcs->md_tx_depth_2_luma_recon_na[ctx->md_na_idx][tile_idx]
+                : ctx->tx_depth == 1 ? pcs->md_tx_depth_1_luma_recon_na[ctx->md_na_idx][tile_idx]
+                                     : pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx];
     }
     // Set luma dc sign level coeff
     ctx->full_loop_luma_dc_sign_level_coeff_na = (ctx->tx_depth)
-        ? pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx]
-        : pcs->md_y_dcs_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+        ? pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[ctx->md_na_idx][tile_idx]
+        : pcs->md_y_dcs_na[ctx->md_na_idx][tile_idx];
 }
 
 void tx_update_neighbor_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx, ModeDecisionCandidateBuffer *cand_bf,
@@ -4295,7 +4339,7 @@ void tx_update_neighbor_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx,
                 ctx->hbd_md);
         int8_t dc_sign_level_coeff = cand_bf->quant_dc.y[ctx->txb_itr];
         svt_aom_neighbor_array_unit_mode_write(
-            pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+            pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[ctx->md_na_idx][tile_idx],
             (uint8_t *)&dc_sign_level_coeff,
             ctx->sb_origin_x + ctx->blk_geom->tx_org_x[is_inter][ctx->tx_depth][ctx->txb_itr],
             ctx->sb_origin_y + ctx->blk_geom->tx_org_y[is_inter][ctx->tx_depth][ctx->txb_itr],
@@ -4312,32 +4356,32 @@ static void tx_reset_neighbor_arrays(PictureControlSet *pcs, ModeDecisionContext
         if (!is_inter) {
             if (ctx->hbd_md) {
                 if (tx_depth == 2) {
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_2_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_2_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth,
                                            ctx->blk_geom->bheight,
                                            NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK);
 
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_2_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_2_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth * 2,
                                            MIN(ctx->blk_geom->bheight * 2, sb_size - ctx->blk_geom->org_y),
                                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
                 } else {
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_1_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_1_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth,
                                            ctx->blk_geom->bheight,
                                            NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK);
 
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_1_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_1_luma_recon_na_16bit[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth * 2,
@@ -4346,30 +4390,30 @@ static void tx_reset_neighbor_arrays(PictureControlSet *pcs, ModeDecisionContext
                 }
             } else {
                 if (tx_depth == 2) {
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_2_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_2_luma_recon_na[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth,
                                            ctx->blk_geom->bheight,
                                            NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK);
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_2_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_2_luma_recon_na[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth * 2,
                                            MIN(ctx->blk_geom->bheight * 2, sb_size - ctx->blk_geom->org_y),
                                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
                 } else {
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_1_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_1_luma_recon_na[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth,
                                            ctx->blk_geom->bheight,
                                            NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK);
-                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                                           pcs->md_tx_depth_1_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                    svt_aom_copy_neigh_arr(pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx],
+                                           pcs->md_tx_depth_1_luma_recon_na[ctx->md_na_idx][tile_idx],
                                            ctx->sb_origin_x + ctx->blk_geom->org_x,
                                            ctx->sb_origin_y + ctx->blk_geom->org_y,
                                            ctx->blk_geom->bwidth * 2,
@@ -4378,8 +4422,8 @@ static void tx_reset_neighbor_arrays(PictureControlSet *pcs, ModeDecisionContext
                 }
             }
         }
-        svt_aom_copy_neigh_arr(pcs->md_y_dcs_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
-                               pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+        svt_aom_copy_neigh_arr(pcs->md_y_dcs_na[ctx->md_na_idx][tile_idx],
+                               pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[ctx->md_na_idx][tile_idx],
                                ctx->sb_origin_x + ctx->blk_geom->org_x,
                                ctx->sb_origin_y + ctx->blk_geom->org_y,
                                ctx->blk_geom->bwidth,
@@ -7837,18 +7881,18 @@ static void post_mds0_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                 (int)(mult * MAX((best_md_stage_cost / ((ctx->blk_geom->bwidth * ctx->blk_geom->bheight) << 10)), 1) *
                       ((5 * pcs->ppcs->scs->static_config.qp) - 50)));
 
-    uint64_t                      mds1_class_th            = (pruning_ctrls.mds1_class_th * q_weight) / 1000;
-    uint8_t                       mds1_band_cnt            = pruning_ctrls.mds1_band_cnt;
-    uint16_t                      mds1_cand_th_rank_factor = pruning_ctrls.mds1_cand_th_rank_factor;
-    uint64_t                      mds1_cand_base_th_intra  = (pruning_ctrls.mds1_cand_base_th_intra * q_weight) / 1000;
-    uint64_t                      mds1_cand_base_th_inter  = (pruning_ctrls.mds1_cand_base_th_inter * q_weight) / 1000;
-    ModeDecisionCandidateBuffer **cand_bf_arr              = ctx->cand_bf_ptr_array;
+    uint64_t        mds1_class_th            = (pruning_ctrls.mds1_class_th * q_weight) / 1000;
+    uint8_t         mds1_band_cnt            = pruning_ctrls.mds1_band_cnt;
+    uint16_t        mds1_cand_th_rank_factor = pruning_ctrls.mds1_cand_th_rank_factor;
+    uint64_t        mds1_cand_base_th_intra  = (pruning_ctrls.mds1_cand_base_th_intra * q_weight) / 1000;
+    uint64_t        mds1_cand_base_th_inter  = (pruning_ctrls.mds1_cand_base_th_inter * q_weight) / 1000;
+    const uint64_t *fast_cost_array          = ctx->fast_cost_array;
     for (CandClass cidx = CAND_CLASS_0; cidx < CAND_CLASS_TOTAL; cidx++) {
         const uint64_t mds1_cand_th = is_intra_class(cidx) ? mds1_cand_base_th_intra : mds1_cand_base_th_inter;
         if ((mds1_cand_th != (uint64_t)~0 || mds1_class_th != (uint64_t)~0) && ctx->md_stage_0_count[cidx] > 0 &&
             ctx->md_stage_1_count[cidx] > 0) {
             const uint32_t *cand_buff = ctx->cand_buff_indices[cidx];
-            const uint64_t  best_cost = *cand_bf_arr[cand_buff[0]]->fast_cost;
+            const uint64_t  best_cost = fast_cost_array[cand_buff[0]];
             // inter class pruning
             if (best_cost && best_md_stage_cost && best_cost != best_md_stage_cost) {
                 if (mds1_class_th == 0) {
@@ -7871,7 +7915,7 @@ static void post_mds0_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
             uint32_t cand_count = 1;
             if (best_cost) {
                 while (cand_count < ctx->md_stage_1_count[cidx] &&
-                       (*cand_bf_arr[cand_buff[cand_count]]->fast_cost - best_cost) * 100 / best_cost <
+                       (fast_cost_array[cand_buff[cand_count]] - best_cost) * 100 / best_cost <
                            mds1_cand_th / (mds1_cand_th_rank_factor ? mds1_cand_th_rank_factor * cand_count : 1))
                     cand_count++;
             }
@@ -7915,16 +7959,16 @@ static void post_mds1_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                           1) *
                       ((5 * pcs->ppcs->scs->static_config.qp) - 50)));
 
-    const uint64_t                mds2_cand_th         = (pruning_ctrls.mds2_cand_base_th * q_weight) / 1000;
-    const uint64_t                mds2_class_th        = (pruning_ctrls.mds2_class_th * q_weight) / 1000;
-    const uint8_t                 mds2_band_cnt        = pruning_ctrls.mds2_band_cnt;
-    const uint16_t                mds2_relative_dev_th = pruning_ctrls.mds2_relative_dev_th;
-    ModeDecisionCandidateBuffer **cand_bf_arr          = ctx->cand_bf_ptr_array;
+    const uint64_t  mds2_cand_th         = (pruning_ctrls.mds2_cand_base_th * q_weight) / 1000;
+    const uint64_t  mds2_class_th        = (pruning_ctrls.mds2_class_th * q_weight) / 1000;
+    const uint8_t   mds2_band_cnt        = pruning_ctrls.mds2_band_cnt;
+    const uint16_t  mds2_relative_dev_th = pruning_ctrls.mds2_relative_dev_th;
+    const uint64_t *full_cost_array      = ctx->full_cost_array;
     for (CandClass cidx = CAND_CLASS_0; cidx < CAND_CLASS_TOTAL; cidx++) {
         if ((mds2_cand_th != (uint64_t)~0 || mds2_class_th != (uint64_t)~0) && ctx->md_stage_1_count[cidx] > 0 &&
             ctx->md_stage_2_count[cidx] > 0 && ctx->bypass_md_stage_1 == false) {
             const uint32_t *cand_buff = ctx->cand_buff_indices[cidx];
-            const uint64_t  best_cost = *cand_bf_arr[cand_buff[0]]->full_cost;
+            const uint64_t  best_cost = full_cost_array[cand_buff[0]];
 
             // class pruning
             if (best_cost && best_md_stage_cost && best_cost != best_md_stage_cost) {
@@ -7957,7 +8001,7 @@ static void post_mds1_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                         else if (ctx->mds0_best_idx == ctx->mds1_best_idx)
                             mds2_cand_th_rank_factor += 2;
                     }
-                    uint64_t dev      = (*cand_bf_arr[cand_buff[cand_count]]->full_cost - best_cost) * 100 / best_cost;
+                    uint64_t dev      = (full_cost_array[cand_buff[cand_count]] - best_cost) * 100 / best_cost;
                     uint64_t prev_dev = dev;
                     while (
                         (!mds2_relative_dev_th || dev <= prev_dev + mds2_relative_dev_th) &&
@@ -7967,7 +8011,7 @@ static void post_mds1_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                         if (cand_count >= ctx->md_stage_2_count[cidx])
                             break;
                         prev_dev = dev;
-                        dev      = (*cand_bf_arr[cand_buff[cand_count]]->full_cost - best_cost) * 100 / best_cost;
+                        dev      = (full_cost_array[cand_buff[cand_count]] - best_cost) * 100 / best_cost;
                     }
                 }
                 ctx->md_stage_2_count[cidx] = cand_count;
@@ -7994,16 +8038,16 @@ static void post_mds2_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                           1) *
                       ((5 * pcs->ppcs->scs->static_config.qp) - 50)));
 
-    const uint64_t                mds3_cand_th  = (pruning_ctrls.mds3_cand_base_th * q_weight) / 1000;
-    const uint64_t                mds3_class_th = (pruning_ctrls.mds3_class_th * q_weight) / 1000;
-    const uint8_t                 mds3_band_cnt = pruning_ctrls.mds3_band_cnt;
-    ModeDecisionCandidateBuffer **cand_bf_arr   = ctx->cand_bf_ptr_array;
-    ctx->md_stage_3_total_count                 = 0;
+    const uint64_t  mds3_cand_th    = (pruning_ctrls.mds3_cand_base_th * q_weight) / 1000;
+    const uint64_t  mds3_class_th   = (pruning_ctrls.mds3_class_th * q_weight) / 1000;
+    const uint8_t   mds3_band_cnt   = pruning_ctrls.mds3_band_cnt;
+    const uint64_t *full_cost_array = ctx->full_cost_array;
+    ctx->md_stage_3_total_count     = 0;
     for (CandClass cidx = CAND_CLASS_0; cidx < CAND_CLASS_TOTAL; cidx++) {
         if ((mds3_cand_th != (uint64_t)~0 || mds3_class_th != (uint64_t)~0) && ctx->md_stage_2_count[cidx] > 0 &&
             ctx->md_stage_3_count[cidx] > 0 && ctx->bypass_md_stage_2 == false) {
             const uint32_t *cand_buff = ctx->cand_buff_indices[cidx];
-            const uint64_t  best_cost = *cand_bf_arr[cand_buff[0]]->full_cost;
+            const uint64_t  best_cost = full_cost_array[cand_buff[0]];
 
             // inter class pruning
             if (best_cost && best_md_stage_cost && best_cost != best_md_stage_cost) {
@@ -8028,7 +8072,7 @@ static void post_mds2_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
             if (best_cost)
                 while (
                     cand_count < ctx->md_stage_3_count[cidx] &&
-                    (((*cand_bf_arr[cand_buff[cand_count]]->full_cost - best_cost) * 100) / best_cost < mds3_cand_th)) {
+                    (((full_cost_array[cand_buff[cand_count]] - best_cost) * 100) / best_cost < mds3_cand_th)) {
                     cand_count++;
                 }
             ctx->md_stage_3_count[cidx] = cand_count;
@@ -9446,8 +9490,8 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
             //Sort:  md_stage_1_count[cand_class_it]
             uint32_t *cand_buff_indices = ctx->cand_buff_indices[cand_class_it];
             if (ctx->md_stage_1_count[cand_class_it] == 1) {
-                cand_buff_indices[0] = *(cand_bf_ptr_array[buffer_start_idx]->fast_cost) <
-                        *(cand_bf_ptr_array[buffer_start_idx + 1]->fast_cost)
+                cand_buff_indices[0] = ctx->fast_cost_array[buffer_start_idx] <
+                        ctx->fast_cost_array[buffer_start_idx + 1]
                     ? buffer_start_idx
                     : buffer_start_idx + 1;
             } else {
@@ -9458,8 +9502,8 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
                         1, // # cands to sort. buffer_count_for_curr_class may be wrong when multiple iterations used at MDS0
                     ctx->cand_buff_indices[cand_class_it]);
             }
-            if (*(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->fast_cost) < best_md_stage_cost) {
-                best_md_stage_cost      = *(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->fast_cost);
+            if (ctx->fast_cost_array[cand_buff_indices[0]] < best_md_stage_cost) {
+                best_md_stage_cost      = ctx->fast_cost_array[cand_buff_indices[0]];
                 best_md_stage_dist      = ctx->cand_bf_ptr_array[cand_buff_indices[0]]->luma_fast_dist;
                 ctx->mds0_best_idx      = cand_buff_indices[0];
                 ctx->mds0_best_class_it = cand_class_it;
@@ -9499,8 +9543,8 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
                     sort_full_cost_based_candidates(
                         ctx, ctx->md_stage_1_count[cand_class_it], ctx->cand_buff_indices[cand_class_it]);
                 uint32_t *cand_buff_indices = ctx->cand_buff_indices[cand_class_it];
-                if (*(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->full_cost) < best_md_stage_cost) {
-                    best_md_stage_cost      = *(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->full_cost);
+                if (ctx->full_cost_array[cand_buff_indices[0]] < best_md_stage_cost) {
+                    best_md_stage_cost      = ctx->full_cost_array[cand_buff_indices[0]];
                     ctx->mds1_best_idx      = cand_buff_indices[0];
                     ctx->mds1_best_class_it = cand_class_it;
                 }
@@ -9538,7 +9582,7 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
                     ctx, ctx->md_stage_2_count[cand_class_it], ctx->cand_buff_indices[cand_class_it]);
 
             uint32_t *cand_buff_indices = ctx->cand_buff_indices[cand_class_it];
-            best_md_stage_cost = MIN((*(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->full_cost)), best_md_stage_cost);
+            best_md_stage_cost = MIN(ctx->full_cost_array[cand_buff_indices[0]], best_md_stage_cost);
         }
     }
 
@@ -10142,35 +10186,35 @@ static EbPictureBufferDesc *pad_hbd_pictures(SequenceControlSet *scs, PictureCon
  */
 static INLINE void update_neighbour_arrays_light_pd0(PictureControlSet *pcs, ModeDecisionContext *ctx) {
     const uint16_t tile_idx = ctx->tile_index;
-    ctx->recon_neigh_y      = pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+    ctx->recon_neigh_y      = pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx];
 }
 /*
  * Update the neighbour arrays before starting block processing.
  */
 static void update_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx) {
     const uint16_t tile_idx = ctx->tile_index;
-    ctx->leaf_partition_na  = pcs->mdleaf_partition_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+    ctx->leaf_partition_na  = pcs->mdleaf_partition_na[ctx->md_na_idx][tile_idx];
     if (ctx->encoder_bit_depth > EB_EIGHT_BIT && ctx->bypass_encdec && !ctx->hbd_md && ctx->pd_pass == PD_PASS_1) {
-        ctx->recon_neigh_y  = pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->recon_neigh_cb = pcs->md_cb_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->recon_neigh_cr = pcs->md_cr_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+        ctx->recon_neigh_y  = pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx];
+        ctx->recon_neigh_cb = pcs->md_cb_recon_na[ctx->md_na_idx][tile_idx];
+        ctx->recon_neigh_cr = pcs->md_cr_recon_na[ctx->md_na_idx][tile_idx];
 
-        ctx->luma_recon_na_16bit = pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->cb_recon_na_16bit   = pcs->md_cb_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->cr_recon_na_16bit   = pcs->md_cr_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+        ctx->luma_recon_na_16bit = pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx];
+        ctx->cb_recon_na_16bit   = pcs->md_cb_recon_na_16bit[ctx->md_na_idx][tile_idx];
+        ctx->cr_recon_na_16bit   = pcs->md_cr_recon_na_16bit[ctx->md_na_idx][tile_idx];
     } else if (!ctx->hbd_md) {
-        ctx->recon_neigh_y  = pcs->md_luma_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->recon_neigh_cb = pcs->md_cb_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->recon_neigh_cr = pcs->md_cr_recon_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+        ctx->recon_neigh_y  = pcs->md_luma_recon_na[ctx->md_na_idx][tile_idx];
+        ctx->recon_neigh_cb = pcs->md_cb_recon_na[ctx->md_na_idx][tile_idx];
+        ctx->recon_neigh_cr = pcs->md_cr_recon_na[ctx->md_na_idx][tile_idx];
     } else {
-        ctx->luma_recon_na_16bit = pcs->md_luma_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->cb_recon_na_16bit   = pcs->md_cb_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-        ctx->cr_recon_na_16bit   = pcs->md_cr_recon_na_16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+        ctx->luma_recon_na_16bit = pcs->md_luma_recon_na_16bit[ctx->md_na_idx][tile_idx];
+        ctx->cb_recon_na_16bit   = pcs->md_cb_recon_na_16bit[ctx->md_na_idx][tile_idx];
+        ctx->cr_recon_na_16bit   = pcs->md_cr_recon_na_16bit[ctx->md_na_idx][tile_idx];
     }
-    ctx->luma_dc_sign_level_coeff_na = pcs->md_y_dcs_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-    ctx->cb_dc_sign_level_coeff_na   = pcs->md_cb_dc_sign_level_coeff_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-    ctx->cr_dc_sign_level_coeff_na   = pcs->md_cr_dc_sign_level_coeff_na[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
-    ctx->txfm_context_array          = pcs->md_txfm_context_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+    ctx->luma_dc_sign_level_coeff_na = pcs->md_y_dcs_na[ctx->md_na_idx][tile_idx];
+    ctx->cb_dc_sign_level_coeff_na   = pcs->md_cb_dc_sign_level_coeff_na[ctx->md_na_idx][tile_idx];
+    ctx->cr_dc_sign_level_coeff_na   = pcs->md_cr_dc_sign_level_coeff_na[ctx->md_na_idx][tile_idx];
+    ctx->txfm_context_array          = pcs->md_txfm_context_array[ctx->md_na_idx][tile_idx];
 }
 
 static EbErrorType md_rtime_alloc_palette_info(BlkStruct *md_blk_arr_nsq) {
@@ -10319,8 +10363,8 @@ static bool update_redundant(PictureControlSet *pcs, ModeDecisionContext *ctx) {
             svt_aom_copy_neighbour_arrays( //restore [1] in [0] after done last ns block
                 pcs,
                 ctx,
-                1,
-                0,
+                ctx->nsq_na_idx,
+                ctx->md_na_idx,
                 ctx->blk_geom->sqi_mds);
 
         // Copy results
@@ -10385,7 +10429,7 @@ static bool update_redundant(PictureControlSet *pcs, ModeDecisionContext *ctx) {
 static void process_block_light_pd0(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
                                     const uint8_t blk_split_flag, EbPictureBufferDesc *in_pic, uint32_t sb_addr,
                                     uint32_t blk_idx_mds, uint32_t *next_non_skip_blk_idx_mds, bool *md_early_exit_sq) {
-    ctx->blk_geom      = get_blk_geom_mds(blk_idx_mds);
+    ctx->blk_geom      = get_blk_geom_mds(scs->blk_geom_mds, blk_idx_mds);
     BlkStruct *blk_ptr = ctx->blk_ptr = &ctx->md_blk_arr_nsq[blk_idx_mds];
 
     // Neighbour partition array is not updated in PD0, so set neighbour info to invalid.
@@ -10423,7 +10467,7 @@ static bool get_skip_processing_nsq_block(PictureControlSet *pcs, ModeDecisionCo
  */
 static void process_block_light_pd1(PictureControlSet *pcs, ModeDecisionContext *ctx, EbPictureBufferDesc *in_pic,
                                     uint32_t sb_addr, uint32_t blk_idx_mds) {
-    ctx->blk_geom = get_blk_geom_mds(blk_idx_mds);
+    ctx->blk_geom = get_blk_geom_mds(pcs->scs->blk_geom_mds, blk_idx_mds);
     ctx->blk_ptr  = &ctx->md_blk_arr_nsq[blk_idx_mds];
 
     // LPD1 assumes a fixed partition structure, so partition neighbour arrays (blk_ptr->left_neighbor_partition and
@@ -10517,8 +10561,8 @@ static void process_block(PictureControlSet *pcs, ModeDecisionContext *ctx, cons
             svt_aom_copy_neighbour_arrays( //restore [1] in [0] after done last ns block
                 pcs,
                 ctx,
-                1,
-                0,
+                ctx->nsq_na_idx,
+                ctx->md_na_idx,
                 blk_geom->sqi_mds);
         }
 
@@ -10576,12 +10620,8 @@ static void update_d1_data(PictureControlSet *pcs, ModeDecisionContext *ctx, uin
                 // Copy neighbour arrays to temp buffer for later reuse if testing more than 1 NSQ shape
                 // or will be splitting (SQ doesn't need to update neighbour arrays)
                 if (!ctx->copied_neigh_arrays && copy_neigh_arrays) {
-                    svt_aom_copy_neighbour_arrays( //save a clean neigh in [1], encode uses [0], reload the clean in [0] after done last ns block in a partition
-                        pcs,
-                        ctx,
-                        0,
-                        1,
-                        ctx->blk_geom->sqi_mds);
+                    // save a clean neigh in [1] on write, encode uses [0], reload the clean in [0] after done last ns block in a partition
+                    set_neighbour_arrays_cow(pcs, ctx, true);
                     ctx->copied_neigh_arrays = 1;
                 }
                 md_update_all_neighbour_arrays(pcs, ctx, blk_idx_mds);
@@ -10619,7 +10659,7 @@ static void update_d2_decision_light_pd0(PictureControlSet *pcs, ModeDecisionCon
 
     // only needed to update recon
     if (!ctx->skip_intra && ctx->md_blk_arr_nsq[last_blk_index_mds].split_flag == false) {
-        ctx->blk_geom  = get_blk_geom_mds(ctx->md_blk_arr_nsq[last_blk_index_mds].best_d1_blk);
+        ctx->blk_geom  = get_blk_geom_mds(pcs->scs->blk_geom_mds, ctx->md_blk_arr_nsq[last_blk_index_mds].best_d1_blk);
         ctx->blk_org_x = ctx->sb_origin_x + ctx->blk_geom->org_x;
         ctx->blk_org_y = ctx->sb_origin_y + ctx->blk_geom->org_y;
         ctx->blk_ptr   = &ctx->md_blk_arr_nsq[ctx->md_blk_arr_nsq[last_blk_index_mds].best_d1_blk];
@@ -10734,6 +10774,8 @@ void svt_aom_mode_decision_sb_light_pd1(SequenceControlSet *scs, PictureControlS
                                         const MdcSbData *const mdc_sb_data) {
     // Update neighbour arrays for the SB
     update_neighbour_arrays(pcs, ctx);
+    // The cached predictions are only kept within the SB
+    ctx->inter_pred_cache.generation++;
 
     // get the input picture; if high bit-depth, pad the input pic
     EbPictureBufferDesc *input_pic = pcs->ppcs->enhanced_pic;
@@ -10851,45 +10893,50 @@ static void update_part_neighs(ModeDecisionContext *ctx) {
         : ((PartitionContext *)leaf_partition_na->left_array)[partition_left_neighbor_index].left;
 }
 /*
- * Loop over all passed blocks in an SB and perform mode decision for each block,
- * then output the optimal mode distribution/partitioning for the given SB.
- *
- * For each block, selects the best mode through multiple MD stages (accuracy increases
- * while the number of mode candidates decreases as you move from one stage to another).
- * Based on the block costs, selects the best partition for a parent block (if NSQ
- * shapes are present). Finally, performs inter-depth decision towards a final partitiioning.
+ * Set up the SB-level state of svt_aom_mode_decision_sb().
  */
-void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
-                              const MdcSbData *const mdc_sb_data) {
+void svt_aom_mode_decision_sb_start(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                    MdSbLoopState *state) {
     // Update neighbour arrays for the SB
     update_neighbour_arrays(pcs, ctx);
+    // The cached predictions are only kept within the SB
+    ctx->inter_pred_cache.generation++;
 
     // get the input picture; if high bit-depth, pad the input pic
-    EbPictureBufferDesc *input_pic = pcs->ppcs->enhanced_pic;
+    state->input_pic = pcs->ppcs->enhanced_pic;
     // If will need the 16bit picture, pad the input pic.  Done once for SB.
     if (ctx->hbd_md) {
-        input_pic = pad_hbd_pictures(scs, pcs, ctx, input_pic);
+        state->input_pic = pad_hbd_pictures(scs, pcs, ctx, state->input_pic);
     } else if (ctx->encoder_bit_depth > EB_EIGHT_BIT && ctx->bypass_encdec && ctx->pd_pass == PD_PASS_1) {
         // If using 8bit MD but bypassing EncDec, will need th 16bit pic later, but don't change input_pic
-        pad_hbd_pictures(scs, pcs, ctx, input_pic);
+        pad_hbd_pictures(scs, pcs, ctx, state->input_pic);
     }
     // Initialize variables used to track blocks
-    uint32_t                   leaf_count      = mdc_sb_data->leaf_count;
-    const EbMdcLeafData *const leaf_data_array = mdc_sb_data->leaf_data_array;
-
-    bool     md_early_exit_sq          = 0;
-    uint32_t next_non_skip_blk_idx_mds = 0;
-    ctx->coded_area_sb                 = 0;
-    ctx->coded_area_sb_uv              = 0;
-    ctx->params_status                 = 0;
-    ctx->copied_neigh_arrays           = 0;
+    state->md_early_exit_sq          = 0;
+    state->next_non_skip_blk_idx_mds = 0;
+    ctx->coded_area_sb               = 0;
+    ctx->coded_area_sb_uv            = 0;
+    ctx->params_status               = 0;
+    ctx->copied_neigh_arrays         = 0;
+}
+/*
+ * Perform mode decision for the leaves [first_leaf, end_leaf) of the SB, continuing from the loop state left by the
+ * previous call.
+ */
+void svt_aom_mode_decision_sb_blocks(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                     const MdcSbData *const mdc_sb_data, uint32_t first_leaf, uint32_t end_leaf,
+                                     MdSbLoopState *state) {
+    const EbMdcLeafData *const leaf_data_array           = mdc_sb_data->leaf_data_array;
+    EbPictureBufferDesc       *input_pic                 = state->input_pic;
+    bool                       md_early_exit_sq          = state->md_early_exit_sq;
+    uint32_t                   next_non_skip_blk_idx_mds = state->next_non_skip_blk_idx_mds;
 
     // Iterate over all blocks which are flagged to be considered
-    for (uint32_t blk_idx = 0; blk_idx < leaf_count; blk_idx++) {
+    for (uint32_t blk_idx = first_leaf; blk_idx < end_leaf; blk_idx++) {
         uint32_t                   base_blk_idx_mds = leaf_data_array[blk_idx].mds_idx;
         const EbMdcLeafData *const leaf_data_ptr    = &leaf_data_array[blk_idx];
         const uint8_t              blk_split_flag   = mdc_sb_data->split_flag[blk_idx];
-        ctx->blk_geom                               = get_blk_geom_mds(base_blk_idx_mds);
+        ctx->blk_geom                               = get_blk_geom_mds(scs->blk_geom_mds, base_blk_idx_mds);
         ctx->blk_ptr                                = &ctx->md_blk_arr_nsq[base_blk_idx_mds];
 
         // Reset settings, in case they were over-written by previous block
@@ -10932,7 +10979,7 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
 
             for (uint32_t nsi = 0; nsi < shape_block_cnt; nsi++, blk_idx_mds++) {
                 // Get the blk_geom and blk_ptr for the current block within the shape being tested
-                ctx->blk_geom = get_blk_geom_mds(blk_idx_mds);
+                ctx->blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_idx_mds);
                 ctx->blk_ptr  = &ctx->md_blk_arr_nsq[blk_idx_mds];
 
                 init_block_data(pcs, ctx, blk_split_flag, blk_idx_mds);
@@ -10953,9 +11000,12 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
             svt_aom_copy_neighbour_arrays( //restore [1] in [0] after done last ns block
                 pcs,
                 ctx,
-                1,
-                0,
+                ctx->nsq_na_idx,
+                ctx->md_na_idx,
                 ctx->blk_geom->sqi_mds);
+        // No more restores from [1], so stop saving the neighbor arrays written by the d2 update
+        if (ctx->copied_neigh_arrays)
+            set_neighbour_arrays_cow(pcs, ctx, false);
 
         // Perform d2 inter-depth decision after final d1 block
         update_d2_decision(pcs, ctx);
@@ -10971,4 +11021,32 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
         }
         ctx->copied_neigh_arrays = 0;
     }
+    state->md_early_exit_sq          = md_early_exit_sq;
+    state->next_non_skip_blk_idx_mds = next_non_skip_blk_idx_mds;
+}
+/*
+ * Evaluate the early exit check of blk_mds, the first leaf of an SB quadrant, once the previous quadrants are
+ * decided. Returns true when the remaining quadrants are skipped.
+ */
+bool svt_aom_mode_decision_sb_quadrant_exit(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                            uint32_t blk_mds, MdSbLoopState *state) {
+    ctx->blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_mds);
+    ctx->blk_ptr  = &ctx->md_blk_arr_nsq[blk_mds];
+    check_curr_to_parent_cost(scs, pcs, ctx, &state->next_non_skip_blk_idx_mds, &state->md_early_exit_sq);
+    return state->md_early_exit_sq;
+}
+/*
+ * Loop over all passed blocks in an SB and perform mode decision for each block,
+ * then output the optimal mode distribution/partitioning for the given SB.
+ *
+ * For each block, selects the best mode through multiple MD stages (accuracy increases
+ * while the number of mode candidates decreases as you move from one stage to another).
+ * Based on the block costs, selects the best partition for a parent block (if NSQ
+ * shapes are present). Finally, performs inter-depth decision towards a final partitiioning.
+ */
+void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
+                              const MdcSbData *const mdc_sb_data) {
+    MdSbLoopState state;
+    svt_aom_mode_decision_sb_start(scs, pcs, ctx, &state);
+    svt_aom_mode_decision_sb_blocks(scs, pcs, ctx, mdc_sb_data, 0, mdc_sb_data->leaf_count, &state);
 }
@@ -1389,8 +1389,6 @@ static void generate_b64_me_qindex_map(PictureControlSet *pcs) {
     }
 }
 
-int variance_comp_int(const void *a, const void *b) { return (int)*(uint16_t *)a - *(uint16_t *)b; }
-
 #define VAR_BOOST_MAX_DELTAQ_RANGE 80
 #define VAR_BOOST_MAX_QSTEP_RATIO_BOOST 8
 
@@ -1400,20 +1398,45 @@ int variance_comp_int(const void *a, const void *b) { return (int)*(uint16_t *)a
 #define SUBBLOCKS_IN_SB (SUBBLOCKS_IN_SB_DIM * SUBBLOCKS_IN_SB_DIM)
 #define SUBBLOCKS_IN_OCTILE (SUBBLOCKS_IN_SB / 8)
 
-static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *variances, uint8_t strength,
-                                            EbBitDepth bit_depth, uint8_t octile, uint8_t curve) {
-    // boost q_index based on empirical visual testing, strength 2
-    // variance     qstep_ratio boost (@ base_q_idx 255)
-    // 256          1
-    // 64           1.481
-    // 16           2.192
-    // 4            3.246
-    // 1            4.806
+// Partially orders v[left..right] so that v[nth] holds the value it would have if the range were sorted, with no
+// larger value before it and no smaller value after it
+static void select_nth_variance(uint16_t *v, int left, int right, const int nth) {
+    while (left < right) {
+        // median of three pivot, also sentinels for the scans below
+        const int mid = (left + right) >> 1;
+        if (v[mid] < v[left])
+            SWAP(v[mid], v[left]);
+        if (v[right] < v[left])
+            SWAP(v[right], v[left]);
+        if (v[right] < v[mid])
+            SWAP(v[right], v[mid]);
+        const uint16_t pivot = v[mid];
+        int            i     = left;
+        int            j     = right;
+        while (i <= j) {
+            while (v[i] < pivot) i++;
+            while (v[j] > pivot) j--;
+            if (i <= j) {
+                if (i != j)
+                    SWAP(v[i], v[j]);
+                i++;
+                j--;
+            }
+        }
+        // v[left..j] <= pivot, v[j + 1..i - 1] == pivot, v[i..right] >= pivot
+        if (nth <= j)
+            right = j;
+        else if (nth >= i)
+            left = i;
+        else
+            return;
+    }
+}
 
+uint16_t svt_aom_variance_boost_sb_variance(const uint16_t *variances, uint8_t octile) {
     // copy sb 8x8 variance values to an array for ordering
     uint16_t ordered_variances[64];
     memcpy(&ordered_variances, variances + ME_TIER_ZERO_PU_8x8_0, sizeof(uint16_t) * 64);
-    qsort(&ordered_variances, 64, sizeof(uint16_t), variance_comp_int);
 
     // Sample three 8x8 variance values: at the specified octile, previous octile,
     // and next octile. Make sure we use the last subblock in each octile as the
@@ -1423,6 +1446,11 @@ static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *varian
     const int low_idx = AOMMAX(SUBBLOCKS_IN_OCTILE - 1, mid_idx - SUBBLOCKS_IN_OCTILE);
     const int upp_idx = AOMMIN(SUBBLOCKS_IN_SB - 1, mid_idx + SUBBLOCKS_IN_OCTILE);
 
+    // Only the three sampled ranks need to be in place, each selection narrows the range of the next one
+    select_nth_variance(ordered_variances, 0, SUBBLOCKS_IN_SB - 1, upp_idx);
+    select_nth_variance(ordered_variances, 0, upp_idx - 1, mid_idx);
+    select_nth_variance(ordered_variances, 0, mid_idx - 1, low_idx);
+
     // Weigh the three variances in a 1:2:1 ratio, with rounding (the +2 term).
     // This allows for smoother delta-q transitions among superblocks with
     // mixed-variance features.
@@ -1432,13 +1460,12 @@ static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *varian
 
 #if DEBUG_VAR_BOOST
     SVT_INFO("64x64 variance: %d\n", variances[ME_TIER_ZERO_PU_64x64]);
-    SVT_INFO("8x8 min %d, 1st oct %d, median %d, max %d\n",
-             ordered_variances[0],
-             ordered_variances[7],
-             ordered_variances[31],
-             ordered_variances[63]);
+    SVT_INFO("8x8 octiles %d, %d, %d\n",
+             ordered_variances[low_idx],
+             ordered_variances[mid_idx],
+             ordered_variances[upp_idx]);
     SVT_INFO("8x8 variances\n");
-    uint16_t *variances_row = variances + ME_TIER_ZERO_PU_8x8_0;
+    const uint16_t *variances_row = variances + ME_TIER_ZERO_PU_8x8_0;
 
     for (int row = 0; row < 8; row++) {
         SVT_INFO("%5d %5d %5d %5d %5d %5d %5d %5d\n",
@@ -1459,50 +1486,88 @@ static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *varian
     if (variance == 0)
         variance = 1;
 
+    return variance;
+}
+
+// Same search as svt_av1_compute_qdelta_fp() over a precomputed q table
+static int32_t qindex_at_or_above(const int32_t *q_fp8, int32_t q) {
+    int32_t i;
+    for (i = MIN_Q_INDEX; i < MAX_Q_INDEX - 1; ++i)
+        if (q_fp8[i] >= q)
+            break;
+    return i;
+}
+
+void svt_aom_variance_boost_build_row(int8_t *row, uint8_t base_q_idx, uint8_t strength, EbBitDepth bit_depth,
+                                      uint8_t curve) {
+    // boost q_index based on empirical visual testing, strength 2
+    // variance     qstep_ratio boost (@ base_q_idx 255)
+    // 256          1
+    // 64           1.481
+    // 16           2.192
+    // 4            3.246
+    // 1            4.806
+    int32_t q_fp8[QINDEX_RANGE];
+    for (int32_t i = MIN_Q_INDEX; i <= MAX_Q_INDEX; ++i) q_fp8[i] = svt_av1_convert_qindex_to_q_fp8(i, bit_depth);
+    const int32_t base_q      = q_fp8[base_q_idx];
+    const int32_t start_index = qindex_at_or_above(q_fp8, base_q);
+
     // compute a boost based on a fast-growing formula
     // high and medium variance sbs essentially get no boost, while increasingly lower variance sbs get stronger boosts
     assert(strength >= 1 && strength <= 4);
-    double       qstep_ratio = 0;
     const double strengths[] = {0, 0.65, 1.1, 1.6, 2.5};
 
-    switch (curve) {
-    case 1: /* 1: low-medium contrast boosting curve */
-        qstep_ratio = 0.25 * strength * (-log2((double)variance) + 8) + 1;
-        break;
-    case 2: /* 2: still picture curve, tuned for SSIMULACRA2 performance on CID22 */
-        qstep_ratio = 0.15 * strength * (-log2((double)variance) + 10) + 1;
-        break;
-    default: /* 0: default q step ratio curve */
-        qstep_ratio = pow(1.018, strengths[strength] * (-10 * log2((double)variance) + 80));
-        break;
-    }
-    qstep_ratio = CLIP3(1, VAR_BOOST_MAX_QSTEP_RATIO_BOOST, qstep_ratio);
-
-    int32_t base_q   = svt_av1_convert_qindex_to_q_fp8(base_q_idx, bit_depth);
-    int32_t target_q = (int32_t)(base_q / qstep_ratio);
-    int32_t boost    = 0;
-
-    switch (curve) {
-    case 2: /* still picture boost, tuned for SSIMULACRA2 performance on CID22 */
-        boost = (int32_t)((base_q_idx + 496) * -svt_av1_compute_qdelta_fp(base_q, target_q, bit_depth) / (255 + 1024));
-        break;
-    default: /* curve 0 & 1 boost (default) */
-        boost = (int32_t)((base_q_idx + 40) * -svt_av1_compute_qdelta_fp(base_q, target_q, bit_depth) / (255 + 40));
-        break;
-    }
-    boost = AOMMIN(VAR_BOOST_MAX_DELTAQ_RANGE, boost);
+    for (int v = 0; v < VAR_BOOST_LUT_SIZE; v++) {
+        // a variance of 0 is boosted as 1, see svt_aom_variance_boost_sb_variance()
+        const double variance    = v ? v : 1;
+        double       qstep_ratio = 0;
 
-#if DEBUG_VAR_BOOST
-    SVT_INFO("Variance: %d, Strength: %d, Q-step ratio: %f, Boost: %d, Base q: %d, Target q: %d\n",
-             variance,
-             strength,
-             qstep_ratio,
-             boost,
-             base_q,
-             target_q);
-#endif
+        switch (curve) {
+        case 1: /* 1: low-medium contrast boosting curve */
+            qstep_ratio = 0.25 * strength * (-log2(variance) + 8) + 1;
+            break;
+        case 2: /* 2: still picture curve, tuned for SSIMULACRA2 performance on CID22 */
+            qstep_ratio = 0.15 * strength * (-log2(variance) + 10) + 1;
+            break;
+        default: /* 0: default q step ratio curve */
+            qstep_ratio = pow(1.018, strengths[strength] * (-10 * log2(variance) + 80));
+            break;
+        }
+        qstep_ratio = CLIP3(1, VAR_BOOST_MAX_QSTEP_RATIO_BOOST, qstep_ratio);
 
-    return boost;
+        const int32_t target_q = (int32_t)(base_q / qstep_ratio);
+        const int32_t qdelta   = qindex_at_or_above(q_fp8, target_q) - start_index;
+        int32_t       boost    = 0;
+
+        switch (curve) {
+        case 2: /* still picture boost, tuned for SSIMULACRA2 performance on CID22 */
+            boost = (int32_t)((base_q_idx + 496) * -qdelta / (255 + 1024));
+            break;
+        default: /* curve 0 & 1 boost (default) */
+            boost = (int32_t)((base_q_idx + 40) * -qdelta / (255 + 40));
+            break;
+        }
+        row[v] = (int8_t)AOMMIN(VAR_BOOST_MAX_DELTAQ_RANGE, boost);
+    }
+}
+
+// Returns the boost row of base_q_idx, built on first use. Called from the rate control and the recode paths.
+static const int8_t *get_variance_boost_row(PictureControlSet *pcs, uint8_t base_q_idx) {
+    SequenceControlSet *scs     = pcs->ppcs->scs;
+    EncodeContext      *enc_ctx = scs->enc_ctx;
+    int8_t             *row     = enc_ctx->var_boost_lut + base_q_idx * VAR_BOOST_LUT_SIZE;
+
+    svt_block_on_mutex(enc_ctx->var_boost_lut_mutex);
+    if (!enc_ctx->var_boost_lut_ready[base_q_idx]) {
+        svt_aom_variance_boost_build_row(row,
+                                         base_q_idx,
+                                         scs->static_config.variance_boost_strength,
+                                         scs->static_config.encoder_bit_depth,
+                                         scs->static_config.variance_boost_curve);
+        enc_ctx->var_boost_lut_ready[base_q_idx] = true;
+    }
+    svt_release_mutex(enc_ctx->var_boost_lut_mutex);
+    return row;
 }
 
 void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
@@ -1519,8 +1584,9 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
         sb_cnt = ppcs_ptr->b64_total_count;
     }
 
-    uint8_t min_qindex = MAX_Q_INDEX;
-    uint8_t max_qindex = MIN_Q_INDEX;
+    uint8_t       min_qindex = MAX_Q_INDEX;
+    uint8_t       max_qindex = MIN_Q_INDEX;
+    const int8_t *boost_row  = get_variance_boost_row(pcs, ppcs_ptr->frm_hdr.quantization_params.base_q_idx);
 
 #if DEBUG_VAR_BOOST_STATS
     printf("TPL/CQP SB qindex, frame %llu, temp. level %i\n", pcs->picture_number, pcs->temporal_layer_index);
@@ -1541,12 +1607,16 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
         int boost;
 
         // adjust deltaq based on sb variance, with lower variance resulting in a lower qindex
-        boost = av1_get_deltaq_sb_variance_boost(ppcs_ptr->frm_hdr.quantization_params.base_q_idx,
-                                                 ppcs_ptr->variance[sb_addr],
-                                                 scs->static_config.variance_boost_strength,
-                                                 scs->static_config.encoder_bit_depth,
-                                                 scs->static_config.variance_octile,
-                                                 scs->static_config.variance_boost_curve);
+        // the octile variance of each sb is selected by picture analysis, high variances get no boost
+        const uint16_t variance = ppcs_ptr->sb_boost_variance[sb_addr];
+        boost                   = variance < VAR_BOOST_LUT_SIZE ? boost_row[variance] : 0;
+#if DEBUG_VAR_BOOST
+        SVT_INFO("Variance: %d, Strength: %d, Boost: %d, Base q idx: %d\n",
+                 variance,
+                 scs->static_config.variance_boost_strength,
+                 boost,
+                 ppcs_ptr->frm_hdr.quantization_params.base_q_idx);
+#endif
 #if DEBUG_VAR_BOOST_STATS
         printf("%4d ", boost);
 
@@ -3242,9 +3312,10 @@ static void coded_frames_stat_calc(PictureParentControlSet *ppcs) {
 * reset RC related variable in PPCS
 *****************************************************************************************/
 void reset_rc_param(PictureParentControlSet *ppcs) {
-    ppcs->loop_count      = 0;
-    ppcs->overshoot_seen  = 0;
-    ppcs->undershoot_seen = 0;
+    ppcs->loop_count          = 0;
+    ppcs->overshoot_seen      = 0;
+    ppcs->undershoot_seen     = 0;
+    ppcs->recode_reuse_blocks = 0;
 }
 
 void *svt_aom_rate_control_kernel(void *input_ptr) {
@@ -3286,7 +3357,10 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
             scs = pcs->scs;
             // Get r0
             if (pcs->ppcs->r0_based_qps_qpm) {
-                svt_aom_generate_r0beta(pcs->ppcs);
+                if (!svt_aom_analysis_cache_get_r0(scs->enc_ctx->analysis_cache, pcs->ppcs))
+                    svt_aom_generate_r0beta(pcs->ppcs);
+                if (!is_superres_recode_task)
+                    svt_aom_analysis_cache_put_r0(scs->enc_ctx->analysis_cache, pcs->ppcs);
             }
             // Get intra % in ref frame
             get_ref_intra_percentage(pcs, &pcs->ref_intra_percentage);
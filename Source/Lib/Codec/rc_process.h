@@ -233,4 +233,12 @@ int svt_aom_compute_fast_lambda(struct PictureControlSet *pcs, uint8_t q_index,
 struct PictureParentControlSet;
 void svt_aom_cyclic_refresh_init(struct PictureParentControlSet *ppcs);
 
+// Variances above 1024 get a q step ratio of 1, i.e. no boost, with every variance boost curve
+#define VAR_BOOST_LUT_SIZE 1025
+// Returns the variance used to boost a 64x64 block, derived from its 8x8 variances at the given octile
+uint16_t svt_aom_variance_boost_sb_variance(const uint16_t *variances, uint8_t octile);
+// Fills the boost of every variance below VAR_BOOST_LUT_SIZE for the given base_q_idx
+void svt_aom_variance_boost_build_row(int8_t *row, uint8_t base_q_idx, uint8_t strength, EbBitDepth bit_depth,
+                                      uint8_t curve);
+
 #endif // EbRateControl_h
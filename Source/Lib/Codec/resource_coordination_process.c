@@ -1028,6 +1028,9 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 svt_aom_reset_resized_picture(scs, pcs, pcs->enhanced_pic);
             pcs->superres_total_recode_loop = 0;
             pcs->superres_recode_loop       = 0;
+            pcs->rest_unit_cache_best       = -1;
+            pcs->rest_unit_cache_denom[0]   = 0;
+            pcs->rest_unit_cache_denom[1]   = 0;
             svt_av1_get_time(&pcs->start_time_seconds, &pcs->start_time_u_seconds);
             pcs->seq_param_changed = (context_ptr->seq_param_change) ? true : false;
             // set the scs wrapper to be released after the picture is done
@@ -1073,11 +1076,13 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 pcs->y8b_wrapper = NULL;
             }
             // Set Picture Control Flags
-            pcs->idr_flag          = scs->enc_ctx->initial_picture;
-            pcs->cra_flag          = 0;
-            pcs->scene_change_flag = false;
-            pcs->qp_on_the_fly     = false;
-            pcs->b64_total_count   = scs->b64_total_count;
+            pcs->idr_flag           = scs->enc_ctx->initial_picture;
+            pcs->cra_flag           = 0;
+            pcs->scene_change_flag  = false;
+            pcs->scene_change_score = 0;
+            pcs->flash_score        = 0;
+            pcs->qp_on_the_fly      = false;
+            pcs->b64_total_count    = scs->b64_total_count;
             if (scs->speed_control_flag) {
                 speed_buffer_control(context_ptr, pcs, scs);
             } else
@@ -22,6 +22,7 @@
 #include "resource_coordination_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "restoration_pick.h"
 
 /**************************************
  * Rest Context
@@ -29,6 +30,7 @@
 typedef struct RestContext {
     EbDctor dctor;
     EbFifo *rest_input_fifo_ptr;
+    EbFifo *rest_feedback_fifo_ptr;
     EbFifo *rest_output_fifo_ptr;
     EbFifo *picture_demux_fifo_ptr;
 
@@ -53,7 +55,6 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
 void        pad_ref_and_set_flags(PictureControlSet *pcs, SequenceControlSet *scs);
 void        restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, const Yv12BufferConfig *src,
                                    Yv12BufferConfig *trial_frame_rst, PictureControlSet *pcs, uint32_t segment_index);
-void        rest_finish_search(PictureControlSet *pcs);
 void        svt_av1_upscale_normative_rows(const Av1Common *cm, const uint8_t *src, int src_stride, uint8_t *dst,
                                            int dst_stride, int rows, int sub_x, int bd, bool is_16bit_pipeline);
 #if DEBUG_UPSCALING
@@ -78,7 +79,7 @@ static void rest_context_dctor(EbPtr p) {
  * Rest Context Constructor
  ******************************************************/
 EbErrorType svt_aom_rest_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
-                                      EbPtr object_init_data_ptr, int index, int demux_index) {
+                                      EbPtr object_init_data_ptr, int index, int demux_index, int feedback_index) {
     const SequenceControlSet       *scs           = enc_handle_ptr->scs_instance_array[0]->scs;
     const EbSvtAv1EncConfiguration *config        = &scs->static_config;
     EbColorFormat                   color_format  = config->encoder_color_format;
@@ -91,6 +92,8 @@ EbErrorType svt_aom_rest_context_ctor(EbThreadContext *thread_ctx, const EbEncHa
     // Input/Output System Resource Manager FIFOs
     context_ptr->rest_input_fifo_ptr  = svt_system_resource_get_consumer_fifo(enc_handle_ptr->cdef_results_resource_ptr,
                                                                              index);
+    context_ptr->rest_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->cdef_results_resource_ptr, feedback_index);
     context_ptr->rest_output_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->rest_results_resource_ptr,
                                                                               index);
     context_ptr->picture_demux_fifo_ptr = svt_system_resource_get_producer_fifo(
@@ -520,16 +523,14 @@ static void copy_statistics_to_ref_obj_ect(PictureControlSet *pcs, SequenceContr
 /******************************************************
  * Rest Kernel
  ******************************************************/
-void *svt_aom_rest_kernel(void *input_ptr) {
-    // Context & SCS & PCS
-    EbThreadContext    *thread_ctx  = (EbThreadContext *)input_ptr;
-    RestContext        *context_ptr = (RestContext *)thread_ctx->priv;
-    PictureControlSet  *pcs;
-    SequenceControlSet *scs;
-
-    //// Input
-    EbObjectWrapper *cdef_results_wrapper;
-    CdefResults     *cdef_results;
+/* Apply the restoration filters decided by the search, finish the reconstruction of the picture
+ * and hand it over to the next processes */
+static void rest_finish_picture(RestContext *context_ptr, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper) {
+    PictureParentControlSet *ppcs     = pcs->ppcs;
+    SequenceControlSet      *scs      = pcs->scs;
+    FrameHeader             *frm_hdr  = &ppcs->frm_hdr;
+    bool                     is_16bit = scs->is_16bit_pipeline;
+    Av1Common               *cm       = ppcs->av1_cm;
 
     //// Output
     EbObjectWrapper     *rest_results_wrapper;
@@ -542,12 +543,195 @@ void *svt_aom_rest_kernel(void *input_ptr) {
 
     bool superres_recode = false;
 
+    if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
+        // Only need recon if REF pic or recon is output
+        if (pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
+            if (pcs->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                pcs->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                pcs->rst_info[2].frame_restoration_type != RESTORE_NONE) {
+                svt_av1_loop_restoration_filter_frame(context_ptr->rst_tmpbuf, cm->frame_to_show, cm, 0);
+            }
+        }
+
+        if (cm->sg_filter_ctrls.enabled) {
+            uint8_t best_ep_cnt = 0;
+            uint8_t best_ep     = 0;
+            for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+                if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                    best_ep     = i;
+                    best_ep_cnt = cm->sg_frame_ep_cnt[i];
+                }
+            }
+            cm->sg_frame_ep = best_ep;
+        }
+    } else {
+        pcs->rst_info[0].frame_restoration_type = RESTORE_NONE;
+        pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
+        pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
+    }
+
+    // delete scaled_input_pic after lr finished
+    EB_DELETE(pcs->scaled_input_pic);
+    if (pcs->ppcs->ref_pic_wrapper != NULL) {
+        // copy stat to ref object (intra_coded_area, Luminance, Scene change detection
+        // flags)
+        copy_statistics_to_ref_obj_ect(pcs, scs);
+    }
+
+    superres_recode = pcs->ppcs->superres_total_recode_loop > 0 ? true : false;
+
+    // Pad the reference picture and set ref POC
+    {
+        if (pcs->ppcs->is_ref == true)
+            pad_ref_and_set_flags(pcs, scs);
+        else {
+            // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and
+            // psnr/ssim calculation
+            if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
+                EbPictureBufferDesc *ref_pic_ptr       = pcs->ppcs->enc_dec_ptr->recon_pic;
+                EbPictureBufferDesc *ref_pic_16bit_ptr = pcs->ppcs->enc_dec_ptr->recon_pic_16bit;
+                // Y
+                uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
+                uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
+                svt_convert_16bit_to_8bit(buf_16bit,
+                                          ref_pic_16bit_ptr->stride_y,
+                                          buf_8bit,
+                                          ref_pic_ptr->stride_y,
+                                          ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1),
+                                          ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1));
+
+                //CB
+                buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
+                buf_8bit  = ref_pic_ptr->buffer_cb;
+                svt_convert_16bit_to_8bit(
+                    buf_16bit,
+                    ref_pic_16bit_ptr->stride_cb,
+                    buf_8bit,
+                    ref_pic_ptr->stride_cb,
+                    (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
+                    (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
+
+                //CR
+                buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
+                buf_8bit  = ref_pic_ptr->buffer_cr;
+                svt_convert_16bit_to_8bit(
+                    buf_16bit,
+                    ref_pic_16bit_ptr->stride_cr,
+                    buf_8bit,
+                    ref_pic_ptr->stride_cr,
+                    (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
+                    (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
+            }
+        }
+    }
+
+    // PSNR and SSIM Calculation.
+    if (superres_recode) { // superres needs psnr to compute rdcost
+        // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
+        EbErrorType return_error = psnr_calculations(pcs, scs, false);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_assert_err(0,
+                               "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                               "calculations");
+        }
+    } else if (scs->static_config.stat_report) {
+        // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
+        EbErrorType return_error = psnr_calculations(pcs, scs, false);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_assert_err(0,
+                               "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                               "calculations");
+        }
+        return_error = svt_aom_ssim_calculations(pcs, scs, true /* free memory here */);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_assert_err(0,
+                               "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
+                               "calculations");
+        }
+    }
+
+    if (!superres_recode) {
+        if (scs->static_config.recon_enabled) {
+            svt_aom_recon_output(pcs, scs);
+        }
+        // post reference picture task in packetization process if it's superres_recode
+        if (pcs->ppcs->is_ref) {
+            // Get Empty PicMgr Results
+            svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+
+            picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
+            picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
+            picture_demux_results_rtr->scs             = pcs->scs;
+            picture_demux_results_rtr->picture_number  = pcs->picture_number;
+            picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
+
+            // Post Reference Picture
+            svt_post_full_object(picture_demux_results_wrapper_ptr);
+        }
+    }
+
+    tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
+    tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
+
+    for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
+        for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
+            const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
+            svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
+            rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
+            rest_results->pcs_wrapper = pcs_wrapper;
+            rest_results->tile_index  = tile_idx;
+            // Post Rest Results
+            svt_post_full_object(rest_results_wrapper);
+        }
+    }
+}
+
+/* Post the restoration type jobs of the final search of a picture but the first one to the rest
+ * processes, run that one here and finish the picture if it was the last job */
+static void rest_finish_search_jobs(RestContext *context_ptr, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper) {
+    RestFinishJob  jobs[MAX_MB_PLANE * 2];
+    const uint32_t job_count = svt_aom_rest_finish_search_init(pcs, jobs);
+    if (!job_count) {
+        rest_finish_picture(context_ptr, pcs, pcs_wrapper);
+        return;
+    }
+    for (uint32_t i = 1; i < job_count; i++) {
+        EbObjectWrapper *job_wrapper;
+        svt_get_empty_object(context_ptr->rest_feedback_fifo_ptr, &job_wrapper);
+        CdefResults *job = (CdefResults *)job_wrapper->object_ptr;
+        job->task_type   = REST_TASKS_FINISH_SEARCH;
+        job->pcs_wrapper = pcs_wrapper;
+        job->plane       = jobs[i].plane;
+        job->rest_type   = jobs[i].rtype;
+        svt_post_full_object(job_wrapper);
+    }
+    if (svt_aom_rest_finish_search_job(pcs, jobs[0].plane, (RestorationType)jobs[0].rtype))
+        rest_finish_picture(context_ptr, pcs, pcs_wrapper);
+}
+
+void *svt_aom_rest_kernel(void *input_ptr) {
+    // Context & SCS & PCS
+    EbThreadContext    *thread_ctx  = (EbThreadContext *)input_ptr;
+    RestContext        *context_ptr = (RestContext *)thread_ctx->priv;
+    PictureControlSet  *pcs;
+    SequenceControlSet *scs;
+
+    //// Input
+    EbObjectWrapper *cdef_results_wrapper;
+    CdefResults     *cdef_results;
+
     for (;;) {
         // Get Cdef Results
         EB_GET_FULL_OBJECT(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper);
 
-        cdef_results                  = (CdefResults *)cdef_results_wrapper->object_ptr;
-        pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
+        cdef_results = (CdefResults *)cdef_results_wrapper->object_ptr;
+        pcs          = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
+        if (cdef_results->task_type == REST_TASKS_FINISH_SEARCH) {
+            if (svt_aom_rest_finish_search_job(pcs, cdef_results->plane, (RestorationType)cdef_results->rest_type))
+                rest_finish_picture(context_ptr, pcs, cdef_results->pcs_wrapper);
+            svt_release_object(cdef_results_wrapper);
+            continue;
+        }
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
         FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
@@ -615,154 +799,20 @@ void *svt_aom_rest_kernel(void *input_ptr) {
 
         //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
         svt_block_on_mutex(pcs->rest_search_mutex);
-
         pcs->tot_seg_searched_rest++;
-        if (pcs->tot_seg_searched_rest == pcs->rest_segments_total_count) {
-            if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
-                rest_finish_search(pcs);
-
-                // Only need recon if REF pic or recon is output
-                if (pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
-                    if (pcs->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                        pcs->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                        pcs->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-                        svt_av1_loop_restoration_filter_frame(context_ptr->rst_tmpbuf, cm->frame_to_show, cm, 0);
-                    }
-                }
-
-                if (cm->sg_filter_ctrls.enabled) {
-                    uint8_t best_ep_cnt = 0;
-                    uint8_t best_ep     = 0;
-                    for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                        if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                            best_ep     = i;
-                            best_ep_cnt = cm->sg_frame_ep_cnt[i];
-                        }
-                    }
-                    cm->sg_frame_ep = best_ep;
-                }
-            } else {
-                pcs->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
-            }
-
-            // delete scaled_input_pic after lr finished
-            EB_DELETE(pcs->scaled_input_pic);
-            if (pcs->ppcs->ref_pic_wrapper != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection
-                // flags)
-                copy_statistics_to_ref_obj_ect(pcs, scs);
-            }
-
-            superres_recode = pcs->ppcs->superres_total_recode_loop > 0 ? true : false;
-
-            // Pad the reference picture and set ref POC
-            {
-                if (pcs->ppcs->is_ref == true)
-                    pad_ref_and_set_flags(pcs, scs);
-                else {
-                    // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and
-                    // psnr/ssim calculation
-                    if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
-                        EbPictureBufferDesc *ref_pic_ptr       = pcs->ppcs->enc_dec_ptr->recon_pic;
-                        EbPictureBufferDesc *ref_pic_16bit_ptr = pcs->ppcs->enc_dec_ptr->recon_pic_16bit;
-                        // Y
-                        uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
-                        uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
-                        svt_convert_16bit_to_8bit(buf_16bit,
-                                                  ref_pic_16bit_ptr->stride_y,
-                                                  buf_8bit,
-                                                  ref_pic_ptr->stride_y,
-                                                  ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1),
-                                                  ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1));
-
-                        //CB
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
-                        buf_8bit  = ref_pic_ptr->buffer_cb;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cb,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cb,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
-
-                        //CR
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
-                        buf_8bit  = ref_pic_ptr->buffer_cr;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cr,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cr,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
-                    }
-                }
-            }
-
-            // PSNR and SSIM Calculation.
-            if (superres_recode) { // superres needs psnr to compute rdcost
-                // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
-                EbErrorType return_error = psnr_calculations(pcs, scs, false);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-            } else if (scs->static_config.stat_report) {
-                // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
-                EbErrorType return_error = psnr_calculations(pcs, scs, false);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-                return_error = svt_aom_ssim_calculations(pcs, scs, true /* free memory here */);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
-                                       "calculations");
-                }
-            }
-
-            if (!superres_recode) {
-                if (scs->static_config.recon_enabled) {
-                    svt_aom_recon_output(pcs, scs);
-                }
-                // post reference picture task in packetization process if it's superres_recode
-                if (pcs->ppcs->is_ref) {
-                    // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
-
-                    picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
-                    picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
-                    picture_demux_results_rtr->scs             = pcs->scs;
-                    picture_demux_results_rtr->picture_number  = pcs->picture_number;
-                    picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
-
-                    // Post Reference Picture
-                    svt_post_full_object(picture_demux_results_wrapper_ptr);
-                }
-            }
+        const bool last_segment = pcs->tot_seg_searched_rest == pcs->rest_segments_total_count;
+        svt_release_mutex(pcs->rest_search_mutex);
 
-            tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
-            tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
-
-            for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
-                for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
-                    const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
-                    svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
-                    rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
-                    rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
-                    rest_results->tile_index  = tile_idx;
-                    // Post Rest Results
-                    svt_post_full_object(rest_results_wrapper);
-                }
-            }
+        if (last_segment) {
+            if (!(ppcs->enable_restoration && frm_hdr->allow_intrabc == 0))
+                rest_finish_picture(context_ptr, pcs, cdef_results->pcs_wrapper);
+            else if (scs->rest_process_init_count == 1) {
+                // no other rest process to share the final search with
+                rest_finish_search(pcs);
+                rest_finish_picture(context_ptr, pcs, cdef_results->pcs_wrapper);
+            } else
+                rest_finish_search_jobs(context_ptr, pcs, cdef_results->pcs_wrapper);
         }
-        svt_release_mutex(pcs->rest_search_mutex);
 
         // Release input Results
         svt_release_object(cdef_results_wrapper);
@@ -18,7 +18,8 @@
  * Extern Function Declarations
  **************************************/
 extern EbErrorType svt_aom_rest_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
-                                             EbPtr object_init_data_ptr, int index, int demux_index);
+                                             EbPtr object_init_data_ptr, int index, int demux_index,
+                                             int feedback_index);
 
 extern void *svt_aom_rest_kernel(void *input_ptr);
 
@@ -121,7 +121,7 @@ Av1PixelRect svt_aom_whole_frame_rect(FrameSize *frm_size, int32_t sub_x, int32_
 // restoration unit can extend to up to 150% its normal width or height. The
 // max with 1 is to deal with tiles that are smaller than half of a restoration
 // unit.
-static int32_t count_units_in_tile(int32_t unit_size, int32_t tile_size) {
+int32_t svt_aom_count_units_in_tile(int32_t unit_size, int32_t tile_size) {
     return AOMMAX((tile_size + (unit_size >> 1)) / unit_size, 1);
 }
 
@@ -143,10 +143,10 @@ EbErrorType svt_av1_alloc_restoration_struct(struct Av1Common *cm, RestorationIn
     // max with 1 is to deal with tiles that are smaller than half of a
     // restoration unit.
     const int32_t unit_size = rsi->restoration_unit_size;
-    const int32_t hpertile  = count_units_in_tile(
+    const int32_t hpertile  = svt_aom_count_units_in_tile(
         unit_size,
         max_tile_w); //FB of size < 1/2 unit_size are included in neigh FB making them bigger!!
-    const int32_t vpertile = count_units_in_tile(unit_size, max_tile_h);
+    const int32_t vpertile = svt_aom_count_units_in_tile(unit_size, max_tile_h);
 
     rsi->units_per_tile      = hpertile * vpertile; //pic_tot_FB
     rsi->horz_units_per_tile = hpertile; //pic_width_in_FB
@@ -1456,8 +1456,8 @@ int32_t svt_av1_loop_restoration_corners_in_sb(Av1Common *cm, SeqHeader *seq_hea
 
     // Calculate the number of restoration units in this tile (which might be
     // strictly less than rsi->horz_units_per_tile and rsi->vert_units_per_tile)
-    const int32_t horz_units = count_units_in_tile(size, tile_w);
-    const int32_t vert_units = count_units_in_tile(size, tile_h);
+    const int32_t horz_units = svt_aom_count_units_in_tile(size, tile_w);
+    const int32_t vert_units = svt_aom_count_units_in_tile(size, tile_h);
 
     // The size of an MI-unit on this plane of the image
     const int32_t ss_x      = is_uv && cm->subsampling_x;
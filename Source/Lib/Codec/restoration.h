@@ -339,6 +339,7 @@ static INLINE int32_t av1_superres_unscaled(const FrameSize *frm_size) {
 }
 
 Av1PixelRect svt_aom_whole_frame_rect(FrameSize *frm_size, int32_t sub_x, int32_t sub_y, int32_t is_uv);
+int32_t      svt_aom_count_units_in_tile(int32_t unit_size, int32_t tile_size);
 
 #define RDDIV_BITS 7
 #define RD_EPB_SHIFT 6
@@ -359,6 +360,13 @@ typedef struct RestUnitSearchInfo {
     RestorationType best_rtype[RESTORE_TYPES - 1];
 } RestUnitSearchInfo;
 
+// Segment search results of a restoration unit, keyed by a hash of the pixels and settings the search reads
+typedef struct RestUnitCacheEntry {
+    uint64_t           key;
+    bool               hit; // the search of the current pass is skipped, the results are reused
+    RestUnitSearchInfo rusi;
+} RestUnitCacheEntry;
+
 #define NUM_STRIPE_FILTERS 4
 
 void svt_aom_wiener_filter_stripe(const RestorationUnitInfo *rui, int32_t stripe_width, int32_t stripe_height,
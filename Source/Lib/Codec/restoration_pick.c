@@ -1,3 +1,4 @@
+#include <stdlib.h>
 /*
  * Copyright (c) 2016, Alliance for Open Media. All rights reserved
  *
@@ -88,6 +89,10 @@ typedef struct {
     // tile in the frame.
     SgrprojInfo sgrproj;
     WienerInfo  wiener;
+
+    // superres recode cache of the plane (NULL if off) and hash of the search settings of the plane
+    RestUnitCacheEntry *cache;
+    uint64_t            cache_seed;
 } RestSearchCtxt;
 
 static void rsc_on_tile(int32_t tile_row, int32_t tile_col, void *priv) {
@@ -1206,6 +1211,8 @@ static void search_sgrproj_seg(const RestorationTileLimits *limits, const Av1Pix
                                void *priv) {
     RestSearchCtxt     *rsc  = (RestSearchCtxt *)priv;
     RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
+    if (rsc->cache && rsc->cache[rest_unit_idx].hit)
+        return;
 
     Av1Common *const cm        = rsc->cm;
     const int32_t    highbd    = cm->use_highbitdepth;
@@ -1289,6 +1296,8 @@ static void search_wiener_seg(const RestorationTileLimits *limits, const Av1Pixe
                                                                         : WIENER_WIN_3TAP;
 
     const int32_t wiener_win = (rsc->plane == AOM_PLANE_Y) ? wn_luma : MIN(wn_luma, WIENER_WIN_CHROMA);
+    if (rsc->cache && rsc->cache[rest_unit_idx].hit)
+        return;
 
     RestorationUnitInfo rui;
     memset(&rui, 0, sizeof(rui));
@@ -1412,6 +1421,8 @@ static void search_norestore_seg(const RestorationTileLimits *limits, const Av1P
 
     RestSearchCtxt     *rsc  = (RestSearchCtxt *)priv;
     RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
+    if (rsc->cache && rsc->cache[rest_unit_idx].hit)
+        return;
 
     const int32_t highbd    = rsc->cm->use_highbitdepth;
     rusi->sse[RESTORE_NONE] = sse_restoration_unit(limits, rsc->src, rsc->cm->frame_to_show, rsc->plane, highbd);
@@ -1440,6 +1451,141 @@ static double search_rest_type_finish(RestSearchCtxt *rsc, RestorationType rtype
 
     return RDCOST_DBL(rsc->x->rdmult, rsc->bits >> 4, rsc->sse);
 }
+static INLINE uint64_t rest_hash_mix(uint64_t h, uint64_t w) {
+    h = (h ^ w) * 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 32);
+}
+// width and stride in bytes
+static uint64_t rest_hash_block(uint64_t h, const uint8_t *buf, int32_t stride, int32_t width, int32_t rows) {
+    for (int32_t r = 0; r < rows; ++r, buf += stride) {
+        int32_t  c = 0;
+        uint64_t w;
+        for (; c + 8 <= width; c += 8) {
+            memcpy(&w, buf + c, 8);
+            h = rest_hash_mix(h, w);
+        }
+        if (c < width) {
+            w = 0;
+            memcpy(&w, buf + c, width - c);
+            h = rest_hash_mix(h, w);
+        }
+    }
+    return h;
+}
+// Slot of the superres recode unit cache filled by the current loop: the slot already searched at the same denom
+// (final recode with the best denom), else the one not holding the best loop so far
+static int32_t rest_unit_cache_slot(const PictureParentControlSet *ppcs) {
+    for (int32_t slot = 0; slot < 2; ++slot)
+        if (ppcs->rest_unit_cache_denom[slot] == ppcs->superres_denom)
+            return slot;
+    return ppcs->rest_unit_cache_best == 0 ? 1 : 0;
+}
+void svt_aom_rest_unit_cache_update(PictureParentControlSet *ppcs, double rdcost) {
+    if (!ppcs->rest_unit_cache[0][0])
+        return;
+    const int32_t slot                 = rest_unit_cache_slot(ppcs);
+    ppcs->rest_unit_cache_denom[slot]  = ppcs->superres_denom;
+    ppcs->rest_unit_cache_rdcost[slot] = rdcost;
+    if (ppcs->rest_unit_cache_best < 0 || rdcost < ppcs->rest_unit_cache_rdcost[ppcs->rest_unit_cache_best])
+        ppcs->rest_unit_cache_best = slot;
+}
+// Hash of everything the segment search of a plane reads besides the pixels of the units
+static uint64_t rest_unit_cache_seed(const PictureControlSet *pcs, int32_t plane) {
+    const PictureParentControlSet *ppcs = pcs->ppcs;
+    const Av1Common *const         cm   = ppcs->av1_cm;
+    const uint64_t                 settings[] = {ppcs->picture_number,
+                                                 plane,
+                                                 ppcs->superres_denom,
+                                                 ppcs->frm_hdr.frame_type,
+                                                 cm->bit_depth,
+                                                 cm->use_highbitdepth,
+                                                 cm->use_boundaries_in_rest_search,
+                                                 (uint8_t)cm->sg_ref_frame_ep[0],
+                                                 (uint8_t)cm->sg_ref_frame_ep[1]};
+    uint64_t h = rest_hash_block(0, (const uint8_t *)settings, 0, sizeof(settings), 1);
+    // the controls only hold byte-sized fields, so there is no padding to skip
+    h = rest_hash_block(h, (const uint8_t *)&cm->wn_filter_ctrls, 0, sizeof(cm->wn_filter_ctrls), 1);
+    return rest_hash_block(h, (const uint8_t *)&cm->sg_filter_ctrls, 0, sizeof(cm->sg_filter_ctrls), 1);
+}
+// Key of a unit: source and recon pixels read by the search, stripe boundaries and the Wiener coeffs inherited from
+// the reference
+static uint64_t rest_unit_cache_key(const RestSearchCtxt *rsc, const RestorationTileLimits *limits,
+                                    const Av1PixelRect *tile_rect, int32_t rest_unit_idx) {
+    const Av1Common *const cm     = rsc->cm;
+    const int32_t          highbd = cm->use_highbitdepth;
+    const int32_t          ss_y   = rsc->plane && cm->subsampling_y;
+    const int32_t          h_beg  = AOMMAX(limits->h_start - RESTORATION_BORDER, 0);
+    const int32_t          h_end  = AOMMIN(limits->h_end + RESTORATION_BORDER, rsc->plane_width);
+    const int32_t          v_beg  = AOMMAX(limits->v_start - RESTORATION_BORDER, 0);
+    const int32_t          v_end  = AOMMIN(limits->v_end + RESTORATION_BORDER, rsc->plane_height);
+
+    uint64_t h = rest_hash_mix(rsc->cache_seed, ((uint64_t)rsc->tile_stripe0 << 32) | (uint32_t)rest_unit_idx);
+    h          = rest_hash_block(
+        h,
+        REAL_PTR(highbd, rsc->src_buffer) + ((limits->v_start * rsc->src_stride + limits->h_start) << highbd),
+        rsc->src_stride << highbd,
+        (limits->h_end - limits->h_start) << highbd,
+        limits->v_end - limits->v_start);
+    h = rest_hash_block(h,
+                        REAL_PTR(highbd, rsc->dgd_buffer) + ((v_beg * rsc->dgd_stride + h_beg) << highbd),
+                        rsc->dgd_stride << highbd,
+                        (h_end - h_beg) << highbd,
+                        v_end - v_beg);
+
+    if (cm->use_boundaries_in_rest_search) {
+        const RestorationStripeBoundaries *rsb = &cm->child_pcs->rst_info[rsc->plane].boundaries;
+        const int32_t full_stripe_height       = RESTORATION_PROC_UNIT_SIZE >> ss_y;
+        const int32_t runit_offset             = RESTORATION_UNIT_OFFSET >> ss_y;
+        const int32_t first = rsc->tile_stripe0 + (limits->v_start - tile_rect->top + runit_offset) / full_stripe_height;
+        const int32_t last  = rsc->tile_stripe0 + (limits->v_end - 1 - tile_rect->top + runit_offset) / full_stripe_height;
+        const int32_t buf_off = (first * RESTORATION_CTX_VERT * rsb->stripe_boundary_stride + limits->h_start)
+            << highbd;
+        const int32_t line_width = (limits->h_end - limits->h_start + 2 * RESTORATION_EXTRA_HORZ) << highbd;
+        const int32_t rows       = (last - first + 1) * RESTORATION_CTX_VERT;
+        h = rest_hash_block(
+            h, rsb->stripe_boundary_above + buf_off, rsb->stripe_boundary_stride << highbd, line_width, rows);
+        h = rest_hash_block(
+            h, rsb->stripe_boundary_below + buf_off, rsb->stripe_boundary_stride << highbd, line_width, rows);
+    }
+    if (cm->wn_filter_ctrls.use_prev_frame_coeffs) {
+        const RestorationUnitInfo *rui = &cm->child_pcs->rst_info[rsc->plane].unit_info[rest_unit_idx];
+        h                              = rest_hash_mix(h, rui->restoration_type);
+        if (rui->restoration_type == RESTORE_WIENER) {
+            h = rest_hash_block(h, (const uint8_t *)rui->wiener_info.vfilter, 0, sizeof(rui->wiener_info.vfilter), 1);
+            h = rest_hash_block(h, (const uint8_t *)rui->wiener_info.hfilter, 0, sizeof(rui->wiener_info.hfilter), 1);
+        }
+    }
+    return h;
+}
+// Reuse the results of the units whose key did not change since they were cached
+static void rest_unit_cache_probe(const RestorationTileLimits *limits, const Av1PixelRect *tile_rect,
+                                  int32_t rest_unit_idx, void *priv) {
+    RestSearchCtxt     *rsc   = (RestSearchCtxt *)priv;
+    RestUnitCacheEntry *entry = &rsc->cache[rest_unit_idx];
+    Av1Common *const    cm    = rsc->cm;
+    const uint64_t      key   = rest_unit_cache_key(rsc, limits, tile_rect, rest_unit_idx);
+
+    entry->hit = entry->key == key;
+    if (!entry->hit) {
+        entry->key = key;
+        return;
+    }
+    rsc->rusi[rest_unit_idx] = entry->rusi;
+    if (cm->sg_filter_ctrls.enabled && (!rsc->plane || cm->sg_filter_ctrls.use_chroma)) {
+        svt_block_on_mutex(cm->child_pcs->rest_search_mutex);
+        cm->sg_frame_ep_cnt[entry->rusi.sgrproj.ep]++;
+        svt_release_mutex(cm->child_pcs->rest_search_mutex);
+    }
+}
+static void rest_unit_cache_store(const RestorationTileLimits *limits, const Av1PixelRect *tile_rect,
+                                  int32_t rest_unit_idx, void *priv) {
+    (void)limits;
+    (void)tile_rect;
+    RestSearchCtxt     *rsc   = (RestSearchCtxt *)priv;
+    RestUnitCacheEntry *entry = &rsc->cache[rest_unit_idx];
+    if (!entry->hit)
+        entry->rusi = rsc->rusi[rest_unit_idx];
+}
 /* Search the available type of restoration filters: OFF, Wiener, and self-guided.
 
    The search will return the best parameters for each type of filter and their associated SSEs,
@@ -1465,12 +1611,18 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, cons
           ? AOM_PLANE_V
           : AOM_PLANE_Y;
 
+    // the superres auto recode searches the same picture at several denoms, then again at the best one
+    PictureParentControlSet *ppcs       = pcs->ppcs;
+    const bool               use_cache  = ppcs->superres_total_recode_loop > 0 && ppcs->rest_unit_cache[0][0];
+    const int32_t            cache_slot = use_cache ? rest_unit_cache_slot(ppcs) : 0;
+
     for (int32_t plane = plane_start; plane <= plane_end; ++plane) {
         RestUnitSearchInfo *rusi = pcs->rusi_picture[plane];
 
         init_rsc_seg(org_fts, src, cm, x, plane, rusi, trial_frame_rst, &rsc);
 
         rsc_p->tmpbuf = rst_tmpbuf;
+        rsc_p->cache  = use_cache ? ppcs->rest_unit_cache[cache_slot][plane] : NULL;
 
         const int32_t highbd = rsc.cm->use_highbitdepth;
         svt_block_on_mutex(pcs->rest_search_mutex);
@@ -1496,6 +1648,17 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, cons
         }
         svt_release_mutex(pcs->rest_search_mutex);
 
+        if (rsc_p->cache) {
+            rsc_p->cache_seed = rest_unit_cache_seed(pcs, plane);
+            svt_aom_foreach_rest_unit_in_frame_seg(rsc_p->cm,
+                                                   rsc_p->plane,
+                                                   rsc_on_tile,
+                                                   rest_unit_cache_probe,
+                                                   rsc_p,
+                                                   pcs->rest_segments_column_count,
+                                                   pcs->rest_segments_row_count,
+                                                   segment_index);
+        }
         svt_aom_foreach_rest_unit_in_frame_seg(rsc_p->cm,
                                                rsc_p->plane,
                                                rsc_on_tile,
@@ -1524,12 +1687,97 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, cons
                                                    pcs->rest_segments_column_count,
                                                    pcs->rest_segments_row_count,
                                                    segment_index);
+
+        if (rsc_p->cache)
+            svt_aom_foreach_rest_unit_in_frame_seg(rsc_p->cm,
+                                                   rsc_p->plane,
+                                                   rsc_on_tile,
+                                                   rest_unit_cache_store,
+                                                   rsc_p,
+                                                   pcs->rest_segments_column_count,
+                                                   pcs->rest_segments_row_count,
+                                                   segment_index);
     }
 }
-/* Given the best parameters for each type of filter and their associated SSEs,
-   decide which filter should be used for each filter block.
+static RestorationType rest_force_type(const Av1Common *cm) {
+    return cm->wn_filter_ctrls.enabled ? (cm->sg_filter_ctrls.enabled ? RESTORE_TYPES : RESTORE_WIENER)
+                                       : (cm->sg_filter_ctrls.enabled ? RESTORE_SGRPROJ : RESTORE_NONE);
+}
+static int32_t rest_plane_end(const Av1Common *cm) {
+    return ((cm->wn_filter_ctrls.enabled && cm->wn_filter_ctrls.use_chroma) ||
+            (cm->sg_filter_ctrls.enabled && cm->sg_filter_ctrls.use_chroma))
+        ? AOM_PLANE_V
+        : AOM_PLANE_Y;
+}
+/* Whether the frame level restoration type r is evaluated for the plane. */
+static bool rest_type_searched(const Av1Common *cm, int32_t plane, RestorationType r) {
+    const RestorationType force_restore_type_d = rest_force_type(cm);
+    const RestorationType num_rtypes           = (rest_tiles_in_plane(cm, plane > 0) > 1) ? RESTORE_TYPES
+                                                                                          : RESTORE_SWITCHABLE_TYPES;
+
+    if (r >= num_rtypes)
+        return false;
+    if ((force_restore_type_d != RESTORE_TYPES) && (r != RESTORE_NONE) && (r != force_restore_type_d))
+        return false;
+    // if current filter was not tested for chroma plane, do not check the cost
+    if (plane &&
+        ((r == RESTORE_WIENER && !cm->wn_filter_ctrls.use_chroma) ||
+         (r == RESTORE_SGRPROJ && !cm->sg_filter_ctrls.use_chroma)))
+        return false;
+    // the switchable search selects among the unit decisions of both filters for this plane
+    if (r == RESTORE_SWITCHABLE && !(rest_type_searched(cm, plane, RESTORE_WIENER) &&
+                                     rest_type_searched(cm, plane, RESTORE_SGRPROJ)))
+        return false;
+    return true;
+}
+static void rest_finish_init_rsc(PictureControlSet *pcs, int32_t plane, RestSearchCtxt *rsc) {
+    rsc->cm       = pcs->ppcs->av1_cm;
+    rsc->x        = pcs->ppcs->av1x;
+    rsc->plane    = plane;
+    rsc->rusi     = pcs->rusi_finish[plane];
+    rsc->pic_num  = (uint32_t)pcs->ppcs->picture_number;
+    rsc->rusi_pic = pcs->rusi_picture[plane];
+}
+/* Given the frame level costs of the filter types of a plane, select the frame restoration type and copy the
+   corresponding unit decisions. */
+static void rest_finish_plane(PictureControlSet *pcs, int32_t plane) {
+    Av1Common *const cm = pcs->ppcs->av1_cm;
+
+    if (rest_type_searched(cm, plane, RESTORE_SWITCHABLE)) {
+        RestSearchCtxt rsc;
+        rest_finish_init_rsc(pcs, plane, &rsc);
+        pcs->rest_finish_cost[plane][RESTORE_SWITCHABLE] = search_rest_type_finish(&rsc, RESTORE_SWITCHABLE);
+    }
+
+    double          best_cost  = 0;
+    RestorationType best_rtype = RESTORE_NONE;
+    for (int32_t rest_type = 0; rest_type < RESTORE_TYPES; ++rest_type) {
+        RestorationType r = (RestorationType)rest_type;
+        if (!rest_type_searched(cm, plane, r))
+            continue;
+        const double cost = pcs->rest_finish_cost[plane][r];
+        if (r == 0 || cost < best_cost) {
+            best_cost  = cost;
+            best_rtype = r;
+        }
+    }
+    cm->child_pcs->rst_info[plane].frame_restoration_type = best_rtype;
+    assert(rest_force_type(cm) == RESTORE_TYPES || best_rtype == rest_force_type(cm) || best_rtype == RESTORE_NONE);
+
+    if (best_rtype != RESTORE_NONE) {
+        const int32_t plane_ntiles = rest_tiles_in_plane(cm, plane > 0);
+        for (int32_t u = 0; u < plane_ntiles; ++u)
+            copy_unit_info(best_rtype, &pcs->rusi_finish[plane][u], &cm->child_pcs->rst_info[plane].unit_info[u]);
+    }
+}
+/* Prepare the final decision of the restoration search of a picture, once the search of all its segments is done.
+
+   The decision is split into one independent job per plane and per Wiener / self-guided frame restoration type,
+   written to jobs[] and returned; they can run concurrently, in any order, through
+   svt_aom_rest_finish_search_job(). The switchable type and the frame restoration type of a plane are decided by
+   the last job of the plane. Planes without jobs are decided here. Returns 0 when the decision is complete.
 */
-void rest_finish_search(PictureControlSet *pcs) {
+static void rest_finish_search_old(PictureControlSet *pcs, int fix) {
     Macroblock              *x                    = pcs->ppcs->av1x;
     Av1Common *const         cm                   = pcs->ppcs->av1_cm;
     PictureParentControlSet *p_pcs_ptr            = pcs->ppcs;
@@ -1538,74 +1786,126 @@ void rest_finish_search(PictureControlSet *pcs) {
                  : ((cm->sg_filter_ctrls.enabled) ? RESTORE_SGRPROJ : RESTORE_NONE);
     int32_t                  ntiles[2];
     for (int32_t is_uv = 0; is_uv < 2; ++is_uv) ntiles[is_uv] = rest_tiles_in_plane(cm, is_uv);
-
-    assert(ntiles[1] <= ntiles[0]);
     RestUnitSearchInfo *rusi = (RestUnitSearchInfo *)svt_aom_memalign(16, sizeof(*rusi) * ntiles[0]);
-
-    // If the restoration unit dimensions are not multiples of
-    // rsi->restoration_unit_size then some elements of the rusi array may be
-    // left uninitialised when we reach copy_unit_info(...). This is not a
-    // problem, as these elements are ignored later, but in order to quiet
-    // Valgrind's warnings we initialise the array below.
     memset(rusi, 0, sizeof(*rusi) * ntiles[0]);
-
     RestSearchCtxt rsc;
     const int32_t  plane_start = AOM_PLANE_Y;
     const int32_t  plane_end   = ((cm->wn_filter_ctrls.enabled && cm->wn_filter_ctrls.use_chroma) ||
                                (cm->sg_filter_ctrls.enabled && cm->sg_filter_ctrls.use_chroma))
            ? AOM_PLANE_V
            : AOM_PLANE_Y;
-
     for (int32_t plane = plane_start; plane <= plane_end; ++plane) {
-        //init rsc context for this plane
+        if (fix)
+            memset(rusi, 0, sizeof(*rusi) * ntiles[0]);
         rsc.cm       = cm;
         rsc.x        = x;
         rsc.plane    = plane;
         rsc.rusi     = rusi;
         rsc.pic_num  = (uint32_t)p_pcs_ptr->picture_number;
         rsc.rusi_pic = pcs->rusi_picture[plane];
-
         const int32_t         plane_ntiles = ntiles[plane > 0];
         const RestorationType num_rtypes   = (plane_ntiles > 1) ? RESTORE_TYPES : RESTORE_SWITCHABLE_TYPES;
-
         double          best_cost  = 0;
         RestorationType best_rtype = RESTORE_NONE;
-
         for (int32_t rest_type = 0; rest_type < num_rtypes; ++rest_type) {
             RestorationType r = (RestorationType)rest_type;
-
             if ((force_restore_type_d != RESTORE_TYPES) && (r != RESTORE_NONE) && (r != force_restore_type_d))
                 continue;
-
             if (plane) {
-                // if current filter was not tested for chroma plane, do not check the cost
                 if ((r == RESTORE_WIENER && !cm->wn_filter_ctrls.use_chroma) ||
                     (r == RESTORE_SGRPROJ && !cm->sg_filter_ctrls.use_chroma))
                     continue;
+                if (fix && r == RESTORE_SWITCHABLE && !(cm->wn_filter_ctrls.use_chroma && cm->sg_filter_ctrls.use_chroma))
+                    continue;
             }
-
             double cost = search_rest_type_finish(&rsc, r);
-
+            if (plane && r == RESTORE_SWITCHABLE) fprintf(stderr, "SW pic %d plane %d cost %f best %f (%d)\n", (int)p_pcs_ptr->picture_number, plane, cost, best_cost, best_rtype);
             if (r == 0 || cost < best_cost) {
                 best_cost  = cost;
                 best_rtype = r;
             }
         }
         cm->child_pcs->rst_info[plane].frame_restoration_type = best_rtype;
-        if (force_restore_type_d != RESTORE_TYPES)
-            assert(best_rtype == force_restore_type_d || best_rtype == RESTORE_NONE);
-
         if (best_rtype != RESTORE_NONE) {
             for (int32_t u = 0; u < plane_ntiles; ++u)
                 copy_unit_info(best_rtype, &rusi[u], &cm->child_pcs->rst_info[plane].unit_info[u]);
         }
     }
+    if (plane_end == AOM_PLANE_Y) {
+        pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
+        pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
+    }
+    svt_aom_free(rusi);
+}
+uint32_t svt_aom_rest_finish_search_init(PictureControlSet *pcs, RestFinishJob *jobs) {
+    if (getenv("OLDREST")) {
+        rest_finish_search_old(pcs, getenv("OLDREST")[0] == 'f');
+        return 0;
+    }
+    Av1Common *const cm        = pcs->ppcs->av1_cm;
+    const int32_t    plane_end = rest_plane_end(cm);
+    uint32_t         job_count = 0;
+
+    for (int32_t plane = AOM_PLANE_Y; plane <= plane_end; ++plane) {
+        const int32_t plane_ntiles = rest_tiles_in_plane(cm, plane > 0);
+        // If the restoration unit dimensions are not multiples of
+        // rsi->restoration_unit_size then some elements of the rusi array may be
+        // left uninitialised when we reach copy_unit_info(...). This is not a
+        // problem, as these elements are ignored later, but in order to quiet
+        // Valgrind's warnings we initialise the array below.
+        memset(pcs->rusi_finish[plane], 0, sizeof(*pcs->rusi_finish[plane]) * plane_ntiles);
+
+        // The cost of RESTORE_NONE also sets the unit SSEs without filtering, used by the other types
+        RestSearchCtxt rsc;
+        rest_finish_init_rsc(pcs, plane, &rsc);
+        pcs->rest_finish_cost[plane][RESTORE_NONE] = search_rest_type_finish(&rsc, RESTORE_NONE);
+
+        pcs->rest_finish_plane_jobs[plane] = 0;
+        for (int32_t rest_type = RESTORE_WIENER; rest_type <= RESTORE_SGRPROJ; ++rest_type) {
+            RestorationType r = (RestorationType)rest_type;
+            if (!rest_type_searched(cm, plane, r))
+                continue;
+            jobs[job_count].plane = plane;
+            jobs[job_count].rtype = r;
+            job_count++;
+            pcs->rest_finish_plane_jobs[plane]++;
+        }
+        if (!pcs->rest_finish_plane_jobs[plane])
+            rest_finish_plane(pcs, plane);
+    }
+    pcs->rest_finish_jobs = job_count;
 
     // if restoration performed for luma only, set chroma to RESTORE_NONE
     if (plane_end == AOM_PLANE_Y) {
         pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
         pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
     }
+    return job_count;
+}
+/* Get the cost of a Wiener or self-guided frame restoration type for a plane. Returns true when the job completes
+   the final decision of the picture. */
+bool svt_aom_rest_finish_search_job(PictureControlSet *pcs, int32_t plane, RestorationType rtype) {
+    RestSearchCtxt rsc;
+    rest_finish_init_rsc(pcs, plane, &rsc);
+    pcs->rest_finish_cost[plane][rtype] = search_rest_type_finish(&rsc, rtype);
+
+    svt_block_on_mutex(pcs->rest_search_mutex);
+    const bool last_of_plane = --pcs->rest_finish_plane_jobs[plane] == 0;
+    svt_release_mutex(pcs->rest_search_mutex);
+    if (last_of_plane)
+        rest_finish_plane(pcs, plane);
+
+    svt_block_on_mutex(pcs->rest_search_mutex);
+    const bool last = --pcs->rest_finish_jobs == 0;
+    svt_release_mutex(pcs->rest_search_mutex);
+    return last;
+}
+/* Given the best parameters for each type of filter and their associated SSEs,
+   decide which filter should be used for each filter block.
+*/
+void rest_finish_search(PictureControlSet *pcs) {
+    RestFinishJob  jobs[MAX_MB_PLANE * 2];
+    const uint32_t job_count = svt_aom_rest_finish_search_init(pcs, jobs);
 
-    svt_aom_free(rusi);
+    for (uint32_t i = 0; i < job_count; i++) svt_aom_rest_finish_search_job(pcs, jobs[i].plane, jobs[i].rtype);
 }
@@ -20,6 +20,19 @@ extern "C" {
 
 struct Yv12BufferConfig;
 struct Av1Comp;
+struct PictureControlSet;
+struct PictureParentControlSet;
+
+// A job of the final restoration search: the frame level cost of a restoration type for a plane
+typedef struct RestFinishJob {
+    uint8_t plane;
+    uint8_t rtype;
+} RestFinishJob;
+
+uint32_t svt_aom_rest_finish_search_init(struct PictureControlSet *pcs, RestFinishJob *jobs);
+bool     svt_aom_rest_finish_search_job(struct PictureControlSet *pcs, int32_t plane, RestorationType rtype);
+void     rest_finish_search(struct PictureControlSet *pcs);
+void     svt_aom_rest_unit_cache_update(struct PictureParentControlSet *ppcs, double rdcost);
 
 static INLINE uint8_t find_average(const uint8_t *src, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end,
                                    int32_t stride) {
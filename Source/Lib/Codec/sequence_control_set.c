@@ -243,9 +243,9 @@ EbErrorType svt_aom_sb_geom_init(SequenceControlSet *scs) {
         uint16_t max_block_count = scs->max_block_cnt;
 
         for (md_scan_block_index = 0; md_scan_block_index < max_block_count; md_scan_block_index++) {
-            const BlockGeom *blk_geom = get_blk_geom_mds(md_scan_block_index);
+            const BlockGeom *blk_geom = get_blk_geom_mds(scs->blk_geom_mds, md_scan_block_index);
             if (scs->over_boundary_block_mode == 1) {
-                const BlockGeom *sq_blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                const BlockGeom *sq_blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_geom->sqi_mds);
                 uint8_t has_rows = (scs->sb_geom[sb_index].org_y + sq_blk_geom->org_y + sq_blk_geom->bheight / 2 <
                                     scs->max_input_luma_height);
                 uint8_t has_cols = (scs->sb_geom[sb_index].org_x + sq_blk_geom->org_x + sq_blk_geom->bwidth / 2 <
@@ -270,7 +270,7 @@ EbErrorType svt_aom_sb_geom_init(SequenceControlSet *scs) {
 
             } else {
                 if (blk_geom->shape != PART_N)
-                    blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                    blk_geom = get_blk_geom_mds(scs->blk_geom_mds, blk_geom->sqi_mds);
 
                 scs->sb_geom[sb_index].block_is_allowed[md_scan_block_index] =
                     ((scs->sb_geom[sb_index].org_x + blk_geom->org_x + blk_geom->bwidth > scs->max_input_luma_width) ||
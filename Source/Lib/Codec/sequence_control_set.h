@@ -59,6 +59,8 @@ typedef struct SequenceControlSet {
     SbGeom *sb_geom;
     /*!< Array of superblock parameters computed at the resource coordination stage */
     B64Geom *b64_geom;
+    /*!< md scan block geometry table of svt_aom_geom_idx, process wide and shared by the instances */
+    const struct BlockGeom *blk_geom_mds;
     /*!< Bitstream level */
     BitstreamLevel level[MAX_NUM_OPERATING_POINTS];
     /*!< Sequence header structure, common between the encoder and decoder */
@@ -1801,7 +1801,11 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
     TplRefList tpl_ref_list[REF_FRAMES + 1]; // Buffer for each ref pic and current pic
     memset(tpl_ref_list, 0, sizeof(tpl_ref_list[0]) * (REF_FRAMES + 1));
 
-    if (pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0) {
+    // The followers of an ABR ladder reuse the TPL results of the leader, and re-encodes skip the TPL groups whose
+    // r0 outputs are all cached
+    const bool tpl_base = pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0;
+    if (tpl_base && !svt_aom_analysis_cache_has_tpl(enc_ctx->analysis_cache, pcs) &&
+        !svt_aom_ladder_get_tpl(enc_ctx->ladder_client, pcs)) {
         // no Tiles path
         if (scs->static_config.tile_rows == 0 && scs->static_config.tile_columns == 0)
             init_tpl_segments(scs, pcs, pcs->tpl_group, frames_in_sw);
@@ -1881,6 +1885,7 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
             if (tpl_on)
                 tpl_mc_flow_synthesizer(pcs->tpl_group, frame_idx, frames_in_sw);
         }
+        svt_aom_ladder_put_tpl(enc_ctx->ladder_client, pcs);
 #if DEBUG_TPL
 
         for (int32_t frame_idx = 0; frame_idx < frames_in_sw; frame_idx++) {
@@ -2019,6 +2024,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
                 segment_band_size  = (segments_ptr->sb_band_count * (segment_band_index + 1) +
                                      segments_ptr->segment_band_count - 1) /
                     segments_ptr->segment_band_count;
+                svt_aom_executor_acquire(scs->enc_ctx->executor_client);
 
                 for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
                      sb_segment_index < sb_start_index + sb_segment_count;
@@ -2053,6 +2059,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
 
                     x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
                 }
+                svt_aom_executor_release(scs->enc_ctx->executor_client);
             }
 
             svt_block_on_mutex(pcs->tpl_disp_mutex);
@@ -2064,6 +2071,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
                 svt_post_semaphore(pcs->tpl_disp_done_semaphore);
         } else {
             // Tiles path does not suupport segments
+            svt_aom_executor_acquire(scs->enc_ctx->executor_client);
             for (uint32_t sb_index = 0; sb_index < pcs->b64_total_count; ++sb_index) {
                 B64Geom *b64_geom = &scs->b64_geom[sb_index];
                 tpl_mc_flow_dispenser_sb_generic(
@@ -2075,6 +2083,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
                     in_results_ptr->qIndex,
                     (b64_geom->width == 64 && b64_geom->height == 64) ? pcs->tpl_ctrls.dispenser_search_level : 0);
             }
+            svt_aom_executor_release(scs->enc_ctx->executor_client);
             svt_post_semaphore(pcs->tpl_disp_done_semaphore);
         }
         svt_release_object(in_results_wrapper_ptr);
@@ -2313,6 +2322,8 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
                 tpl_prep_info(pcs);
                 tpl_mc_flow(scs->enc_ctx, scs, pcs, context_ptr);
             }
+            if (pcs->end_of_sequence_flag)
+                svt_aom_ladder_finish(scs->enc_ctx->ladder_client, LADDER_TPL);
             bool release_pa_ref = (scs->static_config.superres_mode <= SUPERRES_RANDOM) ? true : false;
             // Release Pa Ref if lad_mg is 0 and P slice and not flat struct (not belonging to any TPL group)
             if (release_pa_ref && /*scs->lad_mg == 0 &&*/ pcs->reference_released == 0) {
@@ -2320,6 +2331,8 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
                 // printf ("\n PIC \t %d\n",pcs->picture_number);
             }
         }
+        // The pictures come in decode order, so all the lookahead records up to this picture have been read or skipped
+        svt_aom_ladder_advance(scs->enc_ctx->ladder_client, pcs->picture_number);
         /*********************************************Picture-based operations**********************************************************/
         if (scs->static_config.tune == 2 || scs->static_config.tune == 3 || scs->static_config.tune == 4) {
             aom_av1_set_mb_ssim_rdmult_scaling(pcs);
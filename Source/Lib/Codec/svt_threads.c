@@ -400,6 +400,26 @@ EbErrorType svt_destroy_mutex(EbHandle mutex_handle) {
 
     return return_error;
 }
+/***************************************
+ * svt_run_once
+ ***************************************/
+#ifdef _WIN32
+static BOOL CALLBACK run_once_wrapper(PINIT_ONCE once, PVOID parameter, PVOID *context) {
+    (void)once;
+    (void)context;
+    ((void (*)(void))parameter)();
+    return TRUE;
+}
+#endif
+
+EbErrorType svt_run_once(SvtOnce *once, void (*init_routine)(void)) {
+#ifdef _WIN32
+    return InitOnceExecuteOnce(once, run_once_wrapper, (PVOID)init_routine, NULL) ? EB_ErrorNone : EB_ErrorUndefined;
+#else
+    return pthread_once(once, init_routine) ? EB_ErrorUndefined : EB_ErrorNone;
+#endif
+}
+
 /*
     set an atomic variable to an input value
 */
@@ -120,6 +120,19 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 
 void svt_aom_atomic_set_u32(AtomicVarU32 *var, uint32_t in);
 
+/**************************************
+     * One-time initialization
+     **************************************/
+#ifdef _WIN32
+typedef INIT_ONCE SvtOnce;
+#define SVT_ONCE_INIT INIT_ONCE_STATIC_INIT
+#else
+typedef pthread_once_t SvtOnce;
+#define SVT_ONCE_INIT PTHREAD_ONCE_INIT
+#endif
+// Runs init_routine exactly once per once object, concurrent callers wait until it has completed
+extern EbErrorType svt_run_once(SvtOnce *once, void (*init_routine)(void));
+
 /*
  Condition variable
 */
@@ -20,6 +20,7 @@
 
 #include "utility.h"
 #include "svt_log.h"
+#include "svt_malloc.h"
 #include <math.h>
 
 /* assert a certain condition and report err if condition not met */
@@ -283,20 +284,14 @@ static BlockSize hvsize_to_bsize[/*H*/ 6][/*V*/ 6] = {
     {BLOCK_INVALID, BLOCK_INVALID, BLOCK_64X16, BLOCK_64X32, BLOCK_64X64, BLOCK_64X128},
     {BLOCK_INVALID, BLOCK_INVALID, BLOCK_INVALID, BLOCK_INVALID, BLOCK_128X64, BLOCK_128X128}};
 
-static uint32_t max_sb    = 64;
-static uint32_t max_depth = 5;
-static uint32_t max_part  = 9;
-static uint32_t max_num_active_blocks;
-
-GeomIndex svt_aom_geom_idx;
-//TODO need to remove above globals for multi-channel support
-
-/* to access geom info of a particular block; use this table if you have the block index in md scan */
-#ifdef MINIMAL_BUILD
-BlockGeom* svt_aom_blk_geom_mds;
-#else
-BlockGeom svt_aom_blk_geom_mds[MAX_NUM_BLOCKS_ALLOC];
-#endif
+// Parameters of the block geometry table under construction
+typedef struct BlkGeomBuildParams {
+    BlockGeom* blk_geom_mds;
+    GeomIndex  geom_idx;
+    uint32_t   max_sb;
+    uint32_t   max_depth;
+    uint32_t   max_part;
+} BlkGeomBuildParams;
 
 static INLINE TxSize av1_get_tx_size(BlockSize bsize, int32_t plane /*, const MacroBlockD *xd*/) {
     UNUSED(plane);
@@ -316,9 +311,14 @@ static uint32_t get_num_ns_per_part(uint32_t part_it, uint32_t sq_size) {
     return tot_num_ns_per_part;
 }
 
-static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, uint32_t y, int32_t is_last_quadrant,
-                             uint8_t quad_it, uint8_t min_nsq_bsize) {
+static void md_scan_all_blks(const BlkGeomBuildParams* prm, uint32_t* idx_mds, uint32_t sq_size, uint32_t x, uint32_t y,
+                             int32_t is_last_quadrant, uint8_t quad_it, uint8_t min_nsq_bsize) {
     //the input block is the parent square block of size sq_size located at pos (x,y)
+    BlockGeom*      blk_geom_mds = prm->blk_geom_mds;
+    const GeomIndex geom_idx     = prm->geom_idx;
+    const uint32_t  max_sb       = prm->max_sb;
+    const uint32_t  max_depth    = prm->max_depth;
+    const uint32_t  max_part     = prm->max_part;
 
     assert(quad_it <= 3);
     uint32_t part_it, nsq_it, d1_it, sqi_mds;
@@ -341,374 +341,374 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
         uint32_t tot_num_ns_per_part = get_num_ns_per_part(part_it, sq_size);
 
         for (nsq_it = 0; nsq_it < tot_num_ns_per_part; nsq_it++) {
-            svt_aom_blk_geom_mds[*idx_mds].depth = sq_size == max_sb / 1 ? 0
+            blk_geom_mds[*idx_mds].depth = sq_size == max_sb / 1 ? 0
                 : sq_size == max_sb / 2                                  ? 1
                 : sq_size == max_sb / 4                                  ? 2
                 : sq_size == max_sb / 8                                  ? 3
                 : sq_size == max_sb / 16                                 ? 4
                                                                          : 5;
 
-            svt_aom_blk_geom_mds[*idx_mds].sq_size          = sq_size;
-            svt_aom_blk_geom_mds[*idx_mds].is_last_quadrant = is_last_quadrant;
-            svt_aom_blk_geom_mds[*idx_mds].quadi            = quad_it;
+            blk_geom_mds[*idx_mds].sq_size          = sq_size;
+            blk_geom_mds[*idx_mds].is_last_quadrant = is_last_quadrant;
+            blk_geom_mds[*idx_mds].quadi            = quad_it;
 
             // part_it >= 3 for 128x128 blocks corresponds to HA/HB/VA/VB shapes since H4/V4 are not allowed
             // for 128x128 blocks.  Therefore, need to offset part_it by 2 to not index H4/V4 shapes.
-            uint32_t part_it_idx                 = part_it >= 3 && sq_size == 128 ? part_it + 2 : part_it;
-            svt_aom_blk_geom_mds[*idx_mds].shape = (Part)part_it_idx;
-            svt_aom_blk_geom_mds[*idx_mds].org_x = x + quartsize * ns_quarter_off_mult[part_it_idx][0][nsq_it];
-            svt_aom_blk_geom_mds[*idx_mds].org_y = y + quartsize * ns_quarter_off_mult[part_it_idx][1][nsq_it];
+            uint32_t part_it_idx         = part_it >= 3 && sq_size == 128 ? part_it + 2 : part_it;
+            blk_geom_mds[*idx_mds].shape = (Part)part_it_idx;
+            blk_geom_mds[*idx_mds].org_x = x + quartsize * ns_quarter_off_mult[part_it_idx][0][nsq_it];
+            blk_geom_mds[*idx_mds].org_y = y + quartsize * ns_quarter_off_mult[part_it_idx][1][nsq_it];
 
-            svt_aom_blk_geom_mds[*idx_mds].d1i     = d1_it++;
-            svt_aom_blk_geom_mds[*idx_mds].sqi_mds = sqi_mds;
+            blk_geom_mds[*idx_mds].d1i     = d1_it++;
+            blk_geom_mds[*idx_mds].sqi_mds = sqi_mds;
 
-            svt_aom_blk_geom_mds[*idx_mds].svt_aom_geom_idx = svt_aom_geom_idx;
+            blk_geom_mds[*idx_mds].svt_aom_geom_idx = geom_idx;
 
-            svt_aom_blk_geom_mds[*idx_mds].parent_depth_idx_mds = sqi_mds == 0
+            blk_geom_mds[*idx_mds].parent_depth_idx_mds = sqi_mds == 0
                 ? 0
-                : (sqi_mds + (3 - quad_it) * ns_depth_offset[svt_aom_geom_idx][svt_aom_blk_geom_mds[*idx_mds].depth]) -
-                    parent_depth_offset[svt_aom_geom_idx][svt_aom_blk_geom_mds[*idx_mds].depth];
-            svt_aom_blk_geom_mds[*idx_mds].d1_depth_offset =
-                d1_depth_offset[svt_aom_geom_idx][svt_aom_blk_geom_mds[*idx_mds].depth];
-            svt_aom_blk_geom_mds[*idx_mds].ns_depth_offset =
-                ns_depth_offset[svt_aom_geom_idx][svt_aom_blk_geom_mds[*idx_mds].depth];
-            svt_aom_blk_geom_mds[*idx_mds].totns   = tot_num_ns_per_part;
-            svt_aom_blk_geom_mds[*idx_mds].nsi     = nsq_it;
-            svt_aom_blk_geom_mds[*idx_mds].bwidth  = quartsize * ns_quarter_size_mult[part_it_idx][0][nsq_it];
-            svt_aom_blk_geom_mds[*idx_mds].bheight = quartsize * ns_quarter_size_mult[part_it_idx][1][nsq_it];
-            svt_aom_blk_geom_mds[*idx_mds].bsize =
-                hvsize_to_bsize[svt_log2f(svt_aom_blk_geom_mds[*idx_mds].bwidth) - 2]
-                               [svt_log2f(svt_aom_blk_geom_mds[*idx_mds].bheight) - 2];
-            svt_aom_blk_geom_mds[*idx_mds].bwidth_uv  = MAX(4, svt_aom_blk_geom_mds[*idx_mds].bwidth >> 1);
-            svt_aom_blk_geom_mds[*idx_mds].bheight_uv = MAX(4, svt_aom_blk_geom_mds[*idx_mds].bheight >> 1);
-            svt_aom_blk_geom_mds[*idx_mds].has_uv     = 1;
-
-            if (svt_aom_blk_geom_mds[*idx_mds].bwidth == 4 && svt_aom_blk_geom_mds[*idx_mds].bheight == 4)
-                svt_aom_blk_geom_mds[*idx_mds].has_uv = is_last_quadrant ? 1 : 0;
-
-            else if ((svt_aom_blk_geom_mds[*idx_mds].bwidth >> 1) < svt_aom_blk_geom_mds[*idx_mds].bwidth_uv ||
-                     (svt_aom_blk_geom_mds[*idx_mds].bheight >> 1) < svt_aom_blk_geom_mds[*idx_mds].bheight_uv) {
+                : (sqi_mds + (3 - quad_it) * ns_depth_offset[geom_idx][blk_geom_mds[*idx_mds].depth]) -
+                    parent_depth_offset[geom_idx][blk_geom_mds[*idx_mds].depth];
+            blk_geom_mds[*idx_mds].d1_depth_offset =
+                d1_depth_offset[geom_idx][blk_geom_mds[*idx_mds].depth];
+            blk_geom_mds[*idx_mds].ns_depth_offset =
+                ns_depth_offset[geom_idx][blk_geom_mds[*idx_mds].depth];
+            blk_geom_mds[*idx_mds].totns   = tot_num_ns_per_part;
+            blk_geom_mds[*idx_mds].nsi     = nsq_it;
+            blk_geom_mds[*idx_mds].bwidth  = quartsize * ns_quarter_size_mult[part_it_idx][0][nsq_it];
+            blk_geom_mds[*idx_mds].bheight = quartsize * ns_quarter_size_mult[part_it_idx][1][nsq_it];
+            blk_geom_mds[*idx_mds].bsize   =
+                hvsize_to_bsize[svt_log2f(blk_geom_mds[*idx_mds].bwidth) - 2]
+                               [svt_log2f(blk_geom_mds[*idx_mds].bheight) - 2];
+            blk_geom_mds[*idx_mds].bwidth_uv  = MAX(4, blk_geom_mds[*idx_mds].bwidth >> 1);
+            blk_geom_mds[*idx_mds].bheight_uv = MAX(4, blk_geom_mds[*idx_mds].bheight >> 1);
+            blk_geom_mds[*idx_mds].has_uv     = 1;
+
+            if (blk_geom_mds[*idx_mds].bwidth == 4 && blk_geom_mds[*idx_mds].bheight == 4)
+                blk_geom_mds[*idx_mds].has_uv = is_last_quadrant ? 1 : 0;
+
+            else if ((blk_geom_mds[*idx_mds].bwidth >> 1) < blk_geom_mds[*idx_mds].bwidth_uv ||
+                     (blk_geom_mds[*idx_mds].bheight >> 1) < blk_geom_mds[*idx_mds].bheight_uv) {
                 int32_t num_blk_same_uv = 1;
-                if (svt_aom_blk_geom_mds[*idx_mds].bwidth >> 1 < 4)
+                if (blk_geom_mds[*idx_mds].bwidth >> 1 < 4)
                     num_blk_same_uv *= 2;
-                if (svt_aom_blk_geom_mds[*idx_mds].bheight >> 1 < 4)
+                if (blk_geom_mds[*idx_mds].bheight >> 1 < 4)
                     num_blk_same_uv *= 2;
-                //if (svt_aom_blk_geom_mds[*idx_mds].nsi % 2 == 0)
-                //if (svt_aom_blk_geom_mds[*idx_mds].nsi != (svt_aom_blk_geom_mds[*idx_mds].totns-1) )
-                if (svt_aom_blk_geom_mds[*idx_mds].nsi != (num_blk_same_uv - 1) &&
-                    svt_aom_blk_geom_mds[*idx_mds].nsi != (2 * num_blk_same_uv - 1))
-                    svt_aom_blk_geom_mds[*idx_mds].has_uv = 0;
+                //if (blk_geom_mds[*idx_mds].nsi % 2 == 0)
+                //if (blk_geom_mds[*idx_mds].nsi != (blk_geom_mds[*idx_mds].totns-1) )
+                if (blk_geom_mds[*idx_mds].nsi != (num_blk_same_uv - 1) &&
+                    blk_geom_mds[*idx_mds].nsi != (2 * num_blk_same_uv - 1))
+                    blk_geom_mds[*idx_mds].has_uv = 0;
             }
 
-            svt_aom_blk_geom_mds[*idx_mds].bsize_uv = get_plane_block_size(svt_aom_blk_geom_mds[*idx_mds].bsize, 1, 1);
-            uint16_t txb_itr                        = 0;
+            blk_geom_mds[*idx_mds].bsize_uv = get_plane_block_size(blk_geom_mds[*idx_mds].bsize, 1, 1);
+            uint16_t txb_itr                = 0;
             // tx_depth 1 geom settings
-            uint8_t tx_depth                                   = 0;
-            svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X128
+            uint8_t tx_depth                           = 0;
+            blk_geom_mds[*idx_mds].txb_count[tx_depth] = blk_geom_mds[*idx_mds].bsize == BLOCK_128X128
                 ? 4
-                : svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X64 ||
-                    svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X128
+                : blk_geom_mds[*idx_mds].bsize == BLOCK_128X64 ||
+                    blk_geom_mds[*idx_mds].bsize == BLOCK_64X128
                 ? 2
                 : 1;
-            for (txb_itr = 0; txb_itr < svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth]; txb_itr++) {
-                svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(svt_aom_blk_geom_mds[*idx_mds].bsize,
+            for (txb_itr = 0; txb_itr < blk_geom_mds[*idx_mds].txb_count[tx_depth]; txb_itr++) {
+                blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(blk_geom_mds[*idx_mds].bsize,
                                                                                   0);
-                svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = av1_get_tx_size(
-                    svt_aom_blk_geom_mds[*idx_mds].bsize, 1);
-                if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X128) {
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0 || txb_itr == 2)
-                        ? svt_aom_blk_geom_mds[*idx_mds].org_x
-                        : svt_aom_blk_geom_mds[*idx_mds].org_x + 64;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0 || txb_itr == 1)
-                        ? svt_aom_blk_geom_mds[*idx_mds].org_y
-                        : svt_aom_blk_geom_mds[*idx_mds].org_y + 64;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0)
-                        ? svt_aom_blk_geom_mds[*idx_mds].org_x
-                        : svt_aom_blk_geom_mds[*idx_mds].org_x + 64;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X128) {
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0)
-                        ? svt_aom_blk_geom_mds[*idx_mds].org_y
-                        : svt_aom_blk_geom_mds[*idx_mds].org_y + 64;
+                blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = av1_get_tx_size(
+                    blk_geom_mds[*idx_mds].bsize, 1);
+                if (blk_geom_mds[*idx_mds].bsize == BLOCK_128X128) {
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0 || txb_itr == 2)
+                        ? blk_geom_mds[*idx_mds].org_x
+                        : blk_geom_mds[*idx_mds].org_x + 64;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0 || txb_itr == 1)
+                        ? blk_geom_mds[*idx_mds].org_y
+                        : blk_geom_mds[*idx_mds].org_y + 64;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_128X64) {
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0)
+                        ? blk_geom_mds[*idx_mds].org_x
+                        : blk_geom_mds[*idx_mds].org_x + 64;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X128) {
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0)
+                        ? blk_geom_mds[*idx_mds].org_y
+                        : blk_geom_mds[*idx_mds].org_y + 64;
                 } else {
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y;
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y;
                 }
-                /*if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X8)
+                /*if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X8)
                     SVT_LOG("");*/
-                svt_aom_blk_geom_mds[*idx_mds].tx_width[tx_depth] =
-                    tx_size_wide[svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_height[tx_depth] =
-                    tx_size_high[svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_width_uv[tx_depth] =
-                    tx_size_wide[svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_height_uv[tx_depth] =
-                    tx_size_high[svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_width[tx_depth] =
+                    tx_size_wide[blk_geom_mds[*idx_mds].txsize[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_height[tx_depth] =
+                    tx_size_high[blk_geom_mds[*idx_mds].txsize[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_width_uv[tx_depth] =
+                    tx_size_wide[blk_geom_mds[*idx_mds].txsize_uv[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_height_uv[tx_depth] =
+                    tx_size_high[blk_geom_mds[*idx_mds].txsize_uv[tx_depth]];
             }
             // tx_depth 1 geom settings
-            tx_depth                                           = 1;
-            svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X128
+            tx_depth                                   = 1;
+            blk_geom_mds[*idx_mds].txb_count[tx_depth] = blk_geom_mds[*idx_mds].bsize == BLOCK_128X128
                 ? 4
-                : svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X64 ||
-                    svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X128
+                : blk_geom_mds[*idx_mds].bsize == BLOCK_128X64 ||
+                    blk_geom_mds[*idx_mds].bsize == BLOCK_64X128
                 ? 2
                 : 1;
 
-            if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X64 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X16 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X8) {
-                svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = 4;
+            if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X64 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X16 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_8X8) {
+                blk_geom_mds[*idx_mds].txb_count[tx_depth] = 4;
             }
 
-            if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X64 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X16 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X8 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
-                svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = 2;
+            if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X64 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X16 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X8 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
+                blk_geom_mds[*idx_mds].txb_count[tx_depth] = 2;
             }
-            if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X16 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X64 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X8 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X4 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
-                svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = 2;
+            if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X16 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X64 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X8 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_8X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X4 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
+                blk_geom_mds[*idx_mds].txb_count[tx_depth] = 2;
             }
-            for (txb_itr = 0; txb_itr < svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth]; txb_itr++) {
-                if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X32, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[4]                                 = {0, 32, 0, 32};
-                    uint8_t offsety[4]                                 = {0, 0, 32, 32};
+            for (txb_itr = 0; txb_itr < blk_geom_mds[*idx_mds].txb_count[tx_depth]; txb_itr++) {
+                if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X64) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X32, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[4]                         = {0, 32, 0, 32};
+                    uint8_t offsety[4]                         = {0, 0, 32, 32};
                     //   0  1
                     //   2  3
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X32, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[2]                                 = {0, 32};
-                    uint8_t offsety[2]                                 = {0, 0};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X32, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[2]                         = {0, 32};
+                    uint8_t offsety[2]                         = {0, 0};
                     //   0  1
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X32, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[2]                                 = {0, 0};
-                    uint8_t offsety[2]                                 = {0, 32};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X64) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X32, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[2]                         = {0, 0};
+                    uint8_t offsety[2]                         = {0, 32};
                     //   0  1
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[4]                                 = {0, 16, 0, 16};
-                    uint8_t offsety[4]                                 = {0, 0, 16, 16};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[4]                         = {0, 16, 0, 16};
+                    uint8_t offsety[4]                         = {0, 0, 16, 16};
                     //   0  1
                     //   2  3
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[2]                                 = {0, 16};
-                    uint8_t offsety[2]                                 = {0, 0};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[2]                         = {0, 16};
+                    uint8_t offsety[2]                         = {0, 0};
                     //   0  1
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[2]                                 = {0, 0};
-                    uint8_t offsety[2]                                 = {0, 16};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[2]                         = {0, 0};
+                    uint8_t offsety[2]                         = {0, 16};
                     //   0  1
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[4]                                 = {0, 8, 0, 8};
-                    uint8_t offsety[4]                                 = {0, 0, 8, 8};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[4]                         = {0, 8, 0, 8};
+                    uint8_t offsety[4]                         = {0, 0, 8, 8};
                     //   0  1
                     //   2  3
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X8) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[2]                                 = {0, 8};
-                    uint8_t offsety[2]                                 = {0, 0};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X8) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[2]                         = {0, 8};
+                    uint8_t offsety[2]                         = {0, 0};
                     //   0  1
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[2]                                 = {0, 0};
-                    uint8_t offsety[2]                                 = {0, 8};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[2]                         = {0, 0};
+                    uint8_t offsety[2]                         = {0, 8};
                     //   0  1
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X8) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                    uint8_t offsetx[4]                                 = {0, 4, 0, 4};
-                    uint8_t offsety[4]                                 = {0, 0, 4, 4};
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_8X8) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
+                    uint8_t offsetx[4]                         = {0, 4, 0, 4};
+                    uint8_t offsety[4]                         = {0, 0, 4, 4};
                     //   0  1
                     //   2  3
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_32X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx[2] = {0, 32};
                     uint8_t offsety[2] = {0, 0};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X32, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X64) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X32, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx[2] = {0, 0};
                     uint8_t offsety[2] = {0, 32};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X8) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X8) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx[2] = {0, 16};
                     uint8_t offsety[2] = {0, 0};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_8X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[2] = {0, 0};
                     uint8_t offsety[2] = {0, 16};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X4) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X4) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx[2] = {0, 8};
                     uint8_t offsety[2] = {0, 0};
@@ -716,125 +716,125 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t tbx = offsetx[txb_itr];
                     uint8_t tby = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx[2] = {0, 0};
                     uint8_t offsety[2] = {0, 8};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
                 } else {
-                    if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X128) {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0 ||
+                    if (blk_geom_mds[*idx_mds].bsize == BLOCK_128X128) {
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0 ||
                                                                                              txb_itr == 2)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_x
-                            : svt_aom_blk_geom_mds[*idx_mds].org_x + 64;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0 ||
+                            ? blk_geom_mds[*idx_mds].org_x
+                            : blk_geom_mds[*idx_mds].org_x + 64;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0 ||
                                                                                              txb_itr == 1)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_y
-                            : svt_aom_blk_geom_mds[*idx_mds].org_y + 64;
-                    } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X64) {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_x
-                            : svt_aom_blk_geom_mds[*idx_mds].org_x + 64;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_y;
-                    } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X128) {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_x;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_y
-                            : svt_aom_blk_geom_mds[*idx_mds].org_y + 64;
+                            ? blk_geom_mds[*idx_mds].org_y
+                            : blk_geom_mds[*idx_mds].org_y + 64;
+                    } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_128X64) {
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0)
+                            ? blk_geom_mds[*idx_mds].org_x
+                            : blk_geom_mds[*idx_mds].org_x + 64;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_y;
+                    } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X128) {
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_x;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0)
+                            ? blk_geom_mds[*idx_mds].org_y
+                            : blk_geom_mds[*idx_mds].org_y + 64;
                     } else {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_x;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_y;
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_x;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_y;
                     }
                 }
-                svt_aom_blk_geom_mds[*idx_mds].tx_width[tx_depth] =
-                    tx_size_wide[svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_height[tx_depth] =
-                    tx_size_high[svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_width_uv[tx_depth]  = svt_aom_blk_geom_mds[*idx_mds].tx_width_uv[0];
-                svt_aom_blk_geom_mds[*idx_mds].tx_height_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].tx_height_uv[0];
+                blk_geom_mds[*idx_mds].tx_width[tx_depth] =
+                    tx_size_wide[blk_geom_mds[*idx_mds].txsize[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_height[tx_depth] =
+                    tx_size_high[blk_geom_mds[*idx_mds].txsize[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_width_uv[tx_depth]  = blk_geom_mds[*idx_mds].tx_width_uv[0];
+                blk_geom_mds[*idx_mds].tx_height_uv[tx_depth] = blk_geom_mds[*idx_mds].tx_height_uv[0];
             }
             // tx_depth 2 geom settings
             tx_depth = 2;
 
-            svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X128
+            blk_geom_mds[*idx_mds].txb_count[tx_depth] = blk_geom_mds[*idx_mds].bsize == BLOCK_128X128
                 ? 4
-                : svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X64 ||
-                    svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X128
+                : blk_geom_mds[*idx_mds].bsize == BLOCK_128X64 ||
+                    blk_geom_mds[*idx_mds].bsize == BLOCK_64X128
                 ? 2
                 : 1;
 
-            if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X64 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X16) {
-                svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = 16;
+            if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X64 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X16) {
+                blk_geom_mds[*idx_mds].txb_count[tx_depth] = 16;
             }
-            if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X64 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X16 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X8 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
-                svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = 8;
+            if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X64 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X16 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X8 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
+                blk_geom_mds[*idx_mds].txb_count[tx_depth] = 8;
             }
-            if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X16 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X64 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X8 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X32 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X4 ||
-                svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
-                svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth] = 4;
+            if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X16 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X64 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_32X8 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_8X32 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_16X4 ||
+                blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
+                blk_geom_mds[*idx_mds].txb_count[tx_depth] = 4;
             }
 
-            for (txb_itr = 0; txb_itr < svt_aom_blk_geom_mds[*idx_mds].txb_count[tx_depth]; txb_itr++) {
-                if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+            for (txb_itr = 0; txb_itr < blk_geom_mds[*idx_mds].txb_count[tx_depth]; txb_itr++) {
+                if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X64) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[16] = {0, 16, 32, 48, 0, 16, 32, 48, 0, 16, 32, 48, 0, 16, 32, 48};
                     uint8_t offsety_intra[16] = {0, 0, 0, 0, 16, 16, 16, 16, 32, 32, 32, 32, 48, 48, 48, 48};
@@ -842,19 +842,19 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[16] = {0, 16, 0, 16, 32, 48, 32, 48, 0, 16, 0, 16, 32, 48, 32, 48};
                     uint8_t offsety_inter[16] = {0, 0, 16, 16, 0, 0, 16, 16, 32, 32, 48, 48, 32, 32, 48, 48};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
 
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[8] = {0, 16, 32, 48, 0, 16, 32, 48};
                     uint8_t offsety_intra[8] = {0, 0, 0, 0, 16, 16, 16, 16};
@@ -862,18 +862,18 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[8] = {0, 16, 0, 16, 32, 48, 32, 48};
                     uint8_t offsety_inter[8] = {0, 0, 16, 16, 0, 0, 16, 16};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X64) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[8] = {0, 16, 0, 16, 0, 16, 0, 16};
                     uint8_t offsety_intra[8] = {0, 0, 16, 16, 32, 32, 48, 48};
@@ -881,19 +881,19 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[8] = {0, 16, 0, 16, 0, 16, 0, 16};
                     uint8_t offsety_inter[8] = {0, 0, 16, 16, 32, 32, 48, 48};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
 
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[16] = {0, 8, 16, 24, 0, 8, 16, 24, 0, 8, 16, 24, 0, 8, 16, 24};
                     uint8_t offsety_intra[16] = {0, 0, 0, 0, 8, 8, 8, 8, 16, 16, 16, 16, 24, 24, 24, 24};
@@ -901,18 +901,18 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[16] = {0, 8, 0, 8, 16, 24, 16, 24, 0, 8, 0, 8, 16, 24, 16, 24};
                     uint8_t offsety_inter[16] = {0, 0, 8, 8, 0, 0, 8, 8, 16, 16, 24, 24, 16, 16, 24, 24};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[8] = {0, 8, 16, 24, 0, 8, 16, 24};
                     uint8_t offsety_intra[8] = {0, 0, 0, 0, 8, 8, 8, 8};
@@ -920,18 +920,18 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[8] = {0, 8, 0, 8, 16, 24, 16, 24};
                     uint8_t offsety_inter[8] = {0, 0, 8, 8, 0, 0, 8, 8};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[8] = {0, 8, 0, 8, 0, 8, 0, 8};
                     uint8_t offsety_intra[8] = {0, 0, 8, 8, 16, 16, 24, 24};
@@ -939,18 +939,18 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[8] = {0, 8, 0, 8, 0, 8, 0, 8};
                     uint8_t offsety_inter[8] = {0, 0, 8, 8, 16, 16, 24, 24};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X8) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X8) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[8] = {0, 4, 8, 12, 0, 4, 8, 12};
                     uint8_t offsety_intra[8] = {0, 0, 0, 0, 4, 4, 4, 4};
@@ -958,18 +958,18 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[8] = {0, 4, 0, 4, 8, 12, 8, 12};
                     uint8_t offsety_inter[8] = {0, 0, 4, 4, 0, 0, 4, 4};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_8X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[8] = {0, 4, 0, 4, 0, 4, 0, 4};
                     uint8_t offsety_intra[8] = {0, 0, 4, 4, 8, 8, 12, 12};
@@ -977,19 +977,19 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[8] = {0, 4, 0, 4, 0, 4, 0, 4};
                     uint8_t offsety_inter[8] = {0, 0, 4, 4, 8, 8, 12, 12};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
 
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
 
                     uint8_t offsetx_intra[16] = {0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12};
                     uint8_t offsety_intra[16] = {0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12};
@@ -997,180 +997,183 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
                     uint8_t offsetx_inter[16] = {0, 4, 0, 4, 8, 12, 8, 12, 0, 4, 0, 4, 8, 12, 8, 12};
                     uint8_t offsety_inter[16] = {0, 0, 4, 4, 0, 0, 4, 4, 8, 8, 12, 12, 8, 8, 12, 12};
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
-
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_intra[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_intra[txb_itr];
+
+                    blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_x + offsetx_inter[txb_itr];
+                    blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].org_y + offsety_inter[txb_itr];
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[4] = {0, 16, 32, 48};
                     uint8_t offsety[4] = {0, 0, 0, 0};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X64) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X64) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_16X16, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[4] = {0, 0, 0, 0};
                     uint8_t offsety[4] = {0, 16, 32, 48};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_32X8) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_32X8) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[4] = {0, 8, 16, 24};
                     uint8_t offsety[4] = {0, 0, 0, 0};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_8X32) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_8X32) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_8X8, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[4] = {0, 0, 0, 0};
                     uint8_t offsety[4] = {0, 8, 16, 24};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_16X4) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_16X4) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[4] = {0, 4, 8, 12};
                     uint8_t offsety[4] = {0, 0, 0, 0};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
-                } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
-                    svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
-                    svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
+                } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_4X16) {
+                    blk_geom_mds[*idx_mds].txsize[tx_depth]    = av1_get_tx_size(BLOCK_4X4, 0);
+                    blk_geom_mds[*idx_mds].txsize_uv[tx_depth] = blk_geom_mds[*idx_mds].txsize_uv[0];
                     //   0  1 2 3
                     uint8_t offsetx[4] = {0, 0, 0, 0};
                     uint8_t offsety[4] = {0, 4, 8, 12};
                     uint8_t tbx        = offsetx[txb_itr];
                     uint8_t tby        = offsety[txb_itr];
 
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_x + tbx;
-                    svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].org_y + tby;
+                    blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_x + tbx;
+                    blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                        blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].org_y + tby;
                 } else {
-                    if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X128) {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0 ||
+                    if (blk_geom_mds[*idx_mds].bsize == BLOCK_128X128) {
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0 ||
                                                                                              txb_itr == 2)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_x
-                            : svt_aom_blk_geom_mds[*idx_mds].org_x + 64;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0 ||
+                            ? blk_geom_mds[*idx_mds].org_x
+                            : blk_geom_mds[*idx_mds].org_x + 64;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0 ||
                                                                                              txb_itr == 1)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_y
-                            : svt_aom_blk_geom_mds[*idx_mds].org_y + 64;
-                    } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_128X64) {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_x
-                            : svt_aom_blk_geom_mds[*idx_mds].org_x + 64;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_y;
-                    } else if (svt_aom_blk_geom_mds[*idx_mds].bsize == BLOCK_64X128) {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_x;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0)
-                            ? svt_aom_blk_geom_mds[*idx_mds].org_y
-                            : svt_aom_blk_geom_mds[*idx_mds].org_y + 64;
+                            ? blk_geom_mds[*idx_mds].org_y
+                            : blk_geom_mds[*idx_mds].org_y + 64;
+                    } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_128X64) {
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] = (txb_itr == 0)
+                            ? blk_geom_mds[*idx_mds].org_x
+                            : blk_geom_mds[*idx_mds].org_x + 64;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_y;
+                    } else if (blk_geom_mds[*idx_mds].bsize == BLOCK_64X128) {
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_x;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] = (txb_itr == 0)
+                            ? blk_geom_mds[*idx_mds].org_y
+                            : blk_geom_mds[*idx_mds].org_y + 64;
                     } else {
-                        svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
-                            svt_aom_blk_geom_mds[*idx_mds].bsize, 0);
-                        svt_aom_blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
-                            svt_aom_blk_geom_mds[*idx_mds].txsize_uv[0];
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_x;
-                        svt_aom_blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
-                            svt_aom_blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
-                                svt_aom_blk_geom_mds[*idx_mds].org_y;
+                        blk_geom_mds[*idx_mds].txsize[tx_depth] = av1_get_tx_size(
+                            blk_geom_mds[*idx_mds].bsize, 0);
+                        blk_geom_mds[*idx_mds].txsize_uv[tx_depth] =
+                            blk_geom_mds[*idx_mds].txsize_uv[0];
+                        blk_geom_mds[*idx_mds].tx_org_x[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_x[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_x;
+                        blk_geom_mds[*idx_mds].tx_org_y[0][tx_depth][txb_itr] =
+                            blk_geom_mds[*idx_mds].tx_org_y[1][tx_depth][txb_itr] =
+                                blk_geom_mds[*idx_mds].org_y;
                     }
                 }
-                svt_aom_blk_geom_mds[*idx_mds].tx_width[tx_depth] =
-                    tx_size_wide[svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_height[tx_depth] =
-                    tx_size_high[svt_aom_blk_geom_mds[*idx_mds].txsize[tx_depth]];
-                svt_aom_blk_geom_mds[*idx_mds].tx_width_uv[tx_depth]  = svt_aom_blk_geom_mds[*idx_mds].tx_width_uv[0];
-                svt_aom_blk_geom_mds[*idx_mds].tx_height_uv[tx_depth] = svt_aom_blk_geom_mds[*idx_mds].tx_height_uv[0];
+                blk_geom_mds[*idx_mds].tx_width[tx_depth] =
+                    tx_size_wide[blk_geom_mds[*idx_mds].txsize[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_height[tx_depth] =
+                    tx_size_high[blk_geom_mds[*idx_mds].txsize[tx_depth]];
+                blk_geom_mds[*idx_mds].tx_width_uv[tx_depth]  = blk_geom_mds[*idx_mds].tx_width_uv[0];
+                blk_geom_mds[*idx_mds].tx_height_uv[tx_depth] = blk_geom_mds[*idx_mds].tx_height_uv[0];
             }
-            svt_aom_blk_geom_mds[*idx_mds].blkidx_mds = (*idx_mds);
+            blk_geom_mds[*idx_mds].blkidx_mds = (*idx_mds);
             (*idx_mds)                                = (*idx_mds) + 1;
         }
     }
 
     uint32_t min_size = max_sb >> (max_depth - 1);
     if (halfsize >= min_size) {
-        md_scan_all_blks(idx_mds, halfsize, x, y, 0, 0, min_nsq_bsize);
-        md_scan_all_blks(idx_mds, halfsize, x + halfsize, y, 0, 1, min_nsq_bsize);
-        md_scan_all_blks(idx_mds, halfsize, x, y + halfsize, 0, 2, min_nsq_bsize);
-        md_scan_all_blks(idx_mds, halfsize, x + halfsize, y + halfsize, 1, 3, min_nsq_bsize);
+        md_scan_all_blks(prm, idx_mds, halfsize, x, y, 0, 0, min_nsq_bsize);
+        md_scan_all_blks(prm, idx_mds, halfsize, x + halfsize, y, 0, 1, min_nsq_bsize);
+        md_scan_all_blks(prm, idx_mds, halfsize, x, y + halfsize, 0, 2, min_nsq_bsize);
+        md_scan_all_blks(prm, idx_mds, halfsize, x + halfsize, y + halfsize, 1, 3, min_nsq_bsize);
     }
 }
-static uint32_t count_total_num_of_active_blks(uint8_t min_nsq_bsize) {
-    uint32_t depth_it, sq_it_y, sq_it_x, part_it, nsq_it;
+static uint32_t count_total_num_of_active_blks(const BlkGeomBuildParams* prm, uint8_t min_nsq_bsize) {
+    uint32_t       depth_it, sq_it_y, sq_it_x, part_it, nsq_it;
+    const uint32_t max_sb    = prm->max_sb;
+    const uint32_t max_depth = prm->max_depth;
+    const uint32_t max_part  = prm->max_part;
 
     uint32_t depth_scan_idx = 0;
 
@@ -1202,107 +1205,127 @@ static uint32_t count_total_num_of_active_blks(uint8_t min_nsq_bsize) {
 
     return depth_scan_idx;
 }
-static void log_redundancy_similarity(uint32_t max_block_count) {
-    uint32_t blk_it, s_it;
+static int compare_redund_key(const void* a, const void* b) {
+    const uint64_t ka = *(const uint64_t*)a;
+    const uint64_t kb = *(const uint64_t*)b;
+    return ka < kb ? -1 : ka > kb;
+}
+// The first block (nsi 0) of a partition is redundant to the first blocks of the other partitions with the same size
+// and origin. The keys sort the blocks by (bsize, origin, index) so each group of duplicates is contiguous and in md
+// scan order.
+static EbErrorType log_redundancy_similarity(BlockGeom* blk_geom_mds, uint32_t max_block_count) {
+    uint64_t* keys;
+    uint32_t  key_count = 0;
+    EB_MALLOC_ARRAY(keys, max_block_count);
 
-    for (blk_it = 0; blk_it < max_block_count; blk_it++) {
-        BlockGeom* cur_geom             = &svt_aom_blk_geom_mds[blk_it];
+    for (uint32_t blk_it = 0; blk_it < max_block_count; blk_it++) {
+        BlockGeom* cur_geom             = &blk_geom_mds[blk_it];
         cur_geom->redund                = 0;
         cur_geom->redund_list.list_size = 0;
-
-        for (s_it = 0; s_it < max_block_count; s_it++) {
-            BlockGeom* search_geom = &svt_aom_blk_geom_mds[s_it];
-
-            if (cur_geom->bsize == search_geom->bsize && cur_geom->org_x == search_geom->org_x &&
-                cur_geom->org_y == search_geom->org_y && s_it != blk_it) {
-                if (cur_geom->nsi == 0 && search_geom->nsi == 0 && cur_geom->redund_list.list_size < 3) {
-                    cur_geom->redund                                                     = 1;
-                    cur_geom->redund_list.blk_mds_table[cur_geom->redund_list.list_size] = search_geom->blkidx_mds;
-                    cur_geom->redund_list.list_size++;
-                }
+        if (cur_geom->nsi == 0)
+            keys[key_count++] = ((uint64_t)cur_geom->bsize << 48) | ((uint64_t)cur_geom->org_x << 40) |
+                ((uint64_t)cur_geom->org_y << 32) | blk_it;
+    }
+    qsort(keys, key_count, sizeof(*keys), compare_redund_key);
+
+    for (uint32_t first = 0, last; first < key_count; first = last) {
+        for (last = first + 1; last < key_count && (keys[last] >> 32) == (keys[first] >> 32); last++)
+            ;
+        for (uint32_t i = first; i < last; i++) {
+            BlockGeom* cur_geom = &blk_geom_mds[(uint32_t)keys[i]];
+            for (uint32_t j = first; j < last && cur_geom->redund_list.list_size < 3; j++) {
+                if (j == i)
+                    continue;
+                cur_geom->redund = 1;
+                cur_geom->redund_list.blk_mds_table[cur_geom->redund_list.list_size++] =
+                    blk_geom_mds[(uint32_t)keys[j]].blkidx_mds;
             }
         }
     }
+    EB_FREE_ARRAY(keys);
+    return EB_ErrorNone;
 }
 
 /*
   Build Block Geometry
 */
-void svt_aom_build_blk_geom(GeomIndex geom) {
-    uint32_t max_block_count;
-    svt_aom_geom_idx = geom;
-    uint32_t min_nsq_bsize;
+EbErrorType svt_aom_build_blk_geom(GeomIndex geom, BlockGeom** blk_geom_mds) {
+    BlkGeomBuildParams prm;
+    uint32_t           max_block_count;
+    uint32_t           min_nsq_bsize;
+    prm.geom_idx = geom;
     if (geom == GEOM_0) {
-        max_sb          = 64;
-        max_depth       = 4;
-        max_part        = 1;
+        prm.max_sb      = 64;
+        prm.max_depth   = 4;
+        prm.max_part    = 1;
         max_block_count = 85;
         min_nsq_bsize   = 16;
     } else if (geom == GEOM_1) {
-        max_sb          = 64;
-        max_depth       = 4;
-        max_part        = 3;
+        prm.max_sb      = 64;
+        prm.max_depth   = 4;
+        prm.max_part    = 3;
         max_block_count = 105;
         min_nsq_bsize   = 16;
     } else if (geom == GEOM_2) {
-        max_sb          = 64;
-        max_depth       = 4;
-        max_part        = 3;
+        prm.max_sb      = 64;
+        prm.max_depth   = 4;
+        prm.max_part    = 3;
         max_block_count = 169;
         min_nsq_bsize   = 8;
     } else if (geom == GEOM_3) {
-        max_sb          = 64;
-        max_depth       = 4;
-        max_part        = 3;
+        prm.max_sb      = 64;
+        prm.max_depth   = 4;
+        prm.max_part    = 3;
         max_block_count = 425;
         min_nsq_bsize   = 0;
     } else if (geom == GEOM_4) {
-        max_sb          = 64;
-        max_depth       = 5;
-        max_part        = 3;
+        prm.max_sb      = 64;
+        prm.max_depth   = 5;
+        prm.max_part    = 3;
         max_block_count = 681;
         min_nsq_bsize   = 0;
     } else if (geom == GEOM_5) {
-        max_sb          = 64;
-        max_depth       = 5;
-        max_part        = 5;
+        prm.max_sb      = 64;
+        prm.max_depth   = 5;
+        prm.max_part    = 5;
         max_block_count = 849;
         min_nsq_bsize   = 0;
     } else if (geom == GEOM_6) {
-        max_sb          = 64;
-        max_depth       = 5;
-        max_part        = 9;
+        prm.max_sb      = 64;
+        prm.max_depth   = 5;
+        prm.max_part    = 9;
         max_block_count = 1101;
         min_nsq_bsize   = 0;
     } else if (geom == GEOM_7) {
-        max_sb          = 128;
-        max_depth       = 6;
-        max_part        = 9;
+        prm.max_sb      = 128;
+        prm.max_depth   = 6;
+        prm.max_part    = 9;
         max_block_count = 4421;
         min_nsq_bsize   = 0;
     } else {
-        max_sb          = 128;
-        max_depth       = 5;
-        max_part        = 5;
+        prm.max_sb      = 128;
+        prm.max_depth   = 5;
+        prm.max_part    = 5;
         max_block_count = 2377;
         min_nsq_bsize   = 0;
     }
     //(0)compute total number of blocks using the information provided
-    max_num_active_blocks = count_total_num_of_active_blks(min_nsq_bsize);
+    const uint32_t max_num_active_blocks = count_total_num_of_active_blks(&prm, min_nsq_bsize);
     if (max_num_active_blocks != max_block_count)
         SVT_LOG(" \n\n Error %i blocks\n\n ", max_num_active_blocks);
+    EB_CALLOC_ARRAY(*blk_geom_mds, max_block_count);
+    prm.blk_geom_mds = *blk_geom_mds;
     //(2) Construct md scan blk_geom_mds:  use info from dps
     uint32_t idx_mds = 0;
-    md_scan_all_blks(&idx_mds, max_sb, 0, 0, 0, 0, min_nsq_bsize);
-    log_redundancy_similarity(max_block_count);
+    md_scan_all_blks(&prm, &idx_mds, prm.max_sb, 0, 0, 0, 0, min_nsq_bsize);
+    return log_redundancy_similarity(prm.blk_geom_mds, max_block_count);
 }
-uint32_t get_mds_idx(uint32_t orgx, uint32_t orgy, uint32_t size, uint32_t use_128x128) {
-    (void)use_128x128;
-    uint32_t max_block_count = max_num_active_blocks;
-    uint32_t mds             = 0;
+uint32_t get_mds_idx(const BlockGeom* blk_geom_mds, uint32_t max_block_count, uint32_t orgx, uint32_t orgy,
+                     uint32_t size) {
+    uint32_t mds = 0;
 
     for (uint32_t blk_it = 0; blk_it < max_block_count; blk_it++) {
-        BlockGeom* cur_geom = &svt_aom_blk_geom_mds[blk_it];
+        const BlockGeom* cur_geom = &blk_geom_mds[blk_it];
 
         if ((uint32_t)cur_geom->sq_size == size && cur_geom->org_x == orgx && cur_geom->org_y == orgy &&
             cur_geom->shape == PART_N) {
@@ -37,7 +37,6 @@ typedef enum GeomIndex {
     GEOM_8, //128x128->8x8  NSQ:ON  (only H, V, H4, V4 shapes)
     GEOM_TOT
 } GeomIndex;
-void svt_aom_build_blk_geom(GeomIndex geom);
 
 typedef struct BlockGeom {
     Part    shape; // P_N..P_V4 . P_S is not used.
@@ -170,13 +169,18 @@ static const uint32_t blk32_idx_tab[GEOM_TOT - 1][4] = {{1, 22, 43, 64},
                                                         {5, 174, 343, 512},
                                                         {13, 222, 431, 640},
                                                         {25, 294, 563, 832}};
-#ifdef MINIMAL_BUILD
-extern BlockGeom* svt_aom_blk_geom_mds;
-#else
-extern BlockGeom svt_aom_blk_geom_mds[MAX_NUM_BLOCKS_ALLOC];
-#endif
-
-static INLINE const BlockGeom* get_blk_geom_mds(uint32_t bidx_mds) { return &svt_aom_blk_geom_mds[bidx_mds]; }
+// Allocates and builds the md scan block geometry table of the given geometry type. The table is owned by the
+// encoder instance (released with EB_FREE_ARRAY) and is read-only once built.
+EbErrorType svt_aom_build_blk_geom(GeomIndex geom, BlockGeom** blk_geom_mds);
+// Returns the md scan index of the square block of the given size located at (orgx, orgy) within the SB
+uint32_t get_mds_idx(const BlockGeom* blk_geom_mds, uint32_t max_block_count, uint32_t orgx, uint32_t orgy,
+                     uint32_t size);
+
+/* to access geom info of a particular block; use the table of the encoder instance (scs->blk_geom_mds) and the
+ * block index in md scan */
+static INLINE const BlockGeom* get_blk_geom_mds(const BlockGeom* blk_geom_mds, uint32_t bidx_mds) {
+    return &blk_geom_mds[bidx_mds];
+}
 // CU Stats Helper Functions
 typedef struct CodedBlockStats {
     uint8_t depth;
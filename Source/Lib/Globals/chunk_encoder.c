@@ -0,0 +1,586 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "chunk_encoder.h"
+#include "enc_handle.h"
+#include "executor.h"
+#include "packet_buffer_pool.h"
+#include "metadata_handle.h"
+#include "EbSvtAv1Metadata.h"
+#include "svt_threads.h"
+#include "svt_malloc.h"
+#include "svt_log.h"
+
+// Input picture queued for the encoder of a lane, with its own copy of the samples and of the side data
+typedef struct ChunkPicture {
+    struct ChunkPicture *next;
+    EbBufferHeaderType   header;
+    EbSvtIOFormat        io;
+    uint8_t             *samples;
+} ChunkPicture;
+
+// Output packet of a chunk: the header copied from the encoder of the lane, which the payload is taken over from.
+// The wrapper is not part of a pool, svt_av1_enc_release_out_buffer() frees it.
+typedef struct ChunkPacket {
+    EbObjectWrapper    wrapper;
+    EbBufferHeaderType header;
+} ChunkPacket;
+
+// A closed GOP of the input, its packets are queued until the application gets them
+typedef struct Chunk {
+    struct Chunk     *next; // next chunk in output order
+    struct Chunk     *lane_next; // next chunk encoded by the same lane
+    struct ChunkLane *lane;
+    uint32_t          pic_count; // pictures sent to the encoder of the lane
+    uint32_t          pkt_count; // packets output for the chunk by the encoder of the lane
+    bool              closed; // no more pictures are sent, the chunk is full or the end of stream was sent
+    // Packets output by the drain thread of the lane, pkt_event counts the packets pushed and the completion of the chunk
+    EbObjectWrapper *pkt_head;
+    EbObjectWrapper *pkt_tail;
+    CondVar          pkt_event;
+    int32_t          pkt_events;
+    bool             done; // all the packets of the chunk were pushed
+    bool             failed; // a packet could not be queued
+} Chunk;
+
+// Encoder instance encoding every chunk_parallel-th chunk back to back, as a single stream in which each chunk
+// starts with a key frame
+typedef struct ChunkLane {
+    struct ChunkEncoder *enc;
+    EbComponentType     *handle;
+    EbHandle             feed_thread; // sends the queued pictures to the encoder
+    EbHandle             drain_thread; // gets the packets of the encoder
+    // Pictures queued for the encoder, one post of the semaphore per picture
+    ChunkPicture *pic_head;
+    ChunkPicture *pic_tail;
+    EbHandle      pic_sem;
+    ChunkPicture *eos_pic; // end of stream of the encoder, allocated with the lane so it can always be queued
+    // Chunks sent to the encoder whose packets were not all output yet, in encoding order
+    Chunk *head;
+    Chunk *tail;
+} ChunkLane;
+
+struct ChunkEncoder {
+    EbSvtAv1EncConfiguration config;
+    uint32_t                 chunk_length;
+    EbSvtAv1Executor        *executor;
+    bool                     own_executor;
+    EbHandle                 mutex;
+    // Free entries of the picture queues, shared by the lanes: chunk_length pictures can wait for an encoder
+    EbHandle                 free_pics;
+    ChunkLane               *lanes;
+    uint32_t                 max_lanes;
+    uint32_t                 lanes_running; // lanes started whose encoder did not output its end of stream yet
+    uint64_t                 chunk_count; // chunks started, chunk n is encoded by lane n % max_lanes
+    Chunk                   *current; // chunk receiving the pictures
+    // Chunks in output order, from the oldest one with packets not yet returned to the one receiving pictures. The
+    // end of stream packet is returned by an empty chunk queued last when the application sends the end of stream.
+    Chunk *head;
+    Chunk *tail;
+    Chunk *eos_chunk;
+    bool   eos_sent;
+};
+
+static void free_private_data_list(EbPrivDataNode *node) {
+    while (node) {
+        EbPrivDataNode *next = node->next;
+        if (node->node_type != PRIVATE_DATA && node->node_type != ROI_MAP_EVENT)
+            EB_FREE(node->data);
+        EB_FREE(node);
+        node = next;
+    }
+}
+
+static void free_picture(ChunkPicture *pic) {
+    free_private_data_list((EbPrivDataNode *)pic->header.p_app_private);
+    svt_metadata_array_free(&pic->header.metadata);
+    EB_FREE(pic->samples);
+    EB_FREE(pic);
+}
+
+// Same copy as the library input, the data passed through (PRIVATE_DATA and ROI_MAP_EVENT) is not copied
+static EbErrorType copy_private_data_list(EbBufferHeaderType *dst, const EbBufferHeaderType *src) {
+    EbPrivDataNode **next = (EbPrivDataNode **)&dst->p_app_private;
+    *next                 = NULL;
+    for (const EbPrivDataNode *node = src->p_app_private; node; node = node->next) {
+        if (node->node_type == RES_CHANGE_EVENT) {
+            SVT_ERROR("chunk parallel encoding does not support resolution changes\n");
+            return EB_ErrorBadParameter;
+        }
+        EB_CALLOC(*next, 1, sizeof(**next));
+        (*next)->node_type = node->node_type;
+        (*next)->size      = node->size;
+        if (node->node_type == PRIVATE_DATA || node->node_type == ROI_MAP_EVENT)
+            (*next)->data = node->data;
+        else {
+            EB_MALLOC((*next)->data, node->size);
+            memcpy((*next)->data, node->data, node->size);
+        }
+        next = &(*next)->next;
+    }
+    return EB_ErrorNone;
+}
+
+static void copy_plane(uint8_t *dst, const uint8_t *src, uint32_t src_stride, size_t width, size_t height) {
+    for (size_t y = 0; y < height; y++) {
+        svt_memcpy(dst, src, width);
+        dst += width;
+        src += src_stride;
+    }
+}
+
+static EbErrorType copy_picture(ChunkPicture *pic, const EbBufferHeaderType *src, const EbSvtAv1EncConfiguration *cfg) {
+    pic->header             = *src;
+    pic->header.p_buffer    = NULL;
+    pic->header.wrapper_ptr = NULL;
+    pic->header.metadata    = NULL;
+    if (svt_aom_copy_metadata_buffer(&pic->header, src->metadata) != EB_ErrorNone)
+        pic->header.metadata = NULL;
+    EbErrorType return_error = copy_private_data_list(&pic->header, src);
+    if (return_error != EB_ErrorNone || !src->p_buffer)
+        return return_error;
+
+    const EbSvtIOFormat *src_io = (const EbSvtIOFormat *)src->p_buffer;
+    const EbColorFormat  format = (EbColorFormat)cfg->encoder_color_format;
+    const uint8_t        bytes  = cfg->encoder_bit_depth > EB_EIGHT_BIT ? 2 : 1;
+    const uint8_t subsampling_x = format == EB_YUV444 ? 0 : 1;
+    const uint8_t subsampling_y = format == EB_YUV444 || format == EB_YUV422 ? 0 : 1;
+    const size_t  luma_width    = cfg->source_width;
+    const size_t  luma_height   = cfg->source_height;
+    const size_t  chroma_width  = (luma_width + subsampling_x) >> subsampling_x;
+    const size_t  chroma_height = (luma_height + subsampling_y) >> subsampling_y;
+    const size_t  luma_size     = luma_width * luma_height * bytes;
+    const size_t  chroma_size   = chroma_width * chroma_height * bytes;
+    const size_t  read_size     = luma_size + 2 * chroma_size;
+    EB_CALLOC(pic->samples, read_size, 1);
+    pic->io.luma         = pic->samples;
+    pic->io.cb           = pic->samples + luma_size;
+    pic->io.cr           = pic->samples + luma_size + chroma_size;
+    pic->io.y_stride     = (uint32_t)luma_width;
+    pic->io.cb_stride    = (uint32_t)chroma_width;
+    pic->io.cr_stride    = (uint32_t)chroma_width;
+    pic->header.p_buffer = (uint8_t *)&pic->io;
+    // A too short input is passed on zeroed, for the chunk encoder to reject it as the library does
+    if (read_size > src->n_filled_len)
+        return EB_ErrorNone;
+    pic->header.n_filled_len = (uint32_t)read_size;
+    copy_plane(pic->io.luma, src_io->luma, src_io->y_stride * bytes, luma_width * bytes, luma_height);
+    copy_plane(pic->io.cb, src_io->cb, src_io->cb_stride * bytes, chroma_width * bytes, chroma_height);
+    copy_plane(pic->io.cr, src_io->cr, src_io->cr_stride * bytes, chroma_width * bytes, chroma_height);
+    return EB_ErrorNone;
+}
+
+static void push_picture(ChunkEncoder *enc, ChunkLane *lane, ChunkPicture *pic) {
+    svt_block_on_mutex(enc->mutex);
+    if (lane->pic_tail)
+        lane->pic_tail->next = pic;
+    else
+        lane->pic_head = pic;
+    lane->pic_tail = pic;
+    svt_release_mutex(enc->mutex);
+    svt_post_semaphore(lane->pic_sem);
+}
+
+static ChunkPicture *pop_picture(ChunkEncoder *enc, ChunkLane *lane) {
+    svt_block_on_semaphore(lane->pic_sem);
+    svt_block_on_mutex(enc->mutex);
+    ChunkPicture *pic = lane->pic_head;
+    lane->pic_head    = pic->next;
+    if (!lane->pic_head)
+        lane->pic_tail = NULL;
+    svt_release_mutex(enc->mutex);
+    return pic;
+}
+
+// Must be called with the mutex held, the event count is set under the mutex so it only increases
+static void signal_packet_event(Chunk *chunk) { svt_set_cond_var(&chunk->pkt_event, ++chunk->pkt_events); }
+
+// Must be called with the mutex held
+static void push_packet(Chunk *chunk, EbObjectWrapper *wrapper) {
+    if (chunk->pkt_tail)
+        chunk->pkt_tail->next_ptr = wrapper;
+    else
+        chunk->pkt_head = wrapper;
+    chunk->pkt_tail = wrapper;
+    signal_packet_event(chunk);
+}
+
+// Must be called with the mutex held: the oldest chunk of the lane is done once it got a packet per picture
+static void complete_lane_chunk(ChunkLane *lane) {
+    Chunk *chunk = lane->head;
+    if (!chunk || !chunk->closed || chunk->pkt_count != chunk->pic_count)
+        return;
+    lane->head = chunk->lane_next;
+    if (!lane->head)
+        lane->tail = NULL;
+    chunk->done = true;
+    signal_packet_event(chunk);
+}
+
+// Frees a packet which is not returned to the application
+static void drop_packet(ChunkEncoder *enc, EbObjectWrapper *wrapper) {
+    EbBufferHeaderType *packet = (EbBufferHeaderType *)wrapper->object_ptr;
+    if (packet->flags & EB_BUFFERFLAG_APP_BUFFER)
+        enc->config.output_buffer_free(enc->config.output_buffer_ctx, packet->p_buffer);
+    else
+        svt_aom_packet_buffer_release(packet->p_buffer);
+    EB_FREE(wrapper);
+}
+
+// The encoder outputs a packet per picture in decode order, and the chunks are closed GOPs, so the packets of a lane
+// go to its chunks in turn
+static void route_packet(ChunkEncoder *enc, ChunkLane *lane, EbBufferHeaderType *packet) {
+    ChunkPacket *out;
+    EB_NO_THROW_CALLOC(out, 1, sizeof(*out));
+    if (out) {
+        out->header             = *packet;
+        out->header.wrapper_ptr = &out->wrapper;
+        out->wrapper.object_ptr = &out->header;
+        // the payload outlives the encoder, its packet pool is freed once its last buffer is released
+        packet->p_buffer = NULL;
+    }
+    svt_block_on_mutex(enc->mutex);
+    Chunk *chunk = lane->head;
+    if (chunk) {
+        if (out)
+            push_packet(chunk, &out->wrapper);
+        else
+            chunk->failed = true;
+        chunk->pkt_count++;
+        complete_lane_chunk(lane);
+    }
+    svt_release_mutex(enc->mutex);
+    if (!chunk && out)
+        drop_packet(enc, &out->wrapper);
+}
+
+// Must be called with the mutex held: queues the end of stream packet once no lane is running
+static void end_stream(ChunkEncoder *enc) {
+    Chunk *chunk = enc->eos_chunk;
+    if (chunk->done)
+        return;
+    ChunkPacket *out;
+    EB_NO_THROW_CALLOC(out, 1, sizeof(*out));
+    if (out) {
+        out->header.size        = sizeof(out->header);
+        out->header.flags       = EB_BUFFERFLAG_EOS;
+        out->header.wrapper_ptr = &out->wrapper;
+        out->wrapper.object_ptr = &out->header;
+        push_packet(chunk, &out->wrapper);
+    } else
+        chunk->failed = true;
+    chunk->done = true;
+    signal_packet_event(chunk);
+}
+
+// Ends the lane once its encoder output the end of stream
+static void finish_lane(ChunkEncoder *enc, ChunkLane *lane) {
+    svt_block_on_mutex(enc->mutex);
+    // the chunks of a failed encode which did not get all their packets are not waited for
+    while (lane->head) {
+        lane->head->failed    = true;
+        lane->head->closed    = true;
+        lane->head->pkt_count = lane->head->pic_count;
+        complete_lane_chunk(lane);
+    }
+    if (!--enc->lanes_running)
+        end_stream(enc);
+    svt_release_mutex(enc->mutex);
+}
+
+static void *feed_kernel(void *input_ptr) {
+    ChunkLane    *lane = (ChunkLane *)input_ptr;
+    ChunkEncoder *enc  = lane->enc;
+    bool          eos  = false;
+    while (!eos) {
+        ChunkPicture *pic = pop_picture(enc, lane);
+        eos               = pic->header.flags & EB_BUFFERFLAG_EOS;
+        // the encoder copies the picture, blocking while all its input buffers are in use
+        svt_av1_enc_send_picture(lane->handle, &pic->header);
+        free_picture(pic);
+        if (!eos)
+            svt_post_semaphore(enc->free_pics);
+    }
+    return NULL;
+}
+
+static void *drain_kernel(void *input_ptr) {
+    ChunkLane    *lane = (ChunkLane *)input_ptr;
+    ChunkEncoder *enc  = lane->enc;
+    bool          eos  = false;
+    while (!eos) {
+        EbBufferHeaderType *packet = NULL;
+        svt_av1_enc_get_packet(lane->handle, &packet, 1);
+        if (!packet)
+            continue;
+        eos = packet->flags & EB_BUFFERFLAG_EOS;
+        if (!eos)
+            route_packet(enc, lane, packet);
+        svt_av1_enc_release_out_buffer(&packet);
+    }
+    finish_lane(enc, lane);
+    return NULL;
+}
+
+static EbErrorType create_lane_handle(ChunkEncoder *enc, ChunkLane *lane) {
+    EbSvtAv1EncConfiguration config;
+    EbErrorType              return_error = svt_av1_enc_init_handle(&lane->handle, &config);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    ((EbEncHandle *)lane->handle->p_component_private)->is_chunk_encoder = true;
+    return_error = svt_av1_enc_attach_executor(lane->handle, enc->executor, 1);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    config       = enc->config;
+    return_error = svt_av1_enc_set_parameter(lane->handle, &config);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    return svt_av1_enc_init(lane->handle);
+}
+
+// A lane which failed to start is released by svt_aom_chunk_encoder_free()
+static EbErrorType start_lane(ChunkEncoder *enc, ChunkLane *lane) {
+    lane->enc = enc;
+    EB_CREATE_SEMAPHORE(lane->pic_sem, 0, UINT32_MAX >> 1);
+    EB_CALLOC(lane->eos_pic, 1, sizeof(*lane->eos_pic));
+    lane->eos_pic->header.size  = sizeof(lane->eos_pic->header);
+    lane->eos_pic->header.flags = EB_BUFFERFLAG_EOS;
+    EbErrorType return_error = create_lane_handle(enc, lane);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    lane->drain_thread = svt_create_thread(drain_kernel, lane);
+    EB_ADD_MEM(lane->drain_thread, 1, EB_THREAD);
+    svt_block_on_mutex(enc->mutex);
+    enc->lanes_running++;
+    svt_release_mutex(enc->mutex);
+    lane->feed_thread = svt_create_thread(feed_kernel, lane);
+    EB_NO_THROW_ADD_MEM(lane->feed_thread, 1, EB_THREAD);
+    if (!lane->feed_thread) {
+        // ends the encode for the drain thread to end
+        svt_av1_enc_send_picture(lane->handle, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS});
+        return EB_ErrorInsufficientResources;
+    }
+    return EB_ErrorNone;
+}
+
+static Chunk *new_chunk(void) {
+    Chunk *chunk;
+    EB_NO_THROW_CALLOC(chunk, 1, sizeof(*chunk));
+    if (chunk)
+        svt_create_cond_var(&chunk->pkt_event);
+    return chunk;
+}
+
+static void free_chunk(ChunkEncoder *enc, Chunk *chunk) {
+    while (chunk->pkt_head) {
+        EbObjectWrapper *wrapper = chunk->pkt_head;
+        chunk->pkt_head          = wrapper->next_ptr;
+        drop_packet(enc, wrapper);
+    }
+    EB_FREE(chunk);
+}
+
+// Must be called with the mutex held
+static void append_chunk(ChunkEncoder *enc, Chunk *chunk) {
+    if (enc->tail)
+        enc->tail->next = chunk;
+    else
+        enc->head = chunk;
+    enc->tail = chunk;
+}
+
+static EbErrorType start_chunk(ChunkEncoder *enc) {
+    ChunkLane *lane = &enc->lanes[enc->chunk_count % enc->max_lanes];
+    if (!lane->handle) {
+        EbErrorType return_error = start_lane(enc, lane);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    Chunk *chunk = new_chunk();
+    if (!chunk)
+        return EB_ErrorInsufficientResources;
+    chunk->lane = lane;
+    svt_block_on_mutex(enc->mutex);
+    append_chunk(enc, chunk);
+    if (lane->tail)
+        lane->tail->lane_next = chunk;
+    else
+        lane->head = chunk;
+    lane->tail = chunk;
+    svt_release_mutex(enc->mutex);
+    enc->current = chunk;
+    enc->chunk_count++;
+    return EB_ErrorNone;
+}
+
+// Sends the end of stream to the encoders of the lanes, and to the application once they all output theirs
+static void send_eos(ChunkEncoder *enc) {
+    enc->eos_sent = true;
+    svt_block_on_mutex(enc->mutex);
+    Chunk *chunk = enc->current;
+    if (chunk) {
+        // the packets of the pictures of the last chunk may all be out already
+        chunk->closed = true;
+        complete_lane_chunk(chunk->lane);
+        enc->current = NULL;
+    }
+    append_chunk(enc, enc->eos_chunk);
+    if (!enc->lanes_running)
+        end_stream(enc);
+    svt_release_mutex(enc->mutex);
+    for (uint32_t i = 0; i < enc->max_lanes; i++) {
+        ChunkLane *lane = &enc->lanes[i];
+        if (lane->feed_thread) {
+            push_picture(enc, lane, lane->eos_pic);
+            lane->eos_pic = NULL;
+        }
+    }
+}
+
+EbErrorType svt_aom_chunk_encoder_create(ChunkEncoder **enc_ptr, const EbSvtAv1EncConfiguration *config,
+                                         int32_t intra_period_length, ExecutorClient *executor_client) {
+    ChunkEncoder *enc;
+    EB_CALLOC(enc, 1, sizeof(*enc));
+    *enc_ptr = enc;
+    // the encoder of each lane gets the key frame interval resolved by the parent handle
+    enc->config                     = *config;
+    enc->config.intra_period_length = intra_period_length;
+    enc->config.multiply_keyint     = false;
+    enc->config.chunk_parallel      = 0;
+    memset(&enc->config.frame_scale_evts, 0, sizeof(enc->config.frame_scale_evts));
+    enc->max_lanes    = config->chunk_parallel;
+    enc->chunk_length = (uint32_t)intra_period_length + 1;
+    EB_CALLOC(enc->lanes, enc->max_lanes, sizeof(*enc->lanes));
+    EB_CREATE_MUTEX(enc->mutex);
+    EB_CREATE_SEMAPHORE(enc->free_pics, enc->chunk_length, enc->chunk_length);
+    enc->eos_chunk = new_chunk();
+    EB_CHECK_MEM(enc->eos_chunk);
+    if (executor_client)
+        enc->executor = svt_aom_executor_of(executor_client);
+    else {
+        EbErrorType return_error = svt_aom_executor_create(&enc->executor, config->pin_threads);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        enc->own_executor = true;
+    }
+    return EB_ErrorNone;
+}
+
+void svt_aom_chunk_encoder_free(ChunkEncoder *enc) {
+    if (!enc)
+        return;
+    // the lanes end once their encoder output the end of stream
+    if (enc->mutex && enc->eos_chunk && !enc->eos_sent)
+        send_eos(enc);
+    for (uint32_t i = 0; enc->lanes && i < enc->max_lanes; i++) {
+        ChunkLane *lane = &enc->lanes[i];
+        EB_DESTROY_THREAD(lane->feed_thread);
+        EB_DESTROY_THREAD(lane->drain_thread);
+        if (lane->handle) {
+            svt_av1_enc_deinit(lane->handle);
+            svt_av1_enc_deinit_handle(lane->handle);
+        }
+        while (lane->pic_head) {
+            ChunkPicture *pic = lane->pic_head;
+            lane->pic_head    = pic->next;
+            free_picture(pic);
+        }
+        if (lane->eos_pic)
+            free_picture(lane->eos_pic);
+        EB_DESTROY_SEMAPHORE(lane->pic_sem);
+    }
+    while (enc->head) {
+        Chunk *chunk = enc->head;
+        enc->head    = chunk->next;
+        free_chunk(enc, chunk);
+    }
+    if (enc->own_executor)
+        svt_aom_executor_destroy(enc->executor);
+    EB_FREE(enc->lanes);
+    EB_DESTROY_SEMAPHORE(enc->free_pics);
+    EB_DESTROY_MUTEX(enc->mutex);
+    EB_FREE(enc);
+}
+
+EbErrorType svt_aom_chunk_encoder_send_picture(ChunkEncoder *enc, const EbBufferHeaderType *p_buffer) {
+    if (p_buffer->flags & EB_BUFFERFLAG_EOS) {
+        send_eos(enc);
+        return EB_ErrorNone;
+    }
+    if (!enc->current) {
+        EbErrorType return_error = start_chunk(enc);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    // blocks while chunk_length pictures are waiting for an encoder
+    svt_block_on_semaphore(enc->free_pics);
+    ChunkPicture *pic;
+    EB_NO_THROW_CALLOC(pic, 1, sizeof(*pic));
+    EbErrorType return_error = pic ? copy_picture(pic, p_buffer, &enc->config) : EB_ErrorInsufficientResources;
+    if (return_error != EB_ErrorNone) {
+        if (pic)
+            free_picture(pic);
+        svt_post_semaphore(enc->free_pics);
+        return return_error;
+    }
+    Chunk *chunk = enc->current;
+    // forced, a key frame forced by the application would otherwise offset the key frame interval of the lane
+    if (!chunk->pic_count)
+        pic->header.pic_type = EB_AV1_KEY_PICTURE;
+    svt_block_on_mutex(enc->mutex);
+    chunk->closed = ++chunk->pic_count == enc->chunk_length;
+    svt_release_mutex(enc->mutex);
+    if (chunk->closed)
+        enc->current = NULL;
+    push_picture(enc, chunk->lane, pic);
+    return EB_ErrorNone;
+}
+
+EbErrorType svt_aom_chunk_encoder_get_packet(ChunkEncoder *enc, EbBufferHeaderType **p_buffer, bool block) {
+    EbErrorType return_error = EB_NoErrorEmptyQueue;
+    *p_buffer                = NULL;
+    svt_block_on_mutex(enc->mutex);
+    Chunk *chunk;
+    while ((chunk = enc->head)) {
+        EbObjectWrapper *wrapper = chunk->pkt_head;
+        if (wrapper) {
+            chunk->pkt_head = wrapper->next_ptr;
+            if (!chunk->pkt_head)
+                chunk->pkt_tail = NULL;
+            wrapper->next_ptr = NULL;
+            *p_buffer         = (EbBufferHeaderType *)wrapper->object_ptr;
+            return_error      = EB_ErrorNone;
+            break;
+        }
+        if (chunk->done) {
+            const bool failed = chunk->failed;
+            enc->head         = chunk->next;
+            if (enc->tail == chunk)
+                enc->tail = NULL;
+            free_chunk(enc, chunk);
+            if (failed) {
+                return_error = EB_ErrorInsufficientResources;
+                break;
+            }
+            continue;
+        }
+        if (!block)
+            break;
+        const int32_t events = chunk->pkt_events;
+        svt_release_mutex(enc->mutex);
+        svt_wait_cond_var(&chunk->pkt_event, events);
+        svt_block_on_mutex(enc->mutex);
+    }
+    svt_release_mutex(enc->mutex);
+    return return_error;
+}
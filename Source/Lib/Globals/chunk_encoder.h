@@ -0,0 +1,51 @@
+/*
+* Copyright (c) 2026, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbChunkEncoder_h
+#define EbChunkEncoder_h
+
+#include "definitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ChunkEncoder ChunkEncoder;
+struct ExecutorClient;
+
+/*
+ * Closed GOP chunk parallel encoding behind a single encoder handle.
+ *
+ * The input is split at the key frame interval into chunks of intra_period_length + 1 pictures, each starting with
+ * a key frame. chunk_parallel encoder instances, the lanes, encode the chunks concurrently: lane i encodes chunks i,
+ * i + chunk_parallel, ... back to back as a single stream, so the instances are created once and the chunks keep
+ * starting with a key frame. The pictures are copied into a queue per lane, fed to the encoder of the lane by its
+ * own thread; the queues hold up to chunk length pictures in all, sending a picture blocks while they are full.
+ * The packets of a lane are routed to its chunks by count, the encoder outputting a packet per picture, and are
+ * returned in chunk order, followed by an empty end of stream packet once all the lanes ended.
+ *
+ * The instances share an executor, the one the parent handle is attached to or else one sized for all the cores,
+ * so the chunks encoding concurrently never run more heavy tasks than there are cores.
+ */
+EbErrorType svt_aom_chunk_encoder_create(ChunkEncoder **enc_ptr, const EbSvtAv1EncConfiguration *config,
+                                         int32_t intra_period_length, struct ExecutorClient *executor_client);
+// Flushes the chunks still encoding, the packets not yet returned are dropped
+void svt_aom_chunk_encoder_free(ChunkEncoder *enc);
+
+EbErrorType svt_aom_chunk_encoder_send_picture(ChunkEncoder *enc, const EbBufferHeaderType *p_buffer);
+// Returns EB_NoErrorEmptyQueue when no packet is ready, unless block is set and a packet is still to come
+EbErrorType svt_aom_chunk_encoder_get_packet(ChunkEncoder *enc, EbBufferHeaderType **p_buffer, bool block);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbChunkEncoder_h
@@ -39,6 +39,7 @@
 #include "enc_dec_process.h"
 #include "ec_process.h"
 #include "packetization_process.h"
+#include "packet_buffer_pool.h"
 #include "resource_coordination_results.h"
 #include "pic_analysis_results.h"
 #include "pd_results.h"
@@ -98,6 +99,9 @@
 #define ENCDEC_INPUT_PORT_MDC                                0
 #define ENCDEC_INPUT_PORT_ENCDEC                             1
 #define ENCDEC_INPUT_PORT_INVALID                           -1
+#define REST_INPUT_PORT_CDEF                                 0
+#define REST_INPUT_PORT_REST                                 1
+#define REST_INPUT_PORT_INVALID                             -1
 /**************************************
  * Globals
  **************************************/
@@ -182,13 +186,22 @@ static uint32_t get_num_processors() {
 #endif
 }
 
-static EbErrorType init_thread_management_params() {
+#if defined(__linux__)
+static void processor_topology_cleanup(void) { free(lp_group); }
+#endif
+// The processor topology is read once per process and shared read-only by all encoder instances
+static SvtOnce     processor_topology_once = SVT_ONCE_INIT;
+static EbErrorType processor_topology_error = EB_ErrorNone;
+static void init_processor_topology(void) {
 #ifdef _WIN32
-    // Initialize svt_aom_group_affinity structure with Current thread info
-    GetThreadGroupAffinity(GetCurrentThread(), &svt_aom_group_affinity);
     num_groups = (uint8_t)GetActiveProcessorGroupCount();
 #elif defined(__linux__)
-    memset(lp_group, 0, INITIAL_PROCESSOR_GROUP * sizeof(processorGroup));
+    lp_group = calloc(INITIAL_PROCESSOR_GROUP, sizeof(processorGroup));
+    if (!lp_group) {
+        processor_topology_error = EB_ErrorInsufficientResources;
+        return;
+    }
+    atexit(processor_topology_cleanup);
 
     FILE *fin = fopen("/proc/cpuinfo", "r");
     if (fin) {
@@ -208,7 +221,8 @@ static EbErrorType init_thread_management_params() {
                 long socket_id = strtol(p, NULL, 0);
                 if (socket_id < 0) {
                     fclose(fin);
-                    return EB_ErrorInsufficientResources;
+                    processor_topology_error = EB_ErrorInsufficientResources;
+                    return;
                 }
                 if (socket_id + 1 > num_groups)
                     num_groups = socket_id + 1;
@@ -221,9 +235,9 @@ static EbErrorType init_thread_management_params() {
                         lp_group = temp;
                     }
                     else {
-                        free(lp_group);
                         fclose(fin);
-                        return EB_ErrorInsufficientResources;
+                        processor_topology_error = EB_ErrorInsufficientResources;
+                        return;
                     }
                 }
                 lp_group[socket_id].group[lp_group[socket_id].num++] = processor_id;
@@ -232,7 +246,16 @@ static EbErrorType init_thread_management_params() {
         fclose(fin);
     }
 #endif
-    return EB_ErrorNone;
+}
+
+static EbErrorType init_thread_management_params() {
+    if (svt_run_once(&processor_topology_once, init_processor_topology) != EB_ErrorNone)
+        return EB_ErrorInsufficientResources;
+#ifdef _WIN32
+    // Initialize svt_aom_group_affinity structure with Current thread info
+    GetThreadGroupAffinity(GetCurrentThread(), &svt_aom_group_affinity);
+#endif
+    return processor_topology_error;
 }
 
 #ifdef _WIN32
@@ -489,6 +512,9 @@ static EbErrorType load_default_buffer_configuration_settings(
             core_count = scs->static_config.pin_threads;
         }
     }
+    // Instances sharing an executor are sized from their share of the executor cores
+    if (scs->enc_ctx->executor_client)
+        core_count = MIN(core_count, svt_aom_executor_core_share(scs->enc_ctx->executor_client));
 
     uint32_t lp = scs->static_config.level_of_parallelism;
     if (lp == 0) {
@@ -865,6 +891,11 @@ static EncDecPorts_t enc_dec_ports[] = {
     {ENCDEC_INPUT_PORT_ENCDEC,     0},
     {ENCDEC_INPUT_PORT_INVALID,    0}
 };
+static EncDecPorts_t rest_ports[] = {
+    {REST_INPUT_PORT_CDEF,       0},
+    {REST_INPUT_PORT_REST,       0},
+    {REST_INPUT_PORT_INVALID,    0}
+};
 static EncDecPorts_t tpl_ports[] = {
     {TPL_INPUT_PORT_SOP,     0},
     {TPL_INPUT_PORT_TPL,     0},
@@ -916,6 +947,27 @@ static uint32_t enc_dec_port_total_count(void){
         total_count += enc_dec_ports[port_index++].count;
     return total_count;
 }
+// Rest
+static uint32_t rest_port_lookup(
+    int32_t  type,
+    uint32_t  port_type_index)
+{
+    uint32_t port_index = 0;
+    uint32_t port_count = 0;
+
+    while ((type != rest_ports[port_index].type) && (type != REST_INPUT_PORT_INVALID))
+        port_count += rest_ports[port_index++].count;
+    return (port_count + port_type_index);
+}
+// Rest
+static uint32_t rest_port_total_count(void){
+    uint32_t port_index = 0;
+    uint32_t total_count = 0;
+
+    while (rest_ports[port_index].type != REST_INPUT_PORT_INVALID)
+        total_count += rest_ports[port_index++].count;
+    return total_count;
+}
 /*****************************************
  * Input Port Total Count
  *****************************************/
@@ -979,6 +1031,7 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 static void svt_enc_handle_dctor(EbPtr p)
 {
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
+    svt_aom_chunk_encoder_free(enc_handle_ptr->chunk_encoder);
     svt_enc_handle_stop_threads(enc_handle_ptr);
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1427,6 +1480,67 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
 
 void init_fn_ptr(void);
 void svt_av1_init_wedge_masks(void);
+
+/* Process wide tables and function pointers shared by all encoder instances. They are set up once, by the
+ * first encoder, with its cpu flags. The function pointers are read by the running encoders without any
+ * lock, so they are never rewritten: later encoders asking for other cpu flags run with the first ones. */
+static SvtOnce    global_init_once = SVT_ONCE_INIT;
+static EbHandle   global_init_mutex;
+static bool       global_tables_ready = false;
+static EbCpuFlags global_rtcd_flags;
+// block geometry tables, built on first use and shared by the instances with the same geometry
+static BlockGeom *global_blk_geom[GEOM_TOT];
+
+static void global_init_mutex_cleanup(void) { svt_destroy_mutex(global_init_mutex); }
+static void global_blk_geom_cleanup(void) {
+    for (int geom = 0; geom < GEOM_TOT; geom++) EB_FREE_ARRAY(global_blk_geom[geom]);
+}
+static void create_global_init_mutex(void) {
+    global_init_mutex = svt_create_mutex();
+    atexit(global_blk_geom_cleanup);
+    atexit(global_init_mutex_cleanup);
+}
+
+static EbErrorType init_global_tables(EbCpuFlags *use_cpu_flags) {
+    if (svt_run_once(&global_init_once, create_global_init_mutex) != EB_ErrorNone || !global_init_mutex)
+        return EB_ErrorInsufficientResources;
+    svt_block_on_mutex(global_init_mutex);
+    if (!global_tables_ready) {
+        svt_aom_setup_common_rtcd_internal(*use_cpu_flags);
+        svt_aom_setup_rtcd_internal(*use_cpu_flags);
+        svt_aom_asm_set_convolve_asm_table();
+        svt_aom_asm_set_convolve_hbd_asm_table();
+        svt_aom_init_intra_predictors_internal();
+        init_fn_ptr();
+        // the cpu flag independent tables rely on svt_memcpy, so they are built after the rtcd setup
+        svt_aom_init_intra_dc_predictors_c_internal();
+        svt_av1_init_me_luts();
+        svt_av1_init_wedge_masks();
+        global_rtcd_flags   = *use_cpu_flags;
+        global_tables_ready = true;
+    } else if (global_rtcd_flags != *use_cpu_flags) {
+        SVT_WARN("asm level up to %s requested, another encoder already selected up to %s for the process\n",
+                 get_asm_level_name_str(*use_cpu_flags),
+                 get_asm_level_name_str(global_rtcd_flags));
+        *use_cpu_flags = global_rtcd_flags;
+    }
+    svt_release_mutex(global_init_mutex);
+    return EB_ErrorNone;
+}
+
+static EbErrorType get_global_blk_geom(GeomIndex geom, const BlockGeom **blk_geom_mds) {
+    EbErrorType return_error = EB_ErrorNone;
+    svt_block_on_mutex(global_init_mutex);
+    if (!global_blk_geom[geom]) {
+        return_error = svt_aom_build_blk_geom(geom, &global_blk_geom[geom]);
+        if (return_error != EB_ErrorNone)
+            EB_FREE_ARRAY(global_blk_geom[geom]);
+    }
+    *blk_geom_mds = global_blk_geom[geom];
+    svt_release_mutex(global_init_mutex);
+    return return_error;
+}
+
 /**********************************
 * Initialize Encoder Library
 **********************************/
@@ -1441,24 +1555,25 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     EbColorFormat color_format = enc_handle_ptr->scs_instance_array[0]->scs->static_config.encoder_color_format;
     SequenceControlSet* control_set_ptr;
 
-    svt_aom_setup_common_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
-    svt_aom_setup_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
-
-    svt_aom_asm_set_convolve_asm_table();
-
-    svt_aom_init_intra_dc_predictors_c_internal();
-
-    svt_aom_asm_set_convolve_hbd_asm_table();
-
-    svt_aom_init_intra_predictors_internal();
-    #ifdef MINIMAL_BUILD
-    svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
-    #endif
-    svt_aom_build_blk_geom(enc_handle_ptr->scs_instance_array[0]->scs->svt_aom_geom_idx);
+    // The chunk encoders build their own pipelines, once their chunk starts
+    if (enc_handle_ptr->chunk_encoder)
+        return EB_ErrorNone;
+    return_error = init_global_tables(&enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Each instance points to the table of its own geometry, so instances with different geometries can coexist
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        SequenceControlSet *scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
+        return_error = get_global_blk_geom(scs->svt_aom_geom_idx, &scs->blk_geom_mds);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        if (scs->static_config.analysis_cache_out || scs->static_config.analysis_cache_in.sz) {
+            return_error = svt_aom_analysis_cache_create(&scs->enc_ctx->analysis_cache, scs);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+        }
+    }
 
-    svt_av1_init_me_luts();
-    init_fn_ptr();
-    svt_av1_init_wedge_masks();
     /************************************
      * Sequence Control Set
      ************************************/
@@ -1720,6 +1835,9 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     enc_dec_ports[ENCDEC_INPUT_PORT_MDC].count = enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count;
     enc_dec_ports[ENCDEC_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count;
+    // the rest processes post the jobs of the final restoration search back to themselves
+    rest_ports[REST_INPUT_PORT_CDEF].count = enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count;
+    rest_ports[REST_INPUT_PORT_REST].count = enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count;
     tpl_ports[TPL_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count;
     tpl_ports[TPL_INPUT_PORT_TPL].count = enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count;
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -2024,7 +2142,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->cdef_results_resource_ptr,
             svt_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs->cdef_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
+            rest_port_total_count(),
             enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count,
             cdef_results_creator,
             &cdef_result_init_data,
@@ -2218,7 +2336,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 enc_handle_ptr,
                 &input_data,
                 process_index,
-                pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_REST, process_index));
+                pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_REST, process_index),
+                rest_port_lookup(REST_INPUT_PORT_REST, process_index));
         }
 
         // Entropy Coding Contexts
@@ -2332,6 +2451,12 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
         }
         if (receive_buffer) {
             eos = receive_buffer->flags & EB_BUFFERFLAG_EOS;
+            // the packets are dropped, hand the buffers from the application allocator back to it
+            if (receive_buffer->flags & EB_BUFFERFLAG_APP_BUFFER) {
+                const EbSvtAv1EncConfiguration *cfg =
+                    &((EbEncHandle *)svt_enc_component->p_component_private)->scs_instance_array[0]->scs->static_config;
+                cfg->output_buffer_free(cfg->output_buffer_ctx, receive_buffer->p_buffer);
+            }
             svt_av1_enc_release_out_buffer(&receive_buffer);
             receive_buffer = NULL;
         }
@@ -2339,6 +2464,21 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     return EB_ErrorNone;
 }
 
+// Reports how often the luma inter predictions were reused across the interpolation filter search
+static void report_inter_pred_cache_stats(EbEncHandle *handle) {
+    uint64_t lookups = 0, hits = 0;
+    for (uint32_t i = 0; i < handle->scs_instance_array[0]->scs->enc_dec_process_init_count; i++) {
+        const InterPredCache *cache =
+            &((EncDecContext *)handle->enc_dec_context_ptr_array[i]->priv)->md_ctx->inter_pred_cache;
+        lookups += cache->lookups;
+        hits += cache->hits;
+    }
+    if (lookups)
+        SVT_DEBUG("inter prediction cache: %llu lookups, %.2f%% hits\n",
+                  (unsigned long long)lookups,
+                  hits * 100.0 / lookups);
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -2348,7 +2488,7 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
 
     EbEncHandle *handle = svt_enc_component->p_component_private;
 
-    if (handle->input_y8b_buffer_producer_fifo_ptr && handle->frame_received) {
+    if ((handle->input_y8b_buffer_producer_fifo_ptr || handle->chunk_encoder) && handle->frame_received) {
         if (!handle->eos_received) {
             SVT_ERROR("deinit called without sending EOS!\n");
             svt_av1_enc_send_picture(svt_enc_component, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS});
@@ -2357,10 +2497,9 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
         EbErrorType return_error = enc_drain_queue(svt_enc_component);
         if (return_error != EB_ErrorNone)
             return return_error;
+        if (!handle->chunk_encoder)
+            report_inter_pred_cache_stats(handle);
     }
-    #ifdef MINIMAL_BUILD
-    svt_aom_free(svt_aom_blk_geom_mds);
-    #endif
     svt_shutdown_process(handle->input_buffer_resource_ptr);
     svt_shutdown_process(handle->input_cmd_resource_ptr);
     svt_shutdown_process(handle->resource_coordination_results_resource_ptr);
@@ -2396,12 +2535,6 @@ EB_API EbErrorType svt_av1_enc_init_handle(
          return EB_ErrorBadParameter;
     svt_log_init();
 
-    #if defined(__linux__)
-        if(lp_group == NULL) {
-            EB_MALLOC(lp_group, INITIAL_PROCESSOR_GROUP * sizeof(processorGroup));
-        }
-    #endif
-
     *p_handle = (EbComponentType*)malloc(sizeof(EbComponentType));
     if (*p_handle == (EbComponentType*)NULL) {
         SVT_ERROR("Component Struct Malloc Failed\n");
@@ -2451,9 +2584,6 @@ EB_API EbErrorType svt_av1_enc_deinit_handle(
         EbErrorType return_error = svt_av1_enc_component_de_init(svt_enc_component);
 
         free(svt_enc_component);
-#if  defined(__linux__)
-        EB_FREE(lp_group);
-#endif
         svt_decrease_component_count();
         return return_error;
     }
@@ -4627,6 +4757,30 @@ static void copy_api_from_app(
     // HBD-MD
     scs->static_config.hbd_mds = config_struct->hbd_mds;
 
+    // Fast recode
+    scs->static_config.fast_recode = config_struct->fast_recode;
+
+    // OBU streaming
+    scs->static_config.obu_streaming = config_struct->obu_streaming;
+
+    // Output buffer allocator
+    scs->static_config.output_buffer_alloc = config_struct->output_buffer_alloc;
+    scs->static_config.output_buffer_free  = config_struct->output_buffer_free;
+    scs->static_config.output_buffer_ctx   = config_struct->output_buffer_ctx;
+
+    // PD0 quadrant parallelism
+    scs->static_config.pd0_quadrant_parallel = config_struct->pd0_quadrant_parallel;
+
+    // Split entropy coding
+    scs->static_config.split_entropy_coding = config_struct->split_entropy_coding;
+
+    // Analysis cache
+    scs->static_config.analysis_cache_out = config_struct->analysis_cache_out;
+    scs->static_config.analysis_cache_in  = config_struct->analysis_cache_in;
+
+    // Chunk parallel encoding
+    scs->static_config.chunk_parallel = config_struct->chunk_parallel;
+
     // Override settings for Still Picture tune
     if (scs->static_config.tune == 4) {
         SVT_WARN("Tune 4: Still Picture is experimental, expect frequent changes that may modify present behavior.\n");
@@ -4650,6 +4804,79 @@ static void copy_api_from_app(
     return;
 }
 
+/**********************************
+* Create Executor
+**********************************/
+EB_API EbErrorType svt_av1_executor_create(EbSvtAv1Executor **executor, uint32_t core_count) {
+    if (executor == NULL)
+        return EB_ErrorBadParameter;
+    return svt_aom_executor_create(executor, core_count);
+}
+
+/**********************************
+* Destroy Executor
+**********************************/
+EB_API EbErrorType svt_av1_executor_destroy(EbSvtAv1Executor *executor) {
+    if (executor == NULL)
+        return EB_ErrorBadParameter;
+    svt_aom_executor_destroy(executor);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Attach Executor
+**********************************/
+EB_API EbErrorType svt_av1_enc_attach_executor(
+    EbComponentType  *svt_enc_component,
+    EbSvtAv1Executor *executor,
+    uint32_t          priority)
+{
+    if (svt_enc_component == NULL || executor == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle   *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    EncodeContext *enc_ctx    = enc_handle->scs_instance_array[0]->enc_ctx;
+    // the thread pools are sized in svt_av1_enc_set_parameter()
+    if (enc_ctx->executor_client || enc_handle->scs_instance_array[0]->scs->lp)
+        return EB_ErrorBadParameter;
+    return svt_aom_executor_attach(executor, priority, &enc_ctx->executor_client);
+}
+
+/**********************************
+* Create Analysis Ladder
+**********************************/
+EB_API EbErrorType svt_av1_analysis_ladder_create(EbSvtAv1AnalysisLadder **ladder) {
+    if (ladder == NULL)
+        return EB_ErrorBadParameter;
+    return svt_aom_ladder_create(ladder);
+}
+
+/**********************************
+* Destroy Analysis Ladder
+**********************************/
+EB_API EbErrorType svt_av1_analysis_ladder_destroy(EbSvtAv1AnalysisLadder *ladder) {
+    if (ladder == NULL)
+        return EB_ErrorBadParameter;
+    svt_aom_ladder_destroy(ladder);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Attach Analysis Ladder
+**********************************/
+EB_API EbErrorType svt_av1_enc_attach_analysis_ladder(
+    EbComponentType        *svt_enc_component,
+    EbSvtAv1AnalysisLadder *ladder,
+    bool                    leader)
+{
+    if (svt_enc_component == NULL || ladder == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle   *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    EncodeContext *enc_ctx    = enc_handle->scs_instance_array[0]->enc_ctx;
+    if (enc_ctx->ladder_client)
+        return EB_ErrorBadParameter;
+    return svt_aom_ladder_attach(ladder, leader, &enc_ctx->ladder_client);
+}
+
 /**********************************
 
 * Set Parameter
@@ -4689,8 +4916,17 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     return_error = load_default_buffer_configuration_settings(
         enc_handle->scs_instance_array[instance_index]->scs);
 
-    svt_av1_print_lib_params(
-        enc_handle->scs_instance_array[instance_index]->scs);
+    if (!enc_handle->is_chunk_encoder)
+        svt_av1_print_lib_params(
+            enc_handle->scs_instance_array[instance_index]->scs);
+
+    // The chunk encoders get the configuration of the application, with the key frame interval resolved
+    SequenceControlSet *scs = enc_handle->scs_instance_array[instance_index]->scs;
+    if (return_error == EB_ErrorNone && scs->static_config.chunk_parallel > 1 && !enc_handle->chunk_encoder)
+        return_error = svt_aom_chunk_encoder_create(&enc_handle->chunk_encoder,
+                                                    config_struct,
+                                                    scs->static_config.intra_period_length,
+                                                    scs->enc_ctx->executor_client);
 
     // free frame scale events after copy to encoder
     if (config_struct->frame_scale_evts.resize_denoms) EB_FREE(config_struct->frame_scale_evts.resize_denoms);
@@ -5448,6 +5684,11 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     EbBufferHeaderType   *app_hdr = p_buffer;
     enc_handle_ptr->frame_received = true;
 
+    if (enc_handle_ptr->chunk_encoder) {
+        enc_handle_ptr->eos_received += p_buffer->flags & EB_BUFFERFLAG_EOS;
+        return svt_aom_chunk_encoder_send_picture(enc_handle_ptr->chunk_encoder, p_buffer);
+    }
+
     static bool is_first_picture_sent = 0;
     // Check if a picture has already been sent and AVIF mode is used
     if ( enc_handle_ptr->scs_instance_array[0]->scs->static_config.avif && is_first_picture_sent ) {
@@ -5597,7 +5838,8 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     // check if the user is claiming that the last picture has been sent
     // without actually signalling it through svt_av1_enc_send_picture()
-    assert(!(!enc_handle->eos_received && pic_send_done));
+    // (the encoders of a chunk parallel encode wait for their packets while the pictures are sent)
+    assert(!(!enc_handle->eos_received && pic_send_done) || enc_handle->is_chunk_encoder);
 
     // if we have already sent out an EOS, then the user should not be calling
     // this function again, as it will just block inside svt_get_full_object()
@@ -5606,6 +5848,16 @@ EB_API EbErrorType svt_av1_enc_get_packet(
         return EB_NoErrorEmptyQueue;
     }
 
+    if (enc_handle->chunk_encoder) {
+        return_error = svt_aom_chunk_encoder_get_packet(enc_handle->chunk_encoder, p_buffer, pic_send_done);
+        if (*p_buffer) {
+            if ((*p_buffer)->flags & EB_BUFFERFLAG_ERROR_MASK)
+                return_error = EB_ErrorMax;
+            enc_handle->eos_sent += (*p_buffer)->flags & EB_BUFFERFLAG_EOS;
+        }
+        return return_error;
+    }
+
     if (pic_send_done || cfg->pred_structure == SVT_AV1_PRED_LOW_DELAY_B)
         svt_get_full_object(
             enc_handle->output_stream_buffer_consumer_fifo_ptr,
@@ -5617,7 +5869,7 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     if (eb_wrapper_ptr) {
         packet = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
-        if ( packet->flags & 0xfffffff0 )
+        if ( packet->flags & EB_BUFFERFLAG_ERROR_MASK )
             return_error = EB_ErrorMax;
         // return the output stream buffer
         *p_buffer = packet;
@@ -5638,10 +5890,16 @@ EB_API void svt_av1_enc_release_out_buffer(
 {
     if (p_buffer && (*p_buffer)->wrapper_ptr)
     {
-        if((*p_buffer)->p_buffer)
-           EB_FREE((*p_buffer)->p_buffer);
-        // Release out put buffer back into the pool
-        svt_release_object((EbObjectWrapper  *)(*p_buffer)->wrapper_ptr);
+        // Recycle the packet data into the pool of the encoder that produced it, the application owns its buffers
+        if (!((*p_buffer)->flags & EB_BUFFERFLAG_APP_BUFFER))
+            svt_aom_packet_buffer_release((*p_buffer)->p_buffer);
+        (*p_buffer)->p_buffer = NULL;
+        // Release out put buffer back into the pool, the packets of a chunk parallel encode are not pooled
+        EbObjectWrapper *wrapper = (EbObjectWrapper *)(*p_buffer)->wrapper_ptr;
+        if (wrapper->system_resource_ptr)
+            svt_release_object(wrapper);
+        else
+            EB_DELETE(wrapper);
      }
     return;
 }
@@ -6069,6 +6327,11 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_ANALYSIS_CACHE_OUT) {
+        EncodeContext *context = enc_handle->scs_instance_array[0]->enc_ctx;
+        svt_aom_analysis_cache_get_output(context->analysis_cache, (SvtAv1FixedBuf *)info);
+        return context->analysis_cache && ((SvtAv1FixedBuf *)info)->sz ? EB_ErrorNone : EB_ErrorBadParameter;
+    }
     return EB_ErrorBadParameter;
 }
 // clang-format on
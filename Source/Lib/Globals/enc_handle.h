@@ -18,6 +18,7 @@
 #include "sys_resource_manager.h"
 #include "sequence_control_set.h"
 #include "object.h"
+#include "chunk_encoder.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -130,6 +131,10 @@ struct _EbEncHandle {
     bool eos_sent; // used to signal we sent the EOS to the app
     bool frame_received; // used to signal we received any frame from the app
     bool is_prev_valid; // whether the previous input is valid or not
+
+    // Set when the handle encodes in chunk parallel mode, the pictures are then encoded by its chunk encoders
+    ChunkEncoder *chunk_encoder;
+    bool          is_chunk_encoder; // the handle encodes a chunk of a parent handle
 };
 void set_segments_numbers(SequenceControlSet *scs);
 #endif // EbEncHandle_h
@@ -694,6 +694,47 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         SVT_ERROR("Error instance %u: switch frame interval must be >= 0\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->obu_streaming && config->pred_structure != SVT_AV1_PRED_LOW_DELAY_B) {
+        SVT_ERROR("Error instance %u: obu streaming only supports the low delay prediction structure\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->obu_streaming && config->superres_mode > SUPERRES_NONE) {
+        SVT_ERROR("Error instance %u: obu streaming is not supported with super-resolution\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (!config->output_buffer_alloc != !config->output_buffer_free) {
+        SVT_ERROR("Error instance %u: the output buffer allocator requires both the alloc and the free callbacks\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->obu_streaming && config->stat_report) {
+        SVT_ERROR("Error instance %u: obu streaming does not support the per frame statistics report\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->chunk_parallel > 1) {
+        if (config->rate_control_mode != SVT_AV1_RC_MODE_CQP_OR_CRF || config->pass != ENC_SINGLE_PASS ||
+            config->rc_stats_buffer.sz) {
+            SVT_ERROR("Error instance %u: chunk parallel encoding only supports single pass CRF/CQP\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->pred_structure != SVT_AV1_PRED_RANDOM_ACCESS || config->intra_refresh_type != SVT_AV1_KF_REFRESH ||
+            config->intra_period_length < 0) {
+            SVT_ERROR("Error instance %u: chunk parallel encoding requires random access closed GOPs with a finite "
+                      "key frame interval\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->recon_enabled || config->avif || config->analysis_cache_out || config->analysis_cache_in.sz) {
+            SVT_ERROR("Error instance %u: chunk parallel encoding does not support the recon output, avif, and the "
+                      "analysis cache\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
     if (config->sframe_dist > 0 && config->pred_structure != SVT_AV1_PRED_LOW_DELAY_P &&
         config->pred_structure != SVT_AV1_PRED_LOW_DELAY_B) {
         SVT_ERROR(
@@ -1087,6 +1128,17 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->spy_rd                            = 0;
     config_ptr->sharp_tx                          = 1;
     config_ptr->hbd_mds                           = 0;
+    config_ptr->fast_recode                       = false;
+    config_ptr->obu_streaming                     = false;
+    config_ptr->pd0_quadrant_parallel             = false;
+    config_ptr->split_entropy_coding              = false;
+    config_ptr->output_buffer_alloc               = NULL;
+    config_ptr->output_buffer_free                = NULL;
+    config_ptr->output_buffer_ctx                 = NULL;
+    config_ptr->analysis_cache_out                = false;
+    config_ptr->analysis_cache_in.buf             = NULL;
+    config_ptr->analysis_cache_in.sz              = 0;
+    config_ptr->chunk_parallel                    = 0;
     return return_error;
 }
 static const char *tier_to_str(unsigned in) {
@@ -1158,6 +1210,8 @@ void svt_av1_print_lib_params(SequenceControlSet *scs) {
             config->intra_refresh_type == SVT_AV1_FWDKF_REFRESH    ? "FWD key frame"
                 : config->intra_refresh_type == SVT_AV1_KF_REFRESH ? "key frame"
                                                                    : "Unknown key frame type");
+        if (config->chunk_parallel > 1)
+            SVT_INFO("SVT [config]: GOPs encoded in parallel \t\t\t\t\t: %d\n", config->chunk_parallel);
         if (config->lossless) {
             SVT_INFO("SVT [config]: BRC mode\t\t\t\t\t\t\t: Lossless Coding \n");
         } else {
@@ -2128,6 +2182,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"spy-rd", &config_struct->spy_rd},
         {"hbd-mds", &config_struct->hbd_mds},
         {"sharp-tx", &config_struct->sharp_tx},
+        {"chunk-parallel", &config_struct->chunk_parallel},
     };
     const size_t uint8_opts_size = sizeof(uint8_opts) / sizeof(uint8_opts[0]);
 
@@ -2247,6 +2302,10 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"lossless", &config_struct->lossless},
         {"avif", &config_struct->avif},
         {"max-32-tx-size", &config_struct->max_32_tx_size},
+        {"fast-recode", &config_struct->fast_recode},
+        {"obu-streaming", &config_struct->obu_streaming},
+        {"pd0-quadrant-parallel", &config_struct->pd0_quadrant_parallel},
+        {"split-ec", &config_struct->split_entropy_coding},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
@@ -127,9 +127,6 @@ G_DEFINE_TYPE_WITH_CODE(GstSvtAv1Enc, gst_svtav1enc, GST_TYPE_VIDEO_ENCODER,
                         GST_DEBUG_CATEGORY_INIT(gst_svtav1enc_debug_category, "svtav1enc", 0,
                                                 "SVT-AV1 encoder element"));
 
-/* this mutex is required to avoid race conditions in SVT-AV1 memory allocations, which aren't thread-safe */
-G_LOCK_DEFINE_STATIC(init_mutex);
-
 static void gst_svtav1enc_class_init(GstSvtAv1EncClass *klass) {
     GObjectClass         *gobject_class       = G_OBJECT_CLASS(klass);
     GstVideoEncoderClass *video_encoder_class = GST_VIDEO_ENCODER_CLASS(klass);
@@ -395,6 +392,24 @@ static void gst_svtav1enc_deallocate_svt_buffers(GstSvtAv1Enc *svtav1enc) {
     }
 }
 
+/* the encoder writes the packets into GLib memory which the output GstBuffer then wraps without a copy */
+static uint8_t *gst_svtav1enc_output_buffer_alloc(void *ctx, uint32_t size) {
+    (void)ctx;
+    return g_try_malloc(size);
+}
+
+static void gst_svtav1enc_output_buffer_free(void *ctx, uint8_t *buffer) {
+    (void)ctx;
+    g_free(buffer);
+}
+
+/* releases a packet which is not pushed downstream */
+static void gst_svtav1enc_drop_packet(EbBufferHeaderType **output_buf) {
+    if ((*output_buf)->flags & EB_BUFFERFLAG_APP_BUFFER)
+        g_free((*output_buf)->p_buffer);
+    svt_av1_enc_release_out_buffer(output_buf);
+}
+
 static gboolean gst_svtav1enc_configure_svt(GstSvtAv1Enc *svtav1enc) {
     if (!svtav1enc->state) {
         GST_WARNING_OBJECT(svtav1enc, "no state, can't configure encoder yet");
@@ -444,6 +459,8 @@ static gboolean gst_svtav1enc_configure_svt(GstSvtAv1Enc *svtav1enc) {
     svtav1enc->svt_config->level_of_parallelism = svtav1enc->level_of_parallelism;
     svtav1enc->svt_config->target_socket        = svtav1enc->target_socket;
     gst_svtav1enc_parse_parameters_string(svtav1enc);
+    svtav1enc->svt_config->output_buffer_alloc = gst_svtav1enc_output_buffer_alloc;
+    svtav1enc->svt_config->output_buffer_free  = gst_svtav1enc_output_buffer_free;
 
     /* set properties out of GstVideoInfo */
     const GstVideoInfo *info                      = &svtav1enc->state->info;
@@ -559,9 +576,7 @@ static gboolean gst_svtav1enc_configure_svt(GstSvtAv1Enc *svtav1enc) {
 }
 
 static gboolean gst_svtav1enc_start_svt(GstSvtAv1Enc *svtav1enc) {
-    G_LOCK(init_mutex);
     EbErrorType res = svt_av1_enc_init(svtav1enc->svt_encoder);
-    G_UNLOCK(init_mutex);
 
     if (res != EB_ErrorNone) {
         GST_ELEMENT_ERROR(svtav1enc, LIBRARY, INIT, (NULL), ("svt_av1_enc_init failed with error %d", res));
@@ -672,13 +687,24 @@ static GstFlowReturn gst_svtav1enc_dequeue_encoded_frames(GstSvtAv1Enc *svtav1en
                 GST_VIDEO_CODEC_FRAME_SET_SYNC_POINT(frame);
             }
 
-            if ((ret = gst_video_encoder_allocate_output_frame(
-                     GST_VIDEO_ENCODER(svtav1enc), frame, output_buf->n_filled_len)) != GST_FLOW_OK) {
-                svt_av1_enc_release_out_buffer(&output_buf);
-                gst_video_codec_frame_unref(frame);
-                return ret;
+            if (output_buf->flags & EB_BUFFERFLAG_APP_BUFFER) {
+                // the output buffer takes the ownership of the packet data
+                frame->output_buffer = gst_buffer_new_wrapped_full(0,
+                                                                   output_buf->p_buffer,
+                                                                   output_buf->n_alloc_len,
+                                                                   0,
+                                                                   output_buf->n_filled_len,
+                                                                   output_buf->p_buffer,
+                                                                   g_free);
+            } else {
+                if ((ret = gst_video_encoder_allocate_output_frame(
+                         GST_VIDEO_ENCODER(svtav1enc), frame, output_buf->n_filled_len)) != GST_FLOW_OK) {
+                    svt_av1_enc_release_out_buffer(&output_buf);
+                    gst_video_codec_frame_unref(frame);
+                    return ret;
+                }
+                gst_buffer_fill(frame->output_buffer, 0, output_buf->p_buffer, output_buf->n_filled_len);
             }
-            gst_buffer_fill(frame->output_buffer, 0, output_buf->p_buffer, output_buf->n_filled_len);
 
             frame->pts = frame->output_buffer->pts = output_buf->pts;
 
@@ -692,6 +718,8 @@ static GstFlowReturn gst_svtav1enc_dequeue_encoded_frames(GstSvtAv1Enc *svtav1en
             output_buf = NULL;
 
             ret = gst_video_encoder_finish_frame(GST_VIDEO_ENCODER(svtav1enc), frame);
+        } else if (output_buf) {
+            gst_svtav1enc_drop_packet(&output_buf);
         }
 
     } while (res == EB_ErrorNone && ret == GST_FLOW_OK);
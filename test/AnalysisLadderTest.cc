@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file AnalysisLadderTest.cc
+ *
+ * @brief Unit test for the lookahead analysis shared by ABR ladder renditions:
+ * - svt_aom_ladder_put_scene_change / svt_aom_ladder_get_scene_change
+ * - svt_aom_ladder_put_mini_gop / svt_aom_ladder_get_mini_gop
+ * - svt_aom_ladder_advance
+ * - svt_aom_ladder_detach
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "analysis_ladder.h"
+#include "pcs.h"
+
+/**
+ * @brief Unit test for the analysis ladder
+ *
+ * Test strategy:
+ * A leader publishes scene change and mini-GOP decisions while followers,
+ * possibly running on other threads, read all, part or none of them, skip
+ * keys, or detach before the end of the sequence.
+ *
+ * Expected result:
+ * Followers read the decisions of the leader for the keys it published,
+ * waiting for the leader when they are ahead of it, and fall back to their
+ * own analysis when the record is not coming. Once every follower read a
+ * record, went past its key or detached, the record is freed, so the ladder
+ * keeps no record at the end of the sequence.
+ */
+
+namespace {
+
+static const uint32_t num_pictures = 64;
+
+static bool scene_change_of(uint64_t picture_number) {
+    return picture_number % 7 == 3;
+}
+
+static uint8_t score_of(uint64_t picture_number) {
+    return (uint8_t)(picture_number * 13 + 5);
+}
+
+class AnalysisLadderTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        ladder_ = nullptr;
+        leader_ = nullptr;
+        ASSERT_EQ(svt_aom_ladder_create(&ladder_), EB_ErrorNone);
+        ASSERT_EQ(svt_aom_ladder_attach(ladder_, true, &leader_),
+                  EB_ErrorNone);
+    }
+
+    void TearDown() override {
+        for (LadderClient *follower : followers_)
+            svt_aom_ladder_detach(follower);
+        svt_aom_ladder_detach(leader_);
+        svt_aom_ladder_destroy(ladder_);
+    }
+
+    LadderClient *add_follower() {
+        LadderClient *follower = nullptr;
+        EXPECT_EQ(svt_aom_ladder_attach(ladder_, false, &follower),
+                  EB_ErrorNone);
+        followers_.push_back(follower);
+        return follower;
+    }
+
+    void detach_follower(LadderClient *follower) {
+        for (size_t i = 0; i < followers_.size(); i++) {
+            if (followers_[i] == follower) {
+                followers_.erase(followers_.begin() + i);
+                break;
+            }
+        }
+        svt_aom_ladder_detach(follower);
+    }
+
+    void put_scene_change(uint64_t picture_number) {
+        PictureParentControlSet pcs;
+        memset(&pcs, 0, sizeof(pcs));
+        pcs.picture_number = picture_number;
+        pcs.scene_change_flag = scene_change_of(picture_number);
+        pcs.scene_change_score = score_of(picture_number);
+        pcs.flash_score = score_of(picture_number + 1);
+        svt_aom_ladder_put_scene_change(leader_, &pcs);
+    }
+
+    // Returns whether the record was read, and checks its content
+    static bool get_scene_change(LadderClient *follower,
+                                 uint64_t picture_number) {
+        PictureParentControlSet pcs;
+        memset(&pcs, 0, sizeof(pcs));
+        pcs.picture_number = picture_number;
+        if (!svt_aom_ladder_get_scene_change(follower, &pcs))
+            return false;
+        EXPECT_EQ(pcs.scene_change_flag, scene_change_of(picture_number));
+        EXPECT_EQ(pcs.scene_change_score, score_of(picture_number));
+        EXPECT_EQ(pcs.flash_score, score_of(picture_number + 1));
+        return true;
+    }
+
+    uint32_t record_count(LadderStage stage) {
+        return svt_aom_ladder_record_count(ladder_, stage);
+    }
+
+    EbSvtAv1AnalysisLadder *ladder_;
+    LadderClient *leader_;
+    std::vector<LadderClient *> followers_;
+};
+
+TEST_F(AnalysisLadderTest, FollowersReadAllRecords) {
+    LadderClient *first = add_follower();
+    LadderClient *second = add_follower();
+    for (uint64_t pic = 0; pic < num_pictures; pic++)
+        put_scene_change(pic);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), num_pictures);
+
+    for (uint64_t pic = 0; pic < num_pictures; pic++)
+        EXPECT_TRUE(get_scene_change(first, pic));
+    // The second follower has not read any record yet
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), num_pictures);
+    for (uint64_t pic = 0; pic < num_pictures; pic++)
+        EXPECT_TRUE(get_scene_change(second, pic));
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+}
+
+TEST_F(AnalysisLadderTest, FollowersWaitForLeader) {
+    std::vector<LadderClient *> followers = {add_follower(), add_follower()};
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> read(followers.size(), 0);
+    for (size_t i = 0; i < followers.size(); i++) {
+        threads.emplace_back([&, i]() {
+            for (uint64_t pic = 0; pic < num_pictures; pic++)
+                read[i] += get_scene_change(followers[i], pic);
+        });
+    }
+    for (uint64_t pic = 0; pic < num_pictures; pic++) {
+        put_scene_change(pic);
+        std::this_thread::yield();
+    }
+    svt_aom_ladder_finish(leader_, LADDER_SCENE_CHANGE);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (uint32_t count : read)
+        EXPECT_EQ(count, num_pictures);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+}
+
+TEST_F(AnalysisLadderTest, RecordsNotComing) {
+    LadderClient *follower = add_follower();
+    // The leader went past the key without publishing it
+    put_scene_change(0);
+    put_scene_change(2);
+    EXPECT_TRUE(get_scene_change(follower, 0));
+    EXPECT_FALSE(get_scene_change(follower, 1));
+    EXPECT_TRUE(get_scene_change(follower, 2));
+    // The leader finished the stage
+    svt_aom_ladder_finish(leader_, LADDER_SCENE_CHANGE);
+    EXPECT_FALSE(get_scene_change(follower, 3));
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+}
+
+TEST_F(AnalysisLadderTest, SkippedRecordsAreFreed) {
+    LadderClient *follower = add_follower();
+    const uint64_t mini_gop_size = 16;
+    for (uint64_t start = 0; start < num_pictures; start += mini_gop_size) {
+        const bool activity[3] = {start % 32 == 0, true, false};
+        svt_aom_ladder_put_mini_gop(leader_, start, activity);
+        put_scene_change(start);
+    }
+
+    // Reading a key drops the records of the keys before it
+    bool activity[3];
+    EXPECT_TRUE(svt_aom_ladder_get_mini_gop(follower, 2 * mini_gop_size,
+                                            activity));
+    EXPECT_TRUE(activity[0]);
+    EXPECT_TRUE(activity[1]);
+    EXPECT_FALSE(activity[2]);
+    EXPECT_EQ(record_count(LADDER_MINI_GOP),
+              num_pictures / mini_gop_size - 3);
+
+    // Records of the stages the follower never reads are dropped once it goes
+    // past their keys
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), num_pictures / mini_gop_size);
+    svt_aom_ladder_advance(follower, 2 * mini_gop_size);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE),
+              num_pictures / mini_gop_size - 3);
+    svt_aom_ladder_advance(follower, num_pictures);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+    EXPECT_EQ(record_count(LADDER_MINI_GOP), 0u);
+
+    // Records the follower is already done with are not kept
+    put_scene_change(num_pictures);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+}
+
+TEST_F(AnalysisLadderTest, FollowerDetachesEarly) {
+    LadderClient *early = add_follower();
+    LadderClient *late = add_follower();
+    for (uint64_t pic = 0; pic < num_pictures; pic++)
+        put_scene_change(pic);
+    for (uint64_t pic = 0; pic < num_pictures / 4; pic++)
+        EXPECT_TRUE(get_scene_change(early, pic));
+    for (uint64_t pic = 0; pic < num_pictures / 2; pic++)
+        EXPECT_TRUE(get_scene_change(late, pic));
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE),
+              num_pictures - num_pictures / 4);
+
+    // Detaching drops the share of the leaving follower
+    detach_follower(early);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), num_pictures / 2);
+    for (uint64_t pic = num_pictures / 2; pic < num_pictures; pic++)
+        EXPECT_TRUE(get_scene_change(late, pic));
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+
+    // Nothing is kept once the last follower left
+    put_scene_change(num_pictures);
+    detach_follower(late);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+    put_scene_change(num_pictures + 1);
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+}
+
+TEST_F(AnalysisLadderTest, FollowerDetachesWhileOthersRead) {
+    std::vector<LadderClient *> followers = {
+        add_follower(), add_follower(), add_follower()};
+    LadderClient *leaving = add_follower();
+    std::vector<std::thread> threads;
+    for (LadderClient *follower : followers) {
+        threads.emplace_back([&, follower]() {
+            for (uint64_t pic = 0; pic < num_pictures; pic++) {
+                EXPECT_TRUE(get_scene_change(follower, pic));
+                if (pic % 8 == 7)
+                    svt_aom_ladder_advance(follower, pic);
+            }
+        });
+    }
+    for (uint64_t pic = 0; pic < num_pictures; pic++) {
+        put_scene_change(pic);
+        if (pic == num_pictures / 2)
+            detach_follower(leaving);
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+    EXPECT_EQ(record_count(LADDER_SCENE_CHANGE), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file ArenaTest.cc
+ *
+ * @brief Unit test for the per-picture arena allocator:
+ * - svt_aom_arena_alloc
+ * - svt_aom_arena_reset
+ * - svt_aom_sub_arena_alloc
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "arena.h"
+#include "svt_threads.h"
+#include "random.h"
+
+/**
+ * @brief Unit test for the arena allocator
+ *
+ * Test strategy:
+ * Hand out blocks of various sizes, fill each block with a pattern derived
+ * from its index and check every pattern before the arena is reset, so
+ * overlapping blocks are detected. The stress test encodes 1000 pictures
+ * worth of allocations, part of them from concurrent threads going through
+ * sub-arenas; run it under AddressSanitizer to also catch overflows and leaks
+ * of the chunks.
+ *
+ * Expected result:
+ * Blocks are ARENA_ALIGN-byte aligned and disjoint. The arena allocates no
+ * memory before its first block, carves the blocks from chunks of
+ * ARENA_CHUNK_SIZE bytes and gives big blocks a chunk of their own. A reset
+ * frees the chunks but one, which serves the next picture, and the high-water
+ * mark is the peak of the bytes held. Sub-arenas take their blocks from slabs
+ * of their arena and drop the slab when the arena is reset.
+ */
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+struct ArenaBlock {
+    uint8_t *ptr;
+    size_t size;
+    uint8_t pattern;
+};
+
+static void fill_block(ArenaBlock &block) {
+    memset(block.ptr, block.pattern, block.size);
+}
+
+static bool check_block(const ArenaBlock &block) {
+    for (size_t i = 0; i < block.size; i++)
+        if (block.ptr[i] != block.pattern)
+            return false;
+    return true;
+}
+
+static size_t count_chunks(const EbArena &arena) {
+    size_t count = 0;
+    for (const EbArenaChunk *chunk = arena.chunks; chunk; chunk = chunk->next)
+        count++;
+    return count;
+}
+
+class ArenaTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        memset(&arena_, 0, sizeof(arena_));
+        ASSERT_EQ(svt_aom_arena_ctor(&arena_), EB_ErrorNone);
+    }
+
+    void TearDown() override {
+        if (arena_.dctor)
+            arena_.dctor(&arena_);
+    }
+
+    EbArena arena_;
+};
+
+TEST_F(ArenaTest, AllocatesOnFirstUse) {
+    ASSERT_EQ(arena_.chunks, nullptr);
+    ASSERT_EQ(arena_.spare, nullptr);
+    ASSERT_EQ(arena_.size, 0u);
+
+    // a reset of an unused arena keeps it empty
+    svt_aom_arena_reset(&arena_);
+    ASSERT_EQ(arena_.chunks, nullptr);
+    ASSERT_EQ(arena_.spare, nullptr);
+    ASSERT_EQ(arena_.size, 0u);
+}
+
+TEST_F(ArenaTest, BumpAllocation) {
+    uint8_t *a = (uint8_t *)svt_aom_arena_alloc(&arena_, 1);
+    uint8_t *b = (uint8_t *)svt_aom_arena_alloc(&arena_, 100);
+    uint8_t *c = (uint8_t *)svt_aom_arena_alloc(&arena_, 64);
+    uint8_t *d = (uint8_t *)svt_aom_arena_alloc(&arena_, 0);
+    ASSERT_NE(a, nullptr);
+    ASSERT_EQ(b, a + ARENA_ALIGN);
+    ASSERT_EQ(c, b + 2 * ARENA_ALIGN);
+    ASSERT_EQ(d, c + ARENA_ALIGN);
+    for (uint8_t *p : {a, b, c, d})
+        ASSERT_EQ((uintptr_t)p % ARENA_ALIGN, 0u);
+    ASSERT_EQ(arena_.used, 5u * ARENA_ALIGN);
+    ASSERT_EQ(count_chunks(arena_), 1u);
+    ASSERT_EQ(arena_.size, (size_t)ARENA_CHUNK_SIZE);
+    ASSERT_EQ(arena_.high_water, (size_t)ARENA_CHUNK_SIZE);
+}
+
+TEST_F(ArenaTest, GrowsInChunks) {
+    const size_t block_size = ARENA_CHUNK_SIZE / 8;
+    uint8_t *first = (uint8_t *)svt_aom_arena_alloc(&arena_, block_size);
+    for (int i = 1; i < 8; i++)
+        ASSERT_EQ(svt_aom_arena_alloc(&arena_, block_size),
+                  first + i * block_size);
+    ASSERT_EQ(arena_.used, (size_t)ARENA_CHUNK_SIZE);
+
+    // the first chunk is full
+    uint8_t *next = (uint8_t *)svt_aom_arena_alloc(&arena_, 64);
+    ASSERT_NE(next, nullptr);
+    ASSERT_TRUE(next < first || next >= first + ARENA_CHUNK_SIZE);
+    ASSERT_EQ(arena_.used, 64u);
+    ASSERT_EQ(count_chunks(arena_), 2u);
+    ASSERT_EQ(arena_.size, 2u * ARENA_CHUNK_SIZE);
+}
+
+TEST_F(ArenaTest, BigBlocksGetTheirOwnChunk) {
+    uint8_t *a = (uint8_t *)svt_aom_arena_alloc(&arena_, 100);
+    uint8_t *big = (uint8_t *)svt_aom_arena_alloc(&arena_, 1 << 20);
+    ASSERT_NE(big, nullptr);
+    ASSERT_EQ((uintptr_t)big % ARENA_ALIGN, 0u);
+    memset(big, 0x5A, 1 << 20);
+    ASSERT_EQ(count_chunks(arena_), 2u);
+    ASSERT_EQ(arena_.size, (size_t)ARENA_CHUNK_SIZE + (1 << 20));
+
+    // the small blocks are still carved from the first chunk
+    ASSERT_EQ(svt_aom_arena_alloc(&arena_, 64), a + 2 * ARENA_ALIGN);
+    ASSERT_EQ(arena_.used, 3u * ARENA_ALIGN);
+
+    // a big block is also the first one of an empty arena
+    svt_aom_arena_reset(&arena_);
+    EbArena other;
+    memset(&other, 0, sizeof(other));
+    ASSERT_EQ(svt_aom_arena_ctor(&other), EB_ErrorNone);
+    ASSERT_NE(svt_aom_arena_alloc(&other, ARENA_CHUNK_SIZE / 2), nullptr);
+    ASSERT_EQ(other.size, (size_t)ARENA_CHUNK_SIZE / 2);
+    ASSERT_NE(svt_aom_arena_alloc(&other, 64), nullptr);
+    ASSERT_EQ(count_chunks(other), 2u);
+    other.dctor(&other);
+}
+
+TEST_F(ArenaTest, ResetKeepsOneChunk) {
+    ASSERT_NE(svt_aom_arena_alloc(&arena_, 64), nullptr);
+    for (int i = 0; i < 16; i++)
+        ASSERT_NE(svt_aom_arena_alloc(&arena_, ARENA_CHUNK_SIZE / 8), nullptr);
+    ASSERT_NE(svt_aom_arena_alloc(&arena_, 1 << 20), nullptr);
+    ASSERT_EQ(count_chunks(arena_), 4u);
+    ASSERT_EQ(arena_.high_water, 3u * ARENA_CHUNK_SIZE + (1 << 20));
+
+    svt_aom_arena_reset(&arena_);
+    ASSERT_EQ(arena_.chunks, nullptr);
+    ASSERT_EQ(arena_.used, 0u);
+    ASSERT_NE(arena_.spare, nullptr);
+    ASSERT_EQ(arena_.size, (size_t)ARENA_CHUNK_SIZE);
+    // the high-water mark survives the reset
+    ASSERT_EQ(arena_.high_water, 3u * ARENA_CHUNK_SIZE + (1 << 20));
+
+    // the next picture starts in the chunk kept
+    uint8_t *a = (uint8_t *)svt_aom_arena_alloc(&arena_, 64);
+    ASSERT_NE(a, nullptr);
+    ASSERT_EQ(arena_.spare, nullptr);
+    ASSERT_EQ(arena_.size, (size_t)ARENA_CHUNK_SIZE);
+    ASSERT_EQ(svt_aom_arena_alloc(&arena_, 64), a + ARENA_ALIGN);
+}
+
+TEST_F(ArenaTest, SubArenaCarvesSlabs) {
+    EbSubArena sub;
+    memset(&sub, 0, sizeof(sub));
+
+    uint8_t *a = (uint8_t *)svt_aom_sub_arena_alloc(&sub, &arena_, 1);
+    uint8_t *b = (uint8_t *)svt_aom_sub_arena_alloc(&sub, &arena_, 100);
+    ASSERT_NE(a, nullptr);
+    ASSERT_EQ(b, a + ARENA_ALIGN);
+    // the arena handed out a single slab
+    ASSERT_EQ(arena_.used, (size_t)ARENA_SLAB_SIZE);
+
+    // big blocks come from the arena directly
+    uint8_t *c = (uint8_t *)svt_aom_sub_arena_alloc(&sub, &arena_,
+                                                    ARENA_SLAB_SIZE / 2);
+    ASSERT_EQ(c, a + ARENA_SLAB_SIZE);
+    uint8_t *d = (uint8_t *)svt_aom_sub_arena_alloc(&sub, &arena_, 64);
+    ASSERT_EQ(d, b + 2 * ARENA_ALIGN);
+
+    // a block that does not fit in the slab left takes a new slab
+    while (sub.left >= 4096)
+        ASSERT_NE(svt_aom_sub_arena_alloc(&sub, &arena_, 4096), nullptr);
+    uint8_t *e = (uint8_t *)svt_aom_sub_arena_alloc(&sub, &arena_, 4096);
+    ASSERT_EQ(e, a + ARENA_SLAB_SIZE * 3 / 2);
+    ASSERT_EQ(arena_.used, (size_t)ARENA_SLAB_SIZE * 5 / 2);
+
+    // the slab is dropped by a reset of the arena, the kept chunk serves it
+    svt_aom_arena_reset(&arena_);
+    ASSERT_EQ(svt_aom_sub_arena_alloc(&sub, &arena_, 64), a);
+    ASSERT_EQ(arena_.used, (size_t)ARENA_SLAB_SIZE);
+
+    // and when the sub-arena moves to another arena
+    EbArena other;
+    memset(&other, 0, sizeof(other));
+    ASSERT_EQ(svt_aom_arena_ctor(&other), EB_ErrorNone);
+    ASSERT_NE(svt_aom_sub_arena_alloc(&sub, &other, 64), nullptr);
+    ASSERT_EQ(other.used, (size_t)ARENA_SLAB_SIZE);
+    ASSERT_EQ(svt_aom_sub_arena_alloc(&sub, &arena_, 64),
+              a + ARENA_SLAB_SIZE);
+    other.dctor(&other);
+}
+
+static const int stress_threads = 4;
+static const int stress_blocks_per_thread = 32;
+
+struct StressWorker {
+    EbArena *arena;
+    EbSubArena sub;
+    ArenaBlock blocks[stress_blocks_per_thread];
+    uint32_t seed;
+};
+
+static void *stress_worker_kernel(void *arg) {
+    StressWorker *worker = (StressWorker *)arg;
+    SVTRandom rnd(0, 4095, worker->seed);
+    for (int i = 0; i < stress_blocks_per_thread; i++) {
+        ArenaBlock &block = worker->blocks[i];
+        block.size = rnd.random() + 1;
+        block.pattern = (uint8_t)(worker->seed + i);
+        block.ptr = (uint8_t *)svt_aom_sub_arena_alloc(
+            &worker->sub, worker->arena, block.size);
+        if (block.ptr)
+            fill_block(block);
+    }
+    return NULL;
+}
+
+TEST_F(ArenaTest, StressPictures) {
+    SVTRandom rnd(0, 1 << 16, 0);
+    std::vector<ArenaBlock> blocks;
+    StressWorker workers[stress_threads];
+    memset(workers, 0, sizeof(workers));
+    size_t peak = 0;
+
+    for (int pic = 0; pic < 1000; pic++) {
+        blocks.clear();
+        // pictures of all sizes, most fit in a chunk, some need several and
+        // some have big blocks
+        const int count = rnd.random() % 64 + 1;
+        for (int i = 0; i < count; i++) {
+            ArenaBlock block;
+            block.size =
+                rnd.random() % (pic % 10 == 9 ? 1 << 17 : 2048) + 1;
+            block.pattern = (uint8_t)(pic + i);
+            block.ptr = (uint8_t *)svt_aom_arena_alloc(&arena_, block.size);
+            ASSERT_NE(block.ptr, nullptr);
+            ASSERT_EQ((uintptr_t)block.ptr % ARENA_ALIGN, 0u);
+            fill_block(block);
+            blocks.push_back(block);
+        }
+        // every fourth picture also allocates from concurrent threads
+        if (pic % 4 == 0) {
+            EbHandle threads[stress_threads];
+            for (int t = 0; t < stress_threads; t++) {
+                workers[t].arena = &arena_;
+                workers[t].seed = pic * stress_threads + t;
+                threads[t] =
+                    svt_create_thread(stress_worker_kernel, &workers[t]);
+                ASSERT_NE(threads[t], nullptr);
+            }
+            for (int t = 0; t < stress_threads; t++) {
+                svt_destroy_thread(threads[t]);
+                for (int i = 0; i < stress_blocks_per_thread; i++) {
+                    const ArenaBlock &block = workers[t].blocks[i];
+                    ASSERT_NE(block.ptr, nullptr);
+                    ASSERT_EQ((uintptr_t)block.ptr % ARENA_ALIGN, 0u);
+                    blocks.push_back(block);
+                }
+            }
+        }
+        for (size_t i = 0; i < blocks.size(); i++)
+            ASSERT_TRUE(check_block(blocks[i]))
+                << "picture " << pic << " block " << i;
+        size_t held = 0;
+        for (const EbArenaChunk *chunk = arena_.chunks; chunk;
+             chunk = chunk->next)
+            held += chunk->size;
+        // a picture starting with a big block does not take the chunk kept
+        if (arena_.spare)
+            held += arena_.spare->size;
+        ASSERT_EQ(arena_.size, held);
+        peak = held > peak ? held : peak;
+        ASSERT_EQ(arena_.high_water, peak);
+        svt_aom_arena_reset(&arena_);
+        ASSERT_EQ(arena_.used, 0u);
+        ASSERT_EQ(arena_.chunks, nullptr);
+        ASSERT_EQ(arena_.size, (size_t)ARENA_CHUNK_SIZE);
+    }
+    ASSERT_GT(arena_.high_water, (size_t)ARENA_CHUNK_SIZE);
+}
+
+}  // namespace
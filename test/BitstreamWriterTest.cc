@@ -21,14 +21,19 @@
 #include <math.h>
 #include <stdlib.h>
 #include <random>
+#include <vector>
 #include "cabac_context_model.h"
 #include "bitstream_unit.h"
 #include "bitreader.h"
 #include "definitions.h"
 #include "pic_buffer_desc.h"
+#include "svt_threads.h"
 #include "gtest/gtest.h"
 #include "random.h"
 
+/** reset_test_env is implemented in test/TestEnv.c */
+extern "C" void reset_test_env();
+
 #ifdef max
 #undef max
 #endif
@@ -312,4 +317,136 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
                   rnd(gen));
     }
 }
+
+/**
+ * @brief Unit test for the symbol queue of the split entropy coding:
+ * - svt_aom_ec_symbol_push
+ * - svt_aom_ec_symbol_queue_end
+ * - svt_aom_daala_replay_symbols
+ *
+ * Test strategy:
+ * Write the same random sequence of bits, literals, symbols with fixed and
+ * adapted cdfs and gathered partition split flags once directly and once
+ * through the queue, coded by a thread replaying the symbols.
+ *
+ * Expected result:
+ * The bitstreams and the adapted cdfs are identical.
+ *
+ * Test coverage:
+ * Sequences of several times the ring size, coded as consecutive tiles
+ * reusing the queue.
+ */
+static void *replay_symbols_kernel(void *input_ptr) {
+    AomWriter *bw = (AomWriter *)input_ptr;
+    svt_aom_daala_replay_symbols(bw, bw->symbol_queue);
+    return nullptr;
+}
+
+static void write_random_symbols(AomWriter *bw, FRAME_CONTEXT *fc,
+                                 uint32_t seed, int count) {
+    SVTRandom rnd(0, (1 << 30) - 1);
+    rnd.reset(seed);
+    for (int i = 0; i < count; ++i) {
+        const int r = rnd.random();
+        switch (r % 6) {
+        case 0: aom_write(bw, (r >> 3) & 1, 128); break;
+        case 1: {
+            const int bits = (r >> 3) % 32 + 1;
+            aom_write_literal(bw, rnd.random() & ((1u << (bits - 1)) * 2 - 1),
+                              bits);
+            break;
+        }
+        case 2:
+            aom_write_cdf(bw, (r >> 3) % INTRA_MODES,
+                          svt_aom_default_kf_y_mode_cdf[0][(r >> 8) % 5],
+                          INTRA_MODES);
+            break;
+        case 3:
+            aom_write_symbol(bw, (r >> 3) & 1,
+                             fc->txb_skip_cdf[0][(r >> 4) % 13], 2);
+            break;
+        case 4:
+            aom_write_symbol(bw, (r >> 3) % EXT_PARTITION_TYPES,
+                             fc->partition_cdf[4 + (r >> 8) % 12],
+                             EXT_PARTITION_TYPES);
+            break;
+        default: {
+            // split flag of a block crossing the bottom or the right edge
+            const int ctx = 4 + (r >> 8) % 12;
+            const BlockSize bsize =
+                ctx < 8 ? BLOCK_16X16 : ctx < 12 ? BLOCK_32X32 : BLOCK_64X64;
+            const bool vert = (r >> 4) & 1;
+            if (bw->symbol_queue) {
+                svt_aom_ec_symbol_push(bw->symbol_queue,
+                                       vert ? EC_SYMBOL_PARTITION_VERT
+                                            : EC_SYMBOL_PARTITION_HORZ,
+                                       (r >> 3) & 1,
+                                       fc->partition_cdf[ctx],
+                                       (uint8_t)bsize);
+            } else {
+                AomCdfProb cdf[CDF_SIZE(2)];
+                if (vert)
+                    partition_gather_vert_alike(
+                        cdf, fc->partition_cdf[ctx], bsize);
+                else
+                    partition_gather_horz_alike(
+                        cdf, fc->partition_cdf[ctx], bsize);
+                aom_write_symbol(bw, (r >> 3) & 1, cdf, 2);
+            }
+            break;
+        }
+        }
+    }
+}
+
+TEST(Entropy_BitstreamWriter, write_symbols_through_queue) {
+    const int buffer_size = 1 << 20;
+    const int symbol_count =
+        3 * EC_SYMBOL_BATCH_SIZE * EC_SYMBOL_BATCH_COUNT + 17;
+    std::vector<uint8_t> ref_buffer(buffer_size), test_buffer(buffer_size);
+    EcSymbolQueue queue;
+    // svt_aom_init_mode_probs() copies the default cdfs through the rtcd
+    // pointers
+    reset_test_env();
+    ASSERT_EQ(svt_aom_ec_symbol_queue_ctor(&queue), EB_ErrorNone);
+
+    FRAME_CONTEXT ref_fc, test_fc;
+    memset(&ref_fc, 0, sizeof(ref_fc));
+    svt_aom_init_mode_probs(&ref_fc);
+    svt_av1_default_coef_probs(&ref_fc, 20);
+    test_fc = ref_fc;
+
+    for (uint32_t tile = 0; tile < 3; ++tile) {
+        OutputBitstreamUnit ref_unit, test_unit;
+        ref_unit.buffer_av1 = ref_unit.buffer_begin_av1 = ref_buffer.data();
+        test_unit.buffer_av1 = test_unit.buffer_begin_av1 = test_buffer.data();
+        ref_unit.size = test_unit.size = buffer_size;
+
+        AomWriter ref_bw, test_bw;
+        memset(&ref_bw, 0, sizeof(ref_bw));
+        memset(&test_bw, 0, sizeof(test_bw));
+        ref_bw.allow_update_cdf = test_bw.allow_update_cdf = 1;
+        aom_start_encode(&ref_bw, &ref_unit);
+        write_random_symbols(&ref_bw, &ref_fc, tile + 1, symbol_count);
+        aom_stop_encode(&ref_bw);
+
+        aom_start_encode(&test_bw, &test_unit);
+        test_bw.symbol_queue = &queue;
+        EbHandle coder = svt_create_thread(replay_symbols_kernel, &test_bw);
+        ASSERT_NE(coder, nullptr);
+        write_random_symbols(&test_bw, &test_fc, tile + 1, symbol_count);
+        svt_aom_ec_symbol_queue_end(&queue);
+        svt_destroy_thread(coder);
+        test_bw.symbol_queue = nullptr;
+        aom_stop_encode(&test_bw);
+
+        ASSERT_EQ(ref_bw.pos, test_bw.pos) << "tile " << tile;
+        ASSERT_EQ(memcmp(ref_buffer.data(), test_buffer.data(), ref_bw.pos),
+                  0)
+            << "tile " << tile;
+        ASSERT_EQ(memcmp(&ref_fc, &test_fc, sizeof(ref_fc)), 0)
+            << "tile " << tile;
+    }
+    svt_aom_ec_symbol_queue_dctor(&queue);
+}
 }  // namespace
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file MdRateEstimationTest.cc
+ *
+ * @brief Unit test for the mode decision rate tables:
+ * - svt_aom_estimate_syntax_rate
+ * - svt_aom_estimate_coefficients_rate
+ * - svt_aom_estimate_mv_rate
+ * - svt_aom_get_syntax_rate_from_cdf_avx2
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "definitions.h"
+#include "md_rate_estimation.h"
+#include "pcs.h"
+#include "sequence_control_set.h"
+#include "aom_dsp_rtcd.h"
+#include "svt_time.h"
+#include "random.h"
+
+/** reset_test_env is implemented in test/TestEnv.c */
+extern "C" void reset_test_env();
+
+/**
+ * @brief Unit test for the incremental rebuild of the rate tables
+ *
+ * Test strategy:
+ * Adapt random cdfs of a frame context step by step and derive the rate
+ * tables of each step twice: incrementally, in the same context all along,
+ * and from scratch.
+ *
+ * Expected result:
+ * The tables are bit-exact.
+ *
+ * Test coverage:
+ * The cdfs of the syntax elements, coefficients, motion vectors and
+ * displacement vectors, with the picture level tools turned on and off
+ * between the steps.
+ */
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+typedef struct {
+    size_t offset;
+    size_t size;
+    int stride;
+} CdfField;
+
+#define CDF_FIELD(f, n) \
+    { offsetof(FRAME_CONTEXT, f), sizeof(((FRAME_CONTEXT *)0)->f), CDF_SIZE(n) }
+
+static const CdfField cdf_fields[] = {
+    CDF_FIELD(txb_skip_cdf, 2),
+    CDF_FIELD(eob_extra_cdf, 2),
+    CDF_FIELD(dc_sign_cdf, 2),
+    CDF_FIELD(eob_flag_cdf16, 5),
+    CDF_FIELD(eob_flag_cdf32, 6),
+    CDF_FIELD(eob_flag_cdf64, 7),
+    CDF_FIELD(eob_flag_cdf128, 8),
+    CDF_FIELD(eob_flag_cdf256, 9),
+    CDF_FIELD(eob_flag_cdf512, 10),
+    CDF_FIELD(eob_flag_cdf1024, 11),
+    CDF_FIELD(coeff_base_eob_cdf, 3),
+    CDF_FIELD(coeff_base_cdf, 4),
+    CDF_FIELD(coeff_br_cdf, BR_CDF_SIZE),
+    CDF_FIELD(newmv_cdf, 2),
+    CDF_FIELD(drl_cdf, 2),
+    CDF_FIELD(inter_compound_mode_cdf, INTER_COMPOUND_MODES),
+    CDF_FIELD(wedge_idx_cdf, 16),
+    CDF_FIELD(motion_mode_cdf, MOTION_MODES),
+    CDF_FIELD(palette_y_color_index_cdf, PALETTE_COLORS),
+    CDF_FIELD(palette_uv_mode_cdf, 2),
+    CDF_FIELD(single_ref_cdf, 2),
+    CDF_FIELD(comp_bwdref_cdf, 2),
+    CDF_FIELD(txfm_partition_cdf, 2),
+    CDF_FIELD(skip_cdfs, 2),
+    CDF_FIELD(nmvc.joints_cdf, MV_JOINTS),
+    CDF_FIELD(nmvc.comps[0].classes_cdf, MV_CLASSES),
+    CDF_FIELD(nmvc.comps[1].bits_cdf, 2),
+    CDF_FIELD(ndvc.comps[0].class0_fp_cdf, MV_FP_SIZE),
+    CDF_FIELD(intrabc_cdf, 2),
+    CDF_FIELD(filter_intra_cdfs, 2),
+    CDF_FIELD(switchable_restore_cdf, RESTORE_SWITCHABLE_TYPES),
+    CDF_FIELD(y_mode_cdf, INTRA_MODES),
+    CDF_FIELD(uv_mode_cdf, UV_INTRA_MODES),
+    CDF_FIELD(partition_cdf, EXT_PARTITION_TYPES),
+    CDF_FIELD(kf_y_cdf, INTRA_MODES),
+    CDF_FIELD(tx_size_cdf, MAX_TX_DEPTH + 1),
+    CDF_FIELD(intra_ext_tx_cdf, TX_TYPES),
+    CDF_FIELD(inter_ext_tx_cdf, TX_TYPES),
+    CDF_FIELD(cfl_sign_cdf, CFL_JOINT_SIGNS),
+    CDF_FIELD(cfl_alpha_cdf, CFL_ALPHABET_SIZE),
+};
+
+static const int cdf_field_count = sizeof(cdf_fields) / sizeof(cdf_fields[0]);
+
+// Number of symbols of a cdf, the last one ends at the first 0 entry
+static int cdf_symbols(const AomCdfProb *cdf, int max_symbols) {
+    int n = 0;
+    while (n < max_symbols - 1 && cdf[n]) n++;
+    return n + 1;
+}
+
+// Codes count random symbols of random cdfs, as a superblock would
+static void adapt_cdfs(FRAME_CONTEXT *fc, SVTRandom &rnd, int count) {
+    for (int i = 0; i < count; i++) {
+        const CdfField *field = &cdf_fields[rnd.random() % cdf_field_count];
+        const int rows = (int)(field->size / sizeof(AomCdfProb)) / field->stride;
+        AomCdfProb *cdf = (AomCdfProb *)((uint8_t *)fc + field->offset) +
+                          (rnd.random() % rows) * field->stride;
+        const int nsymbs = cdf_symbols(cdf, field->stride - 1);
+        if (nsymbs > 1)
+            update_cdf(cdf, rnd.random() % nsymbs, nsymbs);
+    }
+}
+
+class MdRateEstimationTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        // the default cdfs are copied through the rtcd
+        reset_test_env();
+        fc_ = (FRAME_CONTEXT *)calloc(1, sizeof(*fc_));
+        incremental_ = (MdRateEstimationContext *)calloc(1,
+                                                         sizeof(*incremental_));
+        full_ = (MdRateEstimationContext *)calloc(1, sizeof(*full_));
+        scs_ = (SequenceControlSet *)calloc(1, sizeof(*scs_));
+        ppcs_ = (PictureParentControlSet *)calloc(1, sizeof(*ppcs_));
+        pcs_ = (PictureControlSet *)calloc(1, sizeof(*pcs_));
+        pcs_->ppcs = ppcs_;
+        ppcs_->scs = scs_;
+        // keep the sequence level mv tables out of the comparison
+        scs_->mvrate_set = 1;
+        svt_aom_init_mode_probs(fc_);
+        svt_av1_default_coef_probs(fc_, 100);
+    }
+
+    void TearDown() override {
+        free(pcs_);
+        free(ppcs_);
+        free(scs_);
+        free(full_);
+        free(incremental_);
+        free(fc_);
+    }
+
+    void estimate(MdRateEstimationContext *ctx, bool full, bool is_i_slice,
+                  uint8_t tools) {
+        if (full) {
+            ctx->syntax_rate_valid = false;
+            ctx->coeff_rate_valid = false;
+            ctx->mv_rate_valid = false;
+            ctx->dv_rate_valid = false;
+        }
+        svt_aom_estimate_syntax_rate(ctx,
+                                     is_i_slice,
+                                     tools & 1,
+                                     (tools >> 1) & 1,
+                                     (tools >> 2) & 1,
+                                     ppcs_->frm_hdr.allow_intrabc,
+                                     fc_);
+        svt_aom_estimate_mv_rate(pcs_, ctx, fc_);
+        svt_aom_estimate_coefficients_rate(ctx, fc_);
+    }
+
+    void run_steps(SVTRandom &rnd, int steps) {
+        for (int step = 0; step < steps; step++) {
+            const bool is_i_slice = rnd.random() % 4 == 0;
+            const uint8_t tools = rnd.random() % 8;
+            ppcs_->frm_hdr.allow_high_precision_mv = rnd.random() % 2;
+            ppcs_->frm_hdr.allow_intrabc = rnd.random() % 2;
+            // the first steps change a single cdf, the later ones many
+            adapt_cdfs(fc_, rnd, step < 16 ? 1 : rnd.random() % 256);
+
+            estimate(incremental_, false, is_i_slice, tools);
+            estimate(full_, true, is_i_slice, tools);
+            // the cost stacks point to the tables of their own context
+            incremental_->nmvcoststack[0] = incremental_->nmvcoststack[1] =
+                NULL;
+            full_->nmvcoststack[0] = full_->nmvcoststack[1] = NULL;
+            ASSERT_EQ(0,
+                      memcmp(incremental_,
+                             full_,
+                             offsetof(MdRateEstimationContext, rate_fc)))
+                << "step " << step;
+        }
+    }
+
+    FRAME_CONTEXT *fc_;
+    MdRateEstimationContext *incremental_;
+    MdRateEstimationContext *full_;
+    SequenceControlSet *scs_;
+    PictureParentControlSet *ppcs_;
+    PictureControlSet *pcs_;
+};
+
+TEST_F(MdRateEstimationTest, MatchFullRebuild) {
+    SVTRandom rnd(0, (1 << 30) - 1);
+    run_steps(rnd, 200);
+}
+
+// Time of the per superblock rebuilds of a 1080p frame of 64x64 superblocks,
+// each superblock coding a few hundred symbols
+TEST_F(MdRateEstimationTest, DISABLED_Speed) {
+    static const char *const names[3] = {"syntax", "coeff", "mv"};
+    SVTRandom rnd(0, (1 << 30) - 1);
+    const int sb_count = 30 * 17;
+    const int symbols_per_sb = 200;
+    double time[2][3];
+    uint64_t start_seconds, start_useconds, finish_seconds, finish_useconds;
+
+    // the cdfs at the start of each superblock
+    FRAME_CONTEXT *sb_fc =
+        (FRAME_CONTEXT *)malloc(sb_count * sizeof(*sb_fc));
+    for (int sb = 0; sb < sb_count; sb++) {
+        adapt_cdfs(fc_, rnd, symbols_per_sb);
+        sb_fc[sb] = *fc_;
+    }
+    ppcs_->frm_hdr.allow_high_precision_mv = 1;
+    for (int full = 0; full < 2; full++) {
+        MdRateEstimationContext *ctx = full ? full_ : incremental_;
+        for (int table = 0; table < 3; table++) {
+            svt_av1_get_time(&start_seconds, &start_useconds);
+            for (int sb = 0; sb < sb_count; sb++) {
+                if (full) {
+                    ctx->syntax_rate_valid = false;
+                    ctx->coeff_rate_valid = false;
+                    ctx->mv_rate_valid = false;
+                }
+                switch (table) {
+                case 0:
+                    svt_aom_estimate_syntax_rate(
+                        ctx, false, 1, 1, 1, 0, &sb_fc[sb]);
+                    break;
+                case 1:
+                    svt_aom_estimate_coefficients_rate(ctx, &sb_fc[sb]);
+                    break;
+                default: svt_aom_estimate_mv_rate(pcs_, ctx, &sb_fc[sb]); break;
+                }
+            }
+            svt_av1_get_time(&finish_seconds, &finish_useconds);
+            time[full][table] = svt_av1_compute_overall_elapsed_time_ms(
+                start_seconds, start_useconds, finish_seconds, finish_useconds);
+        }
+    }
+    for (int table = 0; table < 3; table++)
+        printf("%6s rebuild time per frame: full=%8.2f ms \t "
+               "incremental=%8.2f ms \t gain=%5.2f\n",
+               names[table],
+               time[1][table],
+               time[0][table],
+               time[1][table] / time[0][table]);
+    free(sb_fc);
+}
+
+/**
+ * @brief Unit test for the syntax rate of a cdf
+ *
+ * Test strategy:
+ * Derive the symbol costs of random cdfs with the C and the optimized
+ * functions.
+ *
+ * Expected result:
+ * The costs are bit-exact.
+ *
+ * Test coverage:
+ * Cdfs of 1 to 16 symbols, with and without an inverse symbol map, with
+ * symbols of zero probability and cdfs which are not monotonic.
+ */
+
+typedef void (*SyntaxRateFromCdfFunc)(int32_t *costs, const AomCdfProb *cdf,
+                                      const int32_t *inv_map);
+
+class SyntaxRateFromCdfTest
+    : public ::testing::TestWithParam<SyntaxRateFromCdfFunc> {
+  protected:
+    static void fill_cdf(SVTRandom &rnd, AomCdfProb *cdf, int nsymbs,
+                         int mode) {
+        for (int i = 0; i < nsymbs - 1; i++) {
+            switch (mode) {
+            case 0: cdf[i] = rnd.random() % CDF_PROB_TOP; break;
+            case 1: cdf[i] = CDF_PROB_TOP - 1 - rnd.random() % 64; break;
+            default: cdf[i] = rnd.random() % 8; break;
+            }
+        }
+        // the cdfs are decreasing, unless unsorted to cover the wrap around
+        if (mode != 0 || rnd.random() % 2) {
+            for (int i = 0; i < nsymbs - 1; i++)
+                for (int j = i + 1; j < nsymbs - 1; j++)
+                    if (cdf[j] > cdf[i]) {
+                        const AomCdfProb t = cdf[i];
+                        cdf[i] = cdf[j];
+                        cdf[j] = t;
+                    }
+        }
+        // a 0 ends the cdf early
+        for (int i = 0; i < nsymbs - 1; i++)
+            if (!cdf[i])
+                cdf[i] = 1;
+        cdf[nsymbs - 1] = 0;
+        cdf[nsymbs] = rnd.random() % 32;
+    }
+
+    void run_test() {
+        const SyntaxRateFromCdfFunc func = GetParam();
+        SVTRandom rnd(0, (1 << 30) - 1);
+        AomCdfProb cdf[CDF_SIZE(16)];
+        int32_t inv_map[16];
+        int32_t ref_costs[16], costs[16];
+
+        for (int iter = 0; iter < 20000; iter++) {
+            const int nsymbs = 1 + rnd.random() % 16;
+            const bool use_map = rnd.random() % 2;
+            fill_cdf(rnd, cdf, nsymbs, iter % 3);
+            for (int i = 0; i < 16; i++) inv_map[i] = i;
+            for (int i = nsymbs - 1; i > 0; i--) {
+                const int j = rnd.random() % (i + 1);
+                const int32_t t = inv_map[i];
+                inv_map[i] = inv_map[j];
+                inv_map[j] = t;
+            }
+            memset(ref_costs, 0xAB, sizeof(ref_costs));
+            memset(costs, 0xAB, sizeof(costs));
+            svt_aom_get_syntax_rate_from_cdf_c(
+                ref_costs, cdf, use_map ? inv_map : NULL);
+            func(costs, cdf, use_map ? inv_map : NULL);
+            ASSERT_EQ(0, memcmp(ref_costs, costs, sizeof(costs)))
+                << "symbols " << nsymbs << " iter " << iter;
+        }
+    }
+
+    void run_speed_test() {
+        const SyntaxRateFromCdfFunc func = GetParam();
+        SVTRandom rnd(0, (1 << 30) - 1);
+        AomCdfProb cdf[CDF_SIZE(16)];
+        int32_t costs[16];
+        const int num_iters = 1000000;
+        double time_c, time_o;
+        uint64_t start_seconds, start_useconds, finish_seconds,
+            finish_useconds;
+
+        for (int nsymbs = 2; nsymbs <= 16; nsymbs *= 2) {
+            fill_cdf(rnd, cdf, nsymbs, 1);
+
+            svt_av1_get_time(&start_seconds, &start_useconds);
+            for (int iter = 0; iter < num_iters; iter++)
+                svt_aom_get_syntax_rate_from_cdf_c(costs, cdf, NULL);
+            svt_av1_get_time(&finish_seconds, &finish_useconds);
+            time_c = svt_av1_compute_overall_elapsed_time_ms(
+                start_seconds, start_useconds, finish_seconds, finish_useconds);
+
+            svt_av1_get_time(&start_seconds, &start_useconds);
+            for (int iter = 0; iter < num_iters; iter++)
+                func(costs, cdf, NULL);
+            svt_av1_get_time(&finish_seconds, &finish_useconds);
+            time_o = svt_av1_compute_overall_elapsed_time_ms(
+                start_seconds, start_useconds, finish_seconds, finish_useconds);
+
+            printf("symbols %2d: c_time=%6.2f \t simd_time=%6.2f \t "
+                   "gain=%5.2f\n",
+                   nsymbs,
+                   time_c,
+                   time_o,
+                   time_c / time_o);
+        }
+    }
+};
+
+TEST_P(SyntaxRateFromCdfTest, MatchC) {
+    run_test();
+}
+
+TEST_P(SyntaxRateFromCdfTest, DISABLED_Speed) {
+    run_speed_test();
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(SyntaxRateFromCdfTest);
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, SyntaxRateFromCdfTest,
+    ::testing::Values(svt_aom_get_syntax_rate_from_cdf_avx2));
+#endif  // ARCH_X86_64
+
+}  // namespace
@@ -26,6 +26,13 @@
 #endif
 
 #include "restoration_pick.h"
+#include "pcs.h"
+#include "svt_threads.h"
+#include "random.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
 
 typedef void (*av1_compute_stats_func)(int32_t wiener_win, const uint8_t *dgd8,
                                        const uint8_t *src8, int32_t h_start,
@@ -618,3 +625,238 @@ INSTANTIATE_TEST_SUITE_P(
 
 #endif  // HAVE_SVE
 #endif  // ARCH_AARCH64
+
+/**
+ * @brief Unit test for the final restoration search run as jobs:
+ * - svt_aom_rest_finish_search_init
+ * - svt_aom_rest_finish_search_job
+ *
+ * Test strategy:
+ * Fill the segment search results of every restoration unit of a picture
+ * with random SSEs and filter coefficients, then take the final decision with
+ * rest_finish_search() and again with its jobs run in a shuffled order and
+ * from concurrent threads, for every combination of Wiener / self-guided
+ * filters on luma and chroma and with single unit planes.
+ *
+ * Expected result:
+ * The frame restoration type and the RestorationUnitInfo of every unit are
+ * identical, and exactly one job reports the completion of the picture.
+ */
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+typedef struct {
+    bool wn, wn_chroma, sg, sg_chroma;
+} RestFinishConfig;
+
+class RestFinishSearchTest
+    : public ::testing::TestWithParam<::testing::tuple<RestFinishConfig, int>> {
+  public:
+    RestFinishSearchTest() : rnd_(0, 1 << 20, 0) {
+    }
+
+    void SetUp() override {
+        const RestFinishConfig cfg = TEST_GET_PARAM(0);
+        // a single unit per plane or a few rows and columns of units
+        const int width = TEST_GET_PARAM(1);
+        const int height = width * 3 / 4;
+
+        memset(&cm_, 0, sizeof(cm_));
+        memset(&ppcs_, 0, sizeof(ppcs_));
+        memset(&x_, 0, sizeof(x_));
+        pcs_ = (PictureControlSet *)calloc(1, sizeof(*pcs_));
+        ASSERT_NE(pcs_, nullptr);
+        pcs_->rest_search_mutex = svt_create_mutex();
+
+        cm_.child_pcs = pcs_;
+        cm_.subsampling_x = 1;
+        cm_.subsampling_y = 1;
+        cm_.frm_size.frame_width = width;
+        cm_.frm_size.superres_upscaled_width = width;
+        cm_.frm_size.frame_height = height;
+        cm_.wn_filter_ctrls.enabled = cfg.wn;
+        cm_.wn_filter_ctrls.filter_tap_lvl = 1;
+        cm_.wn_filter_ctrls.use_chroma = cfg.wn_chroma;
+        cm_.sg_filter_ctrls.enabled = cfg.sg;
+        cm_.sg_filter_ctrls.use_chroma = cfg.sg_chroma;
+        ppcs_.av1_cm = &cm_;
+        ppcs_.av1x = &x_;
+        pcs_->ppcs = &ppcs_;
+
+        SVTRandom rnd(0, 255, 0);
+        x_.rdmult = 2000 + 20 * rnd.random();
+        for (int i = 0; i < RESTORE_SWITCHABLE_TYPES; i++)
+            x_.switchable_restore_cost[i] = 100 + 4 * rnd.random();
+        for (int i = 0; i < 2; i++) {
+            x_.wiener_restore_cost[i] = 100 + 4 * rnd.random();
+            x_.sgrproj_restore_cost[i] = 100 + 4 * rnd.random();
+        }
+
+        for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+            const int unit_size = 64;
+            const int w = plane ? width >> 1 : width;
+            const int h = plane ? height >> 1 : height;
+            const int hunits = AOMMAX((w + (unit_size >> 1)) / unit_size, 1);
+            const int vunits = AOMMAX((h + (unit_size >> 1)) / unit_size, 1);
+            RestorationInfo *rsi = &pcs_->rst_info[plane];
+            rsi->restoration_unit_size = unit_size;
+            rsi->horz_units_per_tile = hunits;
+            rsi->vert_units_per_tile = vunits;
+            rsi->units_per_tile = hunits * vunits;
+            rusi_pic_[plane].resize(rsi->units_per_tile);
+            rusi_finish_[plane].resize(rsi->units_per_tile);
+            pcs_->rusi_picture[plane] = rusi_pic_[plane].data();
+            pcs_->rusi_finish[plane] = rusi_finish_[plane].data();
+            for (int u = 0; u < rsi->units_per_tile; u++)
+                fill_unit(&rusi_pic_[plane][u], plane);
+        }
+    }
+
+    void TearDown() override {
+        svt_destroy_mutex(pcs_->rest_search_mutex);
+        free(pcs_);
+    }
+
+  protected:
+    void fill_unit(RestUnitSearchInfo *rusi, int plane) {
+        SVTRandom &rnd = rnd_;
+        memset(rusi, 0, sizeof(*rusi));
+        const int64_t sse_none = (1 << 20) + rnd.random();
+        rusi->sse[RESTORE_NONE] = sse_none;
+        // filters gaining a little or losing a little, or no Wiener filter
+        rusi->sse[RESTORE_WIENER] = rnd.random() % 8 == 0
+            ? INT64_MAX
+            : sse_none - rnd.random() % 4096 + 512;
+        rusi->sse[RESTORE_SGRPROJ] = sse_none - rnd.random() % 4096 + 512;
+        InterpKernel *filters[2] = {&rusi->wiener.vfilter, &rusi->wiener.hfilter};
+        for (InterpKernel *f : filters) {
+            (*f)[0] = plane ? 0 : WIENER_FILT_TAP0_MIDV + rnd.random() % 5 - 2;
+            (*f)[1] = WIENER_FILT_TAP1_MIDV + rnd.random() % 5 - 2;
+            (*f)[2] = WIENER_FILT_TAP2_MIDV + rnd.random() % 5 - 2;
+        }
+        rusi->sgrproj.ep = rnd.random() % SGRPROJ_PARAMS;
+        rusi->sgrproj.xqd[0] = SGRPROJ_PRJ_MIN0 +
+            rnd.random() % (SGRPROJ_PRJ_MAX0 - SGRPROJ_PRJ_MIN0 + 1);
+        rusi->sgrproj.xqd[1] = SGRPROJ_PRJ_MIN1 +
+            rnd.random() % (SGRPROJ_PRJ_MAX1 - SGRPROJ_PRJ_MIN1 + 1);
+    }
+
+    // run the final decision into unit_info[] and save the results
+    typedef std::vector<RestorationUnitInfo> Decision[MAX_MB_PLANE];
+    void reset_decision(Decision &unit_info) {
+        for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+            unit_info[plane].assign(pcs_->rst_info[plane].units_per_tile,
+                                    RestorationUnitInfo());
+            memset(unit_info[plane].data(), 0,
+                   unit_info[plane].size() * sizeof(RestorationUnitInfo));
+            pcs_->rst_info[plane].unit_info = unit_info[plane].data();
+            pcs_->rst_info[plane].frame_restoration_type = RESTORE_TYPES;
+        }
+    }
+
+    void check_decision(const Decision &ref, const RestorationType *ref_type,
+                        const Decision &test) {
+        for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+            ASSERT_EQ(ref_type[plane],
+                      pcs_->rst_info[plane].frame_restoration_type)
+                << "plane " << plane;
+            ASSERT_EQ(memcmp(ref[plane].data(),
+                             test[plane].data(),
+                             ref[plane].size() * sizeof(RestorationUnitInfo)),
+                      0)
+                << "plane " << plane;
+        }
+    }
+
+    struct JobThread {
+        PictureControlSet *pcs;
+        RestFinishJob job;
+        bool last;
+    };
+
+    static void *job_kernel(void *arg) {
+        JobThread *t = (JobThread *)arg;
+        t->last = svt_aom_rest_finish_search_job(
+            t->pcs, t->job.plane, (RestorationType)t->job.rtype);
+        return NULL;
+    }
+
+    void run_test() {
+        Decision ref, test;
+        RestorationType ref_type[MAX_MB_PLANE];
+        reset_decision(ref);
+        rest_finish_search(pcs_);
+        for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+            ref_type[plane] = pcs_->rst_info[plane].frame_restoration_type;
+            ASSERT_LT(ref_type[plane], RESTORE_TYPES);
+        }
+
+        std::mt19937 gen(0);
+        for (int iter = 0; iter < 8; iter++) {
+            // jobs in a shuffled order
+            RestFinishJob jobs[MAX_MB_PLANE * 2];
+            reset_decision(test);
+            uint32_t job_count = svt_aom_rest_finish_search_init(pcs_, jobs);
+            std::shuffle(jobs, jobs + job_count, gen);
+            uint32_t last_count = 0;
+            for (uint32_t i = 0; i < job_count; i++) {
+                const bool last = svt_aom_rest_finish_search_job(
+                    pcs_, jobs[i].plane, (RestorationType)jobs[i].rtype);
+                ASSERT_EQ(last, i == job_count - 1);
+                last_count += last;
+            }
+            check_decision(ref, ref_type, test);
+
+            // jobs from concurrent threads
+            reset_decision(test);
+            job_count = svt_aom_rest_finish_search_init(pcs_, jobs);
+            JobThread threads[MAX_MB_PLANE * 2];
+            EbHandle handles[MAX_MB_PLANE * 2];
+            for (uint32_t i = 0; i < job_count; i++) {
+                threads[i].pcs = pcs_;
+                threads[i].job = jobs[i];
+                threads[i].last = false;
+                handles[i] = svt_create_thread(job_kernel, &threads[i]);
+                ASSERT_NE(handles[i], nullptr);
+            }
+            last_count = 0;
+            for (uint32_t i = 0; i < job_count; i++) {
+                svt_destroy_thread(handles[i]);
+                last_count += threads[i].last;
+            }
+            ASSERT_EQ(last_count, job_count ? 1u : 0u);
+            check_decision(ref, ref_type, test);
+        }
+    }
+
+    SVTRandom rnd_;
+    PictureControlSet *pcs_;
+    PictureParentControlSet ppcs_;
+    Av1Common cm_;
+    Macroblock x_;
+    std::vector<RestUnitSearchInfo> rusi_pic_[MAX_MB_PLANE];
+    std::vector<RestUnitSearchInfo> rusi_finish_[MAX_MB_PLANE];
+};
+
+TEST_P(RestFinishSearchTest, MatchSequential) {
+    run_test();
+}
+
+static const RestFinishConfig rest_finish_configs[] = {
+    {true, false, false, false},
+    {true, true, false, false},
+    {false, false, true, false},
+    {false, false, true, true},
+    {true, false, true, true},
+    {true, true, true, false},
+    {true, true, true, true},
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    RST, RestFinishSearchTest,
+    ::testing::Combine(::testing::ValuesIn(rest_finish_configs),
+                       ::testing::Values(48, 352, 640)));
+
+}  // namespace
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file VarianceBoostTest.cc
+ *
+ * @brief Unit test for the variance boost superblock delta q derivation:
+ * - svt_aom_variance_boost_sb_variance
+ * - svt_aom_variance_boost_build_row
+ *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "definitions.h"
+#include "utility.h"
+#include "random.h"
+
+extern "C" int32_t svt_av1_convert_qindex_to_q_fp8(int32_t qindex,
+                                                   EbBitDepth bit_depth);
+extern "C" int32_t svt_av1_compute_qdelta_fp(int32_t qstart_fp8,
+                                             int32_t qtarget_fp8,
+                                             EbBitDepth bit_depth);
+extern "C" uint16_t svt_aom_variance_boost_sb_variance(
+    const uint16_t *variances, uint8_t octile);
+extern "C" void svt_aom_variance_boost_build_row(int8_t *row,
+                                                 uint8_t base_q_idx,
+                                                 uint8_t strength,
+                                                 EbBitDepth bit_depth,
+                                                 uint8_t curve);
+
+/**
+ * @brief Unit test for the variance boost delta q derivation
+ *
+ * Test strategy:
+ * Compare the superblock qindex map derived from the octile selection and the
+ * per base_q_idx boost rows with the one derived by the reference, which
+ * sorts the 8x8 variances of every superblock and evaluates the boost curve
+ * for each of them.
+ *
+ * Expected result:
+ * The qindex maps are bit-exact.
+ *
+ * Test coverage:
+ * All octiles, strengths and curves, 8, 10 and 12-bit, every base_q_idx.
+ * The 8x8 variances are random over the full range, over a low range where
+ * the boost varies the most, or runs of a few distinct values to cover ties
+ * in the selection.
+ */
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const int var_boost_lut_size = 1025;
+static const int sb_count = 8;
+static const int mode_count = 3;
+static const int variance_count = 85;  // ME_TIER_ZERO_PU_8x8_0 + 64
+
+static int variance_comp_ref(const void *a, const void *b) {
+    return (int)*(const uint16_t *)a - *(const uint16_t *)b;
+}
+
+// The per superblock derivation the rate control used to run
+static int variance_boost_ref(uint8_t base_q_idx, const uint16_t *variances,
+                              uint8_t strength, EbBitDepth bit_depth,
+                              uint8_t octile, uint8_t curve) {
+    uint16_t ordered_variances[64];
+    memcpy(ordered_variances, variances + 21, sizeof(ordered_variances));
+    qsort(ordered_variances, 64, sizeof(uint16_t), variance_comp_ref);
+
+    const int mid_idx = octile * 8 - 1;
+    const int low_idx = AOMMAX(8 - 1, mid_idx - 8);
+    const int upp_idx = AOMMIN(64 - 1, mid_idx + 8);
+    uint16_t variance = (ordered_variances[low_idx] +
+                         (ordered_variances[mid_idx] * 2) +
+                         ordered_variances[upp_idx] + 2) /
+                        4;
+    if (variance == 0)
+        variance = 1;
+
+    double qstep_ratio = 0;
+    const double strengths[] = {0, 0.65, 1.1, 1.6, 2.5};
+    switch (curve) {
+    case 1:
+        qstep_ratio = 0.25 * strength * (-log2((double)variance) + 8) + 1;
+        break;
+    case 2:
+        qstep_ratio = 0.15 * strength * (-log2((double)variance) + 10) + 1;
+        break;
+    default:
+        qstep_ratio = pow(1.018,
+                          strengths[strength] *
+                              (-10 * log2((double)variance) + 80));
+        break;
+    }
+    qstep_ratio = CLIP3(1, 8, qstep_ratio);
+
+    int32_t base_q = svt_av1_convert_qindex_to_q_fp8(base_q_idx, bit_depth);
+    int32_t target_q = (int32_t)(base_q / qstep_ratio);
+    int32_t boost = 0;
+    switch (curve) {
+    case 2:
+        boost = (int32_t)((base_q_idx + 496) *
+                          -svt_av1_compute_qdelta_fp(
+                              base_q, target_q, bit_depth) /
+                          (255 + 1024));
+        break;
+    default:
+        boost = (int32_t)((base_q_idx + 40) *
+                          -svt_av1_compute_qdelta_fp(
+                              base_q, target_q, bit_depth) /
+                          (255 + 40));
+        break;
+    }
+    return AOMMIN(80, boost);
+}
+
+class VarianceBoostTest : public ::testing::TestWithParam<EbBitDepth> {
+  protected:
+    void fill_variances(SVTRandom &rnd) {
+        for (int mode = 0; mode < mode_count; mode++) {
+            for (int sb = 0; sb < sb_count; sb++) {
+                uint16_t *v = variances_[mode][sb];
+                memset(v, 0, sizeof(variances_[mode][sb]));
+                const int levels = rnd.random() % 4 + 1;
+                for (int i = 21; i < variance_count; i++) {
+                    switch (mode) {
+                    case 0: v[i] = rnd.random() & 0xFFFF; break;
+                    case 1: v[i] = rnd.random() % 1300; break;
+                    default: v[i] = (rnd.random() % levels) * 37; break;
+                    }
+                }
+                for (uint8_t octile = 1; octile <= 8; octile++)
+                    sb_variance_[mode][octile - 1][sb] =
+                        svt_aom_variance_boost_sb_variance(v, octile);
+            }
+        }
+    }
+
+    void run_test() {
+        const EbBitDepth bit_depth = GetParam();
+        SVTRandom rnd(0, (1 << 30) - 1);
+        int8_t row[var_boost_lut_size];
+
+        fill_variances(rnd);
+        for (uint8_t curve = 0; curve <= 2; curve++) {
+            for (uint8_t strength = 1; strength <= 4; strength++) {
+                for (int q = 0; q <= 255; q++) {
+                    svt_aom_variance_boost_build_row(
+                        row, q, strength, bit_depth, curve);
+                    for (int mode = 0; mode < mode_count; mode++) {
+                        for (uint8_t octile = 1; octile <= 8; octile++) {
+                            for (int sb = 0; sb < sb_count; sb++) {
+                                const uint16_t variance =
+                                    sb_variance_[mode][octile - 1][sb];
+                                const int boost =
+                                    variance < var_boost_lut_size
+                                        ? row[variance]
+                                        : 0;
+                                const int ref_boost = variance_boost_ref(
+                                    q,
+                                    variances_[mode][sb],
+                                    strength,
+                                    bit_depth,
+                                    octile,
+                                    curve);
+                                ASSERT_EQ(CLIP3(1, 255, q - ref_boost),
+                                          CLIP3(1, 255, q - boost))
+                                    << "base_q_idx " << q << " octile "
+                                    << (int)octile << " curve " << (int)curve
+                                    << " strength " << (int)strength
+                                    << " mode " << mode << " sb " << sb;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    uint16_t variances_[mode_count][sb_count][variance_count];
+    uint16_t sb_variance_[mode_count][8][sb_count];
+};
+
+TEST_P(VarianceBoostTest, MatchReference) {
+    run_test();
+}
+
+INSTANTIATE_TEST_SUITE_P(VarianceBoost, VarianceBoostTest,
+                         ::testing::Values(EB_EIGHT_BIT, EB_TEN_BIT,
+                                           EB_TWELVE_BIT));
+
+}  // namespace
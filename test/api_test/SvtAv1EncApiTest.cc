@@ -18,6 +18,13 @@
  * @author Cidana-Edmond, Cidana-Ryan, Cidana-Wenyao
  *
  ******************************************************************************/
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1EncApiTest.h"
@@ -26,6 +33,13 @@ using namespace svt_av1_test;
 
 namespace {
 
+// The sizes of the public structs are part of the ABI: new configuration parameters take their space from its
+// padding
+static_assert(sizeof(void *) != 8 || sizeof(EbSvtAv1EncConfiguration) == 624,
+              "the size of EbSvtAv1EncConfiguration changed, deduct the new parameters from its padding");
+static_assert(sizeof(void *) != 8 || sizeof(EbBufferHeaderType) == 144,
+              "the size of EbBufferHeaderType changed");
+
 /** @brief set_parameter_null_pointer is a death test case
  * EncApiDeathTest.set_parameter_null_pointer is a test case for reporting a
  * death condition lead to ececptions or signals
@@ -201,4 +215,564 @@ TEST(EncApiTest, DISABLED_repeat_normal_setup) {
     }
 }
 
+/** @brief startup_latency is a benchmark of the encoder startup
+ * EncApiTest.startup_latency measures the time from svt_av1_enc_init_handle
+ * to the first packet of encoders opened one after the other in the same
+ * process
+ *
+ * Test strategy: <br>
+ * For 1, 10 and 100 sequential handles, open an encoder, send a single
+ * 320x240 frame and the end of stream, wait for the first packet, then
+ * close the encoder. Report the mean and worst time to the first packet and
+ * the mean time spent in svt_av1_enc_init.
+ *
+ * Expected result: <br>
+ * Every encoder delivers a packet. Since the process wide tables are built by
+ * the first encoder only, the later ones should start faster.
+ *
+ * Test coverage:
+ * svt_av1_enc_init_handle, svt_av1_enc_set_parameter, svt_av1_enc_init,
+ * svt_av1_enc_send_picture, svt_av1_enc_get_packet.
+ *
+ * Comments:
+ * Disabled for it is a benchmark, run it with
+ * --gtest_also_run_disabled_tests --gtest_filter=*startup_latency
+ */
+TEST(EncApiTest, DISABLED_startup_latency) {
+    typedef std::chrono::steady_clock clock;
+    const int width = 320;
+    const int height = 240;
+    std::vector<uint8_t> luma(width * height, 128);
+    std::vector<uint8_t> chroma(width * height / 4, 128);
+
+    for (const int handle_count : {1, 10, 100}) {
+        double total_ms = 0, worst_ms = 0, init_ms = 0;
+        for (int i = 0; i < handle_count; ++i) {
+            SvtAv1Context context;
+            memset(&context, 0, sizeof(context));
+            const clock::time_point start = clock::now();
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_init_handle(&context.enc_handle,
+                                              &context.enc_params));
+            context.enc_params.source_width = width;
+            context.enc_params.source_height = height;
+            context.enc_params.encoder_bit_depth = 8;
+            context.enc_params.enc_mode = 10;
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_set_parameter(context.enc_handle,
+                                                &context.enc_params));
+            const clock::time_point init_start = clock::now();
+            ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle));
+            init_ms += std::chrono::duration<double, std::milli>(
+                           clock::now() - init_start)
+                           .count();
+
+            EbSvtIOFormat frame;
+            memset(&frame, 0, sizeof(frame));
+            frame.luma = luma.data();
+            frame.cb = chroma.data();
+            frame.cr = chroma.data();
+            frame.y_stride = width;
+            frame.cb_stride = width / 2;
+            frame.cr_stride = width / 2;
+            EbBufferHeaderType in;
+            memset(&in, 0, sizeof(in));
+            in.size = sizeof(in);
+            in.p_buffer = (uint8_t *)&frame;
+            in.n_filled_len = width * height * 3 / 2;
+            in.pic_type = EB_AV1_INVALID_PICTURE;
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_send_picture(context.enc_handle, &in));
+            EbBufferHeaderType eos;
+            memset(&eos, 0, sizeof(eos));
+            eos.flags = EB_BUFFERFLAG_EOS;
+            eos.pic_type = EB_AV1_INVALID_PICTURE;
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_send_picture(context.enc_handle, &eos));
+
+            EbBufferHeaderType *out = nullptr;
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_get_packet(context.enc_handle, &out, 1));
+            const double ms =
+                std::chrono::duration<double, std::milli>(clock::now() -
+                                                          start)
+                    .count();
+            total_ms += ms;
+            worst_ms = ms > worst_ms ? ms : worst_ms;
+            // drain the encoder up to the end of stream before closing it
+            bool eos_seen = false;
+            while (!eos_seen) {
+                eos_seen = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+                svt_av1_enc_release_out_buffer(&out);
+                if (!eos_seen) {
+                    ASSERT_EQ(EB_ErrorNone,
+                              svt_av1_enc_get_packet(
+                                  context.enc_handle, &out, 1));
+                }
+            }
+            ASSERT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle));
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_deinit_handle(context.enc_handle));
+        }
+        printf("%3d handles: first packet mean %.2f ms, worst %.2f ms, "
+               "svt_av1_enc_init mean %.2f ms\n",
+               handle_count,
+               total_ms / handle_count,
+               worst_ms,
+               init_ms / handle_count);
+        RecordProperty("first_packet_mean_ms_" + std::to_string(handle_count),
+                       std::to_string(total_ms / handle_count));
+    }
+}
+
+/** @brief Packet is what the encode tests compare of a packet */
+struct Packet {
+    int64_t pts;
+    uint32_t size;
+    EbAv1PictureType pic_type;
+    uint32_t flags;
+};
+
+/** @brief encode_frames encodes a moving gradient with the parameters changed
+ * by configure, and returns the packets up to the end of stream, which is
+ * checked to be flagged on the last one only */
+static void encode_frames(const std::function<void(SvtAv1Context &)> &configure,
+                          int frame_count, std::vector<Packet> &packets) {
+    const int width = 320;
+    const int height = 240;
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> chroma(width * height / 4, 128);
+
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&context.enc_handle,
+                                      &context.enc_params));
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    context.enc_params.encoder_bit_depth = 8;
+    context.enc_params.enc_mode = 12;
+    context.enc_params.intra_period_length = 15;
+    context.enc_params.intra_refresh_type = SVT_AV1_KF_REFRESH;
+    configure(context);
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params));
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle));
+    const bool low_delay =
+        context.enc_params.pred_structure == SVT_AV1_PRED_LOW_DELAY_B;
+
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = luma.data();
+    frame.cb = chroma.data();
+    frame.cr = chroma.data();
+    frame.y_stride = width;
+    frame.cb_stride = width / 2;
+    frame.cr_stride = width / 2;
+    bool eos = false;
+    for (int i = 0; i <= frame_count; ++i) {
+        EbBufferHeaderType in;
+        memset(&in, 0, sizeof(in));
+        in.size = sizeof(in);
+        in.pic_type = EB_AV1_INVALID_PICTURE;
+        if (i < frame_count) {
+            for (int y = 0; y < height; ++y)
+                for (int x = 0; x < width; ++x)
+                    luma[y * width + x] = (uint8_t)(x + 2 * y + 5 * i +
+                                                    ((x * y) >> 7));
+            in.p_buffer = (uint8_t *)&frame;
+            in.n_filled_len = width * height * 3 / 2;
+            in.pts = i;
+        } else
+            in.flags = EB_BUFFERFLAG_EOS;
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, &in));
+        // get the packets as they come, and all of them once the end of
+        // stream was sent; a low delay encoder always blocks, so its frame
+        // is waited for instead
+        bool frame_done = false;
+        EbBufferHeaderType *out = nullptr;
+        while (!eos && !(low_delay && frame_done) &&
+               svt_av1_enc_get_packet(context.enc_handle, &out,
+                                      i == frame_count) == EB_ErrorNone &&
+               out) {
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            frame_done = !(out->flags & EB_BUFFERFLAG_FRAGMENT) ||
+                         (out->flags & EB_BUFFERFLAG_LAST_FRAGMENT);
+            uint8_t *buffer = out->p_buffer;
+            const uint32_t flags = out->flags;
+            if (out->n_filled_len)
+                packets.push_back({out->pts, out->n_filled_len,
+                                   out->pic_type, flags});
+            else
+                EXPECT_TRUE(eos) << "empty packet before the end of stream";
+            svt_av1_enc_release_out_buffer(&out);
+            // the application owns the buffers it allocated
+            if (flags & EB_BUFFERFLAG_APP_BUFFER)
+                context.enc_params.output_buffer_free(
+                    context.enc_params.output_buffer_ctx, buffer);
+        }
+    }
+    EXPECT_TRUE(eos);
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle));
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+}
+
+/** @brief chunk_parallel_matches_serial is an api test case
+ * EncApiTest.chunk_parallel_matches_serial compares the output of a chunk
+ * parallel encode with the one of the same serial encode
+ *
+ * Test strategy: <br>
+ * Encode 72 frames with a key frame interval of 16, i.e. 4 full GOPs and a
+ * partial one, serially and with 2 and 3 GOPs encoded concurrently, getting
+ * the packets while sending the frames.
+ *
+ * Expected result: <br>
+ * The encoders output a packet per frame, in the same order, with the key
+ * frames at the same places, and the end of stream on the last packet only.
+ * The GOPs are encoded as in the serial encode, so the packet sizes match
+ * too; only the order hints of the frame headers differ.
+ *
+ * Test coverage:
+ * chunk_parallel, svt_av1_enc_send_picture, svt_av1_enc_get_packet.
+ */
+TEST(EncApiTest, chunk_parallel_matches_serial) {
+    const int frame_count = 72;
+    std::vector<Packet> serial;
+    encode_frames([](SvtAv1Context &) {}, frame_count, serial);
+    ASSERT_EQ((size_t)frame_count, serial.size());
+    for (const uint8_t chunk_parallel : {2, 3}) {
+        std::vector<Packet> chunked;
+        encode_frames(
+            [chunk_parallel](SvtAv1Context &context) {
+                context.enc_params.chunk_parallel = chunk_parallel;
+            },
+            frame_count, chunked);
+        ASSERT_EQ(serial.size(), chunked.size())
+            << "chunk_parallel " << (int)chunk_parallel;
+        for (size_t i = 0; i < serial.size(); ++i) {
+            EXPECT_EQ(serial[i].pts, chunked[i].pts)
+                << "packet " << i << ", chunk_parallel "
+                << (int)chunk_parallel;
+            EXPECT_EQ(serial[i].pic_type, chunked[i].pic_type)
+                << "packet " << i << ", chunk_parallel "
+                << (int)chunk_parallel;
+            EXPECT_EQ(serial[i].size, chunked[i].size)
+                << "packet " << i << ", chunk_parallel "
+                << (int)chunk_parallel;
+        }
+    }
+}
+
+/** @brief obu_streaming_invalid_setup is an api test case
+ * EncApiTest.obu_streaming_invalid_setup checks obu streaming is rejected
+ * with the settings it does not support
+ *
+ * Test strategy: <br>
+ * Enable obu streaming with the random access prediction structure, and with
+ * the low delay one together with super-resolution or the per frame
+ * statistics report.
+ *
+ * Expected result: <br>
+ * svt_av1_enc_set_parameter returns EB_ErrorBadParameter.
+ *
+ * Test coverage:
+ * obu_streaming, svt_av1_enc_set_parameter.
+ */
+TEST(EncApiTest, obu_streaming_invalid_setup) {
+    for (int i = 0; i < 3; ++i) {
+        SvtAv1Context context;
+        memset(&context, 0, sizeof(context));
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_init_handle(&context.enc_handle,
+                                          &context.enc_params));
+        context.enc_params.source_width = 320;
+        context.enc_params.source_height = 240;
+        context.enc_params.obu_streaming = true;
+        // the PSNR tune supports both prediction structures
+        context.enc_params.tune = 1;
+        if (i == 0)
+            context.enc_params.pred_structure = SVT_AV1_PRED_RANDOM_ACCESS;
+        else
+            context.enc_params.pred_structure = SVT_AV1_PRED_LOW_DELAY_B;
+        if (i == 1)
+            context.enc_params.superres_mode = SUPERRES_FIXED;
+        if (i == 2)
+            context.enc_params.stat_report = 1;
+        EXPECT_EQ(EB_ErrorBadParameter,
+                  svt_av1_enc_set_parameter(context.enc_handle,
+                                            &context.enc_params))
+            << "case " << i;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+    }
+}
+
+/** @brief obu_streaming_fragments is an api test case
+ * EncApiTest.obu_streaming_fragments checks the frames are output as
+ * fragments with obu streaming
+ *
+ * Test strategy: <br>
+ * Encode 20 frames split into 2 tiles with the low delay prediction
+ * structure, with and without obu streaming.
+ *
+ * Expected result: <br>
+ * With obu streaming, every packet is flagged as a fragment, and each frame
+ * is output as its frame header followed by a fragment per tile, the last
+ * one flagged as the last fragment. The fragments carry the pts and the
+ * picture type of their frame, in the order of the packets of the encode
+ * without obu streaming.
+ *
+ * Test coverage:
+ * obu_streaming, svt_av1_enc_get_packet.
+ */
+TEST(EncApiTest, obu_streaming_fragments) {
+    const int frame_count = 20;
+    const size_t fragments_per_frame = 3;
+    std::vector<Packet> frames;
+    std::vector<Packet> fragments;
+    for (const bool obu_streaming : {false, true}) {
+        encode_frames(
+            [obu_streaming](SvtAv1Context &context) {
+                context.enc_params.pred_structure = SVT_AV1_PRED_LOW_DELAY_B;
+                context.enc_params.tune = 1;
+                context.enc_params.tile_columns = 1;
+                context.enc_params.obu_streaming = obu_streaming;
+            },
+            frame_count, obu_streaming ? fragments : frames);
+    }
+    ASSERT_EQ((size_t)frame_count, frames.size());
+    ASSERT_EQ(frames.size() * fragments_per_frame, fragments.size());
+    for (size_t i = 0; i < fragments.size(); ++i) {
+        const Packet &frame = frames[i / fragments_per_frame];
+        const bool last = i % fragments_per_frame == fragments_per_frame - 1;
+        EXPECT_TRUE(fragments[i].flags & EB_BUFFERFLAG_FRAGMENT)
+            << "fragment " << i;
+        EXPECT_EQ(last, !!(fragments[i].flags & EB_BUFFERFLAG_LAST_FRAGMENT))
+            << "fragment " << i;
+        EXPECT_EQ(frame.pts, fragments[i].pts) << "fragment " << i;
+        EXPECT_EQ(frame.pic_type, fragments[i].pic_type) << "fragment " << i;
+    }
+    for (const Packet &frame : frames)
+        EXPECT_FALSE(frame.flags & EB_BUFFERFLAG_FRAGMENT);
+}
+
+/** @brief executor_invalid_setup is an api test case
+ * EncApiTest.executor_invalid_setup checks the executor functions reject
+ * null pointers and a second attachment
+ *
+ * Test strategy: <br>
+ * Create and destroy a null executor, attach a null encoder handle or a null
+ * executor, and attach an encoder to an executor twice.
+ *
+ * Expected result: <br>
+ * The functions return EB_ErrorBadParameter, the first attachment succeeds.
+ *
+ * Test coverage:
+ * svt_av1_executor_create, svt_av1_enc_attach_executor,
+ * svt_av1_executor_destroy.
+ */
+TEST(EncApiTest, executor_invalid_setup) {
+    EXPECT_EQ(EB_ErrorBadParameter, svt_av1_executor_create(nullptr, 0));
+    EXPECT_EQ(EB_ErrorBadParameter, svt_av1_executor_destroy(nullptr));
+
+    EbSvtAv1Executor *executor = nullptr;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_executor_create(&executor, 2));
+    ASSERT_NE(nullptr, executor);
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&context.enc_handle,
+                                      &context.enc_params));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_attach_executor(nullptr, executor, 1));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_attach_executor(context.enc_handle, nullptr, 1));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_attach_executor(context.enc_handle, executor, 1));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_attach_executor(context.enc_handle, executor, 1));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_executor_destroy(executor));
+}
+
+/** @brief executor_shared_encode is an api test case
+ * EncApiTest.executor_shared_encode encodes with two encoders sharing an
+ * executor
+ *
+ * Test strategy: <br>
+ * Encode 32 frames with an encoder alone, then concurrently with two encoders
+ * attached to an executor of 2 cores, with the priorities 1 and 4.
+ *
+ * Expected result: <br>
+ * The executor only schedules the tasks, so both encoders output the packets
+ * of the encoder alone.
+ *
+ * Test coverage:
+ * svt_av1_executor_create, svt_av1_enc_attach_executor,
+ * svt_av1_executor_destroy.
+ */
+TEST(EncApiTest, executor_shared_encode) {
+    const int frame_count = 32;
+    std::vector<Packet> alone;
+    encode_frames([](SvtAv1Context &) {}, frame_count, alone);
+    ASSERT_EQ((size_t)frame_count, alone.size());
+
+    EbSvtAv1Executor *executor = nullptr;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_executor_create(&executor, 2));
+    std::vector<Packet> shared[2];
+    std::vector<std::thread> encoders;
+    for (uint32_t i = 0; i < 2; ++i) {
+        const uint32_t priority = i ? 4 : 1;
+        encoders.emplace_back([executor, priority, frame_count, &shared, i] {
+            encode_frames(
+                [executor, priority](SvtAv1Context &context) {
+                    ASSERT_EQ(EB_ErrorNone,
+                              svt_av1_enc_attach_executor(
+                                  context.enc_handle, executor, priority));
+                },
+                frame_count, shared[i]);
+        });
+    }
+    for (std::thread &encoder : encoders)
+        encoder.join();
+    EXPECT_EQ(EB_ErrorNone, svt_av1_executor_destroy(executor));
+
+    for (const std::vector<Packet> &packets : shared) {
+        ASSERT_EQ(alone.size(), packets.size());
+        for (size_t i = 0; i < alone.size(); ++i) {
+            EXPECT_EQ(alone[i].pts, packets[i].pts) << "packet " << i;
+            EXPECT_EQ(alone[i].size, packets[i].size) << "packet " << i;
+        }
+    }
+}
+
+/** @brief OutputBuffers tracks the output buffers allocated for an encoder */
+struct OutputBuffers {
+    std::mutex mutex;
+    std::set<uint8_t *> allocated;
+    uint32_t alloc_count;
+};
+
+static uint8_t *alloc_output_buffer(void *ctx, uint32_t size) {
+    OutputBuffers *buffers = (OutputBuffers *)ctx;
+    uint8_t *buffer = new uint8_t[size];
+    std::lock_guard<std::mutex> lock(buffers->mutex);
+    buffers->allocated.insert(buffer);
+    buffers->alloc_count++;
+    return buffer;
+}
+
+static void free_output_buffer(void *ctx, uint8_t *buffer) {
+    OutputBuffers *buffers = (OutputBuffers *)ctx;
+    {
+        std::lock_guard<std::mutex> lock(buffers->mutex);
+        EXPECT_EQ(1u, buffers->allocated.erase(buffer))
+            << "freeing a buffer not allocated by alloc_output_buffer";
+    }
+    delete[] buffer;
+}
+
+/** @brief output_buffer_invalid_setup is an api test case
+ * EncApiTest.output_buffer_invalid_setup checks the output buffer callbacks
+ * are unset by default and must be set together
+ *
+ * Test strategy: <br>
+ * Get the default configuration, then set only one of the output buffer
+ * callbacks.
+ *
+ * Expected result: <br>
+ * The callbacks and their context are NULL by default,
+ * svt_av1_enc_set_parameter returns EB_ErrorBadParameter when only one
+ * callback is set.
+ *
+ * Test coverage:
+ * output_buffer_alloc, output_buffer_free, output_buffer_ctx,
+ * svt_av1_enc_set_parameter.
+ */
+TEST(EncApiTest, output_buffer_invalid_setup) {
+    for (int i = 0; i < 2; ++i) {
+        SvtAv1Context context;
+        memset(&context, 0, sizeof(context));
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_init_handle(&context.enc_handle,
+                                          &context.enc_params));
+        EXPECT_EQ(nullptr, context.enc_params.output_buffer_alloc);
+        EXPECT_EQ(nullptr, context.enc_params.output_buffer_free);
+        EXPECT_EQ(nullptr, context.enc_params.output_buffer_ctx);
+        context.enc_params.source_width = 320;
+        context.enc_params.source_height = 240;
+        if (i == 0)
+            context.enc_params.output_buffer_alloc = alloc_output_buffer;
+        else
+            context.enc_params.output_buffer_free = free_output_buffer;
+        EXPECT_EQ(EB_ErrorBadParameter,
+                  svt_av1_enc_set_parameter(context.enc_handle,
+                                            &context.enc_params))
+            << "case " << i;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+    }
+}
+
+/** @brief output_buffer_app_encode is an api test case
+ * EncApiTest.output_buffer_app_encode encodes into buffers allocated by the
+ * application
+ *
+ * Test strategy: <br>
+ * Encode 32 frames with the random access prediction structure, and 20
+ * frames with obu streaming, with and without the output buffer callbacks.
+ * The application frees the buffers of the packets it is given.
+ *
+ * Expected result: <br>
+ * The packets are the same with the callbacks, all flagged with
+ * EB_BUFFERFLAG_APP_BUFFER. Once the encoder is deinitialized, every
+ * allocated buffer was freed, by the encoder or by the application.
+ *
+ * Test coverage:
+ * output_buffer_alloc, output_buffer_free, output_buffer_ctx,
+ * svt_av1_enc_get_packet, svt_av1_enc_release_out_buffer.
+ */
+TEST(EncApiTest, output_buffer_app_encode) {
+    for (const bool obu_streaming : {false, true}) {
+        const int frame_count = obu_streaming ? 20 : 32;
+        OutputBuffers buffers;
+        buffers.alloc_count = 0;
+        std::vector<Packet> internal;
+        std::vector<Packet> app;
+        for (const bool app_buffers : {false, true}) {
+            encode_frames(
+                [obu_streaming, app_buffers, &buffers](SvtAv1Context &context) {
+                    if (obu_streaming) {
+                        context.enc_params.pred_structure =
+                            SVT_AV1_PRED_LOW_DELAY_B;
+                        context.enc_params.tune = 1;
+                        context.enc_params.tile_columns = 1;
+                        context.enc_params.obu_streaming = true;
+                    }
+                    if (app_buffers) {
+                        context.enc_params.output_buffer_alloc =
+                            alloc_output_buffer;
+                        context.enc_params.output_buffer_free =
+                            free_output_buffer;
+                        context.enc_params.output_buffer_ctx = &buffers;
+                    }
+                },
+                frame_count, app_buffers ? app : internal);
+        }
+        EXPECT_TRUE(buffers.allocated.empty())
+            << buffers.allocated.size() << " buffers not freed";
+        EXPECT_LE(app.size(), buffers.alloc_count);
+        ASSERT_LE((size_t)frame_count, internal.size());
+        ASSERT_EQ(internal.size(), app.size());
+        for (size_t i = 0; i < internal.size(); ++i) {
+            EXPECT_TRUE(app[i].flags & EB_BUFFERFLAG_APP_BUFFER)
+                << "packet " << i;
+            EXPECT_FALSE(internal[i].flags & EB_BUFFERFLAG_APP_BUFFER)
+                << "packet " << i;
+            EXPECT_EQ(internal[i].pts, app[i].pts) << "packet " << i;
+            EXPECT_EQ(internal[i].size, app[i].size) << "packet " << i;
+        }
+    }
+}
+
 }  // namespace
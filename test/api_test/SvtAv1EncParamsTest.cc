@@ -130,6 +130,11 @@ class EncParamTestBase : public ::testing::Test {
             }
         } else if (!param_name_str_.compare("target_bit_rate")) {
             ctxt_.enc_params.rate_control_mode = SVT_AV1_RC_MODE_VBR;
+        } else if (!param_name_str_.compare("obu_streaming")) {
+            /** obu streaming requires the low delay prediction structure,
+             * which the default SSIM tune does not support */
+            ctxt_.enc_params.pred_structure = SVT_AV1_PRED_LOW_DELAY_B;
+            ctxt_.enc_params.tune = 1;
         }
     }
 
@@ -350,4 +355,8 @@ PARAM_TEST(EncParamTransferCharacteristicsTest);
 DEFINE_PARAM_TEST_CLASS(EncParamMatrixCoefficientsTest, matrix_coefficients);
 PARAM_TEST(EncParamMatrixCoefficientsTest);
 
+/** Test case for obu_streaming*/
+DEFINE_PARAM_TEST_CLASS(EncParamObuStreamingTest, obu_streaming);
+PARAM_TEST(EncParamObuStreamingTest);
+
 }  // namespace
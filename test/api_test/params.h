@@ -1022,6 +1022,12 @@ static const vector<EbMatrixCoefficients> invalid_matrix_coefficients = {
     EB_CICP_MC_IDENTITY,  // not actually invalid, but requires 4:4:4
 };
 
+/* OBU streaming, only supported with the low delay prediction structure
+ */
+static const vector<bool> default_obu_streaming = {false};
+static const vector<bool> valid_obu_streaming = {false, true};
+static const vector<bool> invalid_obu_streaming = {/*none*/};
+
 }  // namespace svt_av1_test_params
 
 /** @} */  // end of svt_av1_test_params
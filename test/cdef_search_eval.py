@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+
+"""
+Offline evaluation of encoder speed features against a reference build.
+
+Encodes every clip at every preset and CRF with a reference and a test
+SvtAv1EncApp, then reports per clip and preset the BD-rate of the test build
+(Y PSNR, negative is better) and its encoding time relative to the reference.
+Written to evaluate the CDEF strength search speedups but usable for any pair
+of builds.
+
+Requires:
+
+- Python 3.8+
+
+Example:
+
+    cdef_search_eval.py --ref base/Bin/Release/SvtAv1EncApp \\
+        --test Bin/Release/SvtAv1EncApp --presets 0 1 2 -n 60 clip1.y4m clip2.y4m
+"""
+
+
+import re
+import subprocess
+from argparse import ArgumentParser
+from math import log10
+from pathlib import Path
+from sys import stderr
+from tempfile import TemporaryDirectory
+from time import monotonic
+from typing import List, Sequence, Tuple
+
+PSNR_RE = re.compile(r"\|\s*([\d.]+) dB\s+([\d.]+) dB\s+([\d.]+) dB\s*\|")
+BITRATE_RE = re.compile(r"([\d.]+) kbps")
+
+
+def encode(app: str, clip: str, preset: int, crf: int, frames: int,
+           extra: Sequence[str], out: Path) -> Tuple[float, float, float]:
+    """Return (kbps, overall Y PSNR, seconds) of one encode"""
+    cmd = [app, "-i", clip, "--preset", str(preset), "--crf", str(crf),
+           "--enable-stat-report", "1", "-b", str(out), *extra]
+    if frames:
+        cmd += ["-n", str(frames)]
+    start = monotonic()
+    res = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                         universal_newlines=True, check=False)
+    elapsed = monotonic() - start
+    if res.returncode:
+        print(res.stdout, file=stderr)
+        raise RuntimeError(f"{' '.join(cmd)} failed")
+    psnr = PSNR_RE.findall(res.stdout)
+    rate = BITRATE_RE.findall(res.stdout)
+    if not psnr or not rate:
+        raise RuntimeError(f"no summary in the output of {' '.join(cmd)}")
+    # the second triplet is the overall PSNR (per-frame MSE)
+    return float(rate[-1]), float(psnr[-1][0]), elapsed
+
+
+def polyfit3(xs: List[float], ys: List[float]) -> List[float]:
+    """Least-squares cubic, coefficients from the constant term up"""
+    n = 4
+    mat = [[sum(x ** (i + j) for x in xs) for j in range(n)] for i in range(n)]
+    vec = [sum(y * x ** i for x, y in zip(xs, ys)) for i in range(n)]
+    # Gaussian elimination with partial pivoting
+    for col in range(n):
+        piv = max(range(col, n), key=lambda r: abs(mat[r][col]))
+        mat[col], mat[piv] = mat[piv], mat[col]
+        vec[col], vec[piv] = vec[piv], vec[col]
+        for row in range(col + 1, n):
+            f = mat[row][col] / mat[col][col]
+            for k in range(col, n):
+                mat[row][k] -= f * mat[col][k]
+            vec[row] -= f * vec[col]
+    coef = [0.0] * n
+    for row in reversed(range(n)):
+        coef[row] = (vec[row] - sum(mat[row][k] * coef[k]
+                                    for k in range(row + 1, n))) / mat[row][row]
+    return coef
+
+
+def integral(coef: List[float], lo: float, hi: float) -> float:
+    def prim(x):
+        return sum(c * x ** (i + 1) / (i + 1) for i, c in enumerate(coef))
+    return prim(hi) - prim(lo)
+
+
+def bd_rate(ref: List[Tuple[float, float]], test: List[Tuple[float, float]]) -> float:
+    """Bjontegaard delta rate in percent of (kbps, PSNR) points"""
+    ref_fit = polyfit3([p for _, p in ref], [log10(r) for r, _ in ref])
+    test_fit = polyfit3([p for _, p in test], [log10(r) for r, _ in test])
+    lo = max(min(p for _, p in ref), min(p for _, p in test))
+    hi = min(max(p for _, p in ref), max(p for _, p in test))
+    if hi <= lo:
+        return float("nan")
+    diff = (integral(test_fit, lo, hi) - integral(ref_fit, lo, hi)) / (hi - lo)
+    return (10 ** diff - 1) * 100
+
+
+def main():
+    parser = ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("--ref", required=True, help="reference encoder")
+    parser.add_argument("--test", required=True, help="encoder under test")
+    parser.add_argument("--presets", type=int, nargs="+", default=[0, 1, 2])
+    parser.add_argument("--crfs", type=int, nargs="+", default=[23, 31, 39, 47, 55])
+    parser.add_argument("-n", "--frames", type=int, default=0)
+    parser.add_argument("--extra", default="", help="additional encoder arguments")
+    parser.add_argument("clips", nargs="+")
+    args = parser.parse_args()
+    if len(args.crfs) < 4:
+        parser.error("BD-rate needs at least 4 CRFs")
+
+    extra = args.extra.split()
+    print(f"{'clip':24} {'preset':>6} {'BD-rate Y':>10} {'ref s':>9} {'test s':>9} {'speedup':>8}")
+    total_ref = total_test = 0.0
+    with TemporaryDirectory() as tmp:
+        out = Path(tmp) / "out.ivf"
+        for clip in args.clips:
+            for preset in args.presets:
+                ref_pts, test_pts = [], []
+                ref_time = test_time = 0.0
+                for crf in args.crfs:
+                    rate, psnr, sec = encode(args.ref, clip, preset, crf, args.frames, extra, out)
+                    ref_pts.append((rate, psnr))
+                    ref_time += sec
+                    rate, psnr, sec = encode(args.test, clip, preset, crf, args.frames, extra, out)
+                    test_pts.append((rate, psnr))
+                    test_time += sec
+                total_ref += ref_time
+                total_test += test_time
+                print(f"{Path(clip).name[:24]:24} {preset:6} {bd_rate(ref_pts, test_pts):9.3f}% "
+                      f"{ref_time:9.2f} {test_time:9.2f} {ref_time / test_time:7.3f}x", flush=True)
+    print(f"{'total':24} {'':6} {'':10} {total_ref:9.2f} {total_test:9.2f} {total_ref / total_test:7.3f}x")
+
+
+if __name__ == "__main__":
+    main()
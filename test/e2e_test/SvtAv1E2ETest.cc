@@ -19,6 +19,8 @@
  *
  ******************************************************************************/
 
+#include <mutex>
+#include <set>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1E2EFramework.h"
@@ -789,3 +791,217 @@ static const std::vector<EncTestSetting> generate_aq_mode_1_settings() {
 INSTANTIATE_TEST_SUITE_P(SEGMENTTEST, SegmentTest,
                          ::testing::ValuesIn(generate_aq_mode_1_settings()),
                          EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder E2E test with comparing the reconstructed frame with
+ * output frame from decoder buffer list when the recode loop codes pictures
+ * again, with and without fast recode
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder with VBR at a low target bitrate and the recode loop
+ * on every picture, so pictures get coded again at another qindex. With fast
+ * recode the passes reuse the blocks decided by the first pass of the picture,
+ * including their palette data on screen content. Collect the reconstructed
+ * frames and compared them with reference decoder output.
+ *
+ * Expected result:
+ * No error is reported in encoding progress. The reconstructed frame data is
+ * same as the output frame from reference decoder.
+ *
+ * Test coverage:
+ * 8-bit and 10-bit test vectors, screen content test vectors
+ */
+class FastRecodeTest : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_decoder = true;
+        enable_recon = true;
+        enable_stat = true;
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+};
+
+TEST_P(FastRecodeTest, RecodeTest) {
+    run_death_test();
+}
+
+// Test cases of the recode loop, each one with and without fast recode
+static const std::vector<EncTestSetting> generate_fast_recode_settings() {
+    static const std::string test_prefix = "FastRecode_";
+    std::vector<EncTestSetting> settings;
+
+    int count = 0;
+    static const EncSetting param_vecs[] = {
+        {{"EncoderMode", "10"}},
+        {{"EncoderMode", "6"}},
+        {{"EncoderMode", "3"}},
+    };
+    static const std::vector<TestVideoVector> *test_vectors[] = {
+        &incomplete_sb_test_vectors, &screen_test_vectors};
+    for (const std::vector<TestVideoVector> *vectors : test_vectors) {
+        for (EncSetting param : param_vecs) {
+            param.emplace("RateControlMode", "1");
+            param.emplace("TargetBitRate", "100");
+            param.emplace("Tune", "0");
+            param.emplace("RecodeLoop", "3");
+            if (vectors == &screen_test_vectors)
+                param.emplace("ScreenContentMode", "1");
+            for (const char *fast_recode : {"0", "1"}) {
+                EncSetting recode_param = param;
+                recode_param.emplace("FastRecode", fast_recode);
+                string name = test_prefix + std::to_string(count);
+                EncTestSetting setting{name, recode_param, *vectors};
+                settings.push_back(setting);
+                count++;
+            }
+        }
+    }
+    return settings;
+}
+
+INSTANTIATE_TEST_SUITE_P(FASTRECODETEST, FastRecodeTest,
+                         ::testing::ValuesIn(generate_fast_recode_settings()),
+                         EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder E2E test with comparing the reconstructed frame with
+ * output frame from decoder buffer list when the encoder runs its tasks on a
+ * shared executor
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder attached to an executor of 2 cores, destroyed right
+ * after the attachment so the encoder keeps it alive until it is
+ * deinitialized. Collect the reconstructed frames and compared them with
+ * reference decoder output.
+ *
+ * Expected result:
+ * No error is reported in encoding progress. The reconstructed frame data is
+ * same as the output frame from reference decoder.
+ *
+ * Test coverage:
+ * Random access and low delay prediction structures
+ */
+class SharedExecutorTest : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_decoder = true;
+        enable_recon = true;
+        enable_stat = true;
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+    void update_enc_setting() override {
+        SvtAv1E2ETestFramework::update_enc_setting();
+        EbSvtAv1Executor *executor = nullptr;
+        ASSERT_EQ(svt_av1_executor_create(&executor, 2), EB_ErrorNone);
+        ASSERT_EQ(svt_av1_enc_attach_executor(av1enc_ctx_.enc_handle,
+                                              executor,
+                                              1),
+                  EB_ErrorNone);
+        ASSERT_EQ(svt_av1_executor_destroy(executor), EB_ErrorNone);
+    }
+};
+
+TEST_P(SharedExecutorTest, ExecutorTest) {
+    run_death_test();
+}
+
+static const std::vector<EncTestSetting> shared_executor_settings = {
+    {"SharedExecutorTest1", {{"EncoderMode", "8"}}, default_test_vectors},
+    {"SharedExecutorTest2", {{"EncoderMode", "12"}}, default_test_vectors},
+    {"SharedExecutorTest3",
+     {{"EncoderMode", "10"}, {"PredStructure", "1"}, {"Tune", "1"}},
+     default_test_vectors},
+};
+
+INSTANTIATE_TEST_SUITE_P(SHAREDEXECUTORTEST, SharedExecutorTest,
+                         ::testing::ValuesIn(shared_executor_settings),
+                         EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder E2E test with comparing the reconstructed frame with
+ * output frame from decoder buffer list when the packets are written into
+ * buffers allocated by the application
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder with the output buffer callbacks, so the packets sent
+ * to the reference decoder are the buffers the encoder wrote into the memory
+ * of the test. Collect the reconstructed frames and compared them with
+ * reference decoder output.
+ *
+ * Expected result:
+ * No error is reported in encoding progress. The reconstructed frame data is
+ * same as the output frame from reference decoder, and the encoder used the
+ * callbacks.
+ *
+ * Test coverage:
+ * Random access and low delay prediction structures, overlays
+ */
+class AppOutputBufferTest : public SvtAv1E2ETestFramework {
+  public:
+    ~AppOutputBufferTest() override {
+        // the buffers of the packets are owned by the test once output
+        for (uint8_t *buffer : allocated_)
+            delete[] buffer;
+    }
+
+  protected:
+    void config_test() override {
+        enable_decoder = true;
+        enable_recon = true;
+        enable_stat = true;
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+    void update_enc_setting() override {
+        SvtAv1E2ETestFramework::update_enc_setting();
+        av1enc_ctx_.enc_params.output_buffer_alloc = alloc_buffer;
+        av1enc_ctx_.enc_params.output_buffer_free = free_buffer;
+        av1enc_ctx_.enc_params.output_buffer_ctx = this;
+    }
+    void post_process() override {
+        SvtAv1E2ETestFramework::post_process();
+        EXPECT_GT(alloc_count_, 0u) << "output buffer callbacks not used";
+    }
+
+  private:
+    static uint8_t *alloc_buffer(void *ctx, uint32_t size) {
+        AppOutputBufferTest *test = (AppOutputBufferTest *)ctx;
+        uint8_t *buffer = new uint8_t[size];
+        std::lock_guard<std::mutex> lock(test->mutex_);
+        test->allocated_.insert(buffer);
+        test->alloc_count_++;
+        return buffer;
+    }
+    static void free_buffer(void *ctx, uint8_t *buffer) {
+        AppOutputBufferTest *test = (AppOutputBufferTest *)ctx;
+        {
+            std::lock_guard<std::mutex> lock(test->mutex_);
+            test->allocated_.erase(buffer);
+        }
+        delete[] buffer;
+    }
+
+    std::mutex mutex_;
+    std::set<uint8_t *> allocated_;
+    uint32_t alloc_count_ = 0;
+};
+
+TEST_P(AppOutputBufferTest, OutputBufferTest) {
+    run_death_test();
+}
+
+static const std::vector<EncTestSetting> app_output_buffer_settings = {
+    {"AppOutputBufferTest1", {{"EncoderMode", "8"}}, default_test_vectors},
+    {"AppOutputBufferTest2",
+     {{"EncoderMode", "10"}, {"EnableOverlays", "1"}},
+     default_test_vectors},
+    {"AppOutputBufferTest3",
+     {{"EncoderMode", "10"}, {"PredStructure", "1"}, {"Tune", "1"}},
+     default_test_vectors},
+};
+
+INSTANTIATE_TEST_SUITE_P(APPOUTPUTBUFFERTEST, AppOutputBufferTest,
+                         ::testing::ValuesIn(app_output_buffer_settings),
+                         EncTestSetting::GetSettingName);